@@ -0,0 +1,8 @@
+#! /usr/bin/env python3
+
+# Programs that are runnable.
+ns3_runnable_programs = ['build/src/applications/examples/ns3.35-three-gpp-http-example-debug', 'build/src/config-store/examples/ns3.35-config-store-save-debug', 'build/src/core/examples/ns3.35-main-callback-debug', 'build/src/core/examples/ns3.35-sample-simulator-debug', 'build/src/core/examples/ns3.35-main-ptr-debug', 'build/src/core/examples/ns3.35-main-random-variable-stream-debug', 'build/src/core/examples/ns3.35-sample-random-variable-debug', 'build/src/core/examples/ns3.35-sample-random-variable-stream-debug', 'build/src/core/examples/ns3.35-command-line-example-debug', 'build/src/core/examples/ns3.35-hash-example-debug', 'build/src/core/examples/ns3.35-sample-log-time-format-debug', 'build/src/core/examples/ns3.35-test-string-value-formatting-debug', 'build/src/core/examples/ns3.35-sample-show-progress-debug', 'build/src/core/examples/ns3.35-empirical-random-variable-example-debug', 'build/src/core/examples/ns3.35-system-path-examples-debug', 'build/src/core/examples/ns3.35-fatal-example-debug', 'build/src/core/examples/ns3.35-main-test-sync-debug', 'build/src/core/examples/ns3.35-length-example-debug', 'build/src/energy/examples/ns3.35-li-ion-energy-source-debug', 'build/src/energy/examples/ns3.35-rv-battery-model-test-debug', 'build/src/energy/examples/ns3.35-basic-energy-model-test-debug', 'build/src/internet/examples/ns3.35-main-simple-debug', 'build/src/mobility/examples/ns3.35-main-grid-topology-debug', 'build/src/mobility/examples/ns3.35-main-random-topology-debug', 'build/src/mobility/examples/ns3.35-main-random-walk-debug', 'build/src/mobility/examples/ns3.35-mobility-trace-example-debug', 'build/src/mobility/examples/ns3.35-ns2-mobility-trace-debug', 'build/src/mobility/examples/ns3.35-bonnmotion-ns2-example-debug', 'build/src/mobility/examples/ns3.35-reference-point-group-mobility-example-debug', 'build/src/network/examples/ns3.35-main-packet-header-debug', 'build/src/network/examples/ns3.35-main-packet-tag-debug', 'build/src/network/examples/ns3.35-packet-socket-apps-debug', 'build/src/network/examples/ns3.35-lollipop-comparisions-debug', 'build/src/network/examples/ns3.35-bit-serializer-debug', 'build/src/point-to-point/examples/ns3.35-main-attribute-value-debug', 'build/src/spectrum/examples/ns3.35-adhoc-aloha-ideal-phy-debug', 'build/src/spectrum/examples/ns3.35-adhoc-aloha-ideal-phy-matrix-propagation-loss-model-debug', 'build/src/spectrum/examples/ns3.35-adhoc-aloha-ideal-phy-with-microwave-oven-debug', 'build/src/spectrum/examples/ns3.35-tv-trans-example-debug', 'build/src/spectrum/examples/ns3.35-tv-trans-regional-example-debug', 'build/src/stats/examples/ns3.35-gnuplot-example-debug', 'build/src/stats/examples/ns3.35-double-probe-example-debug', 'build/src/stats/examples/ns3.35-time-probe-example-debug', 'build/src/stats/examples/ns3.35-gnuplot-aggregator-example-debug', 'build/src/stats/examples/ns3.35-gnuplot-helper-example-debug', 'build/src/stats/examples/ns3.35-file-aggregator-example-debug', 'build/src/stats/examples/ns3.35-file-helper-example-debug', 'build/src/traffic-control/examples/ns3.35-red-tests-debug', 'build/src/traffic-control/examples/ns3.35-adaptive-red-tests-debug', 'build/src/traffic-control/examples/ns3.35-codel-vs-pfifo-basic-test-debug', 'build/src/traffic-control/examples/ns3.35-codel-vs-pfifo-asymmetric-debug', 'build/src/traffic-control/examples/ns3.35-pie-example-debug', 'build/src/traffic-control/examples/ns3.35-fqcodel-l4s-example-debug', 'build/src/wifi/examples/ns3.35-wifi-phy-test-debug', 'build/src/wifi/examples/ns3.35-wifi-test-interference-helper-debug', 'build/src/wifi/examples/ns3.35-wifi-manager-example-debug', 'build/src/wifi/examples/ns3.35-wifi-trans-example-debug', 'build/src/wifi/examples/ns3.35-wifi-phy-configuration-debug', 'build/src/wifi/examples/ns3.35-wifi-bianchi-debug', 'build/examples/tcp/ns3.35-tcp-large-transfer-debug', 'build/examples/tcp/ns3.35-tcp-nsc-lfn-debug', 'build/examples/tcp/ns3.35-tcp-star-server-debug', 'build/examples/tcp/ns3.35-tcp-bulk-send-debug', 'build/examples/tcp/ns3.35-tcp-pcap-nanosec-example-debug', 'build/examples/tcp/ns3.35-tcp-nsc-comparison-debug', 'build/examples/tcp/ns3.35-tcp-variants-comparison-debug', 'build/examples/tcp/ns3.35-tcp-pacing-debug', 'build/examples/tcp/ns3.35-dctcp-example-debug', 'build/examples/tcp/ns3.35-tcp-linux-reno-debug', 'build/examples/tcp/ns3.35-tcp-validation-debug', 'build/examples/tcp/ns3.35-tcp-bbr-example-debug', 'build/examples/energy/ns3.35-energy-model-example-debug', 'build/examples/energy/ns3.35-energy-model-with-harvesting-example-debug', 'build/examples/routing/ns3.35-simple-global-routing-debug', 'build/examples/routing/ns3.35-simple-alternate-routing-debug', 'build/examples/routing/ns3.35-simple-multicast-flooding-debug', 'build/examples/stats/ns3.35-wifi-example-sim-debug', 'build/examples/error-model/ns3.35-simple-error-model-debug', 'build/examples/wireless/ns3.35-wifi-adhoc-debug', 'build/examples/wireless/ns3.35-wifi-clear-channel-cmu-debug', 'build/examples/wireless/ns3.35-wifi-ap-debug', 'build/examples/wireless/ns3.35-wifi-simple-adhoc-debug', 'build/examples/wireless/ns3.35-wifi-simple-infra-debug', 'build/examples/wireless/ns3.35-wifi-simple-interference-debug', 'build/examples/wireless/ns3.35-wifi-blockack-debug', 'build/examples/wireless/ns3.35-wifi-dsss-validation-debug', 'build/examples/wireless/ns3.35-wifi-ofdm-validation-debug', 'build/examples/wireless/ns3.35-wifi-ofdm-ht-validation-debug', 'build/examples/wireless/ns3.35-wifi-ofdm-vht-validation-debug', 'build/examples/wireless/ns3.35-wifi-hidden-terminal-debug', 'build/examples/wireless/ns3.35-wifi-ht-network-debug', 'build/examples/wireless/ns3.35-wifi-vht-network-debug', 'build/examples/wireless/ns3.35-wifi-timing-attributes-debug', 'build/examples/wireless/ns3.35-wifi-sleep-debug', 'build/examples/wireless/ns3.35-wifi-power-adaptation-distance-debug', 'build/examples/wireless/ns3.35-wifi-power-adaptation-interference-debug', 'build/examples/wireless/ns3.35-wifi-rate-adaptation-distance-debug', 'build/examples/wireless/ns3.35-wifi-aggregation-debug', 'build/examples/wireless/ns3.35-wifi-txop-aggregation-debug', 'build/examples/wireless/ns3.35-wifi-simple-ht-hidden-stations-debug', 'build/examples/wireless/ns3.35-wifi-80211n-mimo-debug', 'build/examples/wireless/ns3.35-wifi-mixed-network-debug', 'build/examples/wireless/ns3.35-wifi-tcp-debug', 'build/examples/wireless/ns3.35-wifi-80211e-txop-debug', 'build/examples/wireless/ns3.35-wifi-spectrum-per-example-debug', 'build/examples/wireless/ns3.35-wifi-spectrum-per-interference-debug', 'build/examples/wireless/ns3.35-wifi-spectrum-saturation-example-debug', 'build/examples/wireless/ns3.35-wifi-ofdm-he-validation-debug', 'build/examples/wireless/ns3.35-wifi-he-network-debug', 'build/examples/wireless/ns3.35-wifi-multi-tos-debug', 'build/examples/wireless/ns3.35-wifi-backward-compatibility-debug', 'build/examples/wireless/ns3.35-wifi-spatial-reuse-debug', 'build/examples/wireless/ns3.35-wifi-error-models-comparison-debug', 'build/examples/tutorial/ns3.35-hello-simulator-debug', 'build/examples/tutorial/ns3.35-first-debug', 'build/examples/tutorial/ns3.35-fourth-debug', 'build/examples/tutorial/ns3.35-fifth-debug', 'build/examples/tutorial/ns3.35-sixth-debug', 'build/examples/tutorial/ns3.35-seventh-debug', 'build/examples/ipv6/ns3.35-test-ipv6-debug', 'build/examples/traffic-control/ns3.35-traffic-control-debug', 'build/examples/traffic-control/ns3.35-queue-discs-benchmark-debug', 'build/examples/traffic-control/ns3.35-tbf-example-debug', 'build/examples/traffic-control/ns3.35-cobalt-vs-codel-debug', 'build/scratch/subdir/ns3.35-subdir-debug', 'build/scratch/ns3.35-scratch-simulator-debug']
+
+# Scripts that are runnable.
+ns3_runnable_scripts = ['sample-simulator.py', 'wifi-ap.py', 'first.py']
+
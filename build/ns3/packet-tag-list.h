@@ -0,0 +1,324 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2006 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+#ifndef PACKET_TAG_LIST_H
+#define PACKET_TAG_LIST_H
+
+/**
+\file   packet-tag-list.h
+\brief  Defines a flat array of Packet tags, including copy-on-write semantics.
+*/
+
+#include <stdint.h>
+#include <cstdlib>
+#include <ostream>
+#include "ns3/type-id.h"
+
+namespace ns3 {
+
+class Tag;
+
+/**
+ * \ingroup packet
+ *
+ * \brief List of the packet tags stored in a packet.
+ *
+ * This class is mostly private to the Packet implementation and users
+ * should never have to access it directly.
+ *
+ * \internal
+ *
+ * All the tags of a packet live in a single contiguous, reference
+ * counted TagBlock:
+ *
+ * \verbatim
+     +-------+--------+----------+------+-----+------+------+-----+---------+
+     | count | nTags  | capacity | used | ... |  T0  |  T1  | ... |  data   |
+     +-------+--------+----------+------+-----+------+------+-----+---------+
+                                             \___ TagData slots _/ \_ bytes _/
+   \endverbatim
+ *
+ *   - Each TagData slot holds the TypeId and size of one tag, and
+ *     points into the data area at the end of the same block, where the
+ *     tag is stored in serialized form.  Slots are in insertion order;
+ *     the most recent tag is the last slot.
+ *
+ *   - A typical packet carries a handful of small tags, so a lookup is
+ *     a linear scan over a few adjacent slots, and a single allocation
+ *     holds the whole list.
+ *
+ * \par <b> Copy-on-write </b> is implemented as follows:
+ *
+ *   - Copy constructor (PacketTagList(const PacketTagList & o))
+ *     and assignment (#operator=(const PacketTagList & o))
+ *     share the block of \c o, incrementing its \c count.  Copying a
+ *     Packet therefore stays a constant time operation.
+ *
+ *   - #Add, #Remove and #Replace first make sure this PacketTagList is
+ *     the only owner of its block (<tt>count == 1</tt>), copying the
+ *     block otherwise, and then modify the block in place.  #Remove
+ *     compacts the slots and the data area, so the block never has holes.
+ *
+ *   - #Add is a \c const function, since it does not affect
+ *     any other PacketTagList's.
+ */
+class PacketTagList 
+{
+public:
+  /**
+   * Slot describing one serialized tag.
+   *
+   * See PacketTagList for a discussion of the data structure.
+   *
+   * \internal
+   * Unfortunately this has to be public, because
+   * PacketTagIterator::Item::GetTag() needs the data and size values.
+   * The Item nested class can't be forward declared, so friending isn't
+   * possible.
+   */
+  struct TagData
+  {
+    TypeId tid;                 /**< Type of the tag serialized into #data */
+    uint32_t size;              /**< Size of the \c data buffer */
+    uint8_t *data;              /**< Serialization buffer, in the data area of the block */
+  };  /* struct TagData */
+
+  /**
+   * Create a new PacketTagList.
+   */
+  inline PacketTagList ();
+  /**
+   * Copy constructor
+   *
+   * \param [in] o The PacketTagList to copy.
+   *
+   * This makes a light-weight copy by sharing the tag block
+   * of \pname{o}.
+   */
+  inline PacketTagList (PacketTagList const &o);
+  /**
+   * Assignment
+   *
+   * \param [in] o The PacketTagList to copy.
+   * \returns the copied object
+   *
+   * This makes a light-weight copy by #RemoveAll, then
+   * sharing the tag block of \pname{o}.
+   */
+  inline PacketTagList &operator = (PacketTagList const &o);
+  /**
+   * Destructor
+   *
+   * #RemoveAll's the tags.
+   */
+  inline ~PacketTagList ();
+
+  /**
+   * Add a tag to the list.
+   *
+   * \param [in] tag The tag to add
+   */
+  void Add (Tag const&tag) const;
+  /**
+   * Remove (the first instance of) tag from the list.
+   *
+   * \param [in,out] tag The tag type to remove.  If found,
+   *          \pname{tag} is set to the value of the tag found.
+   * \returns True if \pname{tag} is found, false otherwise.
+   */
+  bool Remove (Tag &tag);
+  /**
+   * Replace the value of a tag.
+   *
+   * \param [in] tag The tag type to replace.  To get the old
+   *        value of the tag, use #Peek first.
+   * \returns True if \pname{tag} is found, false otherwise.
+   *        If \pname{tag} wasn't found, Add is performed instead (so
+   *        the list is guaranteed to have the new tag value either way).
+   */
+  bool Replace (Tag &tag);
+  /**
+   * Find a tag and return its value.
+   *
+   * \param [in,out] tag The tag type to find.  If found,
+   *          \pname{tag} is set to the value of the tag found.
+   * \returns True if \pname{tag} is found, false otherwise.
+   */
+  bool Peek (Tag &tag) const;
+  /**
+   * Remove all tags from this list, releasing our reference to the block.
+   */
+  inline void RemoveAll (void);
+  /**
+   * \returns pointer to the first (oldest) tag slot
+   */
+  const struct PacketTagList::TagData *Begin (void) const;
+  /**
+   * \returns pointer past the last (most recent) tag slot
+   */
+  const struct PacketTagList::TagData *End (void) const;
+  /**
+   * Returns number of bytes required for packet serialization.
+   *
+   * \returns number of bytes required for packet serialization
+   */
+  uint32_t GetSerializedSize (void) const;
+  /**
+   * Serialize the tag list into a byte buffer.
+   *
+   * \param [in,out] buffer The byte buffer to which the tag list will be serialized
+   * \param [in] maxSize Max The max size of the buffer for bounds checking
+   *
+   * \returns zero if complete tag list is not serialized
+   */
+  uint32_t Serialize (uint32_t* buffer, uint32_t maxSize) const;
+  /**
+   * Deserialize tag list from the provided buffer.
+   *
+   * \param [in] buffer The buffer to read from.
+   * \param [in] size The number of bytes to deserialize.
+   *
+   * \returns zero if complete tag list is not deserialized
+   */
+  uint32_t Deserialize (const uint32_t* buffer, uint32_t size);
+
+private:
+  /**
+   * Shared storage for the tags of one or more PacketTagList's.
+   *
+   * We use malloc so we can allocate enough room for the slots and the
+   * serialized tags in one chunk.  See Object::Aggregates for a similar
+   * construction.
+   */
+  struct TagBlock
+  {
+    uint32_t count;             /**< Number of PacketTagList's sharing this block */
+    uint16_t nTags;             /**< Number of slots in use */
+    uint16_t capacity;          /**< Number of slots allocated */
+    uint32_t used;              /**< Number of bytes in use in the data area */
+    uint32_t dataSize;          /**< Size of the data area */
+    TagData tags[1];            /**< Tag slots, followed by the data area */
+  };  /* struct TagBlock */
+
+  /**
+   * Allocate a TagBlock with room for \pname{capacity} slots and
+   * \pname{dataSize} bytes of serialized tags.
+   *
+   * \param [in] capacity The number of slots.
+   * \param [in] dataSize The size of the data area.
+   * \returns The newly allocated, empty block, with a count of 1.
+   */
+  static TagBlock * CreateBlock (uint16_t capacity, uint32_t dataSize);
+  /**
+   * \param [in] block The block.
+   * \returns The start of the data area of \pname{block}.
+   */
+  static uint8_t * GetDataArea (TagBlock *block);
+  /**
+   * Make sure we are the only owner of our block, and that it has room
+   * for \pname{extraTags} more tags and \pname{extraBytes} more bytes,
+   * copying or growing the block as needed.
+   *
+   * \param [in] extraTags The number of slots to reserve.
+   * \param [in] extraBytes The number of data bytes to reserve.
+   * \returns The writable block.
+   */
+  TagBlock * MakeWritable (uint16_t extraTags, uint32_t extraBytes);
+  /**
+   * Find the slot of a tag type.
+   *
+   * \param [in] tid The tag type to look for.
+   * \returns The index of the slot, or -1 if not found.
+   */
+  int32_t Find (TypeId tid) const;
+  /**
+   * Erase a slot from our (writable) block, compacting the slots and
+   * the data area.
+   *
+   * \param [in] index The index of the slot to erase.
+   */
+  void Erase (uint16_t index);
+
+  /**
+   * Pointer to the shared tag block, or null if there are no tags.
+   */
+  TagBlock *m_block;
+};
+
+} // namespace ns3
+
+/****************************************************
+ *  Implementation of inline methods for performance
+ ****************************************************/
+
+namespace ns3 {
+
+PacketTagList::PacketTagList ()
+  : m_block (0)
+{
+}
+
+PacketTagList::PacketTagList (PacketTagList const &o)
+  : m_block (o.m_block)
+{
+  if (m_block != 0)
+    {
+      m_block->count++;
+    }
+}
+
+PacketTagList &
+PacketTagList::operator = (PacketTagList const &o)
+{
+  // self assignment
+  if (m_block == o.m_block) 
+    {
+      return *this;
+    }
+  RemoveAll ();
+  m_block = o.m_block;
+  if (m_block != 0) 
+    {
+      m_block->count++;
+    }
+  return *this;
+}
+
+PacketTagList::~PacketTagList ()
+{
+  RemoveAll ();
+}
+
+void
+PacketTagList::RemoveAll (void)
+{
+  if (m_block != 0)
+    {
+      m_block->count--;
+      if (m_block->count == 0)
+        {
+          std::free (m_block);
+        }
+      m_block = 0;
+    }
+}
+
+} // namespace ns3
+
+#endif /* PACKET_TAG_LIST_H */
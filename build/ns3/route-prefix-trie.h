@@ -0,0 +1,469 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef ROUTE_PREFIX_TRIE_H
+#define ROUTE_PREFIX_TRIE_H
+
+#include <stdint.h>
+#include <cstring>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "ns3/assert.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv6-address.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup ipv4Routing
+ *
+ * \brief Path-compressed binary trie (Patricia trie) of route prefixes
+ *
+ * The trie maps address prefixes of up to 128 bits to the values (usually
+ * routing table entries) stored for them, and finds all the values whose
+ * prefix matches an address by walking down a single path, in a time that
+ * depends on the address length and not on the number of routes.
+ *
+ * Nodes exist only for the stored prefixes and for the points where two
+ * prefixes diverge. Match returns the values in the order they were
+ * inserted, so that the routing protocols can keep their rules (metric,
+ * first or random choice among equal-cost routes) unchanged, and apply
+ * them to the few candidates found instead of to the whole table.
+ *
+ * Addresses are passed as arrays of BITS / 8 bytes, most significant
+ * first (as written by Ipv4Address::Serialize or Ipv6Address::GetBytes).
+ *
+ * \tparam T the type of the values
+ * \tparam BITS the address length, in bits
+ */
+template <typename T, uint8_t BITS>
+class RoutePrefixTrie
+{
+public:
+  RoutePrefixTrie ()
+    : m_root (new Node),
+      m_nextSeq (0),
+      m_size (0)
+  {
+  }
+
+  ~RoutePrefixTrie ()
+  {
+    delete m_root;
+  }
+
+  /// Copying is not supported
+  RoutePrefixTrie (const RoutePrefixTrie &) = delete;
+  /// Copying is not supported
+  RoutePrefixTrie &operator= (const RoutePrefixTrie &) = delete;
+
+  /**
+   * \brief Store a value for a prefix.
+   * \param prefix the prefix bytes (bits beyond prefixLen are ignored)
+   * \param prefixLen the prefix length, in bits
+   * \param value the value
+   */
+  void Insert (const uint8_t *prefix, uint8_t prefixLen, const T &value)
+  {
+    NS_ASSERT (prefixLen <= BITS);
+    Node *node = m_root;
+    while (node->len != prefixLen)
+      {
+        Node *&child = node->children[GetBit (prefix, node->len)];
+        if (!child)
+          { // New leaf
+            child = new Node (prefix, prefixLen);
+            node = child;
+            break;
+          }
+        uint8_t common = CommonLength (child->key, prefix, std::min (child->len, prefixLen));
+        if (common < child->len)
+          { // The prefix diverges from the child, or ends inside it: split
+            Node *split = new Node (prefix, common);
+            split->children[GetBit (child->key, common)] = child;
+            child = split;
+          }
+        node = child;
+      }
+    node->values.push_back (std::make_pair (m_nextSeq++, value));
+    m_size++;
+  }
+
+  /**
+   * \brief Remove a value stored for a prefix.
+   * \param prefix the prefix bytes
+   * \param prefixLen the prefix length, in bits
+   * \param value the value
+   * \return true if the value was found and removed
+   */
+  bool Remove (const uint8_t *prefix, uint8_t prefixLen, const T &value)
+  {
+    Node **slot = &m_root;
+    Node **parentSlot = 0;
+    while ((*slot)->len != prefixLen)
+      {
+        if ((*slot)->len > prefixLen)
+          {
+            return false;
+          }
+        Node **next = &(*slot)->children[GetBit (prefix, (*slot)->len)];
+        if (!*next || CommonLength ((*next)->key, prefix, std::min ((*next)->len, prefixLen)) < (*next)->len)
+          {
+            return false;
+          }
+        parentSlot = slot;
+        slot = next;
+      }
+    Node *node = *slot;
+    typename Values::iterator it = node->values.begin ();
+    while (it != node->values.end () && !(it->second == value))
+      {
+        ++it;
+      }
+    if (it == node->values.end ())
+      {
+        return false;
+      }
+    node->values.erase (it);
+    m_size--;
+    if (node != m_root)
+      {
+        Prune (slot);
+        if (parentSlot && *parentSlot != m_root)
+          {
+            Prune (parentSlot);
+          }
+      }
+    return true;
+  }
+
+  /**
+   * \brief Find the values whose prefix matches an address.
+   * \param address the address bytes
+   * \param out vector where the values are stored, in insertion order
+   */
+  void Match (const uint8_t *address, std::vector<T> &out) const
+  {
+    out.clear ();
+    const Node *matched[BITS + 1];
+    uint32_t nMatched = 0;
+    const Node *node = m_root;
+    while (node)
+      {
+        if (!node->values.empty ())
+          {
+            matched[nMatched++] = node;
+          }
+        if (node->len == BITS)
+          {
+            break;
+          }
+        const Node *child = node->children[GetBit (address, node->len)];
+        if (child && CommonLength (child->key, address, child->len) < child->len)
+          {
+            child = 0;
+          }
+        node = child;
+      }
+    if (nMatched == 1)
+      { // Common case: the values are already in insertion order
+        for (typename Values::const_iterator it = matched[0]->values.begin (); it != matched[0]->values.end (); ++it)
+          {
+            out.push_back (it->second);
+          }
+        return;
+      }
+    Values merged;
+    for (uint32_t i = 0; i < nMatched; ++i)
+      {
+        merged.insert (merged.end (), matched[i]->values.begin (), matched[i]->values.end ());
+      }
+    std::sort (merged.begin (), merged.end (),
+               [] (const std::pair<uint64_t, T> &a, const std::pair<uint64_t, T> &b)
+               {
+                 return a.first < b.first;
+               });
+    for (typename Values::const_iterator it = merged.begin (); it != merged.end (); ++it)
+      {
+        out.push_back (it->second);
+      }
+  }
+
+  /**
+   * \brief Remove all the values.
+   */
+  void Clear (void)
+  {
+    delete m_root;
+    m_root = new Node;
+    m_size = 0;
+  }
+
+  /**
+   * \return the number of values stored
+   */
+  uint32_t GetSize (void) const
+  {
+    return m_size;
+  }
+
+private:
+  /// Values stored for a prefix, with their insertion sequence number
+  typedef std::vector<std::pair<uint64_t, T> > Values;
+
+  /// A trie node
+  struct Node
+  {
+    Node ()
+      : len (0)
+    {
+      std::memset (key, 0, sizeof (key));
+      children[0] = children[1] = 0;
+    }
+    /**
+     * \brief Constructor.
+     * \param prefix the prefix bytes
+     * \param prefixLen the prefix length, in bits
+     */
+    Node (const uint8_t *prefix, uint8_t prefixLen)
+      : len (prefixLen)
+    {
+      std::memset (key, 0, sizeof (key));
+      std::memcpy (key, prefix, (prefixLen + 7) / 8);
+      children[0] = children[1] = 0;
+    }
+    ~Node ()
+    {
+      delete children[0];
+      delete children[1];
+    }
+    uint8_t key[BITS / 8];     //!< Prefix bytes
+    uint8_t len;               //!< Prefix length, in bits
+    Node *children[2];         //!< Children, by the bit following the prefix
+    Values values;             //!< Values stored for the prefix
+  };
+
+  /**
+   * \brief Get a bit of an address.
+   * \param bytes the address bytes
+   * \param bit the bit index, 0 being the most significant
+   * \return the bit
+   */
+  static uint8_t GetBit (const uint8_t *bytes, uint8_t bit)
+  {
+    return (bytes[bit / 8] >> (7 - bit % 8)) & 1;
+  }
+
+  /**
+   * \brief Get the length of the common prefix of two addresses.
+   * \param a the first address bytes
+   * \param b the second address bytes
+   * \param maxLen the number of bits to compare
+   * \return the number of leading bits in common, at most maxLen
+   */
+  static uint8_t CommonLength (const uint8_t *a, const uint8_t *b, uint8_t maxLen)
+  {
+    uint8_t len = 0;
+    while (len < maxLen)
+      {
+        uint8_t diff = a[len / 8] ^ b[len / 8];
+        if (diff == 0)
+          {
+            len = std::min<uint8_t> (maxLen, (len / 8 + 1) * 8);
+            continue;
+          }
+        uint8_t bit = len % 8;
+        while (bit < 8 && !((diff >> (7 - bit)) & 1))
+          {
+            bit++;
+          }
+        return std::min<uint8_t> (maxLen, (len / 8) * 8 + bit);
+      }
+    return maxLen;
+  }
+
+  /**
+   * \brief Remove a node without values if it is not needed anymore.
+   * \param slot the pointer to the node in its parent
+   */
+  static void Prune (Node **slot)
+  {
+    Node *node = *slot;
+    if (!node->values.empty () || (node->children[0] && node->children[1]))
+      {
+        return;
+      }
+    *slot = node->children[0] ? node->children[0] : node->children[1];
+    node->children[0] = node->children[1] = 0;
+    delete node;
+  }
+
+  Node *m_root;       //!< The root node, for the zero-length prefix
+  uint64_t m_nextSeq; //!< Sequence number of the next value inserted
+  uint32_t m_size;    //!< Number of values stored
+};
+
+/**
+ * \ingroup ipv4Routing
+ *
+ * \brief RoutePrefixTrie of IPv4 routes
+ *
+ * Routes are stored under the leading ones of their mask. With the usual
+ * contiguous masks this is the exact prefix; with other masks Match may
+ * return routes that do not match, so the caller must check them with
+ * Ipv4Mask::IsMatch.
+ *
+ * \tparam T the type of the values
+ */
+template <typename T>
+class Ipv4RoutePrefixTrie : public RoutePrefixTrie<T, 32>
+{
+public:
+  /**
+   * \brief Store a value for a network.
+   * \param network the network address
+   * \param mask the network mask
+   * \param value the value
+   */
+  void Insert (Ipv4Address network, Ipv4Mask mask, const T &value)
+  {
+    uint8_t key[4];
+    network.CombineMask (mask).Serialize (key);
+    RoutePrefixTrie<T, 32>::Insert (key, GetLeadingOnes (mask), value);
+  }
+
+  /**
+   * \brief Remove a value stored for a network.
+   * \param network the network address
+   * \param mask the network mask
+   * \param value the value
+   * \return true if the value was found and removed
+   */
+  bool Remove (Ipv4Address network, Ipv4Mask mask, const T &value)
+  {
+    uint8_t key[4];
+    network.CombineMask (mask).Serialize (key);
+    return RoutePrefixTrie<T, 32>::Remove (key, GetLeadingOnes (mask), value);
+  }
+
+  /**
+   * \brief Find the values stored for the networks containing an address.
+   * \param address the address
+   * \param out vector where the values are stored, in insertion order
+   */
+  void Match (Ipv4Address address, std::vector<T> &out) const
+  {
+    uint8_t key[4];
+    address.Serialize (key);
+    RoutePrefixTrie<T, 32>::Match (key, out);
+  }
+
+private:
+  /**
+   * \brief Count the leading ones of a mask.
+   * \param mask the mask
+   * \return the number of leading ones
+   */
+  static uint8_t GetLeadingOnes (Ipv4Mask mask)
+  {
+    uint32_t bits = mask.Get ();
+    uint8_t len = 0;
+    while (len < 32 && (bits & (0x80000000U >> len)))
+      {
+        len++;
+      }
+    return len;
+  }
+};
+
+/**
+ * \ingroup ipv6Routing
+ *
+ * \brief RoutePrefixTrie of IPv6 routes
+ *
+ * As for Ipv4RoutePrefixTrie, routes are stored under the leading ones of
+ * their prefix, and the caller must check the values returned with
+ * Ipv6Prefix::IsMatch.
+ *
+ * \tparam T the type of the values
+ */
+template <typename T>
+class Ipv6RoutePrefixTrie : public RoutePrefixTrie<T, 128>
+{
+public:
+  /**
+   * \brief Store a value for a network.
+   * \param network the network address
+   * \param prefix the network prefix
+   * \param value the value
+   */
+  void Insert (Ipv6Address network, Ipv6Prefix prefix, const T &value)
+  {
+    uint8_t key[16];
+    network.CombinePrefix (prefix).GetBytes (key);
+    RoutePrefixTrie<T, 128>::Insert (key, GetLeadingOnes (prefix), value);
+  }
+
+  /**
+   * \brief Remove a value stored for a network.
+   * \param network the network address
+   * \param prefix the network prefix
+   * \param value the value
+   * \return true if the value was found and removed
+   */
+  bool Remove (Ipv6Address network, Ipv6Prefix prefix, const T &value)
+  {
+    uint8_t key[16];
+    network.CombinePrefix (prefix).GetBytes (key);
+    return RoutePrefixTrie<T, 128>::Remove (key, GetLeadingOnes (prefix), value);
+  }
+
+  /**
+   * \brief Find the values stored for the networks containing an address.
+   * \param address the address
+   * \param out vector where the values are stored, in insertion order
+   */
+  void Match (Ipv6Address address, std::vector<T> &out) const
+  {
+    uint8_t key[16];
+    address.GetBytes (key);
+    RoutePrefixTrie<T, 128>::Match (key, out);
+  }
+
+private:
+  /**
+   * \brief Count the leading ones of a prefix.
+   * \param prefix the prefix
+   * \return the number of leading ones
+   */
+  static uint8_t GetLeadingOnes (Ipv6Prefix prefix)
+  {
+    uint8_t bytes[16];
+    prefix.GetBytes (bytes);
+    uint8_t len = 0;
+    while (len < 128 && (bytes[len / 8] & (0x80 >> (len % 8))))
+      {
+        len++;
+      }
+    return len;
+  }
+};
+
+} // namespace ns3
+
+#endif /* ROUTE_PREFIX_TRIE_H */
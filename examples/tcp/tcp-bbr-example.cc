@@ -52,6 +52,10 @@
 //
 // The congestion window and queue occupancy traces output by this program show
 // periodic drops every 10 seconds when BBR algorithm is in PROBE_RTT phase.
+//
+// With --edtPacing=true, the sender stamps each segment with its departure
+// time and a FqPacingQueueDisc on the Sender interface releases it, as with
+// Linux fq, instead of TCP pacing each segment with its own timer.
 
 #include "ns3/core-module.h"
 #include "ns3/network-module.h"
@@ -120,12 +124,14 @@ int main (int argc, char *argv [])
   uint32_t delAckCount = 2;
   bool bql = true;
   bool enablePcap = false;
+  bool edtPacing = false;
   Time stopTime = Seconds (100);
 
   CommandLine cmd (__FILE__);
-  cmd.AddValue ("tcpTypeId", "Transport protocol to use: TcpNewReno, TcpBbr", tcpTypeId);
+  cmd.AddValue ("tcpTypeId", "Transport protocol to use: TcpNewReno, TcpBbr, TcpBbr2", tcpTypeId);
   cmd.AddValue ("delAckCount", "Delayed ACK count", delAckCount);
   cmd.AddValue ("enablePcap", "Enable/Disable pcap file generation", enablePcap);
+  cmd.AddValue ("edtPacing", "Pace with departure time stamps, enforced by a FqPacingQueueDisc on the sender", edtPacing);
   cmd.AddValue ("stopTime", "Stop time for applications / simulation time will be stopTime + 1", stopTime);
   cmd.Parse (argc, argv);
 
@@ -137,6 +143,7 @@ int main (int argc, char *argv [])
   Config::SetDefault ("ns3::TcpSocket::InitialCwnd", UintegerValue (10));
   Config::SetDefault ("ns3::TcpSocket::DelAckCount", UintegerValue (delAckCount));
   Config::SetDefault ("ns3::TcpSocket::SegmentSize", UintegerValue (1448));
+  Config::SetDefault ("ns3::TcpSocketState::EdtPacing", BooleanValue (edtPacing));
   Config::SetDefault ("ns3::DropTailQueue<Packet>::MaxSize", QueueSizeValue (QueueSize ("1p")));
   Config::SetDefault (queueDisc + "::MaxSize", QueueSizeValue (QueueSize ("100p")));
 
@@ -175,7 +182,22 @@ int main (int argc, char *argv [])
       tch.SetQueueLimits ("ns3::DynamicQueueLimits", "HoldTime", StringValue ("1000ms"));
     }
 
-  tch.Install (senderEdge);
+  if (edtPacing)
+    {
+      // Host-side pacing: the sender's queue disc enforces the departure times
+      TrafficControlHelper fqTch;
+      fqTch.SetRootQueueDisc ("ns3::FqPacingQueueDisc");
+      if (bql)
+        {
+          fqTch.SetQueueLimits ("ns3::DynamicQueueLimits", "HoldTime", StringValue ("1000ms"));
+        }
+      fqTch.Install (senderEdge.Get (0));
+      tch.Install (senderEdge.Get (1));
+    }
+  else
+    {
+      tch.Install (senderEdge);
+    }
   tch.Install (receiverEdge);
 
   // Assign IP addresses
@@ -29,6 +29,8 @@
 #include "attribute-helper.h"
 #include "simple-ref-count.h"
 #include <typeinfo>
+#include <cstring>
+#include <type_traits>
 
 /**
  * \file
@@ -1187,19 +1189,66 @@ private:
   typename TypeTraits<TX3>::ReferencedType m_a3;  //!< third bound argument
 };
 
+/**
+ * \ingroup callbackimpl
+ * Operations of a member function Callback stored inline in its
+ * CallbackBase, shared by all the Callbacks with the same object,
+ * member function and signature types.
+ */
+struct CallbackInlineOps
+{
+  /**
+   * The invoker, with its type erased.  The actual type is
+   * <tt>R (*) (void *object, const void *memPtr, T1, ...)</tt>
+   * for the non-empty argument types of the Callback.
+   */
+  void (*invoke)(void);
+  /**
+   * Build the equivalent MemPtrCallbackImpl.
+   * \param [in] object The object pointer
+   * \param [in] memPtr The stored member function pointer
+   * \return The new CallbackImpl
+   */
+  Ptr<CallbackImplBase> (*materialize)(void *object, const void *memPtr);
+  const std::type_info *type;           //!< typeid of the equivalent MemPtrCallbackImpl
+  const std::type_info *signature;      //!< typeid of the CallbackImpl of the Callback signature
+
+  /**
+   * Room for a member function pointer: two words in the Itanium C++ ABI.
+   * Larger ones are kept in a pimpl.
+   */
+  static const std::size_t memPtrSize = 2 * sizeof (void *);
+};
+
 /**
  * \ingroup callbackimpl
  * Base class for Callback class.
  * Provides pimpl abstraction.
+ *
+ * A Callback to a member function of an object held by a raw pointer
+ * does not need a pimpl: the object and member function pointers are
+ * stored inline, with a pointer to a static table of operations, so
+ * that building, copying and invoking it never allocates.
  */
 class CallbackBase
 {
 public:
-  CallbackBase () : m_impl ()
-  {}
-  /** \return The impl pointer */
+  CallbackBase () : m_impl (), m_inline (0), m_object (0)
+  {
+    std::memset (m_memPtr, 0, sizeof (m_memPtr));
+  }
+  /**
+   * A Callback stored inline builds a new equivalent pimpl each time
+   * this is called.
+   *
+   * \return The impl pointer
+   */
   Ptr<CallbackImplBase> GetImpl (void) const
   {
+    if (m_inline != 0)
+      {
+        return m_inline->materialize (m_object, m_memPtr);
+      }
     return m_impl;
   }
 
@@ -1208,9 +1257,176 @@ protected:
    * Construct from a pimpl
    * \param [in] impl The CallbackImplBase Ptr
    */
-  CallbackBase (Ptr<CallbackImplBase> impl) : m_impl (impl)
-  {}
+  CallbackBase (Ptr<CallbackImplBase> impl) : m_impl (impl), m_inline (0), m_object (0)
+  {
+    std::memset (m_memPtr, 0, sizeof (m_memPtr));
+  }
+  /**
+   * Equality test, without building a pimpl when both Callbacks
+   * are stored inline.
+   *
+   * \param [in] other Callback
+   * \return \c true if we are equal
+   */
+  bool DoIsEqual (const CallbackBase &other) const
+  {
+    if (m_inline != 0 && other.m_inline != 0)
+      {
+        return *m_inline->type == *other.m_inline->type
+               && m_object == other.m_object
+               && std::memcmp (m_memPtr, other.m_memPtr, sizeof (m_memPtr)) == 0;
+      }
+    return GetImpl ()->IsEqual (other.GetImpl ());
+  }
+  /**
+   * \param [in] other Callback
+   * \return The typeid of the CallbackImpl of the signature of
+   *         \pname{other} if it is stored inline, or 0.
+   */
+  static const std::type_info * GetInlineSignature (const CallbackBase &other)
+  {
+    return other.m_inline != 0 ? other.m_inline->signature : 0;
+  }
+
   Ptr<CallbackImplBase> m_impl;         //!< the pimpl
+  const CallbackInlineOps *m_inline;    //!< the inline operations, or 0 if not stored inline
+  void *m_object;                       //!< the object of an inline Callback
+  char m_memPtr[CallbackInlineOps::memPtrSize]; //!< the member function pointer of an inline Callback
+};
+
+/**
+ * \ingroup callbackimpl
+ * List of the argument types of a Callback.
+ * \tparam Ts \explicit The argument types.
+ */
+template <typename... Ts>
+struct CallbackArgList
+{};
+
+/**
+ * \ingroup callbackimpl
+ * Strip the trailing empty types from a Callback argument list.
+ * \tparam LIST \explicit The CallbackArgList of the types already kept.
+ * \tparam Ts \explicit The remaining types.
+ */
+template <typename LIST, typename... Ts>
+struct CallbackStripEmpty;
+
+/**
+ * \ingroup callbackimpl
+ * No more types: the kept list is the result.
+ * \tparam Ds \explicit The kept types.
+ */
+template <typename... Ds>
+struct CallbackStripEmpty<CallbackArgList<Ds...> >
+{
+  typedef CallbackArgList<Ds...> Type;  //!< the non-empty types
+};
+
+/**
+ * \ingroup callbackimpl
+ * Stop at the first empty type.
+ * \tparam Ds \explicit The kept types.
+ * \tparam Ts \explicit The remaining types.
+ */
+template <typename... Ds, typename... Ts>
+struct CallbackStripEmpty<CallbackArgList<Ds...>, empty, Ts...>
+{
+  typedef CallbackArgList<Ds...> Type;  //!< the non-empty types
+};
+
+/**
+ * \ingroup callbackimpl
+ * Keep a non-empty type.
+ * \tparam Ds \explicit The kept types.
+ * \tparam T \explicit The next type.
+ * \tparam Ts \explicit The remaining types.
+ */
+template <typename... Ds, typename T, typename... Ts>
+struct CallbackStripEmpty<CallbackArgList<Ds...>, T, Ts...>
+  : public CallbackStripEmpty<CallbackArgList<Ds..., T>, Ts...>
+{};
+
+/**
+ * \ingroup callbackimpl
+ * Invoker of a member function Callback stored inline.
+ * \tparam OBJ \explicit The object type.
+ * \tparam MEM_PTR \explicit The member function pointer type.
+ * \tparam R \explicit The return type of the Callback.
+ * \tparam LIST \explicit The CallbackArgList of the Callback arguments.
+ */
+template <typename OBJ, typename MEM_PTR, typename R, typename LIST>
+struct CallbackInlineInvoker;
+
+/**
+ * \ingroup callbackimpl
+ * Invoker of a member function Callback stored inline.
+ * \tparam OBJ \explicit The object type.
+ * \tparam MEM_PTR \explicit The member function pointer type.
+ * \tparam R \explicit The return type of the Callback.
+ * \tparam Ts \explicit The Callback arguments.
+ */
+template <typename OBJ, typename MEM_PTR, typename R, typename... Ts>
+struct CallbackInlineInvoker<OBJ, MEM_PTR, R, CallbackArgList<Ts...> >
+{
+  /**
+   * \param [in] object The object pointer
+   * \param [in] memPtr The stored member function pointer
+   * \param [in] args The Callback arguments
+   * \return Callback value
+   */
+  static R Invoke (void *object, const void *memPtr, Ts... args)
+  {
+    MEM_PTR fn;
+    std::memcpy (&fn, memPtr, sizeof (MEM_PTR));
+    return (static_cast<OBJ *> (object)->*fn)(args...);
+  }
+};
+
+/**
+ * \ingroup callbackimpl
+ * Inline storage of a Callback to a member function of an object
+ * held by a raw pointer.
+ * \tparam OBJ_PTR \explicit Type of the target object, as a raw pointer.
+ * \tparam MEM_PTR \explicit Type of the class member function.
+ * The remaining template arguments are the Callback signature.
+ */
+template <typename OBJ_PTR, typename MEM_PTR, typename R, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8, typename T9>
+struct MemPtrCallbackInline
+{
+  /** Whether this object and member function can be stored inline. */
+  static const bool enabled = std::is_pointer<OBJ_PTR>::value
+    && std::is_member_function_pointer<MEM_PTR>::value
+    && sizeof (MEM_PTR) <= CallbackInlineOps::memPtrSize;
+
+  /** The object type. */
+  typedef typename std::remove_pointer<OBJ_PTR>::type Object;
+  /** The invoker of this Callback. */
+  typedef CallbackInlineInvoker<Object, MEM_PTR, R,
+                                typename CallbackStripEmpty<CallbackArgList<>, T1, T2, T3, T4, T5, T6, T7, T8, T9>::Type> Invoker;
+
+  /**
+   * \param [in] object The object pointer
+   * \param [in] memPtr The stored member function pointer
+   * \return The equivalent MemPtrCallbackImpl
+   */
+  static Ptr<CallbackImplBase> Materialize (void *object, const void *memPtr)
+  {
+    MEM_PTR fn;
+    std::memcpy (&fn, memPtr, sizeof (MEM_PTR));
+    return Create<MemPtrCallbackImpl<OBJ_PTR,MEM_PTR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> > (static_cast<Object *> (object), fn);
+  }
+  /** \return The operations shared by these Callbacks */
+  static const CallbackInlineOps * GetOps (void)
+  {
+    static const CallbackInlineOps ops = {
+      reinterpret_cast<void (*)(void)> (&Invoker::Invoke),
+      &Materialize,
+      &typeid (MemPtrCallbackImpl<OBJ_PTR,MEM_PTR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9>),
+      &typeid (CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,T9>)
+    };
+    return &ops;
+  }
 };
 
 /**
@@ -1306,8 +1522,10 @@ public:
    */
   template <typename OBJ_PTR, typename MEM_PTR>
   Callback (OBJ_PTR const &objPtr, MEM_PTR memPtr)
-    : CallbackBase (Create<MemPtrCallbackImpl<OBJ_PTR,MEM_PTR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> > (objPtr, memPtr))
-  {}
+  {
+    typedef MemPtrCallbackInline<OBJ_PTR,MEM_PTR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> Inline;
+    DoSetMemPtr (objPtr, memPtr, std::integral_constant<bool, Inline::enabled> ());
+  }
 
   /**
    * Construct from a CallbackImpl pointer
@@ -1385,12 +1603,13 @@ public:
    */
   bool IsNull (void) const
   {
-    return (DoPeekImpl () == 0) ? true : false;
+    return (DoPeekImpl () == 0 && m_inline == 0) ? true : false;
   }
   /** Discard the implementation, set it to null */
   void Nullify (void)
   {
     m_impl = 0;
+    m_inline = 0;
   }
 
   /**
@@ -1400,6 +1619,11 @@ public:
   /** \return Callback value */
   R operator() (void) const
   {
+    if (m_inline != 0)
+      {
+        typedef R (*Invoke)(void *, const void *);
+        return reinterpret_cast<Invoke> (m_inline->invoke)(m_object, m_memPtr);
+      }
     return (*(DoPeekImpl ()))();
   }
   /**
@@ -1408,6 +1632,11 @@ public:
    */
   R operator() (T1 a1) const
   {
+    if (m_inline != 0)
+      {
+        typedef R (*Invoke)(void *, const void *, T1);
+        return reinterpret_cast<Invoke> (m_inline->invoke)(m_object, m_memPtr, a1);
+      }
     return (*(DoPeekImpl ()))(a1);
   }
   /**
@@ -1417,6 +1646,11 @@ public:
    */
   R operator() (T1 a1, T2 a2) const
   {
+    if (m_inline != 0)
+      {
+        typedef R (*Invoke)(void *, const void *, T1, T2);
+        return reinterpret_cast<Invoke> (m_inline->invoke)(m_object, m_memPtr, a1, a2);
+      }
     return (*(DoPeekImpl ()))(a1,a2);
   }
   /**
@@ -1427,6 +1661,11 @@ public:
    */
   R operator() (T1 a1, T2 a2, T3 a3) const
   {
+    if (m_inline != 0)
+      {
+        typedef R (*Invoke)(void *, const void *, T1, T2, T3);
+        return reinterpret_cast<Invoke> (m_inline->invoke)(m_object, m_memPtr, a1, a2, a3);
+      }
     return (*(DoPeekImpl ()))(a1,a2,a3);
   }
   /**
@@ -1438,6 +1677,11 @@ public:
    */
   R operator() (T1 a1, T2 a2, T3 a3, T4 a4) const
   {
+    if (m_inline != 0)
+      {
+        typedef R (*Invoke)(void *, const void *, T1, T2, T3, T4);
+        return reinterpret_cast<Invoke> (m_inline->invoke)(m_object, m_memPtr, a1, a2, a3, a4);
+      }
     return (*(DoPeekImpl ()))(a1,a2,a3,a4);
   }
   /**
@@ -1450,6 +1694,11 @@ public:
    */
   R operator() (T1 a1, T2 a2, T3 a3, T4 a4,T5 a5) const
   {
+    if (m_inline != 0)
+      {
+        typedef R (*Invoke)(void *, const void *, T1, T2, T3, T4, T5);
+        return reinterpret_cast<Invoke> (m_inline->invoke)(m_object, m_memPtr, a1, a2, a3, a4, a5);
+      }
     return (*(DoPeekImpl ()))(a1,a2,a3,a4,a5);
   }
   /**
@@ -1463,6 +1712,11 @@ public:
    */
   R operator() (T1 a1, T2 a2, T3 a3, T4 a4,T5 a5,T6 a6) const
   {
+    if (m_inline != 0)
+      {
+        typedef R (*Invoke)(void *, const void *, T1, T2, T3, T4, T5, T6);
+        return reinterpret_cast<Invoke> (m_inline->invoke)(m_object, m_memPtr, a1, a2, a3, a4, a5, a6);
+      }
     return (*(DoPeekImpl ()))(a1,a2,a3,a4,a5,a6);
   }
   /**
@@ -1477,6 +1731,11 @@ public:
    */
   R operator() (T1 a1, T2 a2, T3 a3, T4 a4,T5 a5,T6 a6,T7 a7) const
   {
+    if (m_inline != 0)
+      {
+        typedef R (*Invoke)(void *, const void *, T1, T2, T3, T4, T5, T6, T7);
+        return reinterpret_cast<Invoke> (m_inline->invoke)(m_object, m_memPtr, a1, a2, a3, a4, a5, a6, a7);
+      }
     return (*(DoPeekImpl ()))(a1,a2,a3,a4,a5,a6,a7);
   }
   /**
@@ -1492,6 +1751,11 @@ public:
    */
   R operator() (T1 a1, T2 a2, T3 a3, T4 a4,T5 a5,T6 a6,T7 a7,T8 a8) const
   {
+    if (m_inline != 0)
+      {
+        typedef R (*Invoke)(void *, const void *, T1, T2, T3, T4, T5, T6, T7, T8);
+        return reinterpret_cast<Invoke> (m_inline->invoke)(m_object, m_memPtr, a1, a2, a3, a4, a5, a6, a7, a8);
+      }
     return (*(DoPeekImpl ()))(a1,a2,a3,a4,a5,a6,a7,a8);
   }
   /**
@@ -1508,6 +1772,11 @@ public:
    */
   R operator() (T1 a1, T2 a2, T3 a3, T4 a4,T5 a5,T6 a6,T7 a7,T8 a8, T9 a9) const
   {
+    if (m_inline != 0)
+      {
+        typedef R (*Invoke)(void *, const void *, T1, T2, T3, T4, T5, T6, T7, T8, T9);
+        return reinterpret_cast<Invoke> (m_inline->invoke)(m_object, m_memPtr, a1, a2, a3, a4, a5, a6, a7, a8, a9);
+      }
     return (*(DoPeekImpl ()))(a1,a2,a3,a4,a5,a6,a7,a8,a9);
   }
   /**@}*/
@@ -1520,7 +1789,7 @@ public:
    */
   bool IsEqual (const CallbackBase &other) const
   {
-    return m_impl->IsEqual (other.GetImpl ());
+    return DoIsEqual (other);
   }
 
   /**
@@ -1531,6 +1800,11 @@ public:
    */
   bool CheckType (const CallbackBase & other) const
   {
+    const std::type_info *signature = GetInlineSignature (other);
+    if (signature != 0)
+      {
+        return *signature == typeid (CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,T9>);
+      }
     return DoCheckType (other.GetImpl ());
   }
   /**
@@ -1541,7 +1815,7 @@ public:
    */
   bool Assign (const CallbackBase &other)
   {
-    return DoAssign (other.GetImpl ());
+    return DoAssign (other);
   }
 
 private:
@@ -1573,20 +1847,48 @@ private:
       }
   }
   /** \copydoc Assign */
-  bool DoAssign (Ptr<const CallbackImplBase> other)
+  bool DoAssign (const CallbackBase &other)
   {
-    if (!DoCheckType (other))
+    if (!CheckType (other))
       {
-        std::string othTid = other->GetTypeid ();
+        std::string othTid = other.GetImpl ()->GetTypeid ();
         std::string myTid = CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,T9>::DoGetTypeid ();
         NS_FATAL_ERROR_CONT ("Incompatible types. (feed to \"c++filt -t\" if needed)" << std::endl <<
                              "got=" << othTid << std::endl <<
                              "expected=" << myTid);
         return false;
       }
-    m_impl = const_cast<CallbackImplBase *> (PeekPointer (other));
+    CallbackBase::operator= (other);
     return true;
   }
+  /**
+   * Store a member function Callback in a pimpl.
+   *
+   * \tparam OBJ_PTR \deduced Type of the target object, as a pointer.
+   * \tparam MEM_PTR \deduced Type of the class member function.
+   * \param [in] objPtr Pointer to the object
+   * \param [in] memPtr Pointer to the member function
+   */
+  template <typename OBJ_PTR, typename MEM_PTR>
+  void DoSetMemPtr (OBJ_PTR const &objPtr, MEM_PTR memPtr, std::false_type)
+  {
+    m_impl = Create<MemPtrCallbackImpl<OBJ_PTR,MEM_PTR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> > (objPtr, memPtr);
+  }
+  /**
+   * Store a member function Callback inline.
+   *
+   * \tparam OBJ_PTR \deduced Type of the target object, as a raw pointer.
+   * \tparam MEM_PTR \deduced Type of the class member function.
+   * \param [in] objPtr Pointer to the object
+   * \param [in] memPtr Pointer to the member function
+   */
+  template <typename OBJ_PTR, typename MEM_PTR>
+  void DoSetMemPtr (OBJ_PTR const &objPtr, MEM_PTR memPtr, std::true_type)
+  {
+    m_inline = MemPtrCallbackInline<OBJ_PTR,MEM_PTR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9>::GetOps ();
+    m_object = const_cast<void *> (static_cast<const void *> (objPtr));
+    std::memcpy (m_memPtr, &memPtr, sizeof (MEM_PTR));
+  }
 };
 
 
@@ -27,6 +27,8 @@
 #include "log.h"
 
 #include <sstream>
+#include <map>
+#include <algorithm>
 
 /**
  * \file
@@ -182,6 +184,9 @@ MatchContainer::DisconnectWithoutContext (std::string name, const CallbackBase &
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, at construction, into a list
+ * of index ranges.
  */
 class ArrayMatcher
 {
@@ -199,8 +204,21 @@ public:
    * \returns \c true if the index matches the Config Path.
    */
   bool Matches (std::size_t i) const;
+  /**
+   * Test if the Config path specification matches a single index.
+   *
+   * \param [out] i The index matched.
+   * \returns \c true if the specification is a single index.
+   */
+  bool GetSingleIndex (std::size_t *i) const;
 
 private:
+  /**
+   * Parse a Config path specification, or one of its alternatives.
+   *
+   * \param [in] element The Config path specification.
+   */
+  void Parse (std::string element);
   /**
    * Convert a string to an \c uint32_t.
    *
@@ -209,80 +227,105 @@ private:
    * \returns \c true if the string could be converted.
    */
   bool StringToUint32 (std::string str, uint32_t *value) const;
+
+  /** An inclusive range of indices. */
+  struct Range
+  {
+    std::size_t min;  //!< First index of the range.
+    std::size_t max;  //!< Last index of the range.
+  };
   /** The Config path element. */
   std::string m_element;
+  /** Whether the element is a wildcard. */
+  bool m_all;
+  /** The ranges of indices matched by the element. */
+  std::vector<Range> m_ranges;
 
 };  // class ArrayMatcher
 
 
 ArrayMatcher::ArrayMatcher (std::string element)
-  : m_element (element)
+  : m_element (element),
+    m_all (false)
 {
   NS_LOG_FUNCTION (this << element);
+  Parse (element);
 }
-bool
-ArrayMatcher::Matches (std::size_t i) const
+void
+ArrayMatcher::Parse (std::string element)
 {
-  NS_LOG_FUNCTION (this << i);
-  if (m_element == "*")
+  NS_LOG_FUNCTION (this << element);
+  if (element == "*")
     {
-      NS_LOG_DEBUG ("Array " << i << " matches *");
-      return true;
+      m_all = true;
+      return;
     }
   std::string::size_type tmp;
-  tmp = m_element.find ("|");
+  tmp = element.find ("|");
   if (tmp != std::string::npos)
     {
-      std::string left = m_element.substr (0, tmp - 0);
-      std::string right = m_element.substr (tmp + 1, m_element.size () - (tmp + 1));
-      ArrayMatcher matcher = ArrayMatcher (left);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array " << i << " matches " << left);
-          return true;
-        }
-      matcher = ArrayMatcher (right);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array " << i << " matches " << right);
-          return true;
-        }
-      NS_LOG_DEBUG ("Array " << i << " does not match " << m_element);
-      return false;
+      std::string left = element.substr (0, tmp - 0);
+      std::string right = element.substr (tmp + 1, element.size () - (tmp + 1));
+      Parse (left);
+      Parse (right);
+      return;
     }
-  std::string::size_type leftBracket = m_element.find ("[");
-  std::string::size_type rightBracket = m_element.find ("]");
-  std::string::size_type dash = m_element.find ("-");
-  if (leftBracket == 0 && rightBracket == m_element.size () - 1
+  std::string::size_type leftBracket = element.find ("[");
+  std::string::size_type rightBracket = element.find ("]");
+  std::string::size_type dash = element.find ("-");
+  if (leftBracket == 0 && rightBracket == element.size () - 1
       && dash > leftBracket && dash < rightBracket)
     {
-      std::string lowerBound = m_element.substr (leftBracket + 1, dash - (leftBracket + 1));
-      std::string upperBound = m_element.substr (dash + 1, rightBracket - (dash + 1));
+      std::string lowerBound = element.substr (leftBracket + 1, dash - (leftBracket + 1));
+      std::string upperBound = element.substr (dash + 1, rightBracket - (dash + 1));
       uint32_t min;
       uint32_t max;
       if (StringToUint32 (lowerBound, &min)
-          && StringToUint32 (upperBound, &max)
-          && i >= min && i <= max)
+          && StringToUint32 (upperBound, &max))
         {
-          NS_LOG_DEBUG ("Array " << i << " matches " << m_element);
-          return true;
-        }
-      else
-        {
-          NS_LOG_DEBUG ("Array " << i << " does not " << m_element);
-          return false;
+          Range range = {min, max};
+          m_ranges.push_back (range);
         }
+      return;
     }
   uint32_t value;
-  if (StringToUint32 (m_element, &value)
-      && i == value)
+  if (StringToUint32 (element, &value))
     {
-      NS_LOG_DEBUG ("Array " << i << " matches " << m_element);
+      Range range = {value, value};
+      m_ranges.push_back (range);
+    }
+}
+bool
+ArrayMatcher::Matches (std::size_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  if (m_all)
+    {
+      NS_LOG_DEBUG ("Array " << i << " matches *");
       return true;
     }
+  for (std::vector<Range>::const_iterator j = m_ranges.begin (); j != m_ranges.end (); ++j)
+    {
+      if (i >= j->min && i <= j->max)
+        {
+          NS_LOG_DEBUG ("Array " << i << " matches " << m_element);
+          return true;
+        }
+    }
   NS_LOG_DEBUG ("Array " << i << " does not match " << m_element);
   return false;
 }
+bool
+ArrayMatcher::GetSingleIndex (std::size_t *i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  if (m_all || m_ranges.size () != 1 || m_ranges[0].min != m_ranges[0].max)
+    {
+      return false;
+    }
+  *i = m_ranges[0].min;
+  return true;
+}
 
 bool
 ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
@@ -294,6 +337,176 @@ ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
   return !iss.bad () && !iss.fail ();
 }
 
+/**
+ * \ingroup config-impl
+ * A Config path, split once into its tokens.
+ */
+class CompiledPath
+{
+public:
+  /**
+   * Construct from a Config path.
+   *
+   * \param [in] path The Config path.
+   */
+  CompiledPath (std::string path);
+  /**
+   * Get the number of tokens.
+   *
+   * \returns The number of tokens in the Config path.
+   */
+  std::size_t GetN (void) const;
+  /**
+   * Get a token.
+   *
+   * \param [in] i The index of the token.
+   * \returns The token.
+   */
+  const std::string & Get (std::size_t i) const;
+  /**
+   * Get the index specification of a token.
+   *
+   * \param [in] i The index of the token.
+   * \returns The ArrayMatcher of the token.
+   */
+  const ArrayMatcher & GetMatcher (std::size_t i) const;
+  /**
+   * Get the TypeId of a \c $ns3::Type token.
+   *
+   * \param [in] i The index of the token.
+   * \returns The TypeId named by the token.
+   */
+  TypeId GetTypeId (std::size_t i) const;
+
+private:
+  /** The tokens. */
+  std::vector<std::string> m_tokens;
+  /** The ArrayMatcher of each token. */
+  std::vector<ArrayMatcher> m_matchers;
+  /** The TypeId of each \c $ns3::Type token, looked up on first use. */
+  mutable std::vector<TypeId> m_tids;
+
+};  // class CompiledPath
+
+CompiledPath::CompiledPath (std::string path)
+{
+  NS_LOG_FUNCTION (this << path);
+  NS_ASSERT ((path.find ("/")) == 0);
+  std::string::size_type start = 1;
+  std::string::size_type next = path.find ("/", start);
+  while (next != std::string::npos)
+    {
+      m_tokens.push_back (path.substr (start, next - start));
+      m_matchers.push_back (ArrayMatcher (m_tokens.back ()));
+      start = next + 1;
+      next = path.find ("/", start);
+    }
+  m_tids.resize (m_tokens.size ());
+}
+std::size_t
+CompiledPath::GetN (void) const
+{
+  return m_tokens.size ();
+}
+const std::string &
+CompiledPath::Get (std::size_t i) const
+{
+  return m_tokens[i];
+}
+const ArrayMatcher &
+CompiledPath::GetMatcher (std::size_t i) const
+{
+  return m_matchers[i];
+}
+TypeId
+CompiledPath::GetTypeId (std::size_t i) const
+{
+  NS_ASSERT (m_tokens[i].find ("$") == 0);
+  if (m_tids[i].GetUid () == 0)
+    {
+      m_tids[i] = TypeId::LookupByName (m_tokens[i].substr (1, m_tokens[i].size () - 1));
+    }
+  return m_tids[i];
+}
+
+/**
+ * \ingroup config-impl
+ * An attribute which can be followed on a Config path: a pointer
+ * to an object, or a container of objects.
+ */
+struct PathAttribute
+{
+  /** The attribute name. */
+  std::string name;
+  /** The attribute accessor. */
+  Ptr<const AttributeAccessor> accessor;
+  /** The attribute accessor, if the attribute is a container. */
+  Ptr<const ObjectPtrContainerAccessor> container;
+  /** Whether the attribute is a container. */
+  bool isContainer;
+};
+
+/**
+ * \ingroup config-impl
+ * Get the attributes of a TypeId, and of its parents, which match
+ * a Config path token and can be followed to other objects.
+ *
+ * The result is computed once for each TypeId and token.
+ *
+ * \param [in] tid The TypeId.
+ * \param [in] item The Config path token, or \c "*".
+ * \returns The matching attributes.
+ */
+static const std::vector<PathAttribute> &
+GetPathAttributes (TypeId tid, const std::string &item)
+{
+  NS_LOG_FUNCTION (tid << item);
+  typedef std::map<std::pair<uint16_t, std::string>, std::vector<PathAttribute> > PathAttributeIndex;
+  static PathAttributeIndex index;
+
+  std::pair<uint16_t, std::string> key (tid.GetUid (), item);
+  PathAttributeIndex::iterator found = index.find (key);
+  if (found != index.end ())
+    {
+      return found->second;
+    }
+
+  std::vector<PathAttribute> &attributes = index[key];
+  TypeId nextTid = tid;
+  do
+    {
+      tid = nextTid;
+      for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
+        {
+          struct TypeId::AttributeInformation info;
+          info = tid.GetAttribute (i);
+          if (info.name != item && item != "*")
+            {
+              continue;
+            }
+          PathAttribute attribute;
+          attribute.name = info.name;
+          attribute.accessor = info.accessor;
+          if (dynamic_cast<const PointerChecker *> (PeekPointer (info.checker)) != 0)
+            {
+              attribute.isContainer = false;
+              attributes.push_back (attribute);
+            }
+          else if (dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker)) != 0)
+            {
+              attribute.isContainer = true;
+              attribute.container = DynamicCast<const ObjectPtrContainerAccessor> (info.accessor);
+              attributes.push_back (attribute);
+            }
+          // this could be anything else and we don't know what to do with it.
+          // So, we just ignore it.
+        }
+      nextTid = tid.GetParent ();
+    }
+  while (nextTid != tid);
+  return attributes;
+}
+
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
@@ -320,23 +533,37 @@ public:
   void Resolve (Ptr<Object> root);
 
 private:
-  /** Ensure the Config path starts and ends with a '/'. */
-  void Canonicalize (void);
+  /**
+   * Ensure the Config path starts and ends with a '/'.
+   *
+   * \param [in] path The Config path.
+   * \returns The canonical Config path.
+   */
+  static std::string Canonicalize (std::string path);
   /**
    * Parse the next element in the Config path.
    *
-   * \param [in] path The remaining portion of the Config path.
+   * \param [in] token The index of the next token of the Config path.
    * \param [in] root The object corresponding to the current position
    *                  in the Config path.
    */
-  void DoResolve (std::string path, Ptr<Object> root);
+  void DoResolve (std::size_t token, Ptr<Object> root);
   /**
    * Parse an index on the Config path.
    *
-   * \param [in] path The remaining Config path.
-   * \param [in,out] vector The resulting list of matching objects.
+   * \param [in] token The index of the next token of the Config path.
+   * \param [in] root The object holding the container.
+   * \param [in] attribute The container attribute.
    */
-  void DoArrayResolve (std::string path, const ObjectPtrContainerValue &vector);
+  void DoArrayResolve (std::size_t token, Ptr<Object> root, const PathAttribute &attribute);
+  /**
+   * Resolve the rest of the Config path from one container item.
+   *
+   * \param [in] token The index of the next token of the Config path.
+   * \param [in] index The index of the item in the container.
+   * \param [in] object The item.
+   */
+  void DoArrayResolveOne (std::size_t token, std::size_t index, Ptr<Object> object);
   /**
    * Handle one object found on the path.
    *
@@ -361,37 +588,40 @@ private:
   std::vector<std::string> m_workStack;
   /** The Config path. */
   std::string m_path;
+  /** The tokens of the Config path. */
+  CompiledPath m_tokens;
 
 };  // class Resolver
 
 Resolver::Resolver (std::string path)
-  : m_path (path)
+  : m_path (Canonicalize (path)),
+    m_tokens (m_path)
 {
   NS_LOG_FUNCTION (this << path);
-  Canonicalize ();
 }
 Resolver::~Resolver ()
 {
   NS_LOG_FUNCTION (this);
 }
-void
-Resolver::Canonicalize (void)
+std::string
+Resolver::Canonicalize (std::string path)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (path);
 
   // ensure that we start and end with a '/'
-  std::string::size_type tmp = m_path.find ("/");
+  std::string::size_type tmp = path.find ("/");
   if (tmp != 0)
     {
       // no slash at start
-      m_path = "/" + m_path;
+      path = "/" + path;
     }
-  tmp = m_path.find_last_of ("/");
-  if (tmp != (m_path.size () - 1))
+  tmp = path.find_last_of ("/");
+  if (tmp != (path.size () - 1))
     {
       // no slash at end
-      m_path = m_path + "/";
+      path = path + "/";
     }
+  return path;
 }
 
 void
@@ -399,7 +629,7 @@ Resolver::Resolve (Ptr<Object> root)
 {
   NS_LOG_FUNCTION (this << root);
 
-  DoResolve (m_path, root);
+  DoResolve (0, root);
 }
 
 std::string
@@ -425,13 +655,11 @@ Resolver::DoResolveOne (Ptr<Object> object)
 }
 
 void
-Resolver::DoResolve (std::string path, Ptr<Object> root)
+Resolver::DoResolve (std::size_t token, Ptr<Object> root)
 {
-  NS_LOG_FUNCTION (this << path << root);
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
+  NS_LOG_FUNCTION (this << token << root);
 
-  if (next == std::string::npos)
+  if (token == m_tokens.GetN ())
     {
       //
       // If root is zero, we're beginning to see if we can use the object name
@@ -447,8 +675,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
         }
       return;
     }
-  std::string item = path.substr (1, next - 1);
-  std::string pathLeft = path.substr (next, path.size () - next);
+  const std::string &item = m_tokens.Get (token);
 
   //
   // If root is zero, we're beginning to see if we can use the object name
@@ -459,11 +686,10 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   //
   if (root == 0)
     {
-      std::string::size_type offset = path.find ("/Names");
-      if (offset == 0)
+      if (item.compare (0, 5, "Names") == 0)
         {
           m_workStack.push_back (item);
-          DoResolve (pathLeft, root);
+          DoResolve (token + 1, root);
           m_workStack.pop_back ();
           return;
         }
@@ -480,7 +706,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       NS_LOG_DEBUG ("Name system resolved item = " << item << " to " << namedObject);
       m_workStack.push_back (item);
-      DoResolve (pathLeft, namedObject);
+      DoResolve (token + 1, namedObject);
       m_workStack.pop_back ();
       return;
     }
@@ -500,80 +726,52 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   if (dollarPos == 0)
     {
       // This is a call to GetObject
-      std::string tidString = item.substr (1, item.size () - 1);
-      NS_LOG_DEBUG ("GetObject=" << tidString << " on path=" << GetResolvedPath ());
-      TypeId tid = TypeId::LookupByName (tidString);
+      NS_LOG_DEBUG ("GetObject=" << item << " on path=" << GetResolvedPath ());
+      TypeId tid = m_tokens.GetTypeId (token);
       Ptr<Object> object = root->GetObject<Object> (tid);
       if (object == 0)
         {
-          NS_LOG_DEBUG ("GetObject (" << tidString << ") failed on path=" << GetResolvedPath ());
+          NS_LOG_DEBUG ("GetObject (" << item << ") failed on path=" << GetResolvedPath ());
           return;
         }
       m_workStack.push_back (item);
-      DoResolve (pathLeft, object);
+      DoResolve (token + 1, object);
       m_workStack.pop_back ();
     }
   else
     {
       // this is a normal attribute.
-      TypeId tid;
-      TypeId nextTid = root->GetInstanceTypeId ();
-      bool foundMatch = false;
-
-      do
+      const std::vector<PathAttribute> &attributes =
+        GetPathAttributes (root->GetInstanceTypeId (), item);
+      for (std::vector<PathAttribute>::const_iterator i = attributes.begin (); i != attributes.end (); ++i)
         {
-          tid = nextTid;
-
-          for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
+          if (!i->isContainer)
             {
-              struct TypeId::AttributeInformation info;
-              info = tid.GetAttribute (i);
-              if (info.name != item && item != "*")
+              NS_LOG_DEBUG ("GetAttribute(ptr)=" << i->name << " on path=" << GetResolvedPath ());
+              PointerValue pValue;
+              i->accessor->Get (PeekPointer (root), pValue);
+              Ptr<Object> object = pValue.Get<Object> ();
+              if (object == 0)
                 {
+                  NS_LOG_ERROR ("Requested object name=\"" << item <<
+                                "\" exists on path=\"" << GetResolvedPath () << "\""
+                                " but is null.");
                   continue;
                 }
-              // attempt to cast to a pointer checker.
-              const PointerChecker *pChecker = dynamic_cast<const PointerChecker *> (PeekPointer (info.checker));
-              if (pChecker != 0)
-                {
-                  NS_LOG_DEBUG ("GetAttribute(ptr)=" << info.name << " on path=" << GetResolvedPath ());
-                  PointerValue pValue;
-                  root->GetAttribute (info.name, pValue);
-                  Ptr<Object> object = pValue.Get<Object> ();
-                  if (object == 0)
-                    {
-                      NS_LOG_ERROR ("Requested object name=\"" << item <<
-                                    "\" exists on path=\"" << GetResolvedPath () << "\""
-                                    " but is null.");
-                      continue;
-                    }
-                  foundMatch = true;
-                  m_workStack.push_back (info.name);
-                  DoResolve (pathLeft, object);
-                  m_workStack.pop_back ();
-                }
-              // attempt to cast to an object vector.
-              const ObjectPtrContainerChecker *vectorChecker =
-                dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker));
-              if (vectorChecker != 0)
-                {
-                  NS_LOG_DEBUG ("GetAttribute(vector)=" << info.name << " on path=" << GetResolvedPath () << pathLeft);
-                  foundMatch = true;
-                  ObjectPtrContainerValue vector;
-                  root->GetAttribute (info.name, vector);
-                  m_workStack.push_back (info.name);
-                  DoArrayResolve (pathLeft, vector);
-                  m_workStack.pop_back ();
-                }
-              // this could be anything else and we don't know what to do with it.
-              // So, we just ignore it.
+              m_workStack.push_back (i->name);
+              DoResolve (token + 1, object);
+              m_workStack.pop_back ();
+            }
+          else
+            {
+              NS_LOG_DEBUG ("GetAttribute(vector)=" << i->name << " on path=" << GetResolvedPath ());
+              m_workStack.push_back (i->name);
+              DoArrayResolve (token + 1, root, *i);
+              m_workStack.pop_back ();
             }
-
-          nextTid = tid.GetParent ();
         }
-      while (nextTid != tid);
 
-      if (!foundMatch)
+      if (attributes.empty ())
         {
           NS_LOG_DEBUG ("Requested item=" << item << " does not exist on path=" << GetResolvedPath ());
           return;
@@ -582,32 +780,80 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
 }
 
 void
-Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &container)
+Resolver::DoArrayResolve (std::size_t token, Ptr<Object> root, const PathAttribute &attribute)
 {
-  NS_LOG_FUNCTION (this << path << &container);
-  NS_ASSERT (path != "");
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-  if (next == std::string::npos)
+  NS_LOG_FUNCTION (this << token << root << attribute.name);
+  if (token == m_tokens.GetN ())
     {
       return;
     }
-  std::string item = path.substr (1, next - 1);
-  std::string pathLeft = path.substr (next, path.size () - next);
+  const ArrayMatcher &matcher = m_tokens.GetMatcher (token);
 
-  ArrayMatcher matcher = ArrayMatcher (item);
-  ObjectPtrContainerValue::Iterator it;
-  for (it = container.Begin (); it != container.End (); ++it)
+  if (attribute.container == 0)
     {
-      if (matcher.Matches ((*it).first))
+      // unknown container accessor: get the whole container
+      ObjectPtrContainerValue container;
+      root->GetAttribute (attribute.name, container);
+      ObjectPtrContainerValue::Iterator it;
+      for (it = container.Begin (); it != container.End (); ++it)
         {
-          std::ostringstream oss;
-          oss << (*it).first;
-          m_workStack.push_back (oss.str ());
-          DoResolve (pathLeft, (*it).second);
-          m_workStack.pop_back ();
+          if (matcher.Matches ((*it).first))
+            {
+              DoArrayResolveOne (token, (*it).first, (*it).second);
+            }
+        }
+      return;
+    }
+
+  std::size_t n;
+  if (!attribute.container->GetN (PeekPointer (root), &n))
+    {
+      return;
+    }
+  std::size_t single;
+  if (matcher.GetSingleIndex (&single) && single < n)
+    {
+      // Containers are usually indexed by position: try it first.
+      std::size_t index;
+      Ptr<Object> object = attribute.container->Get (PeekPointer (root), single, &index);
+      if (index == single)
+        {
+          DoArrayResolveOne (token, index, object);
+          return;
         }
     }
+
+  std::vector<std::pair<std::size_t, Ptr<Object> > > matches;
+  bool sorted = true;
+  for (std::size_t i = 0; i < n; i++)
+    {
+      std::size_t index;
+      Ptr<Object> object = attribute.container->Get (PeekPointer (root), i, &index);
+      if (matcher.Matches (index))
+        {
+          sorted = sorted && (matches.empty () || matches.back ().first < index);
+          matches.push_back (std::make_pair (index, object));
+        }
+    }
+  if (!sorted)
+    {
+      std::sort (matches.begin (), matches.end ());
+    }
+  for (std::size_t i = 0; i < matches.size (); i++)
+    {
+      DoArrayResolveOne (token, matches[i].first, matches[i].second);
+    }
+}
+
+void
+Resolver::DoArrayResolveOne (std::size_t token, std::size_t index, Ptr<Object> object)
+{
+  NS_LOG_FUNCTION (this << token << index << object);
+  std::ostringstream oss;
+  oss << index;
+  m_workStack.push_back (oss.str ());
+  DoResolve (token + 1, object);
+  m_workStack.pop_back ();
 }
 
 /**
@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
 #include "simple-ref-count.h"
 
 /**
@@ -40,6 +41,8 @@ namespace ns3 {
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * All subclasses are allocated from the EventPool.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -66,6 +69,19 @@ public:
    */
   bool IsCancelled (void);
 
+  /**
+   * Allocate an event from the EventPool.
+   * \param [in] size The size of the event.
+   * \returns The memory for the event.
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * Release an event to the EventPool.
+   * \param [in] p The event memory.
+   * \param [in] size The size of the event.
+   */
+  static void operator delete (void *p, std::size_t size);
+
 protected:
   /**
    * Implementation for Invoke().
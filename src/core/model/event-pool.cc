@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "event-pool.h"
+#include <atomic>
+#include <new>
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventPool implementation.
+ */
+
+namespace ns3 {
+
+namespace {
+
+/** Size class granularity, in bytes. */
+const std::size_t GRANULARITY = 16;
+/** Number of size classes. */
+const std::size_t N_CLASSES = 16;
+/** Size of a slab, in bytes. */
+const std::size_t SLAB_SIZE = 64 * 1024;
+
+/** A released block, linked in the free list of its size class. */
+struct Block
+{
+  Block *next;  //!< The next released block.
+};
+
+/** The header of a slab. */
+struct Slab
+{
+  Slab *next;   //!< The previously allocated slab.
+  char pad[GRANULARITY - sizeof (Slab *)];  //!< Keep the blocks aligned.
+};
+
+/**
+ * All the slabs, so that they stay reachable even when the thread
+ * which allocated them is gone.
+ */
+std::atomic<Slab *> g_slabs (0);
+
+/**
+ * The pool of a thread.  It is zero-initialized, so that it needs no
+ * guard on access.
+ */
+struct Pool
+{
+  Block *free[N_CLASSES];  //!< The free lists.
+  char *next;              //!< The next free byte of the current slab.
+  char *end;               //!< The end of the current slab.
+  uint64_t hits;           //!< Allocations served by a released block.
+  uint64_t misses;         //!< Allocations served by fresh memory.
+};
+
+/** The pool of the calling thread. */
+thread_local Pool g_pool;
+
+} // unnamed namespace
+
+void *
+EventPool::Allocate (std::size_t size)
+{
+  Pool &pool = g_pool;
+  std::size_t index = (size + GRANULARITY - 1) / GRANULARITY - 1;
+  if (index >= N_CLASSES)
+    {
+      pool.misses++;
+      return ::operator new (size);
+    }
+  Block *block = pool.free[index];
+  if (block != 0)
+    {
+      pool.free[index] = block->next;
+      pool.hits++;
+      return block;
+    }
+  pool.misses++;
+  std::size_t bytes = (index + 1) * GRANULARITY;
+  if (pool.next == 0 || static_cast<std::size_t> (pool.end - pool.next) < bytes)
+    {
+      Slab *slab = static_cast<Slab *> (::operator new (SLAB_SIZE));
+      slab->next = g_slabs.load (std::memory_order_relaxed);
+      while (!g_slabs.compare_exchange_weak (slab->next, slab))
+        {
+        }
+      pool.next = reinterpret_cast<char *> (slab + 1);
+      pool.end = reinterpret_cast<char *> (slab) + SLAB_SIZE;
+    }
+  void *p = pool.next;
+  pool.next += bytes;
+  return p;
+}
+
+void
+EventPool::Deallocate (void *p, std::size_t size)
+{
+  if (p == 0)
+    {
+      return;
+    }
+  std::size_t index = (size + GRANULARITY - 1) / GRANULARITY - 1;
+  if (index >= N_CLASSES)
+    {
+      ::operator delete (p);
+      return;
+    }
+  Pool &pool = g_pool;
+  Block *block = static_cast<Block *> (p);
+  block->next = pool.free[index];
+  pool.free[index] = block;
+}
+
+uint64_t
+EventPool::GetHits (void)
+{
+  return g_pool.hits;
+}
+
+uint64_t
+EventPool::GetMisses (void)
+{
+  return g_pool.misses;
+}
+
+} // namespace ns3
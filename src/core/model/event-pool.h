@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef EVENT_POOL_H
+#define EVENT_POOL_H
+
+#include <cstddef>
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventPool declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup events
+ * \brief A size-class slab allocator for simulation events.
+ *
+ * EventImpl allocates all its subclasses, in particular the ones made
+ * by MakeEvent for each Simulator::Schedule call, through this pool.
+ * Sizes are rounded up to a multiple of 16 bytes; each of the size
+ * classes up to 256 bytes has a free list of released blocks, and new
+ * blocks are carved from 64 KiB slabs.  Larger objects go to the global
+ * operator new.
+ *
+ * The free lists and counters are per thread, so the thread running a
+ * simulator recycles its events without locking.  A block may be
+ * released by another thread than the one which allocated it; it then
+ * joins the free lists of the releasing thread.  Slabs are never given
+ * back, so the pool footprint is the peak event memory.
+ */
+class EventPool
+{
+public:
+  /**
+   * Allocate a block.
+   *
+   * \param [in] size The size of the block, in bytes.
+   * \returns The block.
+   */
+  static void * Allocate (std::size_t size);
+  /**
+   * Release a block.
+   *
+   * \param [in] p The block.
+   * \param [in] size The size the block was allocated with.
+   */
+  static void Deallocate (void *p, std::size_t size);
+  /**
+   * \returns The number of allocations of the calling thread served by
+   *          a released block.
+   */
+  static uint64_t GetHits (void);
+  /**
+   * \returns The number of allocations of the calling thread served by
+   *          fresh memory.
+   */
+  static uint64_t GetMisses (void);
+};
+
+} // namespace ns3
+
+#endif /* EVENT_POOL_H */
@@ -237,6 +237,14 @@ HeapScheduler::Remove (const Event &ev)
           Exch (i, Last ());
           m_heap.pop_back ();
           TopDown (i);
+          // The last event may also be earlier than the parent of the
+          // removed one.
+          while (i < m_heap.size () && !IsRoot (i)
+                 && IsLessStrictly (i, Parent (i)))
+            {
+              Exch (i, Parent (i));
+              i = Parent (i);
+            }
           return;
         }
     }
@@ -0,0 +1,315 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include "type-id.h"
+#include "assert.h"
+#include "log.h"
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+namespace {
+
+/** Number of events of a bucket above which it is split in a new rung. */
+const uint32_t THRESHOLD = 50;
+/** Maximum number of rungs. */
+const uint32_t MAX_RUNGS = 8;
+
+/**
+ * Order events by decreasing key.
+ * \param [in] a The first event.
+ * \param [in] b The second event.
+ * \returns \c true if \p a is later than \p b.
+ */
+bool
+IsLater (const Scheduler::Event &a, const Scheduler::Event &b)
+{
+  return b.key < a.key;
+}
+
+} // unnamed namespace
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<LadderScheduler> ()
+  ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_topStart (0),
+    m_topMin (std::numeric_limits<uint64_t>::max ()),
+    m_topMax (0),
+    m_bottomLimit (THRESHOLD),
+    m_qSize (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LadderScheduler::~LadderScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint32_t
+LadderScheduler::FindRung (uint64_t ts) const
+{
+  uint32_t r = 0;
+  for (; r < m_rungs.size (); r++)
+    {
+      const Rung &rung = m_rungs[r];
+      if (ts >= rung.start + rung.current * rung.width)
+        {
+          break;
+        }
+    }
+  return r;
+}
+
+LadderScheduler::Bucket &
+LadderScheduler::GetBucket (Rung &rung, uint64_t ts)
+{
+  uint64_t index = (ts - rung.start) / rung.width;
+  NS_ASSERT (index >= rung.current && index < rung.buckets.size ());
+  return rung.buckets[index];
+}
+
+void
+LadderScheduler::InsertBottom (const Scheduler::Event &ev)
+{
+  m_bottom.insert (std::upper_bound (m_bottom.begin (), m_bottom.end (), ev, IsLater), ev);
+}
+
+void
+LadderScheduler::Insert (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.key.m_ts << ev.key.m_uid);
+  m_qSize++;
+  uint64_t ts = ev.key.m_ts;
+  if (ts >= m_topStart)
+    {
+      m_top.push_back (ev);
+      m_topMin = std::min (m_topMin, ts);
+      m_topMax = std::max (m_topMax, ts);
+    }
+  else
+    {
+      uint32_t r = FindRung (ts);
+      if (r < m_rungs.size ())
+        {
+          NS_LOG_LOGIC ("insert in rung=" << r);
+          GetBucket (m_rungs[r], ts).push_back (ev);
+          m_rungs[r].count++;
+        }
+      else
+        {
+          InsertBottom (ev);
+          // A bottom grown by a burst of near events is spread onto a
+          // new rung, unless they all share the same time stamp.
+          if (m_bottom.size () > m_bottomLimit && m_rungs.size () < MAX_RUNGS
+              && m_bottom.front ().key.m_ts != m_bottom.back ().key.m_ts)
+            {
+              uint64_t start = m_bottom.back ().key.m_ts;
+              uint64_t end = m_topStart;
+              if (!m_rungs.empty ())
+                {
+                  const Rung &last = m_rungs.back ();
+                  end = last.start + last.current * last.width;
+                }
+              Bucket events;
+              events.swap (m_bottom);
+              SpawnRung (events, start, end);
+            }
+        }
+    }
+  Refill ();
+}
+
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  return m_qSize == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  return m_bottom.back ();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  Scheduler::Event ev = m_bottom.back ();
+  m_bottom.pop_back ();
+  m_qSize--;
+  Refill ();
+  return ev;
+}
+
+void
+LadderScheduler::Remove (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (!IsEmpty ());
+  uint64_t ts = ev.key.m_ts;
+  Bucket *bucket = &m_bottom;
+  if (ts >= m_topStart)
+    {
+      bucket = &m_top;
+    }
+  else
+    {
+      uint32_t r = FindRung (ts);
+      if (r < m_rungs.size ())
+        {
+          bucket = &GetBucket (m_rungs[r], ts);
+          m_rungs[r].count--;
+        }
+    }
+  if (bucket == &m_bottom)
+    {
+      Bucket::iterator i = std::lower_bound (m_bottom.begin (), m_bottom.end (), ev, IsLater);
+      NS_ASSERT (i != m_bottom.end () && i->key == ev.key);
+      m_bottom.erase (i);
+    }
+  else
+    {
+      Bucket::iterator i = bucket->begin ();
+      while (i->key != ev.key)
+        {
+          ++i;
+          NS_ASSERT (i != bucket->end ());
+        }
+      *i = bucket->back ();
+      bucket->pop_back ();
+    }
+  m_qSize--;
+  Refill ();
+}
+
+void
+LadderScheduler::SpawnRung (Bucket &events, uint64_t start, uint64_t end)
+{
+  NS_LOG_FUNCTION (this << events.size () << start << end);
+  NS_ASSERT (start < end);
+  uint64_t span = end - start;
+  uint64_t n = events.size ();
+  uint64_t width = span / n + (span % n != 0 ? 1 : 0);
+  uint64_t nBuckets = span / width + (span % width != 0 ? 1 : 0);
+
+  m_rungs.push_back (Rung ());
+  Rung &rung = m_rungs.back ();
+  rung.start = start;
+  rung.width = width;
+  rung.current = 0;
+  rung.count = n;
+  rung.buckets.resize (nBuckets);
+  for (Bucket::const_iterator i = events.begin (); i != events.end (); ++i)
+    {
+      GetBucket (rung, i->key.m_ts).push_back (*i);
+    }
+  events.clear ();
+  NS_LOG_LOGIC ("rung=" << m_rungs.size () - 1 << " buckets=" << nBuckets << " width=" << width);
+}
+
+void
+LadderScheduler::FillBottom (Bucket &events)
+{
+  NS_LOG_FUNCTION (this << events.size ());
+  NS_ASSERT (m_bottom.empty ());
+  std::sort (events.begin (), events.end (), IsLater);
+  m_bottom.swap (events);
+  // Do not spread again a bottom that could not be split before it
+  // has doubled.
+  m_bottomLimit = std::max<uint32_t> (THRESHOLD, 2 * m_bottom.size ());
+}
+
+void
+LadderScheduler::Refill (void)
+{
+  while (m_bottom.empty () && m_qSize > 0)
+    {
+      Bucket events;
+      if (m_rungs.empty ())
+        {
+          // Start a new epoch: spread the top onto the first rung.
+          NS_ASSERT (!m_top.empty ());
+          uint64_t start = m_topMin;
+          uint64_t end = m_topMax + 1;
+          m_topStart = end;
+          m_topMin = std::numeric_limits<uint64_t>::max ();
+          m_topMax = 0;
+          events.swap (m_top);
+          if (events.size () <= THRESHOLD || end - start == 1)
+            {
+              FillBottom (events);
+            }
+          else
+            {
+              SpawnRung (events, start, end);
+            }
+          continue;
+        }
+      Rung &rung = m_rungs.back ();
+      if (rung.count == 0)
+        {
+          m_rungs.pop_back ();
+          continue;
+        }
+      while (rung.buckets[rung.current].empty ())
+        {
+          rung.current++;
+        }
+      uint64_t start = rung.start + rung.current * rung.width;
+      uint64_t width = rung.width;
+      events.swap (rung.buckets[rung.current]);
+      rung.current++;
+      rung.count -= events.size ();
+      if (events.size () > THRESHOLD && width > 1 && m_rungs.size () < MAX_RUNGS)
+        {
+          SpawnRung (events, start, start + width);
+        }
+      else
+        {
+          FillBottom (events);
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class declaration.
+ */
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue described in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and
+ * Ian Li-Jin Thng][Tang].
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * Events are kept in three tiers:
+ *
+ * - Top: an unsorted vector holding the events at or after
+ *   `m_topStart`, the far future.
+ * - Ladder: a stack of rungs.  Each rung is an array of unsorted
+ *   buckets of uniform width, covering the time span of a single
+ *   bucket of the rung above it.
+ * - Bottom: a small sorted vector holding the earliest events.
+ *
+ * When the bottom runs empty the next non-empty bucket of the lowest rung
+ * is sorted into it.  A bucket holding more than a threshold of events is
+ * split into a new, finer rung instead, so the bucket width adapts to the
+ * local event density: a skewed distribution, like dense packet events
+ * with a few far away timers, only creates rungs where events cluster.
+ * When the ladder is empty the top is spread onto a new first rung.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Append to top or bucket; bounded bottom insertion
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Last element of the bottom
+ * Remove()     | Linear          | Search within top, bucket or bottom
+ * RemoveNext() | ~Constant       | Each event is moved down a bounded number of rungs
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | `std::vector` per tier and bucket | Rung buckets
+ * Per Event | `sizeof (Event)`                  | `std::vector`
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  LadderScheduler ();
+  /** Destructor. */
+  virtual ~LadderScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** Bucket type: an unsorted vector of Events. */
+  typedef std::vector<Scheduler::Event> Bucket;
+
+  /** A rung of the ladder: buckets of uniform width. */
+  struct Rung
+  {
+    uint64_t start;               //!< Time stamp of the start of the first bucket.
+    uint64_t width;               //!< Width of a bucket, in dimensionless time units.
+    uint32_t current;             //!< Index of the first bucket not yet dequeued.
+    uint32_t count;               //!< Number of events in the buckets.
+    std::vector<Bucket> buckets;  //!< The buckets.
+  };
+
+  /**
+   * Find the rung whose undequeued buckets cover a time stamp.
+   *
+   * \param [in] ts The dimensionless time stamp, before \c m_topStart.
+   * \returns The rung index, or the number of rungs if \p ts belongs
+   *          to the bottom.
+   */
+  uint32_t FindRung (uint64_t ts) const;
+  /**
+   * Get the bucket of a rung covering a time stamp.
+   *
+   * \param [in] rung The rung.
+   * \param [in] ts The dimensionless time stamp.
+   * \returns The bucket.
+   */
+  static Bucket & GetBucket (Rung &rung, uint64_t ts);
+  /**
+   * Insert an event in the sorted bottom.
+   *
+   * \param [in] ev The event.
+   */
+  void InsertBottom (const Scheduler::Event &ev);
+  /**
+   * Spread events onto a new lowest rung.
+   *
+   * \param [in,out] events The events, all in [start, end); emptied.
+   * \param [in] start The start of the new rung.
+   * \param [in] end The end of the new rung.
+   */
+  void SpawnRung (Bucket &events, uint64_t start, uint64_t end);
+  /**
+   * Sort events into the empty bottom.
+   *
+   * \param [in,out] events The events; emptied.
+   */
+  void FillBottom (Bucket &events);
+  /** Move the next events down to the bottom, if it is empty. */
+  void Refill (void);
+
+  /** Events at or after \c m_topStart, unsorted. */
+  Bucket m_top;
+  /** Start of the top time span. */
+  uint64_t m_topStart;
+  /** Smallest time stamp in the top. */
+  uint64_t m_topMin;
+  /** Largest time stamp in the top. */
+  uint64_t m_topMax;
+  /** The rungs, from the coarsest to the finest. */
+  std::vector<Rung> m_rungs;
+  /** The earliest events, sorted in decreasing order. */
+  Bucket m_bottom;
+  /** Size of the bottom above which it is spread onto a new rung. */
+  uint32_t m_bottomLimit;
+  /** Number of events in queue. */
+  uint32_t m_qSize;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
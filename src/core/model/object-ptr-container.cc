@@ -128,6 +128,18 @@ ObjectPtrContainerAccessor::Get (const ObjectBase * object, AttributeValue &valu
   return true;
 }
 bool
+ObjectPtrContainerAccessor::GetN (const ObjectBase *object, std::size_t *n) const
+{
+  NS_LOG_FUNCTION (this << object);
+  return DoGetN (object, n);
+}
+Ptr<Object>
+ObjectPtrContainerAccessor::Get (const ObjectBase *object, std::size_t i, std::size_t *index) const
+{
+  NS_LOG_FUNCTION (this << object << i);
+  return DoGet (object, i, index);
+}
+bool
 ObjectPtrContainerAccessor::HasGetter (void) const
 {
   NS_LOG_FUNCTION (this);
@@ -229,6 +229,26 @@ public:
   virtual bool HasGetter (void) const;
   virtual bool HasSetter (void) const;
 
+  /**
+   * Get the number of instances in the container, without
+   * building an ObjectPtrContainerValue.
+   *
+   * \param [in] object The container object.
+   * \param [out] n The number of instances in the container.
+   * \returns true if the value could be obtained successfully.
+   */
+  bool GetN (const ObjectBase *object, std::size_t *n) const;
+  /**
+   * Get the i-th instance of the container, without
+   * building an ObjectPtrContainerValue.
+   *
+   * \param [in] object The container object.
+   * \param [in] i The position of the instance, less than GetN().
+   * \param [out] index The index of the instance in the container.
+   * \returns The instance.
+   */
+  Ptr<Object> Get (const ObjectBase *object, std::size_t i, std::size_t *index) const;
+
 private:
   /**
    * Get the number of instances in the container.
@@ -595,6 +595,80 @@ NullifyCallbackTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (target1.IsNull (), true, "Nullified Callback reports not IsNull()");
 }
 
+// ===========================================================================
+// Test equality and assignment of member function Callbacks, which are
+// stored inline when the object is held by a raw pointer.
+// ===========================================================================
+class EqualCallbackTestCase : public TestCase
+{
+public:
+  EqualCallbackTestCase ();
+  virtual ~EqualCallbackTestCase ()
+  {}
+
+  int Target1 (int a)
+  {
+    return a + 1;
+  }
+  int Target2 (int a)
+  {
+    return a + 2;
+  }
+  virtual int Target3 (int a)
+  {
+    return a + 3;
+  }
+
+private:
+  virtual void DoRun (void);
+};
+
+EqualCallbackTestCase::EqualCallbackTestCase ()
+  : TestCase ("Check IsEqual() and Assign() of member function Callbacks")
+{}
+
+void
+EqualCallbackTestCase::DoRun (void)
+{
+  EqualCallbackTestCase other;
+  Callback<int, int> target1 = MakeCallback (&EqualCallbackTestCase::Target1, this);
+  Callback<int, int> target2 = MakeCallback (&EqualCallbackTestCase::Target2, this);
+  Callback<int, int> target3 = MakeCallback (&EqualCallbackTestCase::Target3, this);
+  Callback<int, int> otherTarget1 = MakeCallback (&EqualCallbackTestCase::Target1, &other);
+
+  NS_TEST_ASSERT_MSG_EQ (target1 (1), 2, "Callback did not fire");
+  NS_TEST_ASSERT_MSG_EQ (target3 (1), 4, "Virtual member Callback did not fire");
+
+  Callback<int, int> copy = target1;
+  NS_TEST_ASSERT_MSG_EQ (copy.IsEqual (target1), true, "Copy is not equal to the original");
+  NS_TEST_ASSERT_MSG_EQ (copy.IsEqual (MakeCallback (&EqualCallbackTestCase::Target1, this)), true,
+                         "Same object and member function are not equal");
+  NS_TEST_ASSERT_MSG_EQ (copy.IsEqual (target2), false, "Different member functions are equal");
+  NS_TEST_ASSERT_MSG_EQ (copy.IsEqual (otherTarget1), false, "Different objects are equal");
+  NS_TEST_ASSERT_MSG_EQ (target3.IsEqual (MakeCallback (&EqualCallbackTestCase::Target3, this)), true,
+                         "Same virtual member function is not equal");
+
+  // A Callback rebuilt from the pimpl compares equal to the original.
+  Ptr<CallbackImplBase> impl = target1.GetImpl ();
+  Callback<int, int> fromImpl (DynamicCast<CallbackImpl<int, int, empty, empty, empty, empty, empty, empty, empty, empty> > (impl));
+  NS_TEST_ASSERT_MSG_EQ (fromImpl (1), 2, "Callback from pimpl did not fire");
+  NS_TEST_ASSERT_MSG_EQ (fromImpl.IsEqual (target1), true, "Callback from pimpl is not equal");
+  NS_TEST_ASSERT_MSG_EQ (target1.IsEqual (fromImpl), true, "Callback is not equal to its pimpl");
+
+  CallbackBase base = target2;
+  Callback<int, int> assigned;
+  NS_TEST_ASSERT_MSG_EQ (assigned.CheckType (base), true, "Type check failed");
+  NS_TEST_ASSERT_MSG_EQ (assigned.Assign (base), true, "Assign failed");
+  NS_TEST_ASSERT_MSG_EQ (assigned (1), 3, "Assigned Callback did not fire");
+  NS_TEST_ASSERT_MSG_EQ (assigned.IsEqual (target2), true, "Assigned Callback is not equal");
+
+  Callback<int, double> wrongType;
+  NS_TEST_ASSERT_MSG_EQ (wrongType.CheckType (base), false, "Incompatible types not detected");
+
+  assigned.Nullify ();
+  NS_TEST_ASSERT_MSG_EQ (assigned.IsNull (), true, "Nullified Callback reports not IsNull()");
+}
+
 // ===========================================================================
 // Make sure that various MakeCallback template functions compile and execute.
 // Doesn't check an results of the execution.
@@ -755,6 +829,7 @@ CallbackTestSuite::CallbackTestSuite ()
   AddTestCase (new MakeCallbackTestCase, TestCase::QUICK);
   AddTestCase (new MakeBoundCallbackTestCase, TestCase::QUICK);
   AddTestCase (new NullifyCallbackTestCase, TestCase::QUICK);
+  AddTestCase (new EqualCallbackTestCase, TestCase::QUICK);
   AddTestCase (new MakeCallbackTemplatesTestCase, TestCase::QUICK);
 }
 
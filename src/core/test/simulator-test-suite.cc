@@ -24,6 +24,10 @@
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/ladder-scheduler.h"
+#include "ns3/event-pool.h"
+#include <unordered_map>
+#include <vector>
 
 using namespace ns3;
 
@@ -465,6 +469,183 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * Drive a scheduler directly with a hold model mixing dense events, far
+ * away timers and simultaneous events, removing some pending events, and
+ * check that the events come out in order.
+ */
+class SchedulerOrderTestCase : public TestCase
+{
+public:
+  SchedulerOrderTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  /**
+   * \returns The next pseudo-random number.
+   */
+  uint32_t Next (void);
+  /**
+   * Insert an event in the scheduler and the pending list.
+   * \param ts The event time stamp.
+   */
+  void Insert (uint64_t ts);
+  /**
+   * Drop an event from the pending list.
+   * \param uid The event uid.
+   */
+  void Forget (uint32_t uid);
+  ObjectFactory m_schedulerFactory;
+  Ptr<Scheduler> m_scheduler;
+  std::vector<Scheduler::Event> m_pending;
+  std::unordered_map<uint32_t, std::size_t> m_index;
+  uint32_t m_uid;
+  uint32_t m_seed;
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check the event order of a skewed schedule with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{}
+uint32_t
+SchedulerOrderTestCase::Next (void)
+{
+  m_seed = m_seed * 1103515245 + 12345;
+  return m_seed >> 8;
+}
+void
+SchedulerOrderTestCase::Insert (uint64_t ts)
+{
+  Scheduler::Event ev;
+  ev.impl = 0;
+  ev.key.m_ts = ts;
+  ev.key.m_uid = m_uid++;
+  ev.key.m_context = 0;
+  m_scheduler->Insert (ev);
+  m_index[ev.key.m_uid] = m_pending.size ();
+  m_pending.push_back (ev);
+}
+void
+SchedulerOrderTestCase::Forget (uint32_t uid)
+{
+  std::size_t i = m_index[uid];
+  m_index.erase (uid);
+  m_pending[i] = m_pending.back ();
+  m_pending.pop_back ();
+  if (i < m_pending.size ())
+    {
+      m_index[m_pending[i].key.m_uid] = i;
+    }
+}
+void
+SchedulerOrderTestCase::DoRun (void)
+{
+  m_scheduler = m_schedulerFactory.Create<Scheduler> ();
+  m_uid = 0;
+  m_seed = 1;
+
+  uint64_t now = 0;
+  for (uint32_t i = 0; i < 4000; i++)
+    {
+      Insert (Next () % 1000);
+    }
+  Scheduler::EventKey last = {0, 0, 0};
+  bool first = true;
+  for (uint32_t step = 0; step < 20000; step++)
+    {
+      if (step % 7 == 0)
+        {
+          Scheduler::Event ev = m_pending[Next () % m_pending.size ()];
+          m_scheduler->Remove (ev);
+          Forget (ev.key.m_uid);
+        }
+      Scheduler::Event ev = m_scheduler->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ ((first || last < ev.key), true, "Event out of order at step " << step);
+      NS_TEST_ASSERT_MSG_EQ (m_index.count (ev.key.m_uid), 1, "Unknown event at step " << step);
+      Forget (ev.key.m_uid);
+      last = ev.key;
+      first = false;
+      now = ev.key.m_ts;
+
+      uint32_t kind = Next () % 100;
+      if (kind < 5)
+        {
+          Insert (now + 10000000000ULL + Next () % 1000);
+        }
+      else if (kind < 15)
+        {
+          Insert (now);
+        }
+      else
+        {
+          Insert (now + Next () % 1000);
+        }
+    }
+  while (!m_scheduler->IsEmpty ())
+    {
+      Scheduler::Event ev = m_scheduler->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ ((last < ev.key), true, "Event out of order while draining");
+      Forget (ev.key.m_uid);
+      last = ev.key;
+    }
+  NS_TEST_ASSERT_MSG_EQ (m_pending.size (), 0, "Events lost");
+  m_scheduler = 0;
+}
+
+/**
+ * Check that events released by the simulator are recycled by the
+ * EventPool.
+ */
+class EventPoolTestCase : public TestCase
+{
+public:
+  EventPoolTestCase ();
+  virtual void DoRun (void);
+  /**
+   * An event with arguments.
+   * \param a An argument.
+   * \param b An argument.
+   */
+  void Event (uint64_t a, uint64_t b);
+  uint64_t m_sum;
+};
+
+EventPoolTestCase::EventPoolTestCase ()
+  : TestCase ("Check that the event pool recycles events")
+{}
+void
+EventPoolTestCase::Event (uint64_t a, uint64_t b)
+{
+  m_sum += a + b;
+}
+void
+EventPoolTestCase::DoRun (void)
+{
+  void *p = EventPool::Allocate (40);
+  EventPool::Deallocate (p, 40);
+  NS_TEST_ASSERT_MSG_EQ (EventPool::Allocate (33), p, "Block of the same size class not reused");
+  EventPool::Deallocate (p, 33);
+  void *large = EventPool::Allocate (4096);
+  EventPool::Deallocate (large, 4096);
+
+  m_sum = 0;
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      Simulator::Schedule (MicroSeconds (i), &EventPoolTestCase::Event, this, i, 1);
+    }
+  Simulator::Run ();
+  uint64_t hits = EventPool::GetHits ();
+  uint64_t misses = EventPool::GetMisses ();
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      Simulator::Schedule (MicroSeconds (i), &EventPoolTestCase::Event, this, i, 1);
+    }
+  NS_TEST_ASSERT_MSG_EQ (EventPool::GetMisses (), misses, "Released events not recycled");
+  NS_TEST_ASSERT_MSG_EQ (EventPool::GetHits (), hits + 100, "Events not counted");
+  Simulator::Run ();
+  NS_TEST_ASSERT_MSG_EQ (m_sum, 2 * (4950 + 100), "Events did not run");
+  Simulator::Destroy ();
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -483,5 +664,20 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (PriorityQueueScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (HeapScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (CalendarScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (PriorityQueueScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory), TestCase::QUICK);
+
+    AddTestCase (new EventPoolTestCase (), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
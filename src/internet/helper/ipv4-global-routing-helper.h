@@ -85,6 +85,21 @@ public:
    *
    */
   static void RecomputeRoutingTables (void);
+  /**
+   * \brief Bring the routes up to date with the global topology, like
+   * RecomputeRoutingTables(), but only recompute what changed.
+   *
+   * The Link State Advertisements are gathered again and compared with
+   * those the routes were computed from.  The routing tables of routers
+   * whose shortest path trees never reached a changed advertisement are
+   * left alone, and the SPF calculation only runs again for routers whose
+   * tree changed shape; the other routers get their routes from their
+   * previous tree.  The routes are the same as after
+   * RecomputeRoutingTables().
+   *
+   * Users must first call PopulateRoutingTables().
+   */
+  static void UpdateRoutingTables (void);
 private:
   /**
    * \brief Assignment operator declared private and not implemented to disallow
@@ -51,22 +51,24 @@ operator<< (std::ostream& os, const CandidateQueue& q)
 {
   typedef CandidateQueue::CandidateList_t List_t;
   typedef List_t::const_iterator CIter_t;
-  const CandidateQueue::CandidateList_t& list = q.m_candidates;
+  List_t list = q.m_candidates;
+  std::sort (list.begin (), list.end (), &CandidateQueue::IsBefore);
 
   os << "*** CandidateQueue Begin (<id, distance, LSA-type>) ***" << std::endl;
   for (CIter_t iter = list.begin (); iter != list.end (); iter++)
     {
       os << "<" 
-      << (*iter)->GetVertexId () << ", "
-      << (*iter)->GetDistanceFromRoot () << ", "
-      << (*iter)->GetVertexType () << ">" << std::endl;
+      << iter->vertex->GetVertexId () << ", "
+      << iter->vertex->GetDistanceFromRoot () << ", "
+      << iter->vertex->GetVertexType () << ">" << std::endl;
     }
   os << "*** CandidateQueue End ***";
   return os;
 }
 
 CandidateQueue::CandidateQueue()
-  : m_candidates ()
+  : m_candidates (),
+    m_nextSeq (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -94,11 +96,11 @@ CandidateQueue::Push (SPFVertex *vNew)
 {
   NS_LOG_FUNCTION (this << vNew);
 
-  CandidateList_t::iterator i = std::upper_bound (
-      m_candidates.begin (), m_candidates.end (), vNew,
-      &CandidateQueue::CompareSPFVertex
-      );
-  m_candidates.insert (i, vNew);
+  Candidate c = {vNew, m_nextSeq++};
+  m_candidates.push_back (c);
+  m_positions[vNew] = m_candidates.size () - 1;
+  m_vertices.insert (std::make_pair (vNew->GetVertexId (), vNew));
+  SiftUp (m_candidates.size () - 1);
 }
 
 SPFVertex *
@@ -110,8 +112,20 @@ CandidateQueue::Pop (void)
       return 0;
     }
 
-  SPFVertex *v = m_candidates.front ();
-  m_candidates.pop_front ();
+  SPFVertex *v = m_candidates.front ().vertex;
+  Candidate last = m_candidates.back ();
+  m_candidates.pop_back ();
+  if (!m_candidates.empty ())
+    {
+      Place (0, last);
+      SiftDown (0);
+    }
+  m_positions.erase (v);
+  std::unordered_map<Ipv4Address, SPFVertex *, Ipv4AddressHash>::iterator it = m_vertices.find (v->GetVertexId ());
+  if (it != m_vertices.end () && it->second == v)
+    {
+      m_vertices.erase (it);
+    }
   return v;
 }
 
@@ -124,7 +138,7 @@ CandidateQueue::Top (void) const
       return 0;
     }
 
-  return m_candidates.front ();
+  return m_candidates.front ().vertex;
 }
 
 bool
@@ -145,18 +159,23 @@ SPFVertex *
 CandidateQueue::Find (const Ipv4Address addr) const
 {
   NS_LOG_FUNCTION (this);
-  CandidateList_t::const_iterator i = m_candidates.begin ();
-
-  for (; i != m_candidates.end (); i++)
+  std::unordered_map<Ipv4Address, SPFVertex *, Ipv4AddressHash>::const_iterator it = m_vertices.find (addr);
+  if (it == m_vertices.end ())
     {
-      SPFVertex *v = *i;
-      if (v->GetVertexId () == addr)
-        {
-          return v;
-        }
+      return 0;
     }
+  return it->second;
+}
 
-  return 0;
+void
+CandidateQueue::Update (SPFVertex *v)
+{
+  NS_LOG_FUNCTION (this << v);
+  std::unordered_map<const SPFVertex *, uint32_t>::const_iterator it = m_positions.find (v);
+  NS_ASSERT_MSG (it != m_positions.end (), "Vertex not in the CandidateQueue");
+  uint32_t pos = it->second;
+  m_candidates[pos].seq = m_nextSeq++;
+  SiftUp (pos);
 }
 
 void
@@ -164,11 +183,78 @@ CandidateQueue::Reorder (void)
 {
   NS_LOG_FUNCTION (this);
 
-  m_candidates.sort (&CandidateQueue::CompareSPFVertex);
+  for (uint32_t i = m_candidates.size () / 2; i-- > 0; )
+    {
+      SiftDown (i);
+    }
   NS_LOG_LOGIC ("After reordering the CandidateQueue");
   NS_LOG_LOGIC (*this);
 }
 
+void
+CandidateQueue::Place (uint32_t pos, const Candidate &c)
+{
+  m_candidates[pos] = c;
+  m_positions[c.vertex] = pos;
+}
+
+void
+CandidateQueue::SiftUp (uint32_t pos)
+{
+  Candidate c = m_candidates[pos];
+  while (pos > 0)
+    {
+      uint32_t parent = (pos - 1) / 2;
+      if (!IsBefore (c, m_candidates[parent]))
+        {
+          break;
+        }
+      Place (pos, m_candidates[parent]);
+      pos = parent;
+    }
+  Place (pos, c);
+}
+
+void
+CandidateQueue::SiftDown (uint32_t pos)
+{
+  Candidate c = m_candidates[pos];
+  uint32_t size = m_candidates.size ();
+  for (;;)
+    {
+      uint32_t child = 2 * pos + 1;
+      if (child >= size)
+        {
+          break;
+        }
+      if (child + 1 < size && IsBefore (m_candidates[child + 1], m_candidates[child]))
+        {
+          child++;
+        }
+      if (!IsBefore (m_candidates[child], c))
+        {
+          break;
+        }
+      Place (pos, m_candidates[child]);
+      pos = child;
+    }
+  Place (pos, c);
+}
+
+bool
+CandidateQueue::IsBefore (const Candidate &c1, const Candidate &c2)
+{
+  if (CompareSPFVertex (c1.vertex, c2.vertex))
+    {
+      return true;
+    }
+  if (CompareSPFVertex (c2.vertex, c1.vertex))
+    {
+      return false;
+    }
+  return c1.seq < c2.seq;
+}
+
 /*
  * In this implementation, SPFVertex follows the ordering where
  * a vertex is ranked first if its GetDistanceFromRoot () is smaller;
@@ -22,7 +22,8 @@
 #define CANDIDATE_QUEUE_H
 
 #include <stdint.h>
-#include <list>
+#include <vector>
+#include <unordered_map>
 #include "ns3/ipv4-address.h"
 
 namespace ns3 {
@@ -47,6 +48,11 @@ class SPFVertex;
  * for a Find () operation, the dynamic nature of the data and the derived
  * requirement for a Reorder () operation led us to implement this simple 
  * enhanced priority queue.
+ *
+ * The queue is a binary heap indexed by vertex, so that Push, Pop and
+ * Update take a logarithmic time and Find a constant one.  Vertices at
+ * the same distance (and of the same type) are popped in the order in
+ * which they were pushed or last updated.
  */
 class CandidateQueue
 {
@@ -139,6 +145,18 @@ public:
  */
   SPFVertex* Find (const Ipv4Address addr) const;
 
+/**
+ * @brief Move a vertex to its place in the queue after its distance from
+ * the root has decreased.
+ *
+ * The vertex is placed after the vertices at the same distance, as if it
+ * had been popped and pushed again.
+ *
+ * @see SPFVertex
+ * @param v The Shortest Path First Vertex, already in the queue.
+ */
+  void Update (SPFVertex *v);
+
 /**
  * @brief Reorders the Candidate Queue according to the priority scheme.
  * 
@@ -184,8 +202,45 @@ private:
  */
   static bool CompareSPFVertex (const SPFVertex* v1, const SPFVertex* v2);
 
-  typedef std::list<SPFVertex*> CandidateList_t; //!< container of SPFVertex pointers
+/// A vertex in the heap
+  struct Candidate
+  {
+    SPFVertex *vertex; //!< the vertex
+    uint64_t seq;      //!< order of insertion, to break ties
+  };
+
+/**
+ * \brief return true if c1 must be popped before c2
+ * \param c1 first operand
+ * \param c2 second operand
+ * \return True if c1 should be popped before c2; false otherwise
+ */
+  static bool IsBefore (const Candidate &c1, const Candidate &c2);
+
+/**
+ * \brief Store a candidate in the heap and in the indexes.
+ * \param pos the position in the heap
+ * \param c the candidate
+ */
+  void Place (uint32_t pos, const Candidate &c);
+
+/**
+ * \brief Move a candidate towards the top of the heap.
+ * \param pos the position of the candidate
+ */
+  void SiftUp (uint32_t pos);
+
+/**
+ * \brief Move a candidate towards the bottom of the heap.
+ * \param pos the position of the candidate
+ */
+  void SiftDown (uint32_t pos);
+
+  typedef std::vector<Candidate> CandidateList_t; //!< binary heap of SPFVertex pointers
   CandidateList_t m_candidates;  //!< SPFVertex candidates
+  std::unordered_map<const SPFVertex *, uint32_t> m_positions; //!< position of each vertex in the heap
+  std::unordered_map<Ipv4Address, SPFVertex *, Ipv4AddressHash> m_vertices; //!< vertices by vertex ID
+  uint64_t m_nextSeq; //!< insertion order of the next vertex
 
   /**
    * \brief Stream insertion operator.
@@ -27,9 +27,13 @@
 #include <queue>
 #include <algorithm>
 #include <iostream>
+#include <thread>
+#include <unordered_set>
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
+#include "ns3/global-value.h"
+#include "ns3/uinteger.h"
 #include "ns3/node-list.h"
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-routing-protocol.h"
@@ -38,11 +42,25 @@
 #include "global-route-manager-impl.h"
 #include "candidate-queue.h"
 #include "ipv4-global-routing.h"
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#endif
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("GlobalRouteManagerImpl");
 
+/**
+ * \ingroup globalrouting
+ * Number of threads running the SPF calculations of the routers.
+ */
+static GlobalValue g_spfThreads ("GlobalRoutingSpfThreads",
+                                 "The number of threads running the SPF calculations "
+                                 "of the global routing (0 for one per core)",
+                                 UintegerValue (0),
+                                 MakeUintegerChecker<uint32_t> ());
+
 /**
  * \brief Stream insertion operator.
  *
@@ -469,7 +487,31 @@ GlobalRouteManagerLSDB::Insert (Ipv4Address addr, GlobalRoutingLSA* lsa)
     } 
   else
     {
-      m_database.insert (LSDBPair_t (addr, lsa));
+      if (!m_database.insert (LSDBPair_t (addr, lsa)).second)
+        {
+          return;
+        }
+//
+// Index the LSA by the Link Data of its TransitNetwork link records.  When
+// several LSAs share a Link Data, keep the first one in address order.
+//
+      for (uint32_t j = 0; j < lsa->GetNLinkRecords (); j++)
+        {
+          GlobalRoutingLinkRecord *lr = lsa->GetLinkRecord (j);
+          if (lr->GetLinkType () != GlobalRoutingLinkRecord::TransitNetwork)
+            {
+              continue;
+            }
+          LinkDataMap_t::iterator i = m_linkData.find (lr->GetLinkData ());
+          if (i == m_linkData.end ())
+            {
+              m_linkData.insert (std::make_pair (lr->GetLinkData (), LSDBPair_t (addr, lsa)));
+            }
+          else if (addr < i->second.first)
+            {
+              i->second = LSDBPair_t (addr, lsa);
+            }
+        }
     }
 }
 
@@ -494,13 +536,10 @@ GlobalRouteManagerLSDB::GetLSA (Ipv4Address addr) const
 //
 // Look up an LSA by its address.
 //
-  LSDBMap_t::const_iterator i;
-  for (i= m_database.begin (); i!= m_database.end (); i++)
+  LSDBMap_t::const_iterator i = m_database.find (addr);
+  if (i != m_database.end ())
     {
-      if (i->first == addr)
-        {
-          return i->second;
-        }
+      return i->second;
     }
   return 0;
 }
@@ -510,24 +549,135 @@ GlobalRouteManagerLSDB::GetLSAByLinkData (Ipv4Address addr) const
 {
   NS_LOG_FUNCTION (this << addr);
 //
-// Look up an LSA by its address.
+// Look up an LSA by the Link Data of one of its TransitNetwork link records.
 //
-  LSDBMap_t::const_iterator i;
-  for (i= m_database.begin (); i!= m_database.end (); i++)
+  LinkDataMap_t::const_iterator i = m_linkData.find (addr);
+  if (i != m_linkData.end ())
     {
-      GlobalRoutingLSA* temp = i->second;
-// Iterate among temp's Link Records
-      for (uint32_t j = 0; j < temp->GetNLinkRecords (); j++)
+      return i->second.second;
+    }
+  return 0;
+}
+
+void
+GlobalRouteManagerLSDB::GetTransitLinks (const GlobalRoutingLSA* lsa, std::vector<TransitLink>& links) const
+{
+  NS_LOG_FUNCTION (this << lsa);
+  links.clear ();
+  TransitLink link;
+  if (lsa->GetLSType () == GlobalRoutingLSA::RouterLSA)
+    {
+      for (uint32_t i = 0; i < lsa->GetNLinkRecords (); i++)
         {
-          GlobalRoutingLinkRecord *lr = temp->GetLinkRecord (j);
-          if ( lr->GetLinkType () == GlobalRoutingLinkRecord::TransitNetwork &&
-               lr->GetLinkData () == addr)
+          GlobalRoutingLinkRecord *l = lsa->GetLinkRecord (i);
+          if (l->GetLinkType () != GlobalRoutingLinkRecord::PointToPoint &&
+              l->GetLinkType () != GlobalRoutingLinkRecord::TransitNetwork)
             {
-              return temp;
+              continue;
             }
+          link.target = l->GetLinkId ();
+          link.data = l->GetLinkData ();
+          link.metric = l->GetMetric ();
+          link.type = l->GetLinkType ();
+          links.push_back (link);
+        }
+    }
+  else if (lsa->GetLSType () == GlobalRoutingLSA::NetworkLSA)
+    {
+      for (uint32_t i = 0; i < lsa->GetNAttachedRouters (); i++)
+        {
+          GlobalRoutingLSA *w_lsa = GetLSAByLinkData (lsa->GetAttachedRouter (i));
+          if (!w_lsa)
+            {
+              continue;
+            }
+          link.target = w_lsa->GetLinkStateId ();
+          link.data = lsa->GetAttachedRouter (i);
+          link.metric = 0;
+          link.type = 0;
+          links.push_back (link);
         }
     }
-  return 0;
+}
+
+bool
+GlobalRouteManagerLSDB::FindChanges (const GlobalRouteManagerLSDB& previous, ChangedLSAs_t& changed) const
+{
+  NS_LOG_FUNCTION (this << &previous);
+  changed.clear ();
+//
+// Link Data now found in another LSA, or in none.  The Network-LSAs listing
+// them as attached routers may lead elsewhere.
+//
+  std::unordered_set<Ipv4Address, Ipv4AddressHash> moved;
+  for (LinkDataMap_t::const_iterator i = m_linkData.begin (); i != m_linkData.end (); i++)
+    {
+      LinkDataMap_t::const_iterator j = previous.m_linkData.find (i->first);
+      if (j == previous.m_linkData.end () || j->second.first != i->second.first)
+        {
+          moved.insert (i->first);
+        }
+    }
+  for (LinkDataMap_t::const_iterator j = previous.m_linkData.begin (); j != previous.m_linkData.end (); j++)
+    {
+      if (m_linkData.find (j->first) == m_linkData.end ())
+        {
+          moved.insert (j->first);
+        }
+    }
+
+  for (LSDBMap_t::const_iterator j = previous.m_database.begin (); j != previous.m_database.end (); j++)
+    {
+      if (m_database.find (j->first) == m_database.end ())
+        {
+          changed[j->first] = true;
+        }
+    }
+  std::vector<TransitLink> before;
+  std::vector<TransitLink> after;
+  for (LSDBMap_t::const_iterator i = m_database.begin (); i != m_database.end (); i++)
+    {
+      GlobalRoutingLSA *lsa = i->second;
+      GlobalRoutingLSA *old = previous.GetLSA (i->first);
+      if (!old)
+        {
+          changed[i->first] = true;
+          continue;
+        }
+      bool same = lsa->IsEquivalent (*old);
+      if (same && lsa->GetLSType () == GlobalRoutingLSA::NetworkLSA)
+        {
+          for (uint32_t j = 0; same && j < lsa->GetNAttachedRouters (); j++)
+            {
+              same = moved.find (lsa->GetAttachedRouter (j)) == moved.end ();
+            }
+        }
+      if (same)
+        {
+          continue;
+        }
+      previous.GetTransitLinks (old, before);
+      GetTransitLinks (lsa, after);
+      bool transit = before != after || lsa->GetLSType () != old->GetLSType () ||
+        lsa->GetNetworkLSANetworkMask () != old->GetNetworkLSANetworkMask ();
+      if (transit || !lsa->IsEquivalent (*old))
+        {
+          changed[i->first] = transit;
+        }
+    }
+
+  if (m_extdatabase.size () != previous.m_extdatabase.size ())
+    {
+      return true;
+    }
+  for (uint32_t j = 0; j < m_extdatabase.size (); j++)
+    {
+      if (!m_extdatabase[j]->IsEquivalent (*previous.m_extdatabase[j]))
+        {
+          return true;
+        }
+    }
+  return false;
 }
 
 // ---------------------------------------------------------------------------
@@ -538,16 +688,30 @@ GlobalRouteManagerLSDB::GetLSAByLinkData (Ipv4Address addr) const
 
 GlobalRouteManagerImpl::GlobalRouteManagerImpl () 
   :
-    m_spfroot (0)
+    m_spfroot (0),
+    m_ownsLsdb (true),
+    m_spfRoots (0),
+    m_spfNextRoot (0)
 {
   NS_LOG_FUNCTION (this);
   m_lsdb = new GlobalRouteManagerLSDB ();
 }
 
+GlobalRouteManagerImpl::GlobalRouteManagerImpl (GlobalRouteManagerLSDB* lsdb)
+  :
+    m_spfroot (0),
+    m_lsdb (lsdb),
+    m_ownsLsdb (false),
+    m_spfRoots (0),
+    m_spfNextRoot (0)
+{
+  NS_LOG_FUNCTION (this << lsdb);
+}
+
 GlobalRouteManagerImpl::~GlobalRouteManagerImpl ()
 {
   NS_LOG_FUNCTION (this);
-  if (m_lsdb)
+  if (m_lsdb && m_ownsLsdb)
     {
       delete m_lsdb;
     }
@@ -562,6 +726,7 @@ GlobalRouteManagerImpl::DebugUseLsdb (GlobalRouteManagerLSDB* lsdb)
       delete m_lsdb;
     }
   m_lsdb = lsdb;
+  m_spfResults.clear ();
 }
 
 void
@@ -571,26 +736,9 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes ()
   NodeList::Iterator listEnd = NodeList::End ();
   for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
     {
-      Ptr<Node> node = *i;
-      Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-      if (router == 0)
-        {
-          continue;
-        }
-      Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-      uint32_t j = 0;
-      uint32_t nRoutes = gr->GetNRoutes ();
-      NS_LOG_LOGIC ("Deleting " << gr->GetNRoutes ()<< " routes from node " << node->GetId ());
-      // Each time we delete route 0, the route index shifts downward
-      // We can delete all routes if we delete the route numbered 0
-      // nRoutes times
-      for (j = 0; j < nRoutes; j++)
-        {
-          NS_LOG_LOGIC ("Deleting global route " << j << " from node " << node->GetId ());
-          gr->RemoveRoute (0);
-        }
-      NS_LOG_LOGIC ("Deleted " << j << " global routes from node "<< node->GetId ());
+      DeleteRoutes (*i);
     }
+  m_spfResults.clear ();
   if (m_lsdb)
     {
       NS_LOG_LOGIC ("Deleting LSDB, creating new one");
@@ -699,6 +847,113 @@ GlobalRouteManagerImpl::InitializeRoutes ()
 // Walk the list of nodes in the system.
 //
   NS_LOG_INFO ("About to start SPF calculation");
+  SPFRoots_t roots;
+  GetRoots (roots);
+  RunSPF (roots);
+  NS_LOG_INFO ("Finished SPF calculation");
+}
+
+void
+GlobalRouteManagerImpl::UpdateRoutes ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_spfResults.empty ())
+    {
+      NS_LOG_LOGIC ("No earlier SPF calculation, computing all routes");
+      DeleteGlobalRoutes ();
+      BuildGlobalRoutingDatabase ();
+      InitializeRoutes ();
+      return;
+    }
+//
+// Gather the LSAs again, and find out which of them changed since the
+// routes were computed.
+//
+  GlobalRouteManagerLSDB *previous = m_lsdb;
+  m_lsdb = new GlobalRouteManagerLSDB ();
+  BuildGlobalRoutingDatabase ();
+  GlobalRouteManagerLSDB::ChangedLSAs_t changed;
+  bool externals = m_lsdb->FindChanges (*previous, changed);
+  NS_LOG_INFO (changed.size () << " LSAs changed, External LSAs changed: " << externals);
+//
+// A router needs new routes if its last calculation read one of the changed
+// LSAs.  SPF runs again unless the tree it built is still valid.
+//
+  SPFRoots_t roots;
+  GetRoots (roots);
+  SPFRoots_t updates;
+  uint32_t nReplays = 0;
+  std::unordered_set<Ipv4Address, Ipv4AddressHash> routers;
+  std::vector<uint32_t> interfaces;
+  for (SPFRoots_t::iterator r = roots.begin (); r != roots.end (); r++)
+    {
+      routers.insert (r->routerId);
+      SPFResults_t::const_iterator last = m_spfResults.find (r->routerId);
+      bool update = true;
+      bool replay = false;
+      if (last != m_spfResults.end ())
+        {
+          const SPFResult &result = last->second;
+          GetInterfaceState (r->node->GetObject<Ipv4> (), interfaces);
+          if (interfaces == result.interfaces)
+            {
+              update = externals;
+              replay = true;
+              GlobalRouteManagerLSDB::ChangedLSAs_t::const_iterator c;
+              for (c = changed.begin (); replay && c != changed.end (); c++)
+                {
+                  uint32_t index;
+                  if (!FindTreeIndex (result, c->first, index))
+                    {
+                      continue;
+                    }
+                  update = true;
+                  replay = !result.stub && index != SPF_INFINITY &&
+                    (!c->second || SPFTreeKeeps (result, index, *previous));
+                }
+            }
+          if (replay)
+            {
+              r->replay = &result;
+            }
+        }
+      if (update)
+        {
+          DeleteRoutes (r->node);
+          nReplays += replay;
+          updates.push_back (*r);
+        }
+    }
+//
+// Routers which no longer take part in routing lose their routes.
+//
+  for (SPFResults_t::iterator i = m_spfResults.begin (); i != m_spfResults.end (); )
+    {
+      if (routers.find (i->first) == routers.end ())
+        {
+          Ptr<Node> node = FindRootNode (i->first);
+          if (node)
+            {
+              DeleteRoutes (node);
+            }
+          i = m_spfResults.erase (i);
+        }
+      else
+        {
+          i++;
+        }
+    }
+  NS_LOG_INFO ("Updating the routes of " << updates.size () << " of " << roots.size () <<
+               " routers, " << nReplays << " from their last tree");
+  RunSPF (updates);
+  delete previous;
+}
+
+void
+GlobalRouteManagerImpl::GetRoots (SPFRoots_t& roots) const
+{
+  NS_LOG_FUNCTION (this);
+  roots.clear ();
   NodeList::Iterator listEnd = NodeList::End ();
   for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
     {
@@ -718,15 +973,415 @@ GlobalRouteManagerImpl::InitializeRoutes ()
         }
 
 //
-// if the node has a global router interface, then run the global routing
-// algorithms.
+// if the node has a global router interface, then run the global routing
+// algorithms.
+//
+      if (rtr && rtr->GetNumLSAs () )
+        {
+          SPFRoot root;
+          root.routerId = rtr->GetRouterId ();
+          root.node = node;
+          root.replay = 0;
+          roots.push_back (root);
+        }
+    }
+}
+
+void
+GlobalRouteManagerImpl::RunSPF (SPFRoots_t& roots)
+{
+  NS_LOG_FUNCTION (this << roots.size ());
+//
+// Each calculation only touches the node at its root, so the roots can be
+// shared among threads.  The main thread works too.
+//
+  UintegerValue threadsValue;
+  g_spfThreads.GetValue (threadsValue);
+  uint32_t nThreads = threadsValue.Get ();
+  if (nThreads == 0)
+    {
+      nThreads = std::max<uint32_t> (std::thread::hardware_concurrency (), 1);
+    }
+  nThreads = std::min<uint32_t> (nThreads, roots.size ());
+  std::atomic<uint32_t> nextRoot (0);
+  m_spfRoots = &roots;
+  m_spfNextRoot = &nextRoot;
+#ifdef HAVE_PTHREAD_H
+  std::vector<GlobalRouteManagerImpl *> workers;
+  std::vector<Ptr<SystemThread> > threads;
+  for (uint32_t i = 1; i < nThreads; i++)
+    {
+      GlobalRouteManagerImpl *worker = new GlobalRouteManagerImpl (m_lsdb);
+      worker->m_spfRoots = &roots;
+      worker->m_spfNextRoot = &nextRoot;
+      workers.push_back (worker);
+      threads.push_back (Create<SystemThread> (MakeCallback (&GlobalRouteManagerImpl::SPFCalculateRoots, worker)));
+      threads.back ()->Start ();
+    }
+  NS_LOG_INFO ("Running " << roots.size () << " SPF calculations on " << nThreads << " threads");
+#endif
+  SPFCalculateRoots ();
+#ifdef HAVE_PTHREAD_H
+  for (uint32_t i = 0; i < threads.size (); i++)
+    {
+      threads[i]->Join ();
+      delete workers[i];
+    }
+#endif
+  m_spfRoots = 0;
+  m_spfNextRoot = 0;
+//
+// Keep the trees for UpdateRoutes ().
+//
+  for (SPFRoots_t::iterator r = roots.begin (); r != roots.end (); r++)
+    {
+      if (!r->replay)
+        {
+          std::swap (m_spfResults[r->routerId], r->result);
+        }
+    }
+}
+
+void
+GlobalRouteManagerImpl::SPFCalculateRoots (void)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t i;
+  while ((i = m_spfNextRoot->fetch_add (1)) < m_spfRoots->size ())
+    {
+      SPFRoot &root = (*m_spfRoots)[i];
+      if (root.replay)
+        {
+          SPFReplay (root.node, *root.replay);
+        }
+      else
+        {
+          SPFCalculate (root.routerId, root.node);
+          std::swap (root.result, m_spfResult);
+        }
+    }
+}
+
+void
+GlobalRouteManagerImpl::DeleteRoutes (Ptr<Node> node) const
+{
+  NS_LOG_FUNCTION (this << node);
+  Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
+  if (router == 0)
+    {
+      return;
+    }
+  Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
+  uint32_t j = 0;
+  uint32_t nRoutes = gr->GetNRoutes ();
+  NS_LOG_LOGIC ("Deleting " << gr->GetNRoutes ()<< " routes from node " << node->GetId ());
+  // Each time we delete route 0, the route index shifts downward
+  // We can delete all routes if we delete the route numbered 0
+  // nRoutes times
+  for (j = 0; j < nRoutes; j++)
+    {
+      NS_LOG_LOGIC ("Deleting global route " << j << " from node " << node->GetId ());
+      gr->RemoveRoute (0);
+    }
+  NS_LOG_LOGIC ("Deleted " << j << " global routes from node "<< node->GetId ());
+}
+
+void
+GlobalRouteManagerImpl::GetInterfaceState (Ptr<Ipv4> ipv4, std::vector<uint32_t>& state)
+{
+  NS_LOG_FUNCTION (ipv4);
+  state.clear ();
+  if (!ipv4)
+    {
+      return;
+    }
+  for (uint32_t i = 0; i < ipv4->GetNInterfaces (); i++)
+    {
+      state.push_back (ipv4->IsUp (i));
+      state.push_back (ipv4->GetNAddresses (i));
+      for (uint32_t j = 0; j < ipv4->GetNAddresses (i); j++)
+        {
+          Ipv4InterfaceAddress address = ipv4->GetAddress (i, j);
+          state.push_back (address.GetLocal ().Get ());
+          state.push_back (address.GetMask ().Get ());
+        }
+    }
+}
+
+bool
+GlobalRouteManagerImpl::FindTreeIndex (const SPFResult& result, Ipv4Address id, uint32_t& index)
+{
+  std::vector<std::pair<Ipv4Address, uint32_t> >::const_iterator i =
+    std::lower_bound (result.index.begin (), result.index.end (), std::make_pair (id, uint32_t (0)));
+  if (i == result.index.end () || i->first != id)
+    {
+      return false;
+    }
+  index = i->second;
+  return true;
+}
+
+bool
+GlobalRouteManagerImpl::SPFTreeKeeps (const SPFResult& result, uint32_t index, const GlobalRouteManagerLSDB& previous) const
+{
+  NS_LOG_FUNCTION (this << index << &previous);
+  const SPFTreeVertex &v = result.tree[index];
+  GlobalRoutingLSA *lsa = m_lsdb->GetLSA (v.id);
+  GlobalRoutingLSA *old = previous.GetLSA (v.id);
+//
+// The links of the root give the first hops, and CheckForStubNode () only
+// looks at them.
+//
+  if (index == 0 || !lsa || !old || lsa->GetLSType () != old->GetLSType () ||
+      lsa->GetNetworkLSANetworkMask () != old->GetNetworkLSANetworkMask ())
+    {
+      NS_LOG_LOGIC ("Vertex " << v.id << " is the root, or changed type");
+      return false;
+    }
+  std::vector<GlobalRouteManagerLSDB::TransitLink> before;
+  std::vector<GlobalRouteManagerLSDB::TransitLink> after;
+  previous.GetTransitLinks (old, before);
+  m_lsdb->GetTransitLinks (lsa, after);
+//
+// Pair the links that stayed; they must still come in the same order, for
+// the candidates to be examined in the same order.
+//
+  std::vector<bool> keptBefore (before.size (), false);
+  std::vector<bool> keptAfter (after.size (), false);
+  for (uint32_t i = 0; i < before.size (); i++)
+    {
+      for (uint32_t j = 0; j < after.size (); j++)
+        {
+          if (!keptAfter[j] && before[i] == after[j])
+            {
+              keptBefore[i] = true;
+              keptAfter[j] = true;
+              break;
+            }
+        }
+    }
+  for (uint32_t i = 0, j = 0; ; i++, j++)
+    {
+      while (i < before.size () && !keptBefore[i])
+        {
+          i++;
+        }
+      while (j < after.size () && !keptAfter[j])
+        {
+          j++;
+        }
+      if (i == before.size () || j == after.size ())
+        {
+          break;
+        }
+      if (!(before[i] == after[j]))
+        {
+          NS_LOG_LOGIC ("Links of vertex " << v.id << " changed order");
+          return false;
+        }
+    }
+//
+// A link between a vertex and one of its parents gives the distance and
+// the next hops of the vertex: it must not go away.
+//
+  for (uint32_t i = 0; i < before.size (); i++)
+    {
+      if (keptBefore[i])
+        {
+          continue;
+        }
+      uint32_t w;
+      for (uint32_t k = v.parents; k < v.parents + v.nParents; k++)
+        {
+          if (result.tree[result.parents[k]].id == before[i].target)
+            {
+              NS_LOG_LOGIC ("Vertex " << v.id << " lost a link to its parent " << before[i].target);
+              return false;
+            }
+        }
+      if (FindTreeIndex (result, before[i].target, w) && w != SPF_INFINITY)
+        {
+          for (uint32_t k = result.tree[w].parents; k < result.tree[w].parents + result.tree[w].nParents; k++)
+            {
+              if (result.parents[k] == index)
+                {
+                  NS_LOG_LOGIC ("Vertex " << v.id << " lost a link to its child " << before[i].target);
+                  return false;
+                }
+            }
+        }
+    }
+//
+// A new link must lead to a vertex of the tree, along a longer path.
+//
+  for (uint32_t j = 0; j < after.size (); j++)
+    {
+      if (keptAfter[j])
+        {
+          continue;
+        }
+      uint32_t w;
+      if (!FindTreeIndex (result, after[j].target, w) || w == SPF_INFINITY ||
+          v.distance + after[j].metric <= result.tree[w].distance)
+        {
+          NS_LOG_LOGIC ("Vertex " << v.id << " has a new shortest path to " << after[j].target);
+          return false;
+        }
+      for (uint32_t k = v.parents; k < v.parents + v.nParents; k++)
+        {
+          if (result.parents[k] == w)
+            {
+              NS_LOG_LOGIC ("Vertex " << v.id << " has a new link to its parent " << after[j].target);
+              return false;
+            }
+        }
+    }
+  return true;
+}
+
+void
+GlobalRouteManagerImpl::SPFReplay (Ptr<Node> node, const SPFResult& result)
+{
+  NS_LOG_FUNCTION (this << node);
+  SetSPFNode (node);
+//
+// Build the tree again, with the LSAs of the current database, and add the
+// routes in the order SPFCalculate () would.
+//
+  std::vector<SPFVertex *> vertices;
+  for (uint32_t i = 0; i < result.tree.size (); i++)
+    {
+      const SPFTreeVertex &entry = result.tree[i];
+      SPFVertex *v = new SPFVertex (m_lsdb->GetLSA (entry.id));
+      v->SetDistanceFromRoot (entry.distance);
+      for (uint32_t j = entry.exits; j < entry.exits + entry.nExits; j++)
+        {
+          SPFVertex exit;
+          exit.SetRootExitDirection (result.exits[j]);
+          v->MergeRootExitDirections (&exit);
+        }
+      for (uint32_t j = entry.parents; j < entry.parents + entry.nParents; j++)
+        {
+          SPFVertex *parent = vertices[result.parents[j]];
+          if (j == entry.parents)
+            {
+              v->SetParent (parent);
+            }
+          else
+            {
+              SPFVertex other;
+              other.SetParent (parent);
+              v->MergeParent (&other);
+            }
+        }
+      SPFVertexAddParent (v);
+      vertices.push_back (v);
+      if (i == 0)
+        {
+          m_spfroot = v;
+        }
+      else if (v->GetVertexType () == SPFVertex::VertexRouter)
+        {
+          SPFIntraAddRouter (v);
+        }
+      else
+        {
+          SPFIntraAddTransit (v);
+        }
+    }
+  SPFAddLeaves ();
+
+  delete m_spfroot;
+  m_spfroot = 0;
+  SetSPFNode (0);
+}
+
+void
+GlobalRouteManagerImpl::SPFRecordVertex (SPFVertex* v)
+{
+  SPFTreeVertex entry;
+  entry.id = v->GetVertexId ();
+  entry.distance = v->GetDistanceFromRoot ();
+  entry.parents = m_spfResult.parents.size ();
+  entry.nParents = 0;
+  SPFVertex *parent;
+  while ((parent = v->GetParent (entry.nParents)) != 0)
+    {
+      m_spfResult.parents.push_back (m_spfTreeIndex[parent]);
+      entry.nParents++;
+    }
+  entry.exits = m_spfResult.exits.size ();
+  entry.nExits = v->GetNRootExitDirections ();
+  for (uint32_t i = 0; i < entry.nExits; i++)
+    {
+      m_spfResult.exits.push_back (v->GetRootExitDirection (i));
+    }
+  uint32_t index = m_spfResult.tree.size ();
+  m_spfTreeIndex[v] = index;
+  m_spfResult.tree.push_back (entry);
+  m_spfResult.index.push_back (std::make_pair (entry.id, index));
+}
+
+void
+GlobalRouteManagerImpl::SetSPFNode (Ptr<Node> node)
+{
+  m_spfNode = node;
+  m_spfIpv4 = 0;
+  m_spfRouting = 0;
+  if (node)
+    {
+      m_spfIpv4 = node->GetObject<Ipv4> ();
+      NS_ASSERT_MSG (m_spfIpv4, 
+                     "GlobalRouteManagerImpl::SPFCalculate (): "
+                     "GetObject for <Ipv4> interface failed");
+      m_spfRouting = node->GetObject<GlobalRouter> ()->GetRoutingProtocol ();
+      NS_ASSERT (m_spfRouting);
+    }
+}
+
+Ptr<Node>
+GlobalRouteManagerImpl::FindRootNode (Ipv4Address routerId) const
+{
+  NS_LOG_FUNCTION (this << routerId);
+//
+// We need to walk the list of nodes looking for the one that has the router
+// ID corresponding to the root vertex.  This is the one we're going to write
+// the routing information to.
+//
+  NodeList::Iterator listEnd = NodeList::End ();
+  for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
+    {
+      Ptr<Node> node = *i;
 //
-      if (rtr && rtr->GetNumLSAs () )
+// The router ID is accessible through the GlobalRouter interface, so we need
+// to GetObject for that interface.  If there's no GlobalRouter interface, 
+// the node in question cannot be the router we want, so we continue.
+// 
+      Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter> ();
+      if (rtr && rtr->GetRouterId () == routerId)
         {
-          SPFCalculate (rtr->GetRouterId ());
+          return node;
         }
     }
-  NS_LOG_INFO ("Finished SPF calculation");
+  NS_LOG_LOGIC ("Can't find root node " << routerId);
+  return 0;
+}
+
+GlobalRoutingLSA::SPFStatus
+GlobalRouteManagerImpl::GetLSAStatus (const GlobalRoutingLSA *lsa) const
+{
+  std::unordered_map<const GlobalRoutingLSA *, GlobalRoutingLSA::SPFStatus>::const_iterator i = m_lsaStatus.find (lsa);
+  if (i == m_lsaStatus.end ())
+    {
+      return GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED;
+    }
+  return i->second;
+}
+
+void
+GlobalRouteManagerImpl::SetLSAStatus (const GlobalRoutingLSA *lsa, GlobalRoutingLSA::SPFStatus status)
+{
+  m_lsaStatus[lsa] = status;
 }
 
 //
@@ -835,7 +1490,7 @@ GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
 // If the link is to a router that is already in the shortest path first tree
 // then we have it covered -- ignore it.
 //
-      if (w_lsa->GetStatus () == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE) 
+      if (GetLSAStatus (w_lsa) == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE) 
         {
           NS_LOG_LOGIC ("Skipping ->  LSA "<< 
                         w_lsa->GetLinkStateId () << " already in SPF tree");
@@ -860,7 +1515,7 @@ GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
       NS_LOG_LOGIC ("Considering w_lsa " << w_lsa->GetLinkStateId ());
 
 // Is there already vertex w in candidate list?
-      if (w_lsa->GetStatus () == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
+      if (GetLSAStatus (w_lsa) == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
         {
 // Calculate nexthop to w
 // We need to figure out how to actually get to the new router represented
@@ -872,7 +1527,7 @@ GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
           w = new SPFVertex (w_lsa);
           if (SPFNexthopCalculation (v, w, l, distance))
             {
-              w_lsa->SetStatus (GlobalRoutingLSA::LSA_SPF_CANDIDATE);
+              SetLSAStatus (w_lsa, GlobalRoutingLSA::LSA_SPF_CANDIDATE);
 //
 // Push this new vertex onto the priority queue (ordered by distance from the
 // root node).
@@ -887,7 +1542,7 @@ GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
             NS_ASSERT_MSG (0, "SPFNexthopCalculation never " 
                            << "return false, but it does now!");
         }
-      else if (w_lsa->GetStatus () == GlobalRoutingLSA::LSA_SPF_CANDIDATE)
+      else if (GetLSAStatus (w_lsa) == GlobalRoutingLSA::LSA_SPF_CANDIDATE)
         {
 //
 // We have already considered the link represented by <w>.  What wse have to
@@ -957,9 +1612,9 @@ GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
                 {
 //
 // If we've changed the cost to get to the vertex represented by <w>, we 
-// must reorder the priority queue keyed to that cost.
+// must move it up in the priority queue keyed to that cost.
 //
-                  candidate.Reorder ();
+                  candidate.Update (cw);
                 }
             } // new lower cost path found
         } // end W is already on the candidate list
@@ -1304,6 +1959,7 @@ GlobalRouteManagerImpl::CheckForStubNode (Ipv4Address root)
           // The link record LinkID is the router ID of the peer.
           // The Link Data is the local IP interface address
           GlobalRoutingLSA *w_lsa = m_lsdb->GetLSA (transitLink->GetLinkId ());
+          m_spfResult.index.push_back (std::make_pair (transitLink->GetLinkId (), SPF_INFINITY));
           uint32_t nLinkRecords = w_lsa->GetNLinkRecords ();
           for (uint32_t j = 0; j < nLinkRecords; ++j)
             {
@@ -1319,9 +1975,7 @@ GlobalRouteManagerImpl::CheckForStubNode (Ipv4Address root)
               if (lr->GetLinkId () == myRouterId)
                 {
                   // Next hop is stored in the LinkID field of lr
-                  Ptr<GlobalRouter> router = rlsa->GetNode ()->GetObject<GlobalRouter> ();
-                  NS_ASSERT (router);
-                  Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
+                  Ptr<Ipv4GlobalRouting> gr = m_spfRouting;
                   NS_ASSERT (gr);
                   gr->AddNetworkRouteTo (Ipv4Address ("0.0.0.0"), Ipv4Mask ("0.0.0.0"), lr->GetLinkData (), 
                                          FindOutgoingInterfaceId (transitLink->GetLinkData ()));
@@ -1336,17 +1990,36 @@ GlobalRouteManagerImpl::CheckForStubNode (Ipv4Address root)
   return false;
 }
 
-// quagga ospf_spf_calculate
 void
 GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 {
   NS_LOG_FUNCTION (this << root);
+  SPFCalculate (root, FindRootNode (root));
+}
+
+// quagga ospf_spf_calculate
+void
+GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root, Ptr<Node> node)
+{
+  NS_LOG_FUNCTION (this << root << node);
 
   SPFVertex *v;
 //
-// Initialize the Link State Database.
+// Find the routing protocol of the root, where the routes will be written.
+//
+  SetSPFNode (node);
+//
+// Start the record of the calculation kept for UpdateRoutes ().
+//
+  m_spfResult = SPFResult ();
+  m_spfResult.stub = false;
+  m_spfTreeIndex.clear ();
+  GetInterfaceState (m_spfIpv4, m_spfResult.interfaces);
 //
-  m_lsdb->Initialize ();
+// Initialize the status of the LSAs.  It is kept here rather than in the
+// LSAs of the Link State Database, which other calculations may be reading.
+//
+  m_lsaStatus.clear ();
 //
 // The candidate queue is a priority queue of SPFVertex objects, with the top
 // of the queue being the closest vertex in terms of distance from the root
@@ -1366,7 +2039,8 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 //
   m_spfroot= v;
   v->SetDistanceFromRoot (0);
-  v->GetLSA ()->SetStatus (GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+  SetLSAStatus (v->GetLSA (), GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+  SPFRecordVertex (v);
   NS_LOG_LOGIC ("Starting SPFCalculate for node " << root);
 
 //
@@ -1376,10 +2050,14 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 // reached.  Instead, short-circuit this computation and just install
 // a default route in the CheckForStubNode() method.
 //
-  if (NodeList::GetNNodes () > 0 && CheckForStubNode (root))
+  if (m_spfNode && CheckForStubNode (root))
     {
       NS_LOG_LOGIC ("SPFCalculate truncated for stub node " << root);
+      m_spfResult.stub = true;
+      std::sort (m_spfResult.index.begin (), m_spfResult.index.end ());
       delete m_spfroot;
+      m_spfroot = 0;
+      SetSPFNode (0);
       return;
     }
 
@@ -1427,7 +2105,7 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 // Update the status field of the vertex to indicate that it is in the SPF
 // tree.
 //
-      v->GetLSA ()->SetStatus (GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+      SetLSAStatus (v->GetLSA (), GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
 //
 // The current vertex has a parent pointer.  By calling this rather oddly 
 // named method (blame quagga) we add the current vertex to the list of 
@@ -1436,6 +2114,7 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 // to now.
 //
       SPFVertexAddParent (v);
+      SPFRecordVertex (v);
 //
 // Note that when there is a choice of vertices closest to the root, network
 // vertices must be chosen before router vertices in order to necessarily
@@ -1485,14 +2164,8 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
     }  // end for loop
 
 // Second stage of SPF calculation procedure
-  SPFProcessStubs (m_spfroot);
-  for (uint32_t i = 0; i < m_lsdb->GetNumExtLSAs (); i++)
-    {
-      m_spfroot->ClearVertexProcessed ();
-      GlobalRoutingLSA *extlsa = m_lsdb->GetExtLSA (i);
-      NS_LOG_LOGIC ("Processing External LSA with id " << extlsa->GetLinkStateId ());
-      ProcessASExternals (m_spfroot, extlsa);
-    }
+  SPFAddLeaves ();
+  std::sort (m_spfResult.index.begin (), m_spfResult.index.end ());
 
 //
 // We're all done setting the routing information for the node at the root of
@@ -1501,6 +2174,21 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 //
   delete m_spfroot;
   m_spfroot = 0;
+  SetSPFNode (0);
+}
+
+void
+GlobalRouteManagerImpl::SPFAddLeaves (void)
+{
+  NS_LOG_FUNCTION (this);
+  SPFProcessStubs (m_spfroot);
+  for (uint32_t i = 0; i < m_lsdb->GetNumExtLSAs (); i++)
+    {
+      m_spfroot->ClearVertexProcessed ();
+      GlobalRoutingLSA *extlsa = m_lsdb->GetExtLSA (i);
+      NS_LOG_LOGIC ("Processing External LSA with id " << extlsa->GetLinkStateId ());
+      ProcessASExternals (m_spfroot, extlsa);
+    }
 }
 
 void
@@ -1559,58 +2247,27 @@ GlobalRouteManagerImpl::SPFAddASExternal (GlobalRoutingLSA *extlsa, SPFVertex *v
 
   NS_LOG_LOGIC ("Vertex ID = " << routerId);
 //
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
+// The routing information is written to the node that has the router ID
+// corresponding to the root vertex, found when the calculation started.
 //
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  if (!m_spfRouting)
     {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to QI for that interface.  If there's no GlobalRouter interface, the node
-// in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter> ();
-
-      if (rtr == 0)
-        {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << node->GetId ());
-          continue;
-        }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
-        {
-          NS_LOG_LOGIC ("Setting routes for node " << node->GetId ());
-//
-// Routing information is updated using the Ipv4 interface.  We need to QI
-// for that interface.  If the node is acting as an IP version 4 router, it
-// should absolutely have an Ipv4 interface.
-//
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "QI for <Ipv4> interface failed");
+      NS_LOG_LOGIC ("No node for router " << routerId);
+      return;
+    }
+  NS_LOG_LOGIC ("Setting routes for node " << m_spfNode->GetId ());
 //
 // Get the Global Router Link State Advertisement from the vertex we're
 // adding the routes to.  The LSA will have a number of attached Global Router
 // Link Records corresponding to links off of that vertex / node.  We're going
 // to be interested in the records corresponding to point-to-point links.
 //
-          NS_ASSERT_MSG (v->GetLSA (), 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "Expected valid LSA in SPFVertex* v");
-          Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask ();
-          Ipv4Address tempip = extlsa->GetLinkStateId ();
-          tempip = tempip.CombineMask (tempmask);
+  NS_ASSERT_MSG (v->GetLSA (), 
+                 "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                 "Expected valid LSA in SPFVertex* v");
+  Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask ();
+  Ipv4Address tempip = extlsa->GetLinkStateId ();
+  tempip = tempip.CombineMask (tempmask);
 
 //
 // Here's why we did all of that work.  We're going to add a host route to the
@@ -1625,42 +2282,31 @@ GlobalRouteManagerImpl::SPFAddASExternal (GlobalRoutingLSA *extlsa, SPFVertex *v
 // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
 // which the packets should be send for forwarding.
 //
-          Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-          if (router == 0)
-            {
-              continue;
-            }
-          Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-          NS_ASSERT (gr);
-          // walk through all next-hop-IPs and out-going-interfaces for reaching
-          // the stub network gateway 'v' from the root node
-          for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-            {
-              SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-              Ipv4Address nextHop = exit.first;
-              int32_t outIf = exit.second;
-              if (outIf >= 0)
-                {
-                  gr->AddASExternalRouteTo (tempip, tempmask, nextHop, outIf);
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " add external network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " via interface " << outIf);
-                }
-              else
-                {
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " NOT able to add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " since outgoing interface id is negative");
-                }
-            }
-          return;
-        } // if
-    } // for
+  // walk through all next-hop-IPs and out-going-interfaces for reaching
+  // the stub network gateway 'v' from the root node
+  for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
+    {
+      SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
+      Ipv4Address nextHop = exit.first;
+      int32_t outIf = exit.second;
+      if (outIf >= 0)
+        {
+          m_spfRouting->AddASExternalRouteTo (tempip, tempmask, nextHop, outIf);
+          NS_LOG_LOGIC ("(Route " << i << ") Node " << m_spfNode->GetId () <<
+                        " add external network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " via interface " << outIf);
+        }
+      else
+        {
+          NS_LOG_LOGIC ("(Route " << i << ") Node " << m_spfNode->GetId () <<
+                        " NOT able to add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " since outgoing interface id is negative");
+        }
+    }
 }
 
-
 // Processing logic from RFC 2328, page 166 and quagga ospf_spf_process_stubs ()
 // stub link records will exist for point-to-point interfaces and for
 // broadcast interfaces for which no neighboring router can be found
@@ -1720,68 +2366,30 @@ GlobalRouteManagerImpl::SPFIntraAddStub (GlobalRoutingLinkRecord *l, SPFVertex*
 //
 // The root of the Shortest Path First tree is the router to which we are 
 // going to write the actual routing table entries.  The vertex corresponding
-// to this router has a vertex ID which is the router ID of that node.  We're
-// going to use this ID to discover which node it is that we're actually going
-// to update.
+// to this router has a vertex ID which is the router ID of that node.  The
+// node with this ID was found when the calculation started.
 //
   Ipv4Address routerId = m_spfroot->GetVertexId ();
 
   NS_LOG_LOGIC ("Vertex ID = " << routerId);
-//
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
-//
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  if (!m_spfRouting)
     {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to QI for that interface.  If there's no GlobalRouter interface, the node
-// in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
-
-      if (rtr == 0)
-        {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << 
-                        node->GetId ());
-          continue;
-        }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
-        {
-          NS_LOG_LOGIC ("Setting routes for node " << node->GetId ());
-//
-// Routing information is updated using the Ipv4 interface.  We need to QI
-// for that interface.  If the node is acting as an IP version 4 router, it
-// should absolutely have an Ipv4 interface.
-//
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "QI for <Ipv4> interface failed");
+      NS_LOG_LOGIC ("No node for router " << routerId);
+      return;
+    }
+  NS_LOG_LOGIC ("Setting routes for node " << m_spfNode->GetId ());
 //
 // Get the Global Router Link State Advertisement from the vertex we're
 // adding the routes to.  The LSA will have a number of attached Global Router
 // Link Records corresponding to links off of that vertex / node.  We're going
 // to be interested in the records corresponding to point-to-point links.
 //
-          NS_ASSERT_MSG (v->GetLSA (), 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "Expected valid LSA in SPFVertex* v");
-          Ipv4Mask tempmask (l->GetLinkData ().Get ());
-          Ipv4Address tempip = l->GetLinkId ();
-          tempip = tempip.CombineMask (tempmask);
+  NS_ASSERT_MSG (v->GetLSA (), 
+                 "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                 "Expected valid LSA in SPFVertex* v");
+  Ipv4Mask tempmask (l->GetLinkData ().Get ());
+  Ipv4Address tempip = l->GetLinkId ();
+  tempip = tempip.CombineMask (tempmask);
 //
 // Here's why we did all of that work.  We're going to add a host route to the
 // host address found in the m_linkData field of the point-to-point link
@@ -1795,40 +2403,29 @@ GlobalRouteManagerImpl::SPFIntraAddStub (GlobalRoutingLinkRecord *l, SPFVertex*
 // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
 // which the packets should be send for forwarding.
 //
-
-          Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-          if (router == 0)
-            {
-              continue;
-            }
-          Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-          NS_ASSERT (gr);
-          // walk through all next-hop-IPs and out-going-interfaces for reaching
-          // the stub network gateway 'v' from the root node
-          for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-            {
-              SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-              Ipv4Address nextHop = exit.first;
-              int32_t outIf = exit.second;
-              if (outIf >= 0)
-                {
-                  gr->AddNetworkRouteTo (tempip, tempmask, nextHop, outIf);
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " via interface " << outIf);
-                }
-              else
-                {
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " NOT able to add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " since outgoing interface id is negative");
-                }
-            }
-          return;
-        } // if
-    } // for
+  // walk through all next-hop-IPs and out-going-interfaces for reaching
+  // the stub network gateway 'v' from the root node
+  for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
+    {
+      SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
+      Ipv4Address nextHop = exit.first;
+      int32_t outIf = exit.second;
+      if (outIf >= 0)
+        {
+          m_spfRouting->AddNetworkRouteTo (tempip, tempmask, nextHop, outIf);
+          NS_LOG_LOGIC ("(Route " << i << ") Node " << m_spfNode->GetId () <<
+                        " add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " via interface " << outIf);
+        }
+      else
+        {
+          NS_LOG_LOGIC ("(Route " << i << ") Node " << m_spfNode->GetId () <<
+                        " NOT able to add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " since outgoing interface id is negative");
+        }
+    }
 }
 
 //
@@ -1843,70 +2440,30 @@ GlobalRouteManagerImpl::FindOutgoingInterfaceId (Ipv4Address a, Ipv4Mask amask)
 {
   NS_LOG_FUNCTION (this << a << amask);
 //
-// We have an IP address <a> and a vertex ID of the root of the SPF tree.
-// The question is what interface index does this address correspond to.
-// The answer is a little complicated since we have to find a pointer to
-// the node corresponding to the vertex ID, find the Ipv4 interface on that
-// node in order to iterate the interfaces and find the one corresponding to
-// the address in question.
-//
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-//
-// Walk the list of nodes in the system looking for the one corresponding to
-// the node at the root of the SPF tree.  This is the node for which we are
-// building the routing table.
+// We have an IP address <a> and the Ipv4 of the node at the root of the SPF
+// tree, found when the calculation started.  This is the node for which we
+// are building the routing table.
 //
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  if (!m_spfIpv4)
     {
-      Ptr<Node> node = *i;
-
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
-//
-// If the node doesn't have a GlobalRouter interface it can't be the one
-// we're interested in.
-//
-      if (rtr == 0)
-        {
-          continue;
-        }
-
-      if (rtr->GetRouterId () == routerId)
-        {
-//
-// This is the node we're building the routing table for.  We're going to need
-// the Ipv4 interface to look for the ipv4 interface index.  Since this node
-// is participating in routing IP version 4 packets, it certainly must have 
-// an Ipv4 interface.
-//
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::FindOutgoingInterfaceId (): "
-                         "GetObject for <Ipv4> interface failed");
+      NS_LOG_LOGIC ("FindOutgoingInterfaceId():Can't find root node " << m_spfroot->GetVertexId ());
+      return -1;
+    }
 //
 // Look through the interfaces on this node for one that has the IP address
 // we're looking for.  If we find one, return the corresponding interface
 // index, or -1 if not found.
 //
-          int32_t interface = ipv4->GetInterfaceForPrefix (a, amask);
+  int32_t interface = m_spfIpv4->GetInterfaceForPrefix (a, amask);
 
 #if 0
-          if (interface < 0)
-            {
-              NS_FATAL_ERROR ("GlobalRouteManagerImpl::FindOutgoingInterfaceId(): "
-                              "Expected an interface associated with address a:" << a);
-            }
-#endif 
-          return interface;
-        }
+  if (interface < 0)
+    {
+      NS_FATAL_ERROR ("GlobalRouteManagerImpl::FindOutgoingInterfaceId(): "
+                      "Expected an interface associated with address a:" << a);
     }
-//
-// Couldn't find it.
-//
-  NS_LOG_LOGIC ("FindOutgoingInterfaceId():Can't find root node " << routerId);
-  return -1;
+#endif 
+  return interface;
 }
 
 //
@@ -1935,68 +2492,30 @@ GlobalRouteManagerImpl::SPFIntraAddRouter (SPFVertex* v)
 //
 // The root of the Shortest Path First tree is the router to which we are 
 // going to write the actual routing table entries.  The vertex corresponding
-// to this router has a vertex ID which is the router ID of that node.  We're
-// going to use this ID to discover which node it is that we're actually going
-// to update.
+// to this router has a vertex ID which is the router ID of that node.  The
+// node with this ID was found when the calculation started.
 //
   Ipv4Address routerId = m_spfroot->GetVertexId ();
 
   NS_LOG_LOGIC ("Vertex ID = " << routerId);
-//
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
-//
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  if (!m_spfRouting)
     {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to GetObject for that interface.  If there's no GlobalRouter interface, 
-// the node in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
-
-      if (rtr == 0)
-        {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << 
-                        node->GetId ());
-          continue;
-        }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
-        {
-          NS_LOG_LOGIC ("Setting routes for node " << node->GetId ());
-//
-// Routing information is updated using the Ipv4 interface.  We need to 
-// GetObject for that interface.  If the node is acting as an IP version 4 
-// router, it should absolutely have an Ipv4 interface.
-//
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "GetObject for <Ipv4> interface failed");
+      NS_LOG_LOGIC ("No node for router " << routerId);
+      return;
+    }
+  NS_LOG_LOGIC ("Setting routes for node " << m_spfNode->GetId ());
 //
 // Get the Global Router Link State Advertisement from the vertex we're
 // adding the routes to.  The LSA will have a number of attached Global Router
 // Link Records corresponding to links off of that vertex / node.  We're going
 // to be interested in the records corresponding to point-to-point links.
 //
-          GlobalRoutingLSA *lsa = v->GetLSA ();
-          NS_ASSERT_MSG (lsa, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "Expected valid LSA in SPFVertex* v");
+  GlobalRoutingLSA *lsa = v->GetLSA ();
+  NS_ASSERT_MSG (lsa, 
+                 "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                 "Expected valid LSA in SPFVertex* v");
 
-          uint32_t nLinkRecords = lsa->GetNLinkRecords ();
+  uint32_t nLinkRecords = lsa->GetNLinkRecords ();
 //
 // Iterate through the link records on the vertex to which we're going to add
 // routes.  To make sure we're being clear, we're going to add routing table
@@ -2005,18 +2524,18 @@ GlobalRouteManagerImpl::SPFIntraAddRouter (SPFVertex* v)
 // the local side of the point-to-point links found on the node described by
 // the vertex <v>.
 //
-          NS_LOG_LOGIC (" Node " << node->GetId () <<
-                        " found " << nLinkRecords << " link records in LSA " << lsa << "with LinkStateId "<< lsa->GetLinkStateId ());
-          for (uint32_t j = 0; j < nLinkRecords; ++j)
-            {
+  NS_LOG_LOGIC (" Node " << m_spfNode->GetId () <<
+                " found " << nLinkRecords << " link records in LSA " << lsa << "with LinkStateId "<< lsa->GetLinkStateId ());
+  for (uint32_t j = 0; j < nLinkRecords; ++j)
+    {
 //
 // We are only concerned about point-to-point links
 //
-              GlobalRoutingLinkRecord *lr = lsa->GetLinkRecord (j);
-              if (lr->GetLinkType () != GlobalRoutingLinkRecord::PointToPoint)
-                {
-                  continue;
-                }
+      GlobalRoutingLinkRecord *lr = lsa->GetLinkRecord (j);
+      if (lr->GetLinkType () != GlobalRoutingLinkRecord::PointToPoint)
+        {
+          continue;
+        }
 //
 // Here's why we did all of that work.  We're going to add a host route to the
 // host address found in the m_linkData field of the point-to-point link
@@ -2030,44 +2549,31 @@ GlobalRouteManagerImpl::SPFIntraAddRouter (SPFVertex* v)
 // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
 // which the packets should be send for forwarding.
 //
-              Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-              if (router == 0)
-                {
-                  continue;
-                }
-              Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-              NS_ASSERT (gr);
-              // walk through all available exit directions due to ECMP,
-              // and add host route for each of the exit direction toward
-              // the vertex 'v'
-              for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-                {
-                  SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-                  Ipv4Address nextHop = exit.first;
-                  int32_t outIf = exit.second;
-                  if (outIf >= 0)
-                    {
-                      gr->AddHostRouteTo (lr->GetLinkData (), nextHop,
-                                          outIf);
-                      NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                    " adding host route to " << lr->GetLinkData () <<
-                                    " using next hop " << nextHop <<
-                                    " and outgoing interface " << outIf);
-                    }
-                  else
-                    {
-                      NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                    " NOT able to add host route to " << lr->GetLinkData () <<
-                                    " using next hop " << nextHop <<
-                                    " since outgoing interface id is negative " << outIf);
-                    }
-                } // for all routes from the root the vertex 'v'
+      // walk through all available exit directions due to ECMP,
+      // and add host route for each of the exit direction toward
+      // the vertex 'v'
+      for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
+        {
+          SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
+          Ipv4Address nextHop = exit.first;
+          int32_t outIf = exit.second;
+          if (outIf >= 0)
+            {
+              m_spfRouting->AddHostRouteTo (lr->GetLinkData (), nextHop,
+                                            outIf);
+              NS_LOG_LOGIC ("(Route " << i << ") Node " << m_spfNode->GetId () <<
+                            " adding host route to " << lr->GetLinkData () <<
+                            " using next hop " << nextHop <<
+                            " and outgoing interface " << outIf);
             }
-//
-// Done adding the routes for the selected node.
-//
-          return;
-        }
+          else
+            {
+              NS_LOG_LOGIC ("(Route " << i << ") Node " << m_spfNode->GetId () <<
+                            " NOT able to add host route to " << lr->GetLinkData () <<
+                            " using next hop " << nextHop <<
+                            " since outgoing interface id is negative " << outIf);
+            }
+        } // for all routes from the root the vertex 'v'
     }
 }
 void
@@ -2080,103 +2586,56 @@ GlobalRouteManagerImpl::SPFIntraAddTransit (SPFVertex* v)
 //
 // The root of the Shortest Path First tree is the router to which we are 
 // going to write the actual routing table entries.  The vertex corresponding
-// to this router has a vertex ID which is the router ID of that node.  We're
-// going to use this ID to discover which node it is that we're actually going
-// to update.
+// to this router has a vertex ID which is the router ID of that node.  The
+// node with this ID was found when the calculation started.
 //
   Ipv4Address routerId = m_spfroot->GetVertexId ();
 
   NS_LOG_LOGIC ("Vertex ID = " << routerId);
-//
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
-//
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  if (!m_spfRouting)
     {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to GetObject for that interface.  If there's no GlobalRouter interface, 
-// the node in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
-
-      if (rtr == 0)
-        {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << 
-                        node->GetId ());
-          continue;
-        }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
-        {
-          NS_LOG_LOGIC ("setting routes for node " << node->GetId ());
-//
-// Routing information is updated using the Ipv4 interface.  We need to 
-// GetObject for that interface.  If the node is acting as an IP version 4 
-// router, it should absolutely have an Ipv4 interface.
-//
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                         "GetObject for <Ipv4> interface failed");
+      NS_LOG_LOGIC ("No node for router " << routerId);
+      return;
+    }
+  NS_LOG_LOGIC ("setting routes for node " << m_spfNode->GetId ());
 //
 // Get the Global Router Link State Advertisement from the vertex we're
 // adding the routes to.  The LSA will have a number of attached Global Router
 // Link Records corresponding to links off of that vertex / node.  We're going
 // to be interested in the records corresponding to point-to-point links.
 //
-          GlobalRoutingLSA *lsa = v->GetLSA ();
-          NS_ASSERT_MSG (lsa, 
-                         "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                         "Expected valid LSA in SPFVertex* v");
-          Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask ();
-          Ipv4Address tempip = lsa->GetLinkStateId ();
-          tempip = tempip.CombineMask (tempmask);
-          Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-          if (router == 0)
-            {
-              continue;
-            }
-          Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-          NS_ASSERT (gr);
-          // walk through all available exit directions due to ECMP,
-          // and add host route for each of the exit direction toward
-          // the vertex 'v'
-          for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-            {
-              SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-              Ipv4Address nextHop = exit.first;
-              int32_t outIf = exit.second;
+  GlobalRoutingLSA *lsa = v->GetLSA ();
+  NS_ASSERT_MSG (lsa, 
+                 "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
+                 "Expected valid LSA in SPFVertex* v");
+  Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask ();
+  Ipv4Address tempip = lsa->GetLinkStateId ();
+  tempip = tempip.CombineMask (tempmask);
+  // walk through all available exit directions due to ECMP,
+  // and add host route for each of the exit direction toward
+  // the vertex 'v'
+  for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
+    {
+      SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
+      Ipv4Address nextHop = exit.first;
+      int32_t outIf = exit.second;
 
-              if (outIf >= 0)
-                {
-                  gr->AddNetworkRouteTo (tempip, tempmask, nextHop, outIf);
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " via interface " << outIf);
-                }
-              else
-                {
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " NOT able to add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " since outgoing interface id is negative " << outIf);
-                }
-            }
+      if (outIf >= 0)
+        {
+          m_spfRouting->AddNetworkRouteTo (tempip, tempmask, nextHop, outIf);
+          NS_LOG_LOGIC ("(Route " << i << ") Node " << m_spfNode->GetId () <<
+                        " add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " via interface " << outIf);
         }
-    } 
+      else
+        {
+          NS_LOG_LOGIC ("(Route " << i << ") Node " << m_spfNode->GetId () <<
+                        " NOT able to add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " since outgoing interface id is negative " << outIf);
+        }
+    }
 }
 
 // Derived from quagga ospf_vertex_add_parents ()
@@ -27,6 +27,8 @@
 #include <queue>
 #include <map>
 #include <vector>
+#include <atomic>
+#include <unordered_map>
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 #include "ns3/ipv4-address.h"
@@ -38,6 +40,8 @@ const uint32_t SPF_INFINITY = 0xffffffff; //!< "infinite" distance between nodes
 
 class CandidateQueue;
 class Ipv4GlobalRouting;
+class Ipv4;
+class Node;
 
 /**
  * \ingroup globalrouting
@@ -674,12 +678,64 @@ public:
    */
   uint32_t GetNumExtLSAs () const;
 
+  /**
+   * @brief A link from a Router-LSA or Network-LSA to another vertex of
+   * the SPF graph, as SPF follows it.
+   */
+  struct TransitLink
+  {
+    Ipv4Address target; //!< Link State ID of the LSA at the other end
+    Ipv4Address data; //!< Link Data, or address of the attached router
+    uint32_t metric; //!< cost of the link
+    uint32_t type; //!< link record type, 0 for the links of a Network-LSA
+    /**
+     * @brief Compare two links
+     * @param other the other link
+     * @returns true if both links are the same
+     */
+    bool operator== (const TransitLink& other) const
+    {
+      return target == other.target && data == other.data &&
+             metric == other.metric && type == other.type;
+    }
+  };
+
+  /**
+   * @brief Get the transit links of an LSA of this database.
+   *
+   * For a Router-LSA these are its point-to-point and transit network link
+   * records; for a Network-LSA, its attached routers that can be found by
+   * GetLSAByLinkData (), at cost 0.
+   *
+   * @param lsa the LSA
+   * @param links receives the links, in the order SPF examines them
+   */
+  void GetTransitLinks (const GlobalRoutingLSA* lsa, std::vector<TransitLink>& links) const;
+
+  /// Changed LSAs by Link State ID, with whether their transit links changed
+  typedef std::unordered_map<Ipv4Address, bool, Ipv4AddressHash> ChangedLSAs_t;
+
+  /**
+   * @brief Compare this database with an earlier one.
+   *
+   * An LSA has changed if it was added or removed, if it advertises
+   * something else, or if one of its transit links (see GetTransitLinks ())
+   * leads elsewhere.
+   *
+   * @param previous the earlier database
+   * @param changed receives the changed LSAs
+   * @returns true if the External LSAs differ
+   */
+  bool FindChanges (const GlobalRouteManagerLSDB& previous, ChangedLSAs_t& changed) const;
 
 private:
   typedef std::map<Ipv4Address, GlobalRoutingLSA*> LSDBMap_t; //!< container of IPv4 addresses / Link State Advertisements
   typedef std::pair<Ipv4Address, GlobalRoutingLSA*> LSDBPair_t; //!< pair of IPv4 addresses / Link State Advertisements
+  /// container of Link Data of TransitNetwork link records / IPv4 addresses and Link State Advertisements
+  typedef std::unordered_map<Ipv4Address, LSDBPair_t, Ipv4AddressHash> LinkDataMap_t;
 
   LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
+  LinkDataMap_t m_linkData; //!< Link State Advertisements by the Link Data of their TransitNetwork link records
   std::vector<GlobalRoutingLSA*> m_extdatabase; //!< database of External Link State Advertisements
 
 /**
@@ -708,6 +764,13 @@ private:
  * and finally configure each of the node's forwarding tables.
  *
  * The design is guided by OSPFv2 \RFC{2328} section 16.1.1 and quagga ospfd.
+ *
+ * The SPF calculations of the different routers only read the LSDB and
+ * write to the routing table of their root, so InitializeRoutes runs them
+ * on a pool of threads (see the GlobalValue "GlobalRoutingSpfThreads").
+ *
+ * The shortest path tree of each router is kept after its calculation, so
+ * that UpdateRoutes can tell which routers a change of topology affects.
  */
 class GlobalRouteManagerImpl
 {
@@ -735,6 +798,19 @@ public:
  */
   virtual void InitializeRoutes ();
 
+/**
+ * @brief Bring the routes up to date after a change of topology.
+ *
+ * The LSDB is built again and compared with the previous one.  The routes
+ * of a router are left alone when none of the changed LSAs was read by its
+ * last SPF calculation.  When some were but its shortest path tree keeps
+ * the same shape, the routes are written again from that tree; otherwise
+ * SPF runs again for this router.  The routes end up the same as after
+ * DeleteGlobalRoutes (), BuildGlobalRoutingDatabase () and
+ * InitializeRoutes ().
+ */
+  virtual void UpdateRoutes ();
+
 /**
  * @brief Debugging routine; allow client code to supply a pre-built LSDB
  * @param lsdb the pre-built LSDB
@@ -748,6 +824,13 @@ public:
   void DebugSPFCalculate (Ipv4Address root);
 
 private:
+/**
+ * @brief Create a worker running SPF calculations on the LSDB of
+ * another GlobalRouteManagerImpl.
+ * @param lsdb the LSDB, not owned by the worker
+ */
+  GlobalRouteManagerImpl (GlobalRouteManagerLSDB* lsdb);
+
 /**
  * @brief GlobalRouteManagerImpl copy construction is disallowed.
  * There's no  need for it and a compiler provided shallow copy would be 
@@ -767,8 +850,165 @@ private:
  */
   GlobalRouteManagerImpl& operator= (GlobalRouteManagerImpl& srmi);
 
+  /// A vertex of a shortest path tree kept after its SPF calculation
+  struct SPFTreeVertex
+  {
+    Ipv4Address id; //!< vertex ID
+    uint32_t distance; //!< distance from the root
+    uint32_t parents; //!< index of the first parent in SPFResult::parents
+    uint32_t nParents; //!< number of parents
+    uint32_t exits; //!< index of the first exit direction in SPFResult::exits
+    uint32_t nExits; //!< number of root exit directions
+  };
+
+  /// What an SPF calculation read and built, as needed by UpdateRoutes ()
+  struct SPFResult
+  {
+    bool stub; //!< whether CheckForStubNode () cut the calculation short
+    std::vector<uint32_t> interfaces; //!< state of the interfaces of the root, see GetInterfaceState ()
+    std::vector<SPFTreeVertex> tree; //!< vertices in the order they joined the tree, root first
+    std::vector<uint32_t> parents; //!< tree indices of the parents of the vertices
+    std::vector<SPFVertex::NodeExit_t> exits; //!< root exit directions of the vertices
+    /// tree indices by vertex ID, sorted; LSAs read without joining the tree have SPF_INFINITY
+    std::vector<std::pair<Ipv4Address, uint32_t> > index;
+  };
+
+  /// A root router of the SPF calculations
+  struct SPFRoot
+  {
+    Ipv4Address routerId; //!< router ID
+    Ptr<Node> node; //!< node of the router
+    const SPFResult *replay; //!< tree whose routes are written again, or 0 to run SPF
+    SPFResult result; //!< what the SPF calculation recorded
+  };
+
+  /// root routers of the SPF calculations
+  typedef std::vector<SPFRoot> SPFRoots_t;
+  /// last SPF calculation of each router, by router ID
+  typedef std::unordered_map<Ipv4Address, SPFResult, Ipv4AddressHash> SPFResults_t;
+
   SPFVertex* m_spfroot; //!< the root node
   GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
+  bool m_ownsLsdb; //!< whether m_lsdb is deleted with this object
+
+  Ptr<Node> m_spfNode; //!< the node of the root router, if any
+  Ptr<Ipv4> m_spfIpv4; //!< the Ipv4 of the root router
+  Ptr<Ipv4GlobalRouting> m_spfRouting; //!< the routing protocol receiving the routes of the SPF calculation
+  std::unordered_map<const GlobalRoutingLSA *, GlobalRoutingLSA::SPFStatus> m_lsaStatus; //!< status of the LSAs in the SPF calculation
+
+  SPFRoots_t *m_spfRoots; //!< root routers shared with the other workers
+  std::atomic<uint32_t> *m_spfNextRoot; //!< index of the next root router to calculate
+
+  SPFResults_t m_spfResults; //!< last SPF calculation of each router
+  SPFResult m_spfResult; //!< what the current SPF calculation read and built
+  std::unordered_map<const SPFVertex *, uint32_t> m_spfTreeIndex; //!< tree indices of the vertices of the current SPF calculation
+
+  /**
+   * \brief Find the routers whose routes are calculated here.
+   * \param roots receives the routers, set to run SPF
+   */
+  void GetRoots (SPFRoots_t& roots) const;
+
+  /**
+   * \brief Run the SPF calculations of some routers on the thread pool,
+   * and keep what they recorded.
+   * \param roots the routers
+   */
+  void RunSPF (SPFRoots_t& roots);
+
+  /**
+   * \brief Delete all of the routes of a router.
+   * \param node the node of the router
+   */
+  void DeleteRoutes (Ptr<Node> node) const;
+
+  /**
+   * \brief Summarize the interfaces of a node: whether they are up, and
+   * their addresses.
+   * \param ipv4 the Ipv4 of the node
+   * \param state receives the summary
+   */
+  static void GetInterfaceState (Ptr<Ipv4> ipv4, std::vector<uint32_t>& state);
+
+  /**
+   * \brief Find a vertex among what an SPF calculation read.
+   * \param result the SPF calculation
+   * \param id the vertex ID
+   * \param index receives the tree index, or SPF_INFINITY if the LSA was
+   * read but did not join the tree
+   * \returns true if the calculation read the LSA
+   */
+  static bool FindTreeIndex (const SPFResult& result, Ipv4Address id, uint32_t& index);
+
+  /**
+   * \brief Check whether a shortest path tree keeps its shape after the
+   * transit links of one of its vertices changed.
+   *
+   * The tree stays valid if no link between a vertex and one of its
+   * parents went away or changed, and if no new link gives a path as short
+   * as or shorter than the tree to a vertex.  Any other change of the
+   * links to vertices in the tree does not alter which vertices join it,
+   * nor in which order.
+   *
+   * \param result the SPF calculation that built the tree
+   * \param index the tree index of the changed vertex
+   * \param previous the LSDB the tree was built from
+   * \returns true if the tree is still a shortest path tree
+   */
+  bool SPFTreeKeeps (const SPFResult& result, uint32_t index, const GlobalRouteManagerLSDB& previous) const;
+
+  /**
+   * \brief Write the routes of a router again from its last shortest path
+   * tree, with the LSAs of the current LSDB.
+   * \param node the node of the router
+   * \param result the SPF calculation that built the tree
+   */
+  void SPFReplay (Ptr<Node> node, const SPFResult& result);
+
+  /**
+   * \brief Record a vertex that joined the tree of the current calculation.
+   * \param v the vertex
+   */
+  void SPFRecordVertex (SPFVertex* v);
+
+  /**
+   * \brief Set the node the current calculation writes its routes to.
+   * \param node the node, or 0
+   */
+  void SetSPFNode (Ptr<Node> node);
+
+  /**
+   * \brief Second stage of the SPF calculation: add the routes to the stub
+   * networks and the AS external routes of the tree rooted at m_spfroot.
+   */
+  void SPFAddLeaves (void);
+
+  /**
+   * \brief Find the node of a router.
+   * \param routerId the router ID
+   * \returns the node, or 0 if no node has this router ID
+   */
+  Ptr<Node> FindRootNode (Ipv4Address routerId) const;
+
+  /**
+   * \brief Get the status of an LSA in the current SPF calculation.
+   * \param lsa the LSA
+   * \returns the status
+   */
+  GlobalRoutingLSA::SPFStatus GetLSAStatus (const GlobalRoutingLSA *lsa) const;
+
+  /**
+   * \brief Set the status of an LSA in the current SPF calculation.
+   * \param lsa the LSA
+   * \param status the status
+   */
+  void SetLSAStatus (const GlobalRoutingLSA *lsa, GlobalRoutingLSA::SPFStatus status);
+
+  /**
+   * \brief Run the SPF calculations of the root routers not taken yet
+   * by another worker.
+   */
+  void SPFCalculateRoots (void);
 
   /**
    * \brief Test if a node is a stub, from an OSPF sense.
@@ -790,6 +1030,17 @@ private:
    */
   void SPFCalculate (Ipv4Address root);
 
+  /**
+   * \brief Calculate the shortest path first (SPF) tree
+   *
+   * Only the node given, and no other, is accessed, so that calculations
+   * with different roots can run in parallel.
+   *
+   * \param root the root node
+   * \param node the node of the root router, or 0 if none
+   */
+  void SPFCalculate (Ipv4Address root, Ptr<Node> node);
+
   /**
    * \brief Process Stub nodes
    *
@@ -936,9 +1187,8 @@ private:
   /**
    * \brief Return the interface number corresponding to a given IP address and mask
    *
-   * This is a wrapper around GetInterfaceForPrefix(), but we first
-   * have to find the right node pointer to pass to that function.
-   * If no such interface is found, return -1 (note:  unit test framework
+   * This is a wrapper around GetInterfaceForPrefix() on the Ipv4 of the
+   * root of the SPF calculation.  If no such interface is found, return -1 (note:  unit test framework
    * for routing assumes -1 to be a legal return value)
    *
    * \param a the target IP address
@@ -65,6 +65,13 @@ public:
  */
   static void InitializeRoutes ();
 
+/**
+ * @brief Bring the routes computed by InitializeRoutes () up to date with
+ * the topology, recomputing only the routes of the routers that a change
+ * affects.
+ */
+  static void UpdateRoutes ();
+
 private:
 /**
  * @brief Global Route Manager copy construction is disallowed.  There's no 
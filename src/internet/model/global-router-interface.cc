@@ -262,15 +262,9 @@ GlobalRoutingLinkRecord *
 GlobalRoutingLSA::GetLinkRecord (uint32_t n) const
 {
   NS_LOG_FUNCTION (this << n);
-  uint32_t j = 0;
-  for ( ListOfLinkRecords_t::const_iterator i = m_linkRecords.begin ();
-        i != m_linkRecords.end (); 
-        i++, j++)
+  if (n < m_linkRecords.size ())
     {
-      if (j == n) 
-        {
-          return *i;
-        }
+      return m_linkRecords[n];
     }
   NS_ASSERT_MSG (false, "GlobalRoutingLSA::GetLinkRecord (): invalid index");
   return 0;
@@ -283,6 +277,32 @@ GlobalRoutingLSA::IsEmpty (void) const
   return m_linkRecords.size () == 0;
 }
 
+bool
+GlobalRoutingLSA::IsEquivalent (const GlobalRoutingLSA& lsa) const
+{
+  NS_LOG_FUNCTION (this << &lsa);
+  if (m_lsType != lsa.m_lsType || m_linkStateId != lsa.m_linkStateId ||
+      m_advertisingRtr != lsa.m_advertisingRtr ||
+      m_networkLSANetworkMask != lsa.m_networkLSANetworkMask ||
+      m_node_id != lsa.m_node_id ||
+      m_linkRecords.size () != lsa.m_linkRecords.size () ||
+      m_attachedRouters != lsa.m_attachedRouters)
+    {
+      return false;
+    }
+  for (uint32_t i = 0; i < m_linkRecords.size (); i++)
+    {
+      GlobalRoutingLinkRecord *a = m_linkRecords[i];
+      GlobalRoutingLinkRecord *b = lsa.m_linkRecords[i];
+      if (a->GetLinkType () != b->GetLinkType () || a->GetLinkId () != b->GetLinkId () ||
+          a->GetLinkData () != b->GetLinkData () || a->GetMetric () != b->GetMetric ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
 GlobalRoutingLSA::LSType
 GlobalRoutingLSA::GetLSType (void) const
 {
@@ -365,15 +385,9 @@ Ipv4Address
 GlobalRoutingLSA::GetAttachedRouter (uint32_t n) const
 {
   NS_LOG_FUNCTION (this << n);
-  uint32_t j = 0;
-  for ( ListOfAttachedRouters_t::const_iterator i = m_attachedRouters.begin ();
-        i != m_attachedRouters.end (); 
-        i++, j++)
+  if (n < m_attachedRouters.size ())
     {
-      if (j == n) 
-        {
-          return *i;
-        }
+      return m_attachedRouters[n];
     }
   NS_ASSERT_MSG (false, "GlobalRoutingLSA::GetAttachedRouter (): invalid index");
   return Ipv4Address ("0.0.0.0");
@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 #include <list>
+#include <vector>
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 #include "ns3/node.h"
@@ -375,6 +376,18 @@ public:
  */
   bool IsEmpty (void) const;
 
+/**
+ * @brief Check whether another Global Routing Link State Advertisement
+ * advertises the same thing as this one.
+ *
+ * The SPF status is not compared.
+ *
+ * @param lsa The LSA to compare with.
+ * @returns True if the type, IDs, mask, link records, attached routers and
+ * node are the same, false otherwise.
+ */
+  bool IsEquivalent (const GlobalRoutingLSA& lsa) const;
+
 /**
  * @brief Print the contents of the Global Routing Link State Advertisement and
  * any Global Routing Link Records present in the list.  Quite verbose.
@@ -524,14 +537,14 @@ private:
 /**
  * A convenience typedef to avoid too much writers cramp.
  */
-  typedef std::list<GlobalRoutingLinkRecord*> ListOfLinkRecords_t;
+  typedef std::vector<GlobalRoutingLinkRecord*> ListOfLinkRecords_t;
 
 /**
  * Each Link State Advertisement contains a number of Link Records that
  * describe the kinds of links that are attached to a given node.  We 
  * consider PointToPoint and StubNetwork links.
  *
- * m_linkRecords is an STL list container to hold the Link Records that have
+ * m_linkRecords is an STL vector container to hold the Link Records that have
  * been discovered and prepared for the advertisement.
  *
  * @see GlobalRouting::DiscoverLSAs ()
@@ -546,12 +559,12 @@ private:
 /**
  * A convenience typedef to avoid too much writers cramp.
  */
-  typedef std::list<Ipv4Address> ListOfAttachedRouters_t;
+  typedef std::vector<Ipv4Address> ListOfAttachedRouters_t;
 
 /**
  * Each Network LSA contains a list of attached routers
  *
- * m_attachedRouters is an STL list container to hold the addresses that have
+ * m_attachedRouters is an STL vector container to hold the addresses that have
  * been discovered and prepared for the advertisement.
  *
  * @see GlobalRouting::DiscoverLSAs ()
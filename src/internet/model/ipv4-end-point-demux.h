@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 #include <list>
+#include <unordered_map>
 #include "ns3/ipv4-address.h"
 #include "ipv4-interface.h"
 
@@ -40,6 +41,15 @@ class Ipv4EndPoint;
  * of endpoints, and has APIs to add and find endpoints in this demux.  This
  * code is shared in common to TCP and UDP protocols in ns3.  This demux
  * sits between ns3's layer four and the socket layer
+ *
+ * Besides the list of all the endpoints, the demux keeps hash indexes so
+ * that a lookup does not depend on the number of endpoints: endpoints with
+ * a fully specified peer (e.g., connected TCP sockets) are indexed by local
+ * port and peer address and port, while the others (e.g., listening sockets)
+ * are indexed by local port only, and act as the wildcard fallback. The
+ * local address is not part of the index, since the sockets may change it
+ * after the allocation; the few endpoints found in a bucket are then
+ * matched as before.
  */
 
 class Ipv4EndPointDemux {
@@ -166,6 +176,45 @@ public:
   void DeAllocate (Ipv4EndPoint *endPoint);
 
 private:
+  friend class Ipv4EndPoint;
+
+  /**
+   * \brief Add an end point to the containers and indexes.
+   * \param endPoint the end point
+   * \return the end point
+   */
+  Ipv4EndPoint *Insert (Ipv4EndPoint *endPoint);
+
+  /**
+   * \brief Remove an end point from the containers and indexes.
+   * \param endPoint the end point
+   */
+  void Erase (Ipv4EndPoint *endPoint);
+
+  /**
+   * \brief Get the peer index bucket of an end point, creating it if needed.
+   *
+   * End points with a fully specified peer are in the bucket of their local
+   * port and peer; the others in the bucket of their local port.
+   *
+   * \param localPort local port
+   * \param peerAddress peer address
+   * \param peerPort peer port
+   * \return the bucket
+   */
+  EndPoints &GetPeerBucket (uint16_t localPort, Ipv4Address peerAddress, uint16_t peerPort);
+
+  /**
+   * \brief Index an end point according to its peer.
+   * \param endPoint the end point
+   */
+  void IndexPeer (Ipv4EndPoint *endPoint);
+
+  /**
+   * \brief Remove an end point from the peer index.
+   * \param endPoint the end point
+   */
+  void UnindexPeer (Ipv4EndPoint *endPoint);
 
   /**
    * \brief Allocate an ephemeral port.
@@ -192,6 +241,71 @@ private:
    * \brief A list of IPv4 end points.
    */
   EndPoints m_endPoints;
+
+  /**
+   * \brief Local port and peer of an end point with a fully specified peer.
+   */
+  struct PeerKey
+  {
+    uint16_t localPort;      //!< Local port
+    Ipv4Address peerAddress; //!< Peer address
+    uint16_t peerPort;       //!< Peer port
+
+    /**
+     * \brief Equality operator.
+     * \param o the other key
+     * \return true if the keys are equal
+     */
+    bool operator== (const PeerKey &o) const
+    {
+      return localPort == o.localPort && peerPort == o.peerPort && peerAddress == o.peerAddress;
+    }
+  };
+
+  /**
+   * \brief Hash function for PeerKey.
+   */
+  struct PeerKeyHash
+  {
+    /**
+     * \brief Hash a key.
+     * \param key the key
+     * \return the hash
+     */
+    size_t operator() (const PeerKey &key) const
+    {
+      return Ipv4AddressHash () (key.peerAddress) ^ (static_cast<size_t> (key.localPort) << 16 | key.peerPort);
+    }
+  };
+
+  /**
+   * \brief Position of an end point in the containers.
+   */
+  struct Position
+  {
+    EndPointsI all;  //!< Position in m_endPoints
+    EndPointsI port; //!< Position in the m_ports list
+  };
+
+  /**
+   * \brief Position of each end point, to remove it in constant time.
+   */
+  std::unordered_map<Ipv4EndPoint *, Position> m_positions;
+
+  /**
+   * \brief All the end points, by local port.
+   */
+  std::unordered_map<uint16_t, EndPoints> m_ports;
+
+  /**
+   * \brief End points with a fully specified peer, by local port and peer.
+   */
+  std::unordered_map<PeerKey, EndPoints, PeerKeyHash> m_connected;
+
+  /**
+   * \brief End points without a fully specified peer, by local port.
+   */
+  std::unordered_map<uint16_t, EndPoints> m_unconnected;
 };
 
 } // namespace ns3
@@ -32,6 +32,7 @@ namespace ns3 {
 
 class Header;
 class Packet;
+class Ipv4EndPointDemux;
 
 /**
  * \ingroup ipv4
@@ -183,6 +184,15 @@ public:
   bool IsRxEnabled (void);
 
 private:
+  friend class Ipv4EndPointDemux;
+
+  /**
+   * \brief The demux that allocated the endpoint (if any).
+   *
+   * The demux indexes the endpoint by its peer, and is told when it changes.
+   */
+  Ipv4EndPointDemux *m_demux;
+
   /**
    * \brief The local address.
    */
@@ -28,6 +28,7 @@
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/random-variable-stream.h"
+#include "route-prefix-trie.h"
 
 namespace ns3 {
 
@@ -268,10 +269,17 @@ private:
    */
   Ptr<Ipv4Route> LookupGlobal (Ipv4Address dest, Ptr<NetDevice> oif = 0);
 
+  /// prefix trie of Ipv4RoutingTableEntry, used to find the routes matching a destination
+  typedef Ipv4RoutePrefixTrie<Ipv4RoutingTableEntry *> RouteTrie;
+
   HostRoutes m_hostRoutes;             //!< Routes to hosts
   NetworkRoutes m_networkRoutes;       //!< Routes to networks
   ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
 
+  RouteTrie m_hostRouteTrie;           //!< Routes to hosts, by destination
+  RouteTrie m_networkRouteTrie;        //!< Routes to networks, by prefix
+  RouteTrie m_ASexternalRouteTrie;     //!< External routes imported, by prefix
+
   Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
 };
 
@@ -18,6 +18,8 @@
 // Author: George F. Riley<riley@ece.gatech.edu>
 //
 
+#include <algorithm>
+
 #include "ns3/packet.h"
 #include "ns3/log.h"
 #include "ns3/callback.h"
@@ -41,6 +43,7 @@
 #include "arp-cache.h"
 #include "ipv4-l3-protocol.h"
 #include "icmpv4-l4-protocol.h"
+#include "tcp-l4-protocol.h"
 #include "ipv4-interface.h"
 #include "ipv4-raw-socket-impl.h"
 
@@ -86,6 +89,13 @@ Ipv4L3Protocol::GetTypeId (void)
                    TimeValue (Seconds (1)),
                    MakeTimeAccessor (&Ipv4L3Protocol::m_purge),
                    MakeTimeChecker (Seconds (0)))
+    .AddAttribute ("GroFlushTimeout",
+                   "The time the generic receive offload (GRO) stage holds "
+                   "in-order TCP segments to coalesce them before delivering "
+                   "them to TCP, 0 disables GRO",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&Ipv4L3Protocol::m_groFlushTimeout),
+                   MakeTimeChecker (Seconds (0)))
     .AddTraceSource ("Tx",
                      "Send ipv4 packet to outgoing interface.",
                      MakeTraceSourceAccessor (&Ipv4L3Protocol::m_txTrace),
@@ -342,6 +352,9 @@ Ipv4L3Protocol::DoDispose (void)
     }
   m_dups.clear ();
 
+  m_groFlushEvent.Cancel ();
+  m_groList.clear ();
+
   Object::DoDispose ();
 }
 
@@ -993,7 +1006,11 @@ Ipv4L3Protocol::SendRealOut (Ptr<Ipv4Route> route,
   if (outInterface->IsUp ())
     {
       NS_LOG_LOGIC ("Send to " << targetLabel << " " << target);
-      if ( packet->GetSize () + ipHeader.GetSerializedSize () > outInterface->GetDevice ()->GetMtu () )
+      // GSO super-segments are not fragmented: they are split into
+      // segments after the queue disc
+      SocketGsoTag gsoTag;
+      if ( packet->GetSize () + ipHeader.GetSerializedSize () > outInterface->GetDevice ()->GetMtu ()
+           && !packet->PeekPacketTag (gsoTag))
         {
           std::list<Ipv4PayloadHeaderPair> listFragments;
           DoFragmentation (packet, ipHeader, outInterface->GetDevice ()->GetMtu (), listFragments);
@@ -1109,6 +1126,19 @@ Ipv4L3Protocol::LocalDeliver (Ptr<const Packet> packet, Ipv4Header const&ip, uin
       ipHeader.SetPayloadSize (p->GetSize ());
     }
 
+  if (!m_groFlushTimeout.IsZero () && ipHeader.GetProtocol () == TcpL4Protocol::PROT_NUMBER)
+    {
+      GroReceive (p, ipHeader, iif);
+      return;
+    }
+  ForwardUp (p, ipHeader, iif);
+}
+
+void
+Ipv4L3Protocol::ForwardUp (Ptr<Packet> p, Ipv4Header const &ipHeader, uint32_t iif)
+{
+  NS_LOG_FUNCTION (this << p << ipHeader << iif);
+
   m_localDeliverTrace (ipHeader, p, iif);
 
   Ptr<IpL4Protocol> protocol = GetProtocol (ipHeader.GetProtocol (), iif);
@@ -1151,6 +1181,131 @@ Ipv4L3Protocol::LocalDeliver (Ptr<const Packet> packet, Ipv4Header const&ip, uin
     }
 }
 
+void
+Ipv4L3Protocol::GroReceive (Ptr<Packet> p, Ipv4Header const &ipHeader, uint32_t iif)
+{
+  NS_LOG_FUNCTION (this << p << ipHeader << iif);
+
+  // Largest IPv4 packet that the GRO stage builds (GRO_MAX_SIZE in Linux)
+  static const uint32_t GRO_MAX_SIZE = 65535;
+  // Largest number of flows that the GRO stage holds (MAX_GRO_SKBS in Linux)
+  static const std::size_t GRO_MAX_FLOWS = 8;
+
+  TcpHeader tcpHeader;
+  p->PeekHeader (tcpHeader);
+  uint32_t headerSize = tcpHeader.GetSerializedSize ();
+  uint32_t payloadSize = p->GetSize () - headerSize;
+  // only segments carrying data and no flag other than ACK and PSH are coalesced
+  bool mergeable = payloadSize > 0
+    && (tcpHeader.GetFlags () & ~(TcpHeader::ACK | TcpHeader::PSH)) == 0;
+
+  GroList_t::iterator flow;
+  for (flow = m_groList.begin (); flow != m_groList.end (); ++flow)
+    {
+      if (flow->m_iif == iif
+          && flow->m_ipHeader.GetSource () == ipHeader.GetSource ()
+          && flow->m_ipHeader.GetDestination () == ipHeader.GetDestination ()
+          && flow->m_tcpHeader.GetSourcePort () == tcpHeader.GetSourcePort ()
+          && flow->m_tcpHeader.GetDestinationPort () == tcpHeader.GetDestinationPort ())
+        {
+          break;
+        }
+    }
+
+  if (flow != m_groList.end ())
+    {
+      // As in Linux, the segment must follow the held ones and have the same
+      // acknowledgment number, data offset, flags but PSH, window and options
+      std::vector<uint8_t> rawHeader (headerSize);
+      p->CopyData (rawHeader.data (), headerSize);
+      const std::vector<uint8_t> &held = flow->m_rawHeader;
+      const uint8_t pshMask = static_cast<uint8_t> (~TcpHeader::PSH);
+      if (mergeable
+          && headerSize == held.size ()
+          && tcpHeader.GetSequenceNumber () == flow->m_tcpHeader.GetSequenceNumber () + flow->m_payload->GetSize ()
+          && flow->m_ipHeader.GetTos () == ipHeader.GetTos ()
+          && flow->m_ipHeader.GetTtl () == ipHeader.GetTtl ()
+          && std::equal (rawHeader.begin () + 8, rawHeader.begin () + 13, held.begin () + 8)
+          && (rawHeader[13] & pshMask) == (held[13] & pshMask)
+          && std::equal (rawHeader.begin () + 14, rawHeader.begin () + 16, held.begin () + 14)
+          && std::equal (rawHeader.begin () + 20, rawHeader.end (), held.begin () + 20)
+          && flow->m_ipHeader.GetSerializedSize () + headerSize
+             + flow->m_payload->GetSize () + payloadSize <= GRO_MAX_SIZE)
+        {
+          NS_LOG_LOGIC ("Coalescing segment " << tcpHeader.GetSequenceNumber ()
+                        << " of " << payloadSize << " bytes");
+          p->RemoveAtStart (headerSize);
+          flow->m_payload->AddAtEnd (p);
+          if (tcpHeader.GetFlags () & TcpHeader::PSH)
+            {
+              // the sender has no more data for now, do not wait for more
+              flow->m_tcpHeader.SetFlags (flow->m_tcpHeader.GetFlags () | TcpHeader::PSH);
+              GroFlush (flow);
+            }
+          return;
+        }
+      GroFlush (flow);
+    }
+
+  if (!mergeable || (tcpHeader.GetFlags () & TcpHeader::PSH))
+    {
+      ForwardUp (p, ipHeader, iif);
+      return;
+    }
+
+  if (m_groList.size () == GRO_MAX_FLOWS)
+    {
+      GroFlush (m_groList.begin ());
+    }
+
+  GroFlow newFlow;
+  newFlow.m_rawHeader.resize (headerSize);
+  p->CopyData (newFlow.m_rawHeader.data (), headerSize);
+  p->RemoveHeader (newFlow.m_tcpHeader);
+  newFlow.m_payload = p;
+  newFlow.m_ipHeader = ipHeader;
+  newFlow.m_iif = iif;
+  m_groList.push_back (newFlow);
+
+  if (!m_groFlushEvent.IsRunning ())
+    {
+      m_groFlushEvent = Simulator::Schedule (m_groFlushTimeout, &Ipv4L3Protocol::GroFlushAll, this);
+    }
+}
+
+void
+Ipv4L3Protocol::GroFlush (GroList_t::iterator flow)
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<Packet> p = flow->m_payload;
+  Ipv4Header ipHeader = flow->m_ipHeader;
+  TcpHeader tcpHeader = flow->m_tcpHeader;
+  uint32_t iif = flow->m_iif;
+  m_groList.erase (flow);
+
+  if (Node::ChecksumEnabled ())
+    {
+      tcpHeader.EnableChecksums ();
+      tcpHeader.InitializeChecksum (ipHeader.GetSource (), ipHeader.GetDestination (),
+                                    TcpL4Protocol::PROT_NUMBER);
+    }
+  p->AddHeader (tcpHeader);
+  ipHeader.SetPayloadSize (p->GetSize ());
+  ForwardUp (p, ipHeader, iif);
+}
+
+void
+Ipv4L3Protocol::GroFlushAll (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  while (!m_groList.empty ())
+    {
+      GroFlush (m_groList.begin ());
+    }
+}
+
 bool
 Ipv4L3Protocol::AddAddress (uint32_t i, Ipv4InterfaceAddress address)
 {
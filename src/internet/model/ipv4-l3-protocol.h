@@ -32,6 +32,7 @@
 #include "ns3/traced-callback.h"
 #include "ns3/ipv4-header.h"
 #include "ns3/ipv4-routing-protocol.h"
+#include "ns3/tcp-header.h"
 #include "ns3/nstime.h"
 #include "ns3/simulator.h"
 
@@ -368,6 +369,14 @@ private:
    */
   void LocalDeliver (Ptr<const Packet> p, Ipv4Header const&ip, uint32_t iif);
 
+  /**
+   * \brief Deliver a complete packet to the upper layer protocol.
+   * \param p packet delivered
+   * \param ipHeader IPv4 header
+   * \param iif input interface packet was received
+   */
+  void ForwardUp (Ptr<Packet> p, Ipv4Header const &ipHeader, uint32_t iif);
+
   /**
    * \brief Fallback when no route is found.
    * \param p packet
@@ -626,6 +635,51 @@ private:
    */
   void RemoveDuplicates (void);
 
+  /**
+   * \brief TCP segments of a flow held by the generic receive offload (GRO)
+   * stage, coalesced into a single packet.
+   */
+  struct GroFlow
+  {
+    Ptr<Packet> m_payload;             //!< The coalesced payload
+    Ipv4Header m_ipHeader;             //!< The IPv4 header of the first segment
+    TcpHeader m_tcpHeader;             //!< The TCP header of the first segment
+    std::vector<uint8_t> m_rawHeader;  //!< The serialized TCP header of the first segment
+    uint32_t m_iif;                    //!< The input interface
+  };
+
+  /// Container of the flows held by the GRO stage
+  typedef std::list<GroFlow> GroList_t;
+
+  /**
+   * \brief Coalesce a locally delivered TCP segment with the segments of
+   * the same flow, as Linux tcp_gro_receive does.
+   *
+   * Back-to-back in-order data segments of a flow with the same
+   * acknowledgment number, window and options are held for at most
+   * GroFlushTimeout and delivered to TCP as a single segment. Any other
+   * segment of the flow flushes the held ones first, so that TCP sees
+   * the segments in the order they arrived.
+   *
+   * \param p the TCP segment
+   * \param ipHeader the IPv4 header
+   * \param iif input interface packet was received
+   */
+  void GroReceive (Ptr<Packet> p, Ipv4Header const &ipHeader, uint32_t iif);
+  /**
+   * \brief Deliver the segments held by the GRO stage for a flow.
+   * \param flow the flow
+   */
+  void GroFlush (GroList_t::iterator flow);
+  /**
+   * \brief Deliver the segments held by the GRO stage for all the flows.
+   */
+  void GroFlushAll (void);
+
+  Time                m_groFlushTimeout; //!< Time the GRO stage holds segments, 0 disables GRO
+  GroList_t           m_groList;      //!< Flows held by the GRO stage, oldest first
+  EventId             m_groFlushEvent; //!< Event to flush the GRO stage
+
   bool                m_enableDpd;    //!< Enable multicast duplicate packet detection
   DupMap_t            m_dups;         //!< map of packet duplicate tuples to expiry event
   Time                m_expire;       //!< duplicate entry expiration delay
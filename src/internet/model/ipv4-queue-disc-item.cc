@@ -20,6 +20,8 @@
 #include "ipv4-queue-disc-item.h"
 #include "ns3/tcp-header.h"
 #include "ns3/udp-header.h"
+#include "ns3/socket.h"
+#include "ns3/node.h"
 
 namespace ns3 {
 
@@ -166,4 +168,63 @@ Ipv4QueueDiscItem::Hash (uint32_t perturbation) const
   return hash;
 }
 
+Ptr<QueueDiscItem>
+Ipv4QueueDiscItem::SplitSegment (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (m_headerAdded, "The header must be added before splitting");
+
+  if (m_header.GetProtocol () != 6)
+    {
+      return 0;
+    }
+  Ptr<Packet> p = GetPacket ();
+  SocketGsoTag gsoTag;
+  if (!p->PeekPacketTag (gsoTag))
+    {
+      return 0;
+    }
+
+  p->RemoveAtStart (m_header.GetSerializedSize ());
+  TcpHeader tcpHeader;
+  p->RemoveHeader (tcpHeader);
+  uint32_t segmentSize = gsoTag.GetSegmentSize ();
+  NS_ASSERT (segmentSize > 0 && p->GetSize () > segmentSize);
+
+  Ptr<Packet> segment = p->CreateFragment (0, segmentSize);
+  p->RemoveAtStart (segmentSize);
+  segment->RemovePacketTag (gsoTag);
+  if (p->GetSize () <= segmentSize)
+    {
+      // the last segment
+      p->RemovePacketTag (gsoTag);
+    }
+
+  TcpHeader segmentHeader = tcpHeader;
+  segmentHeader.SetFlags (tcpHeader.GetFlags () & ~(TcpHeader::FIN | TcpHeader::PSH));
+  tcpHeader.SetSequenceNumber (tcpHeader.GetSequenceNumber () + SequenceNumber32 (segmentSize));
+  tcpHeader.SetFlags (tcpHeader.GetFlags () & ~TcpHeader::CWR);
+  if (Node::ChecksumEnabled ())
+    {
+      segmentHeader.EnableChecksums ();
+      segmentHeader.InitializeChecksum (m_header.GetSource (), m_header.GetDestination (), 6);
+      tcpHeader.EnableChecksums ();
+      tcpHeader.InitializeChecksum (m_header.GetSource (), m_header.GetDestination (), 6);
+    }
+  segment->AddHeader (segmentHeader);
+  p->AddHeader (tcpHeader);
+
+  Ipv4Header ipHeader = m_header;
+  ipHeader.SetPayloadSize (segment->GetSize ());
+  m_header.SetPayloadSize (p->GetSize ());
+  m_header.SetIdentification (m_header.GetIdentification () + 1);
+  p->AddHeader (m_header);
+
+  Ptr<Ipv4QueueDiscItem> item = Create<Ipv4QueueDiscItem> (segment, GetAddress (), GetProtocol (), ipHeader);
+  item->SetTxQueueIndex (GetTxQueueIndex ());
+  item->SetTimeStamp (GetTimeStamp ());
+  item->AddHeader ();
+  return item;
+}
+
 } // namespace ns3
@@ -95,6 +95,19 @@ public:
    */
   virtual uint32_t Hash (uint32_t perturbation) const;
 
+  /**
+   * \brief Split the first segment off a TCP super-segment
+   *
+   * The first segment gets the TCP header of the super-segment, with the
+   * FIN and PSH flags cleared; the rest keeps the header with the sequence
+   * number moved forward and the CWR flag cleared, like in Linux. The IP
+   * identification is incremented for each segment and the checksums are
+   * computed again if enabled.
+   *
+   * \return the first segment, or 0 if this item is not a super-segment
+   */
+  virtual Ptr<QueueDiscItem> SplitSegment (void);
+
 private:
   /**
    * \brief Default constructor
@@ -75,8 +75,7 @@ Ipv4StaticRouting::AddNetworkRouteTo (Ipv4Address network,
 
   if (!LookupRoute (route, metric))
     {
-      Ipv4RoutingTableEntry *routePtr = new Ipv4RoutingTableEntry (route);
-      m_networkRoutes.push_back (make_pair (routePtr, metric));
+      InsertNetworkRoute (new Ipv4RoutingTableEntry (route), metric);
     }
 }
 
@@ -93,9 +92,7 @@ Ipv4StaticRouting::AddNetworkRouteTo (Ipv4Address network,
                                                                              interface);
   if (!LookupRoute (route, metric))
     {
-      Ipv4RoutingTableEntry *routePtr = new Ipv4RoutingTableEntry (route);
-
-      m_networkRoutes.push_back (make_pair (routePtr, metric));
+      InsertNetworkRoute (new Ipv4RoutingTableEntry (route), metric);
     }
 }
 
@@ -153,7 +150,7 @@ Ipv4StaticRouting::SetDefaultMulticastRoute (uint32_t outputInterface)
   *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo (network,
                                                         networkMask,
                                                         outputInterface);
-  m_networkRoutes.push_back (make_pair (route,0));
+  InsertNetworkRoute (route, 0);
 }
 
 uint32_t 
@@ -229,10 +226,30 @@ Ipv4StaticRouting::RemoveMulticastRoute (uint32_t index)
     }
 }
 
+void
+Ipv4StaticRouting::InsertNetworkRoute (Ipv4RoutingTableEntry *route, uint32_t metric)
+{
+  NS_LOG_FUNCTION (this << route << metric);
+  m_networkRoutes.push_back (make_pair (route, metric));
+  m_networkRouteTrie.Insert (route->GetDestNetwork (), route->GetDestNetworkMask (), make_pair (route, metric));
+}
+
+Ipv4StaticRouting::NetworkRoutesI
+Ipv4StaticRouting::EraseNetworkRoute (NetworkRoutesI it)
+{
+  NS_LOG_FUNCTION (this << it->first);
+  m_networkRouteTrie.Remove (it->first->GetDestNetwork (), it->first->GetDestNetworkMask (), *it);
+  delete it->first;
+  return m_networkRoutes.erase (it);
+}
+
 bool
 Ipv4StaticRouting::LookupRoute (const Ipv4RoutingTableEntry &route, uint32_t metric)
 {
-  for (NetworkRoutesI j = m_networkRoutes.begin (); j != m_networkRoutes.end (); j++)
+  // an identical route is stored under a prefix of its destination
+  NetworkRouteVec candidates;
+  m_networkRouteTrie.Match (route.GetDest (), candidates);
+  for (NetworkRouteVec::const_iterator j = candidates.begin (); j != candidates.end (); j++)
     {
       Ipv4RoutingTableEntry* rtentry = j->first;
 
@@ -269,8 +286,11 @@ Ipv4StaticRouting::LookupStatic (Ipv4Address dest, Ptr<NetDevice> oif)
     }
 
 
-  for (NetworkRoutesI i = m_networkRoutes.begin (); 
-       i != m_networkRoutes.end (); 
+  // the routes whose prefix contains the destination, in insertion order
+  NetworkRouteVec candidates;
+  m_networkRouteTrie.Match (dest, candidates);
+  for (NetworkRouteVec::const_iterator i = candidates.begin (); 
+       i != candidates.end (); 
        i++) 
     {
       Ipv4RoutingTableEntry *j=i->first;
@@ -476,8 +496,7 @@ Ipv4StaticRouting::RemoveRoute (uint32_t index)
     {
       if (tmp == index)
         {
-          delete j->first;
-          m_networkRoutes.erase (j);
+          EraseNetworkRoute (j);
           return;
         }
       tmp++;
@@ -604,6 +623,7 @@ Ipv4StaticRouting::DoDispose (void)
     {
       delete (j->first);
     }
+  m_networkRouteTrie.Clear ();
   for (MulticastRoutesI i = m_multicastRoutes.begin (); 
        i != m_multicastRoutes.end (); 
        i = m_multicastRoutes.erase (i)) 
@@ -642,8 +662,7 @@ Ipv4StaticRouting::NotifyInterfaceDown (uint32_t i)
     {
       if (it->first->GetInterface () == i)
         {
-          delete it->first;
-          it = m_networkRoutes.erase (it);
+          it = EraseNetworkRoute (it);
         }
       else
         {
@@ -689,8 +708,7 @@ Ipv4StaticRouting::NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress
           && it->first->GetDestNetwork () == networkAddress
           && it->first->GetDestNetworkMask () == networkMask)
         {
-          delete it->first;
-          it = m_networkRoutes.erase (it);
+          it = EraseNetworkRoute (it);
         }
       else
         {
@@ -24,6 +24,7 @@
 
 #include <list>
 #include <utility>
+#include <vector>
 #include <stdint.h>
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv4-header.h"
@@ -31,6 +32,7 @@
 #include "ns3/ptr.h"
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-routing-protocol.h"
+#include "route-prefix-trie.h"
 
 namespace ns3 {
 
@@ -367,6 +369,12 @@ private:
   /// Iterator for container for the network routes
   typedef std::list<std::pair <Ipv4RoutingTableEntry *, uint32_t> >::iterator NetworkRoutesI;
 
+  /// Prefix trie of the network routes, used to find the routes matching a destination
+  typedef Ipv4RoutePrefixTrie<std::pair <Ipv4RoutingTableEntry *, uint32_t> > NetworkRouteTrie;
+
+  /// Network routes found in the prefix trie
+  typedef std::vector<std::pair <Ipv4RoutingTableEntry *, uint32_t> > NetworkRouteVec;
+
   /// Container for the multicast routes
   typedef std::list<Ipv4MulticastRoutingTableEntry *> MulticastRoutes;
 
@@ -384,6 +392,20 @@ private:
    */
   bool LookupRoute (const Ipv4RoutingTableEntry &route, uint32_t metric);
 
+  /**
+   * \brief Add a network route to the forwarding table.
+   * \param route the route, owned by the forwarding table from now on
+   * \param metric metric of route
+   */
+  void InsertNetworkRoute (Ipv4RoutingTableEntry *route, uint32_t metric);
+
+  /**
+   * \brief Remove a network route from the forwarding table and delete it.
+   * \param it the route
+   * \return the route following the one removed
+   */
+  NetworkRoutesI EraseNetworkRoute (NetworkRoutesI it);
+
   /**
    * \brief Lookup in the forwarding table for destination.
    * \param dest destination address
@@ -407,6 +429,11 @@ private:
    */
   NetworkRoutes m_networkRoutes;
 
+  /**
+   * \brief the network routes, by prefix.
+   */
+  NetworkRouteTrie m_networkRouteTrie;
+
   /**
    * \brief the forwarding table for multicast.
    */
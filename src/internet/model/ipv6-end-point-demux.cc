@@ -40,28 +40,31 @@ Ipv6EndPointDemux::~Ipv6EndPointDemux ()
   for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
     {
       Ipv6EndPoint *endPoint = *i;
+      endPoint->m_demux = 0;
       delete endPoint;
     }
   m_endPoints.clear ();
+  m_positions.clear ();
+  m_ports.clear ();
+  m_connected.clear ();
+  m_unconnected.clear ();
 }
 
 bool Ipv6EndPointDemux::LookupPortLocal (uint16_t port)
 {
   NS_LOG_FUNCTION (this << port);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
-    {
-      if ((*i)->GetLocalPort  () == port)
-        {
-          return true;
-        }
-    }
-  return false;
+  return m_ports.find (port) != m_ports.end ();
 }
 
 bool Ipv6EndPointDemux::LookupLocal (Ptr<NetDevice> boundNetDevice, Ipv6Address addr, uint16_t port)
 {
   NS_LOG_FUNCTION (this << addr << port);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  std::unordered_map<uint16_t, EndPoints>::iterator bucket = m_ports.find (port);
+  if (bucket == m_ports.end ())
+    {
+      return false;
+    }
+  for (EndPointsI i = bucket->second.begin (); i != bucket->second.end (); i++)
     {
       if ((*i)->GetLocalPort () == port &&
           (*i)->GetLocalAddress () == addr &&
@@ -82,8 +85,7 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate ()
       NS_LOG_WARN ("Ephemeral port allocation failed.");
       return 0;
     }
-  Ipv6EndPoint *endPoint = new Ipv6EndPoint (Ipv6Address::GetAny (), port);
-  m_endPoints.push_back (endPoint);
+  Ipv6EndPoint *endPoint = Insert (new Ipv6EndPoint (Ipv6Address::GetAny (), port));
   NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
   return endPoint;
 }
@@ -97,8 +99,7 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ipv6Address address)
       NS_LOG_WARN ("Ephemeral port allocation failed.");
       return 0;
     }
-  Ipv6EndPoint *endPoint = new Ipv6EndPoint (address, port);
-  m_endPoints.push_back (endPoint);
+  Ipv6EndPoint *endPoint = Insert (new Ipv6EndPoint (address, port));
   NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
   return endPoint;
 }
@@ -118,8 +119,7 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice, Ipv6Ad
       NS_LOG_WARN ("Duplicated endpoint.");
       return 0;
     }
-  Ipv6EndPoint *endPoint = new Ipv6EndPoint (address, port);
-  m_endPoints.push_back (endPoint);
+  Ipv6EndPoint *endPoint = Insert (new Ipv6EndPoint (address, port));
   NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
   return endPoint;
 }
@@ -129,7 +129,9 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice,
                                            Ipv6Address peerAddress, uint16_t peerPort)
 {
   NS_LOG_FUNCTION (this << boundNetDevice << localAddress << localPort << peerAddress << peerPort);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  // A duplicate has the same peer, hence it is in the same index bucket
+  EndPoints &bucket = GetPeerBucket (localPort, peerAddress, peerPort);
+  for (EndPointsI i = bucket.begin (); i != bucket.end (); i++)
     {
       if ((*i)->GetLocalPort () == localPort &&
           (*i)->GetLocalAddress () == localAddress &&
@@ -143,7 +145,7 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice,
     }
   Ipv6EndPoint *endPoint = new Ipv6EndPoint (localAddress, localPort);
   endPoint->SetPeer (peerAddress, peerPort);
-  m_endPoints.push_back (endPoint);
+  Insert (endPoint);
 
   NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
 
@@ -153,13 +155,76 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice,
 void Ipv6EndPointDemux::DeAllocate (Ipv6EndPoint *endPoint)
 {
   NS_LOG_FUNCTION (this);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  if (m_positions.find (endPoint) != m_positions.end ())
+    {
+      Erase (endPoint);
+      delete endPoint;
+    }
+}
+
+Ipv6EndPoint* Ipv6EndPointDemux::Insert (Ipv6EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  Position pos;
+  pos.all = m_endPoints.insert (m_endPoints.end (), endPoint);
+  EndPoints &port = m_ports[endPoint->GetLocalPort ()];
+  pos.port = port.insert (port.end (), endPoint);
+  m_positions[endPoint] = pos;
+  endPoint->m_demux = this;
+  IndexPeer (endPoint);
+  return endPoint;
+}
+
+void Ipv6EndPointDemux::Erase (Ipv6EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  std::unordered_map<Ipv6EndPoint *, Position>::iterator pos = m_positions.find (endPoint);
+  NS_ASSERT (pos != m_positions.end ());
+  UnindexPeer (endPoint);
+  std::unordered_map<uint16_t, EndPoints>::iterator port = m_ports.find (endPoint->GetLocalPort ());
+  port->second.erase (pos->second.port);
+  if (port->second.empty ())
+    {
+      m_ports.erase (port);
+    }
+  m_endPoints.erase (pos->second.all);
+  m_positions.erase (pos);
+  endPoint->m_demux = 0;
+}
+
+Ipv6EndPointDemux::EndPoints& Ipv6EndPointDemux::GetPeerBucket (uint16_t localPort, Ipv6Address peerAddress, uint16_t peerPort)
+{
+  if (peerAddress != Ipv6Address::GetAny () && peerPort != 0)
     {
-      if (*i == endPoint)
+      return m_connected[PeerKey {localPort, peerAddress, peerPort}];
+    }
+  return m_unconnected[localPort];
+}
+
+void Ipv6EndPointDemux::IndexPeer (Ipv6EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  GetPeerBucket (endPoint->GetLocalPort (), endPoint->GetPeerAddress (), endPoint->GetPeerPort ())
+    .push_back (endPoint);
+}
+
+void Ipv6EndPointDemux::UnindexPeer (Ipv6EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  uint16_t localPort = endPoint->GetLocalPort ();
+  Ipv6Address peerAddress = endPoint->GetPeerAddress ();
+  uint16_t peerPort = endPoint->GetPeerPort ();
+  EndPoints &bucket = GetPeerBucket (localPort, peerAddress, peerPort);
+  bucket.remove (endPoint);
+  if (bucket.empty ())
+    { // Do not let the index grow with the connections that are gone
+      if (peerAddress != Ipv6Address::GetAny () && peerPort != 0)
         {
-          delete endPoint;
-          m_endPoints.erase (i);
-          break;
+          m_connected.erase (PeerKey {localPort, peerAddress, peerPort});
+        }
+      else
+        {
+          m_unconnected.erase (localPort);
         }
     }
 }
@@ -180,100 +245,122 @@ Ipv6EndPointDemux::EndPoints Ipv6EndPointDemux::Lookup (Ipv6Address daddr, uint1
   EndPoints retval3; /* Matches all but local address */
   EndPoints retval4; /* Exact match on all 4 */
 
-  NS_LOG_DEBUG ("Looking up endpoint for destination address " << daddr);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  // Only the end points connected to the source of the packet, and the
+  // ones without a fully specified peer, can match
+  EndPoints *buckets[2];
+  uint32_t nBuckets = 0;
+  if (saddr != Ipv6Address::GetAny () && sport != 0)
     {
-      Ipv6EndPoint* endP = *i;
-
-      NS_LOG_DEBUG ("Looking at endpoint dport=" << endP->GetLocalPort ()
-                                                 << " daddr=" << endP->GetLocalAddress ()
-                                                 << " sport=" << endP->GetPeerPort ()
-                                                 << " saddr=" << endP->GetPeerAddress ());
-
-      if (!endP->IsRxEnabled ())
+      std::unordered_map<PeerKey, EndPoints, PeerKeyHash>::iterator it =
+        m_connected.find (PeerKey {dport, saddr, sport});
+      if (it != m_connected.end ())
         {
-          NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                        << " because endpoint can not receive packets");
-          continue;
+          buckets[nBuckets++] = &it->second;
         }
+    }
+  std::unordered_map<uint16_t, EndPoints>::iterator wildcard = m_unconnected.find (dport);
+  if (wildcard != m_unconnected.end ())
+    {
+      buckets[nBuckets++] = &wildcard->second;
+    }
 
-      if (endP->GetLocalPort () != dport)
+  NS_LOG_DEBUG ("Looking up endpoint for destination address " << daddr);
+  for (uint32_t b = 0; b < nBuckets; b++)
+    {
+      for (EndPointsI i = buckets[b]->begin (); i != buckets[b]->end (); i++)
         {
-          NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                                             << " because endpoint dport "
-                                             << endP->GetLocalPort ()
-                                             << " does not match packet dport " << dport);
-          continue;
-        }
+          Ipv6EndPoint* endP = *i;
 
-      if (endP->GetBoundNetDevice ())
-        {
-          if (!incomingInterface)
+          NS_LOG_DEBUG ("Looking at endpoint dport=" << endP->GetLocalPort ()
+                                                     << " daddr=" << endP->GetLocalAddress ()
+                                                     << " sport=" << endP->GetPeerPort ()
+                                                     << " saddr=" << endP->GetPeerAddress ());
+
+          if (!endP->IsRxEnabled ())
             {
+              NS_LOG_LOGIC ("Skipping endpoint " << &endP
+                            << " because endpoint can not receive packets");
               continue;
             }
-          if (endP->GetBoundNetDevice () != incomingInterface->GetDevice ())
+
+          if (endP->GetLocalPort () != dport)
             {
               NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                                                 << " because endpoint is bound to specific device and"
-                                                 << endP->GetBoundNetDevice ()
-                                                 << " does not match packet device " << incomingInterface->GetDevice ());
+                                                 << " because endpoint dport "
+                                                 << endP->GetLocalPort ()
+                                                 << " does not match packet dport " << dport);
               continue;
             }
-        }
 
-      /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
-      NS_LOG_DEBUG ("dest addr " << daddr);
+          if (endP->GetBoundNetDevice ())
+            {
+              if (!incomingInterface)
+                {
+                  continue;
+                }
+              if (endP->GetBoundNetDevice () != incomingInterface->GetDevice ())
+                {
+                  NS_LOG_LOGIC ("Skipping endpoint " << &endP
+                                                     << " because endpoint is bound to specific device and"
+                                                     << endP->GetBoundNetDevice ()
+                                                     << " does not match packet device " << incomingInterface->GetDevice ());
+                  continue;
+                }
+            }
 
-      bool localAddressMatchesWildCard = endP->GetLocalAddress () == Ipv6Address::GetAny ();
-      bool localAddressMatchesExact = endP->GetLocalAddress () == daddr;
-      bool localAddressMatchesAllRouters = endP->GetLocalAddress () == Ipv6Address::GetAllRoutersMulticast ();
+          /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
+          NS_LOG_DEBUG ("dest addr " << daddr);
 
-      /* if no match here, keep looking */
-      if (!(localAddressMatchesExact || localAddressMatchesWildCard))
-        {
-          continue;
-        }
-      bool remotePeerMatchesExact = endP->GetPeerPort () == sport;
-      bool remotePeerMatchesWildCard = endP->GetPeerPort () == 0;
-      bool remoteAddressMatchesExact = endP->GetPeerAddress () == saddr;
-      bool remoteAddressMatchesWildCard = endP->GetPeerAddress () == Ipv6Address::GetAny ();
-
-      /* If remote does not match either with exact or wildcard,i
-         skip this one */
-      if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
-        {
-          continue;
-        }
-      if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-          continue;
-        }
+          bool localAddressMatchesWildCard = endP->GetLocalAddress () == Ipv6Address::GetAny ();
+          bool localAddressMatchesExact = endP->GetLocalAddress () == daddr;
+          bool localAddressMatchesAllRouters = endP->GetLocalAddress () == Ipv6Address::GetAllRoutersMulticast ();
 
-      /* Now figure out which return list to add this one to */
-      if (localAddressMatchesWildCard
-          && remotePeerMatchesWildCard
-          && remoteAddressMatchesWildCard)
-        { /* Only local port matches exactly */
-          retval1.push_back (endP);
-        }
-      if ((localAddressMatchesExact || (localAddressMatchesAllRouters))
-          && remotePeerMatchesWildCard
-          && remoteAddressMatchesWildCard)
-        { /* Only local port and local address matches exactly */
-          retval2.push_back (endP);
-        }
-      if (localAddressMatchesWildCard
-          && remotePeerMatchesExact
-          && remoteAddressMatchesExact)
-        { /* All but local address */
-          retval3.push_back (endP);
-        }
-      if (localAddressMatchesExact
-          && remotePeerMatchesExact
-          && remoteAddressMatchesExact)
-        { /* All 4 match */
-          retval4.push_back (endP);
+          /* if no match here, keep looking */
+          if (!(localAddressMatchesExact || localAddressMatchesWildCard))
+            {
+              continue;
+            }
+          bool remotePeerMatchesExact = endP->GetPeerPort () == sport;
+          bool remotePeerMatchesWildCard = endP->GetPeerPort () == 0;
+          bool remoteAddressMatchesExact = endP->GetPeerAddress () == saddr;
+          bool remoteAddressMatchesWildCard = endP->GetPeerAddress () == Ipv6Address::GetAny ();
+
+          /* If remote does not match either with exact or wildcard,i
+             skip this one */
+          if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
+            {
+              continue;
+            }
+          if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
+            {
+              continue;
+            }
+
+          /* Now figure out which return list to add this one to */
+          if (localAddressMatchesWildCard
+              && remotePeerMatchesWildCard
+              && remoteAddressMatchesWildCard)
+            { /* Only local port matches exactly */
+              retval1.push_back (endP);
+            }
+          if ((localAddressMatchesExact || (localAddressMatchesAllRouters))
+              && remotePeerMatchesWildCard
+              && remoteAddressMatchesWildCard)
+            { /* Only local port and local address matches exactly */
+              retval2.push_back (endP);
+            }
+          if (localAddressMatchesWildCard
+              && remotePeerMatchesExact
+              && remoteAddressMatchesExact)
+            { /* All but local address */
+              retval3.push_back (endP);
+            }
+          if (localAddressMatchesExact
+              && remotePeerMatchesExact
+              && remoteAddressMatchesExact)
+            { /* All 4 match */
+              retval4.push_back (endP);
+            }
         }
     }
 
@@ -290,10 +377,31 @@ Ipv6EndPointDemux::EndPoints Ipv6EndPointDemux::Lookup (Ipv6Address daddr, uint1
 
 Ipv6EndPoint* Ipv6EndPointDemux::SimpleLookup (Ipv6Address dst, uint16_t dport, Ipv6Address src, uint16_t sport)
 {
+  std::unordered_map<uint16_t, EndPoints>::iterator port = m_ports.find (dport);
+  if (port == m_ports.end ())
+    {
+      return 0;
+    }
+  if (src != Ipv6Address::GetAny () && sport != 0)
+    { /* Look for an exact match in the index first */
+      std::unordered_map<PeerKey, EndPoints, PeerKeyHash>::iterator it =
+        m_connected.find (PeerKey {dport, src, sport});
+      if (it != m_connected.end ())
+        {
+          for (EndPointsI i = it->second.begin (); i != it->second.end (); i++)
+            {
+              if ((*i)->GetLocalAddress () == dst)
+                {
+                  return *i;
+                }
+            }
+        }
+    }
+
   uint32_t genericity = 3;
   Ipv6EndPoint *generic = 0;
 
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  for (EndPointsI i = port->second.begin (); i != port->second.end (); i++)
     {
       uint32_t tmp = 0;
 
@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 #include <list>
+#include <unordered_map>
 #include "ns3/ipv6-address.h"
 #include "ipv6-interface.h"
 
@@ -34,6 +35,10 @@ class Ipv6EndPoint;
  * \ingroup ipv6
  *
  * \brief Demultiplexer for end points.
+ *
+ * As in Ipv4EndPointDemux, endpoints with a fully specified peer are
+ * indexed by local port and peer address and port, and the others by local
+ * port only, so that a lookup does not depend on the number of endpoints.
  */
 class Ipv6EndPointDemux
 {
@@ -153,6 +158,46 @@ public:
   EndPoints GetEndPoints () const;
 
 private:
+  friend class Ipv6EndPoint;
+
+  /**
+   * \brief Add an end point to the containers and indexes.
+   * \param endPoint the end point
+   * \return the end point
+   */
+  Ipv6EndPoint *Insert (Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Remove an end point from the containers and indexes.
+   * \param endPoint the end point
+   */
+  void Erase (Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Get the peer index bucket of an end point, creating it if needed.
+   *
+   * End points with a fully specified peer are in the bucket of their local
+   * port and peer; the others in the bucket of their local port.
+   *
+   * \param localPort local port
+   * \param peerAddress peer address
+   * \param peerPort peer port
+   * \return the bucket
+   */
+  EndPoints &GetPeerBucket (uint16_t localPort, Ipv6Address peerAddress, uint16_t peerPort);
+
+  /**
+   * \brief Index an end point according to its peer.
+   * \param endPoint the end point
+   */
+  void IndexPeer (Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Remove an end point from the peer index.
+   * \param endPoint the end point
+   */
+  void UnindexPeer (Ipv6EndPoint *endPoint);
+
   /**
    * \brief Allocate a ephemeral port.
    * \return a port
@@ -178,6 +223,71 @@ private:
    * \brief A list of IPv6 end points.
    */
   EndPoints m_endPoints;
+
+  /**
+   * \brief Local port and peer of an end point with a fully specified peer.
+   */
+  struct PeerKey
+  {
+    uint16_t localPort;      //!< Local port
+    Ipv6Address peerAddress; //!< Peer address
+    uint16_t peerPort;       //!< Peer port
+
+    /**
+     * \brief Equality operator.
+     * \param o the other key
+     * \return true if the keys are equal
+     */
+    bool operator== (const PeerKey &o) const
+    {
+      return localPort == o.localPort && peerPort == o.peerPort && peerAddress == o.peerAddress;
+    }
+  };
+
+  /**
+   * \brief Hash function for PeerKey.
+   */
+  struct PeerKeyHash
+  {
+    /**
+     * \brief Hash a key.
+     * \param key the key
+     * \return the hash
+     */
+    size_t operator() (const PeerKey &key) const
+    {
+      return Ipv6AddressHash () (key.peerAddress) ^ (static_cast<size_t> (key.localPort) << 16 | key.peerPort);
+    }
+  };
+
+  /**
+   * \brief Position of an end point in the containers.
+   */
+  struct Position
+  {
+    EndPointsI all;  //!< Position in m_endPoints
+    EndPointsI port; //!< Position in the m_ports list
+  };
+
+  /**
+   * \brief Position of each end point, to remove it in constant time.
+   */
+  std::unordered_map<Ipv6EndPoint *, Position> m_positions;
+
+  /**
+   * \brief All the end points, by local port.
+   */
+  std::unordered_map<uint16_t, EndPoints> m_ports;
+
+  /**
+   * \brief End points with a fully specified peer, by local port and peer.
+   */
+  std::unordered_map<PeerKey, EndPoints, PeerKeyHash> m_connected;
+
+  /**
+   * \brief End points without a fully specified peer, by local port.
+   */
+  std::unordered_map<uint16_t, EndPoints> m_unconnected;
 };
 
 } /* namespace ns3 */
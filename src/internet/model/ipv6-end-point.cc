@@ -23,6 +23,7 @@
 #include "ns3/simulator.h"
 
 #include "ipv6-end-point.h"
+#include "ipv6-end-point-demux.h"
 
 namespace ns3
 {
@@ -30,7 +31,8 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE ("Ipv6EndPoint");
 
 Ipv6EndPoint::Ipv6EndPoint (Ipv6Address addr, uint16_t port)
-  : m_localAddr (addr),
+  : m_demux (0),
+    m_localAddr (addr),
     m_localPort (port),
     m_peerAddr (Ipv6Address::GetAny ()),
     m_peerPort (0),
@@ -66,7 +68,16 @@ uint16_t Ipv6EndPoint::GetLocalPort ()
 
 void Ipv6EndPoint::SetLocalPort (uint16_t port)
 {
+  Ipv6EndPointDemux *demux = m_demux;
+  if (demux)
+    {
+      demux->Erase (this);
+    }
   m_localPort = port;
+  if (demux)
+    {
+      demux->Insert (this);
+    }
 }
 
 Ipv6Address Ipv6EndPoint::GetPeerAddress ()
@@ -92,8 +103,16 @@ Ptr<NetDevice> Ipv6EndPoint::GetBoundNetDevice (void)
 
 void Ipv6EndPoint::SetPeer (Ipv6Address addr, uint16_t port)
 {
+  if (m_demux)
+    {
+      m_demux->UnindexPeer (this);
+    }
   m_peerAddr = addr;
   m_peerPort = port;
+  if (m_demux)
+    {
+      m_demux->IndexPeer (this);
+    }
 }
 
 void Ipv6EndPoint::SetRxCallback (Callback<void, Ptr<Packet>, Ipv6Header, uint16_t, Ptr<Ipv6Interface> > callback)
@@ -34,6 +34,7 @@ namespace ns3
 
 class Header;
 class Packet;
+class Ipv6EndPointDemux;
 
 /**
  * \ingroup ipv6
@@ -192,6 +193,16 @@ public:
   bool IsRxEnabled (void);
 
 private:
+  friend class Ipv6EndPointDemux;
+
+  /**
+   * \brief The demux that allocated the endpoint (if any).
+   *
+   * The demux indexes the endpoint by its local port and peer, and is told
+   * when they change.
+   */
+  Ipv6EndPointDemux *m_demux;
+
   /**
    * \brief The local address.
    */
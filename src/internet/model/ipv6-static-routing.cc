@@ -161,8 +161,7 @@ void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix netwo
 
   if (!LookupRoute (route, metric))
     {
-      Ipv6RoutingTableEntry* routePtr = new Ipv6RoutingTableEntry (route);
-      m_networkRoutes.push_back (std::make_pair (routePtr, metric));
+      InsertNetworkRoute (new Ipv6RoutingTableEntry (route), metric);
     }
 }
 
@@ -177,8 +176,7 @@ void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix netwo
   Ipv6RoutingTableEntry route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkPrefix, nextHop, interface, prefixToUse);
   if (!LookupRoute (route, metric))
     {
-      Ipv6RoutingTableEntry* routePtr = new Ipv6RoutingTableEntry (route);
-      m_networkRoutes.push_back (std::make_pair (routePtr, metric));
+      InsertNetworkRoute (new Ipv6RoutingTableEntry (route), metric);
     }
 }
 
@@ -189,8 +187,7 @@ void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix netwo
   Ipv6RoutingTableEntry route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkPrefix, interface);
   if (!LookupRoute (route, metric))
     {
-      Ipv6RoutingTableEntry* routePtr = new Ipv6RoutingTableEntry (route);
-      m_networkRoutes.push_back (std::make_pair (routePtr, metric));
+      InsertNetworkRoute (new Ipv6RoutingTableEntry (route), metric);
     }
 }
 
@@ -215,7 +212,7 @@ void Ipv6StaticRouting::SetDefaultMulticastRoute (uint32_t outputInterface)
   Ipv6Address network = Ipv6Address ("ff00::"); /* RFC 3513 */
   Ipv6Prefix networkMask = Ipv6Prefix (8);
   *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkMask, outputInterface);
-  m_networkRoutes.push_back (std::make_pair (route, 0));
+  InsertNetworkRoute (route, 0);
 }
 
 uint32_t Ipv6StaticRouting::GetNMulticastRoutes () const
@@ -300,9 +297,27 @@ bool Ipv6StaticRouting::HasNetworkDest (Ipv6Address network, uint32_t interfaceI
   return false;
 }
 
+void Ipv6StaticRouting::InsertNetworkRoute (Ipv6RoutingTableEntry *route, uint32_t metric)
+{
+  NS_LOG_FUNCTION (this << route << metric);
+  m_networkRoutes.push_back (std::make_pair (route, metric));
+  m_networkRouteTrie.Insert (route->GetDestNetwork (), route->GetDestNetworkPrefix (), std::make_pair (route, metric));
+}
+
+Ipv6StaticRouting::NetworkRoutesI Ipv6StaticRouting::EraseNetworkRoute (NetworkRoutesI it)
+{
+  NS_LOG_FUNCTION (this << it->first);
+  m_networkRouteTrie.Remove (it->first->GetDestNetwork (), it->first->GetDestNetworkPrefix (), *it);
+  delete it->first;
+  return m_networkRoutes.erase (it);
+}
+
 bool Ipv6StaticRouting::LookupRoute (const Ipv6RoutingTableEntry &route, uint32_t metric)
 {
-  for (NetworkRoutesI j = m_networkRoutes.begin (); j != m_networkRoutes.end (); j++)
+  /* an identical route is stored under a prefix of its destination */
+  NetworkRouteVec candidates;
+  m_networkRouteTrie.Match (route.GetDest (), candidates);
+  for (NetworkRouteVec::const_iterator j = candidates.begin (); j != candidates.end (); j++)
     {
       Ipv6RoutingTableEntry* rtentry = j->first;
 
@@ -338,7 +353,10 @@ Ptr<Ipv6Route> Ipv6StaticRouting::LookupStatic (Ipv6Address dst, Ptr<NetDevice>
       return rtentry;
     }
 
-  for (NetworkRoutesI it = m_networkRoutes.begin (); it != m_networkRoutes.end (); it++)
+  /* the routes whose prefix contains the destination, in insertion order */
+  NetworkRouteVec candidates;
+  m_networkRouteTrie.Match (dst, candidates);
+  for (NetworkRouteVec::const_iterator it = candidates.begin (); it != candidates.end (); it++)
     {
       Ipv6RoutingTableEntry* j = it->first;
       uint32_t metric = it->second;
@@ -418,6 +436,7 @@ void Ipv6StaticRouting::DoDispose ()
       delete j->first;
     }
   m_networkRoutes.clear ();
+  m_networkRouteTrie.Clear ();
 
   for (MulticastRoutesI i = m_multicastRoutes.begin (); i != m_multicastRoutes.end (); i = m_multicastRoutes.erase (i))
     {
@@ -490,7 +509,10 @@ Ipv6RoutingTableEntry Ipv6StaticRouting::GetDefaultRoute ()
   uint32_t shortestMetric = 0xffffffff;
   Ipv6RoutingTableEntry* result = 0;
 
-  for (NetworkRoutesI it = m_networkRoutes.begin (); it != m_networkRoutes.end (); it++)
+  /* the routes whose prefix contains the destination, in insertion order */
+  NetworkRouteVec candidates;
+  m_networkRouteTrie.Match (dst, candidates);
+  for (NetworkRouteVec::const_iterator it = candidates.begin (); it != candidates.end (); it++)
     {
       Ipv6RoutingTableEntry* j = it->first;
       uint32_t metric = it->second;
@@ -566,8 +588,7 @@ void Ipv6StaticRouting::RemoveRoute (uint32_t index)
     {
       if (tmp == index)
         {
-          delete it->first;
-          m_networkRoutes.erase (it);
+          EraseNetworkRoute (it);
           return;
         }
       tmp++;
@@ -585,8 +606,7 @@ void Ipv6StaticRouting::RemoveRoute (Ipv6Address network, Ipv6Prefix prefix, uin
       if (network == rtentry->GetDest () && rtentry->GetInterface () == ifIndex
           && rtentry->GetPrefixToUse () == prefixToUse)
         {
-          delete it->first;
-          m_networkRoutes.erase (it);
+          EraseNetworkRoute (it);
           return;
         }
     }
@@ -715,8 +735,7 @@ void Ipv6StaticRouting::NotifyInterfaceDown (uint32_t i)
     {
       if (it->first->GetInterface () == i)
         {
-          delete it->first;
-          it = m_networkRoutes.erase (it);
+          it = EraseNetworkRoute (it);
         }
       else
         {
@@ -752,8 +771,7 @@ void Ipv6StaticRouting::NotifyRemoveAddress (uint32_t interface, Ipv6InterfaceAd
           && it->first->GetDestNetwork () == networkAddress
           && it->first->GetDestNetworkPrefix () == networkMask)
         {
-          delete it->first;
-          it = m_networkRoutes.erase (it);
+          it = EraseNetworkRoute (it);
         }
       else
         {
@@ -800,8 +818,7 @@ void Ipv6StaticRouting::NotifyRemoveRoute (Ipv6Address dst, Ipv6Prefix mask, Ipv
 
           if (dst == entry && prefix == mask && rtentry->GetInterface () == interface)
             {
-              delete j->first;
-              j = m_networkRoutes.erase (j);
+              j = EraseNetworkRoute (j);
             }
           else
             {
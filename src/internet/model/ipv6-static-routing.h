@@ -24,12 +24,15 @@
 #include <stdint.h>
 
 #include <list>
+#include <utility>
+#include <vector>
 
 #include "ns3/ptr.h"
 #include "ns3/ipv6-address.h"
 #include "ns3/ipv6.h"
 #include "ns3/ipv6-header.h"
 #include "ns3/ipv6-routing-protocol.h"
+#include "route-prefix-trie.h"
 
 namespace ns3 {
 
@@ -255,6 +258,12 @@ private:
   /// Iterator for container for the network routes
   typedef std::list<std::pair <Ipv6RoutingTableEntry *, uint32_t> >::iterator NetworkRoutesI;
 
+  /// Prefix trie of the network routes, used to find the routes matching a destination
+  typedef Ipv6RoutePrefixTrie<std::pair <Ipv6RoutingTableEntry *, uint32_t> > NetworkRouteTrie;
+
+  /// Network routes found in the prefix trie
+  typedef std::vector<std::pair <Ipv6RoutingTableEntry *, uint32_t> > NetworkRouteVec;
+
   /// Container for the multicast routes
   typedef std::list<Ipv6MulticastRoutingTableEntry *> MulticastRoutes;
 
@@ -272,6 +281,20 @@ private:
    */
   bool LookupRoute (const Ipv6RoutingTableEntry &route, uint32_t metric);
 
+  /**
+   * \brief Add a network route to the forwarding table.
+   * \param route the route, owned by the forwarding table from now on
+   * \param metric metric of route
+   */
+  void InsertNetworkRoute (Ipv6RoutingTableEntry *route, uint32_t metric);
+
+  /**
+   * \brief Remove a network route from the forwarding table and delete it.
+   * \param it the route
+   * \return the route following the one removed
+   */
+  NetworkRoutesI EraseNetworkRoute (NetworkRoutesI it);
+
   /**
    * \brief Lookup in the forwarding table for destination.
    * \param dest destination address
@@ -294,6 +317,11 @@ private:
    */
   NetworkRoutes m_networkRoutes;
 
+  /**
+   * \brief the network routes, by prefix.
+   */
+  NetworkRouteTrie m_networkRouteTrie;
+
   /**
    * \brief the forwarding table for multicast.
    */
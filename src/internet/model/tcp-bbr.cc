@@ -457,7 +457,22 @@ void
 TcpBbr::SetSendQuantum (Ptr<TcpSocketState> tcb)
 {
   NS_LOG_FUNCTION (this << tcb);
-  m_sendQuantum = 1 * tcb->m_segmentSize;
+  if (tcb->m_gsoMaxSize > tcb->m_segmentSize)
+    {
+      // With GSO, as tcp_tso_autosize in Linux: about 1 ms of data at the
+      // pacing rate, at least 2 segments above 1.2 Mb/s, and no more than
+      // one super-segment
+      uint64_t rate = tcb->m_pacingRate.Get ().GetBitRate ();
+      uint64_t segments = std::max<uint64_t> (((rate / 8) >> 10) / tcb->m_segmentSize,
+                                              rate < 1200000 ? 1 : 2);
+      segments = std::min<uint64_t> (segments, tcb->m_gsoMaxSize / tcb->m_segmentSize);
+      m_sendQuantum = segments * tcb->m_segmentSize;
+    }
+  else
+    {
+      m_sendQuantum = 1 * tcb->m_segmentSize;
+    }
+  tcb->m_sendQuantum = m_sendQuantum;
 }
 
 void
@@ -0,0 +1,921 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "tcp-bbr2.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TcpBbr2");
+NS_OBJECT_ENSURE_REGISTERED (TcpBbr2);
+
+const double TcpBbr2::PROBE_BW_PACING_GAIN [] = {5.0 / 4, 3.0 / 4, 1, 1};
+
+TypeId
+TcpBbr2::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TcpBbr2")
+    .SetParent<TcpBbr> ()
+    .AddConstructor<TcpBbr2> ()
+    .SetGroupName ("Internet")
+    .AddAttribute ("Beta",
+                   "Multiplicative decrease of bw_lo and inflight_lo on loss",
+                   DoubleValue (0.7),
+                   MakeDoubleAccessor (&TcpBbr2::m_beta),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("LossThreshold",
+                   "Loss rate above which inflight is considered too high",
+                   DoubleValue (0.02),
+                   MakeDoubleAccessor (&TcpBbr2::m_lossThresh),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("EcnThreshold",
+                   "ECN mark ratio above which inflight is considered too high",
+                   DoubleValue (0.5),
+                   MakeDoubleAccessor (&TcpBbr2::m_ecnThresh),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("EcnAlphaGain",
+                   "EWMA gain used to estimate the ECN mark ratio",
+                   DoubleValue (1.0 / 16),
+                   MakeDoubleAccessor (&TcpBbr2::m_ecnAlphaGain),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("EcnFactor",
+                   "Fraction of the ECN mark ratio used to reduce inflight_lo",
+                   DoubleValue (1.0 / 3),
+                   MakeDoubleAccessor (&TcpBbr2::m_ecnFactor),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("InflightHeadroom",
+                   "Fraction of inflight_hi left unused while cruising",
+                   DoubleValue (0.15),
+                   MakeDoubleAccessor (&TcpBbr2::m_inflightHeadroom),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("FullLossCount",
+                   "Number of lossy ACKs in a round that ends STARTUP",
+                   UintegerValue (8),
+                   MakeUintegerAccessor (&TcpBbr2::m_fullLossCount),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("BwProbeMaxRounds",
+                   "Max number of rounds between bandwidth probes",
+                   UintegerValue (63),
+                   MakeUintegerAccessor (&TcpBbr2::m_bwProbeMaxRounds),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("BwProbeRandRounds",
+                   "Max number of random rounds added to the wait between bandwidth probes",
+                   UintegerValue (2),
+                   MakeUintegerAccessor (&TcpBbr2::m_bwProbeRandRounds),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("BwProbeBaseWait",
+                   "Base time between bandwidth probes",
+                   TimeValue (Seconds (2)),
+                   MakeTimeAccessor (&TcpBbr2::m_bwProbeBaseWait),
+                   MakeTimeChecker ())
+    .AddAttribute ("BwProbeRandWait",
+                   "Max random time added to the wait between bandwidth probes",
+                   TimeValue (Seconds (1)),
+                   MakeTimeAccessor (&TcpBbr2::m_bwProbeRandWait),
+                   MakeTimeChecker ())
+    .AddAttribute ("ProbeRttInterval",
+                   "Time between PROBE_RTT phases",
+                   TimeValue (Seconds (5)),
+                   MakeTimeAccessor (&TcpBbr2::m_probeRttInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("ProbeRttCwndGain",
+                   "Fraction of the BDP used as cwnd in PROBE_RTT",
+                   DoubleValue (0.5),
+                   MakeDoubleAccessor (&TcpBbr2::m_probeRttCwndGain),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+  ;
+  return tid;
+}
+
+TcpBbr2::TcpBbr2 ()
+  : TcpBbr ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TcpBbr2::TcpBbr2 (const TcpBbr2 &sock)
+  : TcpBbr (sock),
+    m_probeBwPhase (sock.m_probeBwPhase),
+    m_ackPhase (sock.m_ackPhase),
+    m_bwLo (sock.m_bwLo),
+    m_bwLatest (sock.m_bwLatest),
+    m_inflightLo (sock.m_inflightLo),
+    m_inflightHi (sock.m_inflightHi),
+    m_inflightLatest (sock.m_inflightLatest),
+    m_bwProbeUpCnt (sock.m_bwProbeUpCnt),
+    m_bwProbeUpAcks (sock.m_bwProbeUpAcks),
+    m_bwProbeUpRounds (sock.m_bwProbeUpRounds),
+    m_roundsSinceProbe (sock.m_roundsSinceProbe),
+    m_bwProbeWait (sock.m_bwProbeWait),
+    m_bwProbeSamples (sock.m_bwProbeSamples),
+    m_prevProbeTooHigh (sock.m_prevProbeTooHigh),
+    m_stoppedRiskyProbe (sock.m_stoppedRiskyProbe),
+    m_lossInRound (sock.m_lossInRound),
+    m_ecnInRound (sock.m_ecnInRound),
+    m_lossRoundStart (sock.m_lossRoundStart),
+    m_lossRoundDelivered (sock.m_lossRoundDelivered),
+    m_lossEventsInRound (sock.m_lossEventsInRound),
+    m_deliveredCe (sock.m_deliveredCe),
+    m_alphaLastDelivered (sock.m_alphaLastDelivered),
+    m_alphaLastDeliveredCe (sock.m_alphaLastDeliveredCe),
+    m_ecnAlpha (sock.m_ecnAlpha),
+    m_ecnCeRatio (sock.m_ecnCeRatio),
+    m_beta (sock.m_beta),
+    m_lossThresh (sock.m_lossThresh),
+    m_ecnThresh (sock.m_ecnThresh),
+    m_ecnAlphaGain (sock.m_ecnAlphaGain),
+    m_ecnFactor (sock.m_ecnFactor),
+    m_inflightHeadroom (sock.m_inflightHeadroom),
+    m_fullLossCount (sock.m_fullLossCount),
+    m_bwProbeMaxRounds (sock.m_bwProbeMaxRounds),
+    m_bwProbeRandRounds (sock.m_bwProbeRandRounds),
+    m_bwProbeBaseWait (sock.m_bwProbeBaseWait),
+    m_bwProbeRandWait (sock.m_bwProbeRandWait),
+    m_probeRttInterval (sock.m_probeRttInterval),
+    m_probeRttCwndGain (sock.m_probeRttCwndGain),
+    m_probeRttMin (sock.m_probeRttMin),
+    m_probeRttMinStamp (sock.m_probeRttMinStamp),
+    m_probeRttExpired (sock.m_probeRttExpired)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+const char* const
+TcpBbr2::Bbr2ProbeBwPhaseName[BBR2_BW_PROBE_REFILL + 1] =
+{
+  "BBR2_BW_PROBE_UP", "BBR2_BW_PROBE_DOWN", "BBR2_BW_PROBE_CRUISE", "BBR2_BW_PROBE_REFILL"
+};
+
+TcpBbr2::Bbr2ProbeBwPhase_t
+TcpBbr2::GetProbeBwPhase () const
+{
+  NS_LOG_FUNCTION (this);
+  return m_probeBwPhase;
+}
+
+DataRate
+TcpBbr2::GetBw () const
+{
+  DataRate bw = m_maxBwFilter.GetBest ();
+  if (m_bwLo.GetBitRate () != 0)
+    {
+      bw = std::min (bw, m_bwLo);
+    }
+  return bw;
+}
+
+uint32_t
+TcpBbr2::Bdp (Ptr<TcpSocketState> tcb, DataRate bw, double gain) const
+{
+  if (m_rtProp == Time::Max ())
+    {
+      return tcb->m_initialCWnd * tcb->m_segmentSize;
+    }
+  return gain * (bw * m_rtProp) / 8.0;
+}
+
+uint32_t
+TcpBbr2::TargetInflight (Ptr<TcpSocketState> tcb) const
+{
+  return std::min (Bdp (tcb, GetBw (), 1), tcb->m_cWnd.Get ());
+}
+
+uint32_t
+TcpBbr2::InflightWithHeadroom () const
+{
+  if (m_inflightHi == UINT32_MAX)
+    {
+      return UINT32_MAX;
+    }
+  uint32_t headroom = m_inflightHi * m_inflightHeadroom;
+  if (headroom >= m_inflightHi)
+    {
+      return m_minPipeCwnd;
+    }
+  return std::max (m_inflightHi - headroom, m_minPipeCwnd);
+}
+
+bool
+TcpBbr2::IsProbingBandwidth () const
+{
+  return m_state == BbrMode_t::BBR_STARTUP
+         || (m_state == BbrMode_t::BBR_PROBE_BW
+             && (m_probeBwPhase == BBR2_BW_PROBE_REFILL || m_probeBwPhase == BBR2_BW_PROBE_UP));
+}
+
+void
+TcpBbr2::SetProbeBwPhase (Bbr2ProbeBwPhase_t phase)
+{
+  NS_LOG_FUNCTION (this << phase);
+  NS_LOG_DEBUG (Simulator::Now () << " Changing from " << Bbr2ProbeBwPhaseName[m_probeBwPhase] <<
+                " to " << Bbr2ProbeBwPhaseName[phase]);
+  m_probeBwPhase = phase;
+  m_pacingGain = PROBE_BW_PACING_GAIN [phase];
+  m_cWndGain = 2;
+}
+
+void
+TcpBbr2::PickProbeWait ()
+{
+  NS_LOG_FUNCTION (this);
+  m_roundsSinceProbe = (uint32_t) m_uv->GetValue (0, m_bwProbeRandRounds);
+  m_bwProbeWait = m_bwProbeBaseWait + Seconds (m_uv->GetValue (0, m_bwProbeRandWait.GetSeconds ()));
+}
+
+void
+TcpBbr2::ResetLowerBounds ()
+{
+  NS_LOG_FUNCTION (this);
+  m_bwLo = DataRate (0);
+  m_inflightLo = UINT32_MAX;
+}
+
+void
+TcpBbr2::ResetCongestionSignals ()
+{
+  NS_LOG_FUNCTION (this);
+  m_lossInRound = false;
+  m_ecnInRound = false;
+  m_bwLatest = DataRate (0);
+  m_inflightLatest = 0;
+}
+
+void
+TcpBbr2::StartBwProbeDown ()
+{
+  NS_LOG_FUNCTION (this);
+  ResetCongestionSignals ();
+  m_bwProbeUpCnt = UINT32_MAX;
+  PickProbeWait ();
+  m_cycleStamp = Simulator::Now ();
+  m_ackPhase = BBR2_ACKS_PROBE_STOPPING;
+  m_nextRoundDelivered = m_delivered;
+  SetProbeBwPhase (BBR2_BW_PROBE_DOWN);
+}
+
+void
+TcpBbr2::StartBwProbeCruise ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_inflightLo != UINT32_MAX)
+    {
+      m_inflightLo = std::min (m_inflightLo, m_inflightHi);
+    }
+  SetProbeBwPhase (BBR2_BW_PROBE_CRUISE);
+}
+
+void
+TcpBbr2::StartBwProbeRefill ()
+{
+  NS_LOG_FUNCTION (this);
+  ResetLowerBounds ();
+  m_bwProbeUpRounds = 0;
+  m_bwProbeUpAcks = 0;
+  m_stoppedRiskyProbe = false;
+  m_ackPhase = BBR2_ACKS_REFILLING;
+  m_nextRoundDelivered = m_delivered;
+  SetProbeBwPhase (BBR2_BW_PROBE_REFILL);
+}
+
+void
+TcpBbr2::StartBwProbeUp (Ptr<TcpSocketState> tcb)
+{
+  NS_LOG_FUNCTION (this << tcb);
+  m_ackPhase = BBR2_ACKS_PROBE_STARTING;
+  m_nextRoundDelivered = m_delivered;
+  m_cycleStamp = Simulator::Now ();
+  SetProbeBwPhase (BBR2_BW_PROBE_UP);
+  RaiseInflightHiSlope (tcb);
+}
+
+bool
+TcpBbr2::CheckTimeToProbeBw (Ptr<TcpSocketState> tcb)
+{
+  NS_LOG_FUNCTION (this << tcb);
+  // Probe at least every m_bwProbeMaxRounds rounds, or every BDP worth of
+  // rounds if that is shorter, so as to be as fair as Reno/CUBIC at the
+  // same BDP
+  uint32_t renoRounds = std::min (m_bwProbeMaxRounds, TargetInflight (tcb) / tcb->m_segmentSize);
+  if (Simulator::Now () - m_cycleStamp > m_bwProbeWait || m_roundsSinceProbe >= renoRounds)
+    {
+      StartBwProbeRefill ();
+      return true;
+    }
+  return false;
+}
+
+bool
+TcpBbr2::CheckTimeToCruise (Ptr<TcpSocketState> tcb, uint32_t inflight) const
+{
+  NS_LOG_FUNCTION (this << tcb << inflight);
+  if (inflight > InflightWithHeadroom ())
+    {
+      return false;
+    }
+  return inflight <= Bdp (tcb, m_maxBwFilter.GetBest (), 1);
+}
+
+bool
+TcpBbr2::IsInflightTooHigh (const TcpRateOps::TcpRateSample &rs, uint32_t ceBytes) const
+{
+  if (rs.m_bytesLoss > 0 && rs.m_priorInFlight > 0
+      && rs.m_bytesLoss > m_lossThresh * rs.m_priorInFlight)
+    {
+      NS_LOG_DEBUG ("Loss rate too high: lost " << rs.m_bytesLoss << " of " << rs.m_priorInFlight);
+      return true;
+    }
+
+  if (ceBytes > 0 && m_delivered > m_alphaLastDelivered)
+    {
+      double ceRatio = static_cast<double> (m_deliveredCe - m_alphaLastDeliveredCe)
+                       / (m_delivered - m_alphaLastDelivered);
+      if (ceRatio >= m_ecnThresh)
+        {
+          NS_LOG_DEBUG ("ECN mark ratio too high: " << ceRatio);
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+TcpBbr2::HandleInflightTooHigh (Ptr<TcpSocketState> tcb, const TcpRateOps::TcpRateSample &rs)
+{
+  NS_LOG_FUNCTION (this << tcb << rs);
+  m_prevProbeTooHigh = true;
+  m_bwProbeSamples = false;
+  if (!rs.m_isAppLimited)
+    {
+      m_inflightHi = std::max (rs.m_priorInFlight,
+                               static_cast<uint32_t> (TargetInflight (tcb) * m_beta));
+    }
+  if (m_state == BbrMode_t::BBR_PROBE_BW && m_probeBwPhase == BBR2_BW_PROBE_UP)
+    {
+      StartBwProbeDown ();
+    }
+}
+
+void
+TcpBbr2::RaiseInflightHiSlope (Ptr<TcpSocketState> tcb)
+{
+  NS_LOG_FUNCTION (this << tcb);
+  uint32_t growthThisRound = 1 << m_bwProbeUpRounds;
+  m_bwProbeUpRounds = std::min<uint32_t> (m_bwProbeUpRounds + 1, 30);
+  m_bwProbeUpCnt = std::max<uint32_t> (tcb->m_cWnd / tcb->m_segmentSize / growthThisRound, 1);
+}
+
+void
+TcpBbr2::ProbeInflightHiUpward (Ptr<TcpSocketState> tcb, const TcpRateOps::TcpRateSample &rs)
+{
+  NS_LOG_FUNCTION (this << tcb << rs);
+  if (rs.m_isAppLimited || tcb->m_cWnd < m_inflightHi)
+    {
+      // Not fully using inflight_hi, so don't grow it
+      m_bwProbeUpAcks = 0;
+      return;
+    }
+
+  // For each m_bwProbeUpCnt segments acked, grow inflight_hi by one segment
+  m_bwProbeUpAcks += rs.m_ackedSacked;
+  uint64_t upCntBytes = static_cast<uint64_t> (m_bwProbeUpCnt) * tcb->m_segmentSize;
+  if (m_bwProbeUpAcks >= upCntBytes)
+    {
+      uint32_t delta = m_bwProbeUpAcks / upCntBytes;
+      m_bwProbeUpAcks -= delta * upCntBytes;
+      m_inflightHi += delta * tcb->m_segmentSize;
+    }
+  if (m_roundStart)
+    {
+      RaiseInflightHiSlope (tcb);
+    }
+}
+
+bool
+TcpBbr2::AdaptUpperBounds (Ptr<TcpSocketState> tcb, const TcpRateOps::TcpRateSample &rs, uint32_t ceBytes)
+{
+  NS_LOG_FUNCTION (this << tcb << rs << ceBytes);
+  if (m_ackPhase == BBR2_ACKS_PROBE_STARTING && m_roundStart)
+    {
+      m_ackPhase = BBR2_ACKS_PROBE_FEEDBACK;
+    }
+  if (m_ackPhase == BBR2_ACKS_PROBE_STOPPING && m_roundStart)
+    {
+      // End of samples from the bandwidth probe
+      m_bwProbeSamples = false;
+      m_ackPhase = BBR2_ACKS_INIT;
+      if (m_state == BbrMode_t::BBR_PROBE_BW && m_stoppedRiskyProbe && !m_prevProbeTooHigh)
+        {
+          StartBwProbeRefill ();
+          return true;
+        }
+    }
+
+  if (IsInflightTooHigh (rs, ceBytes))
+    {
+      if (m_bwProbeSamples)
+        {
+          HandleInflightTooHigh (tcb, rs);
+        }
+    }
+  else
+    {
+      if (m_inflightHi == UINT32_MAX)
+        {
+          return false;
+        }
+      if (rs.m_priorInFlight > m_inflightHi)
+        {
+          m_inflightHi = rs.m_priorInFlight;
+        }
+      if (m_state == BbrMode_t::BBR_PROBE_BW && m_probeBwPhase == BBR2_BW_PROBE_UP)
+        {
+          ProbeInflightHiUpward (tcb, rs);
+        }
+    }
+  return false;
+}
+
+void
+TcpBbr2::UpdateCyclePhase (Ptr<TcpSocketState> tcb, const TcpRateOps::TcpRateSample &rs, uint32_t ceBytes)
+{
+  NS_LOG_FUNCTION (this << tcb << rs << ceBytes);
+  if (!m_isPipeFilled)
+    {
+      return;
+    }
+
+  if (AdaptUpperBounds (tcb, rs, ceBytes) || m_state != BbrMode_t::BBR_PROBE_BW)
+    {
+      return;
+    }
+
+  uint32_t inflight = tcb->m_bytesInFlight.Get ();
+  switch (m_probeBwPhase)
+    {
+      case BBR2_BW_PROBE_CRUISE:
+        CheckTimeToProbeBw (tcb);
+        break;
+      case BBR2_BW_PROBE_REFILL:
+        // After one round of refilling, start probing up
+        if (m_roundStart)
+          {
+            m_bwProbeSamples = true;
+            StartBwProbeUp (tcb);
+          }
+        break;
+      case BBR2_BW_PROBE_UP:
+        {
+          bool isRisky = false;
+          bool isQueuing = false;
+          if (m_prevProbeTooHigh && inflight >= m_inflightHi)
+            {
+              m_stoppedRiskyProbe = true;
+              isRisky = true;
+            }
+          else if (Simulator::Now () - m_cycleStamp > m_rtProp
+                   && inflight >= Bdp (tcb, m_maxBwFilter.GetBest (), PROBE_BW_PACING_GAIN [BBR2_BW_PROBE_UP]))
+            {
+              isQueuing = true;
+            }
+          if (isRisky || isQueuing)
+            {
+              m_prevProbeTooHigh = false;
+              StartBwProbeDown ();
+            }
+        }
+        break;
+      case BBR2_BW_PROBE_DOWN:
+        if (CheckTimeToProbeBw (tcb))
+          {
+            break;
+          }
+        if (CheckTimeToCruise (tcb, inflight))
+          {
+            StartBwProbeCruise ();
+          }
+        break;
+      default:
+        NS_ASSERT (false);
+    }
+}
+
+void
+TcpBbr2::AdaptLowerBounds (Ptr<TcpSocketState> tcb)
+{
+  NS_LOG_FUNCTION (this << tcb);
+  // The lower bounds only react to congestion while not probing
+  if (IsProbingBandwidth () || (!m_lossInRound && !m_ecnInRound))
+    {
+      return;
+    }
+
+  if (m_bwLo.GetBitRate () == 0)
+    {
+      m_bwLo = m_maxBwFilter.GetBest ();
+    }
+  if (m_inflightLo == UINT32_MAX)
+    {
+      m_inflightLo = tcb->m_cWnd;
+    }
+
+  uint32_t ecnInflightLo = UINT32_MAX;
+  if (m_ecnInRound)
+    {
+      ecnInflightLo = m_inflightLo * (1 - m_ecnAlpha * m_ecnFactor);
+    }
+  if (m_lossInRound)
+    {
+      m_bwLo = std::max (m_bwLatest, DataRate (m_bwLo.GetBitRate () * m_beta));
+      m_inflightLo = std::max (m_inflightLatest, static_cast<uint32_t> (m_inflightLo * m_beta));
+    }
+  m_inflightLo = std::min (m_inflightLo, ecnInflightLo);
+  NS_LOG_DEBUG ("bw_lo " << m_bwLo << " inflight_lo " << m_inflightLo);
+}
+
+void
+TcpBbr2::UpdateCongestionSignals (Ptr<TcpSocketState> tcb, const TcpRateOps::TcpRateSample &rs, uint32_t ceBytes)
+{
+  NS_LOG_FUNCTION (this << tcb << rs << ceBytes);
+  m_lossRoundStart = false;
+  if (rs.m_interval <= Seconds (0) || !rs.m_ackedSacked)
+    {
+      return;
+    }
+
+  m_bwLatest = std::max (m_bwLatest, rs.m_deliveryRate);
+  m_inflightLatest = std::max<uint32_t> (m_inflightLatest, std::max (rs.m_delivered, 0));
+
+  if (rs.m_priorDelivered >= m_lossRoundDelivered)
+    {
+      m_lossRoundDelivered = m_delivered;
+      m_lossRoundStart = true;
+    }
+  if (rs.m_bytesLoss > 0)
+    {
+      m_lossInRound = true;
+    }
+  if (ceBytes > 0)
+    {
+      m_ecnInRound = true;
+    }
+
+  if (!m_lossRoundStart)
+    {
+      return;
+    }
+
+  AdaptLowerBounds (tcb);
+
+  m_lossInRound = false;
+  m_ecnInRound = false;
+  m_bwLatest = rs.m_deliveryRate;
+  m_inflightLatest = std::max (rs.m_delivered, 0);
+}
+
+void
+TcpBbr2::UpdateEcnAlpha ()
+{
+  NS_LOG_FUNCTION (this);
+  uint64_t delivered = m_delivered - m_alphaLastDelivered;
+  if (delivered == 0)
+    {
+      return;
+    }
+  m_ecnCeRatio = std::min (1.0, static_cast<double> (m_deliveredCe - m_alphaLastDeliveredCe) / delivered);
+  m_ecnAlpha = (1 - m_ecnAlphaGain) * m_ecnAlpha + m_ecnAlphaGain * m_ecnCeRatio;
+  m_alphaLastDelivered = m_delivered;
+  m_alphaLastDeliveredCe = m_deliveredCe;
+}
+
+void
+TcpBbr2::CheckStartupTooHigh (Ptr<TcpSocketState> tcb, const TcpRateOps::TcpRateSample &rs, uint32_t ceBytes)
+{
+  NS_LOG_FUNCTION (this << tcb << rs << ceBytes);
+  if (m_isPipeFilled)
+    {
+      return;
+    }
+
+  if (rs.m_bytesLoss > 0 && m_lossEventsInRound < 15)
+    {
+      m_lossEventsInRound++;
+    }
+
+  bool tooHigh = false;
+  if (m_lossRoundStart)
+    {
+      tooHigh = tcb->m_congState == TcpSocketState::CA_RECOVERY
+                && m_lossEventsInRound >= m_fullLossCount
+                && IsInflightTooHigh (rs, ceBytes);
+      m_lossEventsInRound = 0;
+    }
+  if (m_roundStart && tcb->m_ecnState != TcpSocketState::ECN_DISABLED
+      && m_ecnCeRatio > 0 && m_ecnCeRatio >= m_ecnThresh)
+    {
+      tooHigh = true;
+    }
+
+  if (tooHigh)
+    {
+      NS_LOG_DEBUG ("Queue too high in STARTUP, pipe filled");
+      m_isPipeFilled = true;
+      m_inflightHi = Bdp (tcb, m_maxBwFilter.GetBest (), 1);
+    }
+}
+
+void
+TcpBbr2::CheckDrainDone (Ptr<TcpSocketState> tcb)
+{
+  NS_LOG_FUNCTION (this << tcb);
+  if (m_state == BbrMode_t::BBR_STARTUP && m_isPipeFilled)
+    {
+      EnterDrain ();
+      tcb->m_ssThresh = Bdp (tcb, m_maxBwFilter.GetBest (), 1);
+    }
+
+  if (m_state == BbrMode_t::BBR_DRAIN
+      && tcb->m_bytesInFlight <= Bdp (tcb, m_maxBwFilter.GetBest (), 1))
+    {
+      SetBbrState (BbrMode_t::BBR_PROBE_BW);
+      StartBwProbeDown ();
+    }
+}
+
+void
+TcpBbr2::ExitProbeRtt (Ptr<TcpSocketState> tcb)
+{
+  NS_LOG_FUNCTION (this << tcb);
+  m_probeRttMinStamp = Simulator::Now ();
+  RestoreCwnd (tcb);
+  ResetLowerBounds ();
+  if (m_isPipeFilled)
+    {
+      SetBbrState (BbrMode_t::BBR_PROBE_BW);
+      StartBwProbeDown ();
+      StartBwProbeCruise ();
+    }
+  else
+    {
+      EnterStartup ();
+    }
+}
+
+void
+TcpBbr2::UpdateMinRtt (Ptr<TcpSocketState> tcb, const TcpRateOps::TcpRateSample &rs)
+{
+  NS_LOG_FUNCTION (this << tcb << rs);
+  m_probeRttExpired = Simulator::Now () > (m_probeRttMinStamp + m_probeRttInterval);
+  if (tcb->m_lastRtt >= Seconds (0) && (tcb->m_lastRtt < m_probeRttMin || m_probeRttExpired))
+    {
+      m_probeRttMin = tcb->m_lastRtt;
+      m_probeRttMinStamp = Simulator::Now ();
+    }
+  UpdateRTprop (tcb);
+
+  if (m_probeRttExpired && !m_idleRestart && m_state != BbrMode_t::BBR_PROBE_RTT)
+    {
+      EnterProbeRTT ();
+      SaveCwnd (tcb);
+      m_probeRttDoneStamp = Seconds (0);
+      m_ackPhase = BBR2_ACKS_PROBE_STOPPING;
+      m_nextRoundDelivered = m_delivered;
+    }
+
+  if (m_state == BbrMode_t::BBR_PROBE_RTT)
+    {
+      m_appLimited = (m_delivered + tcb->m_bytesInFlight.Get ()) ? : 1;
+      uint32_t probeRttCwnd = std::max (Bdp (tcb, GetBw (), m_probeRttCwndGain), m_minPipeCwnd);
+      if (m_probeRttDoneStamp == Seconds (0) && tcb->m_bytesInFlight <= probeRttCwnd)
+        {
+          m_probeRttDoneStamp = Simulator::Now () + m_probeRttDuration;
+          m_probeRttRoundDone = false;
+          m_nextRoundDelivered = m_delivered;
+        }
+      else if (m_probeRttDoneStamp != Seconds (0))
+        {
+          if (m_roundStart)
+            {
+              m_probeRttRoundDone = true;
+            }
+          if (m_probeRttRoundDone && Simulator::Now () > m_probeRttDoneStamp)
+            {
+              ExitProbeRtt (tcb);
+            }
+        }
+    }
+
+  if (rs.m_delivered > 0)
+    {
+      m_idleRestart = false;
+    }
+}
+
+void
+TcpBbr2::SetPacingRateBounded (Ptr<TcpSocketState> tcb, double gain)
+{
+  NS_LOG_FUNCTION (this << tcb << gain);
+  DataRate rate (gain * GetBw ().GetBitRate ());
+  rate = std::min (rate, tcb->m_maxPacingRate);
+
+  if (!m_hasSeenRtt && tcb->m_minRtt != Time::Max ())
+    {
+      InitPacingRate (tcb);
+    }
+
+  if (m_isPipeFilled || rate > tcb->m_pacingRate)
+    {
+      tcb->m_pacingRate = rate;
+    }
+}
+
+void
+TcpBbr2::SetCwndBounded (Ptr<TcpSocketState> tcb, const TcpRateOps::TcpRateSample &rs)
+{
+  NS_LOG_FUNCTION (this << tcb << rs);
+
+  if (rs.m_ackedSacked
+      && !(tcb->m_congState == TcpSocketState::CA_RECOVERY && ModulateCwndForRecovery (tcb, rs)))
+    {
+      m_targetCWnd = Bdp (tcb, GetBw (), m_cWndGain) + 3 * m_sendQuantum + AckAggregationCwnd ();
+      if (m_state == BbrMode_t::BBR_PROBE_BW && m_probeBwPhase == BBR2_BW_PROBE_UP)
+        {
+          m_targetCWnd += 2 * tcb->m_segmentSize;
+        }
+
+      if (m_isPipeFilled)
+        {
+          tcb->m_cWnd = std::min (tcb->m_cWnd.Get () + (uint32_t) rs.m_ackedSacked, m_targetCWnd);
+        }
+      else if (tcb->m_cWnd < m_targetCWnd || m_delivered < tcb->m_initialCWnd * tcb->m_segmentSize)
+        {
+          tcb->m_cWnd = tcb->m_cWnd.Get () + rs.m_ackedSacked;
+        }
+      tcb->m_cWnd = std::max (tcb->m_cWnd.Get (), m_minPipeCwnd);
+    }
+
+  // Bound cwnd by the loss/ECN-aware inflight model
+  uint32_t cap = UINT32_MAX;
+  if (m_state == BbrMode_t::BBR_PROBE_BW && m_probeBwPhase != BBR2_BW_PROBE_CRUISE)
+    {
+      cap = m_inflightHi;
+    }
+  else if (m_state == BbrMode_t::BBR_PROBE_RTT
+           || (m_state == BbrMode_t::BBR_PROBE_BW && m_probeBwPhase == BBR2_BW_PROBE_CRUISE))
+    {
+      cap = InflightWithHeadroom ();
+    }
+  cap = std::max (std::min (cap, m_inflightLo), m_minPipeCwnd);
+  tcb->m_cWnd = std::min (tcb->m_cWnd.Get (), cap);
+
+  if (m_state == BbrMode_t::BBR_PROBE_RTT)
+    {
+      uint32_t probeRttCwnd = std::max (Bdp (tcb, GetBw (), m_probeRttCwndGain), m_minPipeCwnd);
+      tcb->m_cWnd = std::min (tcb->m_cWnd.Get (), probeRttCwnd);
+    }
+}
+
+std::string
+TcpBbr2::GetName () const
+{
+  return "TcpBbr2";
+}
+
+void
+TcpBbr2::CongControl (Ptr<TcpSocketState> tcb,
+                      const TcpRateOps::TcpRateConnection &rc,
+                      const TcpRateOps::TcpRateSample &rs)
+{
+  NS_LOG_FUNCTION (this << tcb << rs);
+  m_delivered = rc.m_delivered;
+  m_txItemDelivered = rc.m_txItemDelivered;
+
+  // With classic ECN, an ACK carrying ECE is taken as all of its newly
+  // acked data having been CE marked
+  uint32_t ceBytes = 0;
+  if (tcb->m_ecnState == TcpSocketState::ECN_ECE_RCVD)
+    {
+      ceBytes = rs.m_ackedSacked;
+      m_deliveredCe += ceBytes;
+    }
+
+  m_roundStart = false;
+  UpdateBtlBw (tcb, rs);
+  if (m_roundStart)
+    {
+      m_roundsSinceProbe++;
+      UpdateEcnAlpha ();
+    }
+  UpdateCongestionSignals (tcb, rs, ceBytes);
+  UpdateAckAggregation (tcb, rs);
+  CheckStartupTooHigh (tcb, rs, ceBytes);
+  CheckFullPipe (rs);
+  CheckDrainDone (tcb);
+  UpdateCyclePhase (tcb, rs, ceBytes);
+  UpdateMinRtt (tcb, rs);
+
+  SetPacingRateBounded (tcb, m_pacingGain);
+  SetSendQuantum (tcb);
+  SetCwndBounded (tcb, rs);
+}
+
+void
+TcpBbr2::CongestionStateSet (Ptr<TcpSocketState> tcb,
+                             const TcpSocketState::TcpCongState_t newState)
+{
+  NS_LOG_FUNCTION (this << tcb << newState);
+  if (newState == TcpSocketState::CA_OPEN && !m_isInitialized)
+    {
+      TcpBbr::CongestionStateSet (tcb, newState);
+      m_probeRttMin = m_rtProp;
+      m_probeRttMinStamp = Simulator::Now ();
+      m_probeBwPhase = BBR2_BW_PROBE_DOWN;
+      m_ackPhase = BBR2_ACKS_INIT;
+      m_inflightHi = UINT32_MAX;
+      m_bwProbeUpCnt = UINT32_MAX;
+      m_bwProbeUpAcks = 0;
+      m_bwProbeUpRounds = 0;
+      m_bwProbeSamples = false;
+      m_prevProbeTooHigh = false;
+      m_stoppedRiskyProbe = false;
+      m_lossRoundDelivered = 0;
+      m_lossEventsInRound = 0;
+      m_deliveredCe = 0;
+      m_alphaLastDelivered = 0;
+      m_alphaLastDeliveredCe = 0;
+      m_ecnAlpha = 1.0;
+      m_ecnCeRatio = 0;
+      ResetLowerBounds ();
+      ResetCongestionSignals ();
+    }
+  else if (newState == TcpSocketState::CA_LOSS)
+    {
+      TcpBbr::CongestionStateSet (tcb, newState);
+      m_fullBandwidth = 0;
+      // The lower bounds adapt from the cwnd used before the RTO
+      if (!IsProbingBandwidth () && m_inflightLo == UINT32_MAX)
+        {
+          m_inflightLo = std::max (tcb->m_cWnd.Get (), m_priorCwnd);
+        }
+      m_lossInRound = true;
+      if (m_bwProbeSamples)
+        {
+          HandleInflightTooHigh (tcb, TcpRateOps::TcpRateSample ());
+        }
+    }
+  else
+    {
+      TcpBbr::CongestionStateSet (tcb, newState);
+    }
+}
+
+void
+TcpBbr2::CwndEvent (Ptr<TcpSocketState> tcb,
+                    const TcpSocketState::TcpCAEvent_t event)
+{
+  NS_LOG_FUNCTION (this << tcb << event);
+  if (event == TcpSocketState::CA_EVENT_TX_START && m_appLimited)
+    {
+      NS_LOG_DEBUG ("CwndEvent triggered to CA_EVENT_TX_START :: " << event);
+      m_idleRestart = true;
+      m_ackEpochTime = Simulator::Now ();
+      m_ackEpochAcked = 0;
+      if (m_state == BbrMode_t::BBR_PROBE_BW)
+        {
+          SetPacingRateBounded (tcb, 1);
+        }
+      else if (m_state == BbrMode_t::BBR_PROBE_RTT)
+        {
+          if (m_probeRttRoundDone && Simulator::Now () > m_probeRttDoneStamp)
+            {
+              ExitProbeRtt (tcb);
+            }
+        }
+    }
+  else
+    {
+      TcpBbr::CwndEvent (tcb, event);
+    }
+}
+
+Ptr<TcpCongestionOps>
+TcpBbr2::Fork (void)
+{
+  return CopyObject<TcpBbr2> (this);
+}
+
+} // namespace ns3
@@ -0,0 +1,372 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TCPBBR2_H
+#define TCPBBR2_H
+
+#include "ns3/tcp-bbr.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup congestionOps
+ *
+ * \brief BBRv2 congestion control
+ *
+ * BBRv2 keeps the BBR network model (windowed max bandwidth filter,
+ * min RTT, ack aggregation estimate) inherited from TcpBbr, and adds
+ * loss and ECN awareness through two sets of bounds on the model:
+ *
+ * - long-term upper bounds (inflight_hi), learned while probing for
+ *   bandwidth and lowered when a probe causes excessive loss or ECN marks;
+ * - short-term lower bounds (bw_lo, inflight_lo), lowered once per round
+ *   trip that sees congestion signals while not probing.
+ *
+ * The PROBE_BW state is split into the DOWN, CRUISE, REFILL and UP
+ * phases; the wait between bandwidth probes is randomized and bounded
+ * so that BBRv2 coexists with Reno/CUBIC flows.
+ *
+ * The implementation follows the Linux v2alpha code (tcp_bbr2.c).
+ */
+class TcpBbr2 : public TcpBbr
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief Constructor
+   */
+  TcpBbr2 ();
+
+  /**
+   * Copy constructor.
+   * \param sock The socket to copy from.
+   */
+  TcpBbr2 (const TcpBbr2 &sock);
+
+  /**
+   * \brief Phases of the BBRv2 PROBE_BW state
+   */
+  typedef enum
+  {
+    BBR2_BW_PROBE_UP,     /**< Push up inflight to probe for bandwidth */
+    BBR2_BW_PROBE_DOWN,   /**< Drain excess inflight from the queue */
+    BBR2_BW_PROBE_CRUISE, /**< Use pipe, with headroom in queue and pipe */
+    BBR2_BW_PROBE_REFILL, /**< Refill the pipe, to prepare for probing up */
+  } Bbr2ProbeBwPhase_t;
+
+  /**
+   * \brief What a bandwidth probe is currently waiting for in the ACK stream
+   */
+  typedef enum
+  {
+    BBR2_ACKS_INIT,           /**< Not probing; not getting probe feedback */
+    BBR2_ACKS_REFILLING,      /**< Sending at est. bw to fill pipe */
+    BBR2_ACKS_PROBE_STARTING, /**< Inflight rising to probe bw */
+    BBR2_ACKS_PROBE_FEEDBACK, /**< Getting feedback from bw probing */
+    BBR2_ACKS_PROBE_STOPPING, /**< Stopped probing; still getting feedback */
+  } Bbr2AckPhase_t;
+
+  /**
+   * \brief Literal names of PROBE_BW phases for use in log messages
+   */
+  static const char* const Bbr2ProbeBwPhaseName[BBR2_BW_PROBE_REFILL + 1];
+
+  /**
+   * \brief BBRv2 pacing gain for each PROBE_BW phase, indexed by Bbr2ProbeBwPhase_t
+   */
+  const static double PROBE_BW_PACING_GAIN [];
+
+  virtual std::string GetName () const;
+  virtual void CongControl (Ptr<TcpSocketState> tcb,
+                            const TcpRateOps::TcpRateConnection &rc,
+                            const TcpRateOps::TcpRateSample &rs);
+  virtual void CongestionStateSet (Ptr<TcpSocketState> tcb,
+                                   const TcpSocketState::TcpCongState_t newState);
+  virtual void CwndEvent (Ptr<TcpSocketState> tcb,
+                          const TcpSocketState::TcpCAEvent_t event);
+  virtual Ptr<TcpCongestionOps> Fork ();
+
+protected:
+  /**
+   * \brief TcpBbr2CheckGainValuesTest friend class (for tests).
+   * \relates TcpBbr2CheckGainValuesTest
+   */
+  friend class TcpBbr2CheckGainValuesTest;
+
+  /**
+   * \brief TcpBbr2LossResponseTest friend class (for tests).
+   * \relates TcpBbr2LossResponseTest
+   */
+  friend class TcpBbr2LossResponseTest;
+
+  /**
+   * \brief Gets the current PROBE_BW phase.
+   * \return the PROBE_BW phase.
+   */
+  Bbr2ProbeBwPhase_t GetProbeBwPhase () const;
+
+  /**
+   * \brief Gets the bandwidth used by the model, i.e. the max bandwidth
+   *        bounded by the short-term lower bound bw_lo.
+   * \return the bandwidth estimate.
+   */
+  DataRate GetBw () const;
+
+  /**
+   * \brief Computes the bandwidth-delay product scaled by a gain.
+   * \param tcb the socket state.
+   * \param bw the bandwidth.
+   * \param gain the gain to apply.
+   * \return the scaled BDP in bytes.
+   */
+  uint32_t Bdp (Ptr<TcpSocketState> tcb, DataRate bw, double gain) const;
+
+  /**
+   * \brief Computes the inflight target used to judge probe outcomes.
+   * \param tcb the socket state.
+   * \return the target inflight in bytes.
+   */
+  uint32_t TargetInflight (Ptr<TcpSocketState> tcb) const;
+
+  /**
+   * \brief Computes inflight_hi reduced by the configured headroom.
+   * \return the inflight cap in bytes, or UINT32_MAX if inflight_hi is unset.
+   */
+  uint32_t InflightWithHeadroom () const;
+
+  /**
+   * \brief Tells whether BBRv2 is currently probing for bandwidth.
+   * \return true in STARTUP, REFILL and UP.
+   */
+  bool IsProbingBandwidth () const;
+
+  /**
+   * \brief Sets the PROBE_BW phase and its pacing and cwnd gains.
+   * \param phase the new phase.
+   */
+  void SetProbeBwPhase (Bbr2ProbeBwPhase_t phase);
+
+  /**
+   * \brief Randomizes the time and round count to wait before the next probe.
+   */
+  void PickProbeWait ();
+
+  /**
+   * \brief Enters PROBE_BW DOWN.
+   */
+  void StartBwProbeDown ();
+
+  /**
+   * \brief Enters PROBE_BW CRUISE.
+   */
+  void StartBwProbeCruise ();
+
+  /**
+   * \brief Enters PROBE_BW REFILL.
+   */
+  void StartBwProbeRefill ();
+
+  /**
+   * \brief Enters PROBE_BW UP.
+   * \param tcb the socket state.
+   */
+  void StartBwProbeUp (Ptr<TcpSocketState> tcb);
+
+  /**
+   * \brief Checks whether the wait before the next bandwidth probe is over,
+   *        and if so starts refilling the pipe.
+   * \param tcb the socket state.
+   * \return true if the probe has been started.
+   */
+  bool CheckTimeToProbeBw (Ptr<TcpSocketState> tcb);
+
+  /**
+   * \brief Checks whether enough of the queue has been drained to cruise.
+   * \param tcb the socket state.
+   * \param inflight the bytes in flight.
+   * \return true if it is time to cruise.
+   */
+  bool CheckTimeToCruise (Ptr<TcpSocketState> tcb, uint32_t inflight) const;
+
+  /**
+   * \brief Adapts the upper bounds and steps the PROBE_BW phase machine.
+   * \param tcb the socket state.
+   * \param rs rate sample.
+   * \param ceBytes bytes delivered with an ECN echo in this sample.
+   */
+  void UpdateCyclePhase (Ptr<TcpSocketState> tcb, const TcpRateOps::TcpRateSample &rs, uint32_t ceBytes);
+
+  /**
+   * \brief Tells whether the loss or ECN mark rate of a sample is above
+   *        the tolerated thresholds.
+   * \param rs rate sample.
+   * \param ceBytes bytes delivered with an ECN echo in this sample.
+   * \return true if inflight was too high.
+   */
+  bool IsInflightTooHigh (const TcpRateOps::TcpRateSample &rs, uint32_t ceBytes) const;
+
+  /**
+   * \brief Reacts to an inflight level that caused too much loss or marking.
+   * \param tcb the socket state.
+   * \param rs rate sample.
+   */
+  void HandleInflightTooHigh (Ptr<TcpSocketState> tcb, const TcpRateOps::TcpRateSample &rs);
+
+  /**
+   * \brief Grows the inflight_hi increment per round while probing up.
+   * \param tcb the socket state.
+   */
+  void RaiseInflightHiSlope (Ptr<TcpSocketState> tcb);
+
+  /**
+   * \brief Increases inflight_hi while probing up and cwnd-limited.
+   * \param tcb the socket state.
+   * \param rs rate sample.
+   */
+  void ProbeInflightHiUpward (Ptr<TcpSocketState> tcb, const TcpRateOps::TcpRateSample &rs);
+
+  /**
+   * \brief Updates the long-term upper bound inflight_hi.
+   * \param tcb the socket state.
+   * \param rs rate sample.
+   * \param ceBytes bytes delivered with an ECN echo in this sample.
+   * \return true if a PROBE_BW phase transition has been decided.
+   */
+  bool AdaptUpperBounds (Ptr<TcpSocketState> tcb, const TcpRateOps::TcpRateSample &rs, uint32_t ceBytes);
+
+  /**
+   * \brief Updates the short-term lower bounds bw_lo and inflight_lo.
+   * \param tcb the socket state.
+   */
+  void AdaptLowerBounds (Ptr<TcpSocketState> tcb);
+
+  /**
+   * \brief Resets the short-term lower bounds.
+   */
+  void ResetLowerBounds ();
+
+  /**
+   * \brief Resets the per-round congestion signals.
+   */
+  void ResetCongestionSignals ();
+
+  /**
+   * \brief Collects loss and ECN signals, and adapts the lower bounds at the
+   *        end of each loss round.
+   * \param tcb the socket state.
+   * \param rs rate sample.
+   * \param ceBytes bytes delivered with an ECN echo in this sample.
+   */
+  void UpdateCongestionSignals (Ptr<TcpSocketState> tcb, const TcpRateOps::TcpRateSample &rs, uint32_t ceBytes);
+
+  /**
+   * \brief Updates the ECN mark ratio estimate once per round.
+   */
+  void UpdateEcnAlpha ();
+
+  /**
+   * \brief Exits STARTUP if loss or ECN marking is persistently too high.
+   * \param tcb the socket state.
+   * \param rs rate sample.
+   * \param ceBytes bytes delivered with an ECN echo in this sample.
+   */
+  void CheckStartupTooHigh (Ptr<TcpSocketState> tcb, const TcpRateOps::TcpRateSample &rs, uint32_t ceBytes);
+
+  /**
+   * \brief Checks whether to leave STARTUP for DRAIN, and DRAIN for PROBE_BW.
+   * \param tcb the socket state.
+   */
+  void CheckDrainDone (Ptr<TcpSocketState> tcb);
+
+  /**
+   * \brief Updates min RTT and the shorter probe RTT filter, and handles
+   *        the PROBE_RTT state.
+   * \param tcb the socket state.
+   * \param rs rate sample.
+   */
+  void UpdateMinRtt (Ptr<TcpSocketState> tcb, const TcpRateOps::TcpRateSample &rs);
+
+  /**
+   * \brief Leaves PROBE_RTT.
+   * \param tcb the socket state.
+   */
+  void ExitProbeRtt (Ptr<TcpSocketState> tcb);
+
+  /**
+   * \brief Updates the congestion window, bounded by the inflight model.
+   * \param tcb the socket state.
+   * \param rs rate sample.
+   */
+  void SetCwndBounded (Ptr<TcpSocketState> tcb, const TcpRateOps::TcpRateSample &rs);
+
+  /**
+   * \brief Updates the pacing rate using the bounded bandwidth.
+   * \param tcb the socket state.
+   * \param gain pacing gain.
+   */
+  void SetPacingRateBounded (Ptr<TcpSocketState> tcb, double gain);
+
+private:
+  Bbr2ProbeBwPhase_t m_probeBwPhase     {BBR2_BW_PROBE_DOWN};  //!< Current phase of PROBE_BW
+  Bbr2AckPhase_t m_ackPhase             {BBR2_ACKS_INIT};      //!< Probe feedback expected in the ACK stream
+  DataRate    m_bwLo                    {0};                   //!< Short-term lower bound on bandwidth; 0 when unset
+  DataRate    m_bwLatest                {0};                   //!< Max delivery rate in the current loss round
+  uint32_t    m_inflightLo              {UINT32_MAX};          //!< Short-term lower bound on inflight
+  uint32_t    m_inflightHi              {UINT32_MAX};          //!< Long-term upper bound on inflight
+  uint32_t    m_inflightLatest          {0};                   //!< Max delivered data in the current loss round
+  uint32_t    m_bwProbeUpCnt            {UINT32_MAX};          //!< Segments acked before growing inflight_hi by one segment
+  uint32_t    m_bwProbeUpAcks           {0};                   //!< Bytes acked since the last inflight_hi increment
+  uint32_t    m_bwProbeUpRounds         {0};                   //!< Rounds spent probing up, controls the inflight_hi slope
+  uint32_t    m_roundsSinceProbe        {0};                   //!< Packet-timed rounds since the last bandwidth probe
+  Time        m_bwProbeWait             {Seconds (0)};         //!< Wall clock time to wait before the next probe
+  bool        m_bwProbeSamples          {false};               //!< Whether the ACKs carry feedback from a bandwidth probe
+  bool        m_prevProbeTooHigh        {false};               //!< Whether the previous probe hit the loss/ECN limits
+  bool        m_stoppedRiskyProbe       {false};               //!< Whether the last probe was cut short at inflight_hi
+  bool        m_lossInRound             {false};               //!< Whether losses were seen in the current loss round
+  bool        m_ecnInRound              {false};               //!< Whether ECN echoes were seen in the current loss round
+  bool        m_lossRoundStart          {false};               //!< Whether this ACK starts a new loss round
+  uint64_t    m_lossRoundDelivered      {0};                   //!< Delivered count that ends the current loss round
+  uint32_t    m_lossEventsInRound       {0};                   //!< Lossy ACKs in the current round, used in STARTUP
+  uint64_t    m_deliveredCe             {0};                   //!< Total bytes delivered with an ECN echo
+  uint64_t    m_alphaLastDelivered      {0};                   //!< Delivered count at the last ECN alpha update
+  uint64_t    m_alphaLastDeliveredCe    {0};                   //!< ECN-echoed count at the last ECN alpha update
+  double      m_ecnAlpha                {1.0};                 //!< EWMA of the ratio of ECN-echoed bytes per round
+  double      m_ecnCeRatio              {0};                   //!< Ratio of ECN-echoed bytes in the last round
+  double      m_beta                    {0.7};                 //!< Multiplicative decrease of the lower bounds on loss
+  double      m_lossThresh              {0.02};                //!< Tolerated loss rate per round of probing
+  double      m_ecnThresh               {0.5};                 //!< Tolerated ECN mark ratio per round of probing
+  double      m_ecnAlphaGain            {1.0 / 16};            //!< EWMA gain for the ECN mark ratio
+  double      m_ecnFactor               {1.0 / 3};             //!< Fraction of the ECN alpha used to cut inflight_lo
+  double      m_inflightHeadroom        {0.15};                //!< Fraction of inflight_hi left free while cruising
+  uint32_t    m_fullLossCount           {8};                   //!< Lossy ACKs in a round that end STARTUP
+  uint32_t    m_bwProbeMaxRounds        {63};                  //!< Max rounds between probes, for Reno coexistence
+  uint32_t    m_bwProbeRandRounds       {2};                   //!< Max random extra rounds between probes
+  Time        m_bwProbeBaseWait         {Seconds (2)};         //!< Base wall clock time between probes
+  Time        m_bwProbeRandWait         {Seconds (1)};         //!< Max random extra time between probes
+  Time        m_probeRttInterval        {Seconds (5)};         //!< Length of the probe RTT min filter window
+  double      m_probeRttCwndGain        {0.5};                 //!< BDP fraction used as cwnd in PROBE_RTT
+  Time        m_probeRttMin             {Time::Max ()};        //!< Min RTT over the last probe RTT interval
+  Time        m_probeRttMinStamp        {Seconds (0)};         //!< Time at which m_probeRttMin was obtained
+  bool        m_probeRttExpired         {false};               //!< Whether m_probeRttMin has expired
+};
+
+} // namespace ns3
+#endif // TCPBBR2_H
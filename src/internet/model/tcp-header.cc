@@ -22,6 +22,10 @@
 #include <iostream>
 #include "tcp-header.h"
 #include "tcp-option.h"
+#include "tcp-option-rfc793.h"
+#include "tcp-option-winscale.h"
+#include "tcp-option-sack-permitted.h"
+#include "tcp-option-ts.h"
 #include "ns3/buffer.h"
 #include "ns3/address-utils.h"
 #include "ns3/log.h"
@@ -43,7 +47,14 @@ TcpHeader::TcpHeader ()
     m_urgentPointer (0),
     m_calcChecksum (false),
     m_goodChecksum (true),
-    m_optionsLen (0)
+    m_optionsLen (0),
+    m_nOptions (0),
+    m_inlineOptions (0),
+    m_mss (0),
+    m_winScale (0),
+    m_timestamp (0),
+    m_echo (0),
+    m_nSackBlocks (0)
 {
 }
 
@@ -295,9 +306,10 @@ TcpHeader::Print (std::ostream &os)  const
 
   os << " Seq=" << m_sequenceNumber << " Ack=" << m_ackNumber << " Win=" << m_windowSize;
 
+  const TcpOptionList &options = GetOptionList ();
   TcpOptionList::const_iterator op;
 
-  for (op = m_options.begin (); op != m_options.end (); ++op)
+  for (op = options.begin (); op != options.end (); ++op)
     {
       os << " " << (*op)->GetInstanceTypeId ().GetName () << "(";
       (*op)->Print (os);
@@ -328,12 +340,51 @@ TcpHeader::Serialize (Buffer::Iterator start)  const
   // This implementation does not presently try to align options on word
   // boundaries using NOP options
   uint32_t optionLen = 0;
-  TcpOptionList::const_iterator op;
-  for (op = m_options.begin (); op != m_options.end (); ++op)
+  TcpOptionList::const_iterator op = m_options.begin ();
+  for (uint8_t n = 0; n < m_nOptions; ++n)
     {
-      optionLen += (*op)->GetSerializedSize ();
-      (*op)->Serialize (i);
-      i.Next ((*op)->GetSerializedSize ());
+      switch (m_optionKinds[n])
+        {
+        case TcpOption::MSS:
+          i.WriteU8 (TcpOption::MSS);
+          i.WriteU8 (4);
+          i.WriteHtonU16 (m_mss);
+          optionLen += 4;
+          break;
+        case TcpOption::WINSCALE:
+          i.WriteU8 (TcpOption::WINSCALE);
+          i.WriteU8 (3);
+          i.WriteU8 (m_winScale);
+          optionLen += 3;
+          break;
+        case TcpOption::SACKPERMITTED:
+          i.WriteU8 (TcpOption::SACKPERMITTED);
+          i.WriteU8 (2);
+          optionLen += 2;
+          break;
+        case TcpOption::SACK:
+          i.WriteU8 (TcpOption::SACK);
+          i.WriteU8 (2 + 8 * m_nSackBlocks);
+          for (uint8_t b = 0; b < m_nSackBlocks; ++b)
+            {
+              i.WriteHtonU32 (m_sackBlocks[b].first.GetValue ());
+              i.WriteHtonU32 (m_sackBlocks[b].second.GetValue ());
+            }
+          optionLen += 2 + 8 * m_nSackBlocks;
+          break;
+        case TcpOption::TS:
+          i.WriteU8 (TcpOption::TS);
+          i.WriteU8 (10);
+          i.WriteHtonU32 (m_timestamp);
+          i.WriteHtonU32 (m_echo);
+          optionLen += 10;
+          break;
+        default:
+          optionLen += (*op)->GetSerializedSize ();
+          (*op)->Serialize (i);
+          i.Next ((*op)->GetSerializedSize ());
+          ++op;
+        }
     }
 
   // padding to word alignment; add ENDs and/or pad values (they are the same)
@@ -374,6 +425,9 @@ TcpHeader::Deserialize (Buffer::Iterator start)
 
   // Deserialize options if they exist
   m_options.clear ();
+  m_nOptions = 0;
+  m_inlineOptions = 0;
+  m_nSackBlocks = 0;
   uint32_t optionLen = (m_length - 5) * 4;
   if (optionLen > m_maxOptionsLen)
     {
@@ -383,6 +437,60 @@ TcpHeader::Deserialize (Buffer::Iterator start)
   while (optionLen)
     {
       uint8_t kind = i.PeekU8 ();
+      // Fast path for the first well-formed option of each standard kind
+      if (IsInlineKind (kind) && (m_inlineOptions & (1 << kind)) == 0 && optionLen >= 2)
+        {
+          Buffer::Iterator j = i;
+          j.Next (1);
+          uint8_t size = j.PeekU8 ();
+          bool wellFormed = false;
+          switch (kind)
+            {
+            case TcpOption::MSS:
+              wellFormed = (size == 4);
+              break;
+            case TcpOption::WINSCALE:
+              wellFormed = (size == 3);
+              break;
+            case TcpOption::SACKPERMITTED:
+              wellFormed = (size == 2);
+              break;
+            case TcpOption::SACK:
+              wellFormed = (size >= 2 && (size - 2) % 8 == 0 && (size - 2) / 8 <= m_maxSackBlocks);
+              break;
+            case TcpOption::TS:
+              wellFormed = (size == 10);
+              break;
+            }
+          if (wellFormed && size <= optionLen)
+            {
+              i.Next (2);
+              switch (kind)
+                {
+                case TcpOption::MSS:
+                  m_mss = i.ReadNtohU16 ();
+                  break;
+                case TcpOption::WINSCALE:
+                  m_winScale = i.ReadU8 ();
+                  break;
+                case TcpOption::SACK:
+                  m_nSackBlocks = (size - 2) / 8;
+                  for (uint8_t b = 0; b < m_nSackBlocks; ++b)
+                    {
+                      m_sackBlocks[b].first = SequenceNumber32 (i.ReadNtohU32 ());
+                      m_sackBlocks[b].second = SequenceNumber32 (i.ReadNtohU32 ());
+                    }
+                  break;
+                case TcpOption::TS:
+                  m_timestamp = i.ReadNtohU32 ();
+                  m_echo = i.ReadNtohU32 ();
+                  break;
+                }
+              AddOptionEntry (kind, size);
+              optionLen -= size;
+              continue;
+            }
+        }
       Ptr<TcpOption> op;
       uint32_t optionSize;
       if (TcpOption::IsKindKnown (kind))
@@ -405,7 +513,7 @@ TcpHeader::Deserialize (Buffer::Iterator start)
           optionLen -= optionSize;
           i.Next (optionSize);
           m_options.push_back (op);
-          m_optionsLen += optionSize;
+          AddOptionEntry (TcpOption::UNKNOWN, optionSize);
         }
       else
         {
@@ -445,11 +553,19 @@ uint8_t
 TcpHeader::CalculateHeaderLength () const
 {
   uint32_t len = 20;
-  TcpOptionList::const_iterator i;
+  TcpOptionList::const_iterator op = m_options.begin ();
 
-  for (i = m_options.begin (); i != m_options.end (); ++i)
+  for (uint8_t n = 0; n < m_nOptions; ++n)
     {
-      len += (*i)->GetSerializedSize ();
+      if (m_optionKinds[n] == TcpOption::UNKNOWN)
+        {
+          len += (*op)->GetSerializedSize ();
+          ++op;
+        }
+      else
+        {
+          len += GetInlineOptionSize (m_optionKinds[n]);
+        }
     }
   // Option list may not include padding; need to pad up to word boundary
   if (len % 4)
@@ -459,6 +575,93 @@ TcpHeader::CalculateHeaderLength () const
   return len >> 2;
 }
 
+bool
+TcpHeader::IsInlineKind (uint8_t kind)
+{
+  switch (kind)
+    {
+    case TcpOption::MSS:
+    case TcpOption::WINSCALE:
+    case TcpOption::SACKPERMITTED:
+    case TcpOption::SACK:
+    case TcpOption::TS:
+      return true;
+    }
+  return false;
+}
+
+uint8_t
+TcpHeader::GetInlineOptionSize (uint8_t kind) const
+{
+  switch (kind)
+    {
+    case TcpOption::MSS:
+      return 4;
+    case TcpOption::WINSCALE:
+      return 3;
+    case TcpOption::SACKPERMITTED:
+      return 2;
+    case TcpOption::SACK:
+      return 2 + 8 * m_nSackBlocks;
+    case TcpOption::TS:
+      return 10;
+    }
+  NS_FATAL_ERROR ("Option kind " << static_cast<int> (kind) << " is not stored inline");
+  return 0;
+}
+
+Ptr<TcpOption>
+TcpHeader::CreateInlineOption (uint8_t kind) const
+{
+  switch (kind)
+    {
+    case TcpOption::MSS:
+      {
+        Ptr<TcpOptionMSS> option = CreateObject<TcpOptionMSS> ();
+        option->SetMSS (m_mss);
+        return option;
+      }
+    case TcpOption::WINSCALE:
+      {
+        Ptr<TcpOptionWinScale> option = CreateObject<TcpOptionWinScale> ();
+        option->SetScale (m_winScale);
+        return option;
+      }
+    case TcpOption::SACKPERMITTED:
+      return CreateObject<TcpOptionSackPermitted> ();
+    case TcpOption::SACK:
+      {
+        Ptr<TcpOptionSack> option = CreateObject<TcpOptionSack> ();
+        for (uint8_t b = 0; b < m_nSackBlocks; ++b)
+          {
+            option->AddSackBlock (m_sackBlocks[b]);
+          }
+        return option;
+      }
+    case TcpOption::TS:
+      {
+        Ptr<TcpOptionTS> option = CreateObject<TcpOptionTS> ();
+        option->SetTimestamp (m_timestamp);
+        option->SetEcho (m_echo);
+        return option;
+      }
+    }
+  NS_FATAL_ERROR ("Option kind " << static_cast<int> (kind) << " is not stored inline");
+  return 0;
+}
+
+void
+TcpHeader::AddOptionEntry (uint8_t kind, uint8_t size)
+{
+  NS_ASSERT (m_nOptions < m_maxOptionsLen);
+  m_optionKinds[m_nOptions++] = kind;
+  m_optionsLen += size;
+  if (kind != TcpOption::UNKNOWN)
+    {
+      m_inlineOptions |= (1 << kind);
+    }
+}
+
 bool
 TcpHeader::AppendOption (Ptr<const TcpOption> option)
 {
@@ -472,8 +675,42 @@ TcpHeader::AppendOption (Ptr<const TcpOption> option)
 
       if (option->GetKind () != TcpOption::END)
         {
-          m_options.push_back (option);
-          m_optionsLen += option->GetSerializedSize ();
+          uint8_t kind = option->GetKind ();
+          if (IsInlineKind (kind) && (m_inlineOptions & (1 << kind)) == 0)
+            {
+              switch (kind)
+                {
+                case TcpOption::MSS:
+                  m_mss = DynamicCast<const TcpOptionMSS> (option)->GetMSS ();
+                  break;
+                case TcpOption::WINSCALE:
+                  m_winScale = DynamicCast<const TcpOptionWinScale> (option)->GetScale ();
+                  break;
+                case TcpOption::SACK:
+                  {
+                    TcpOptionSack::SackList sackList = DynamicCast<const TcpOptionSack> (option)->GetSackList ();
+                    m_nSackBlocks = 0;
+                    for (TcpOptionSack::SackList::const_iterator it = sackList.begin (); it != sackList.end (); ++it)
+                      {
+                        m_sackBlocks[m_nSackBlocks++] = *it;
+                      }
+                    break;
+                  }
+                case TcpOption::TS:
+                  {
+                    Ptr<const TcpOptionTS> ts = DynamicCast<const TcpOptionTS> (option);
+                    m_timestamp = ts->GetTimestamp ();
+                    m_echo = ts->GetEcho ();
+                    break;
+                  }
+                }
+              AddOptionEntry (kind, option->GetSerializedSize ());
+            }
+          else
+            {
+              m_options.push_back (option);
+              AddOptionEntry (TcpOption::UNKNOWN, option->GetSerializedSize ());
+            }
 
           uint32_t totalLen = 20 + 3 + m_optionsLen;
           m_length = totalLen >> 2;
@@ -485,15 +722,99 @@ TcpHeader::AppendOption (Ptr<const TcpOption> option)
   return false;
 }
 
+bool
+TcpHeader::AppendTimestamp (uint32_t timestamp, uint32_t echo)
+{
+  if ((m_inlineOptions & (1 << TcpOption::TS)) || m_optionsLen + 10 > m_maxOptionsLen)
+    {
+      return false;
+    }
+  m_timestamp = timestamp;
+  m_echo = echo;
+  AddOptionEntry (TcpOption::TS, 10);
+  m_length = (20 + 3 + m_optionsLen) >> 2;
+  return true;
+}
+
+bool
+TcpHeader::GetTimestamp (uint32_t &timestamp, uint32_t &echo) const
+{
+  if ((m_inlineOptions & (1 << TcpOption::TS)) == 0)
+    {
+      return false;
+    }
+  timestamp = m_timestamp;
+  echo = m_echo;
+  return true;
+}
+
+bool
+TcpHeader::AppendSackBlock (const TcpOptionSack::SackBlock &block)
+{
+  if ((m_inlineOptions & (1 << TcpOption::SACK)) == 0)
+    {
+      if (m_optionsLen + 10 > m_maxOptionsLen)
+        {
+          return false;
+        }
+      m_sackBlocks[0] = block;
+      m_nSackBlocks = 1;
+      AddOptionEntry (TcpOption::SACK, 10);
+    }
+  else
+    {
+      if (m_nSackBlocks == m_maxSackBlocks || m_optionsLen + 8 > m_maxOptionsLen)
+        {
+          return false;
+        }
+      m_sackBlocks[m_nSackBlocks++] = block;
+      m_optionsLen += 8;
+    }
+  m_length = (20 + 3 + m_optionsLen) >> 2;
+  return true;
+}
+
+uint8_t
+TcpHeader::GetNSackBlocks (void) const
+{
+  return (m_inlineOptions & (1 << TcpOption::SACK)) ? m_nSackBlocks : 0;
+}
+
+TcpOptionSack::SackBlock
+TcpHeader::GetSackBlock (uint8_t i) const
+{
+  NS_ASSERT (i < GetNSackBlocks ());
+  return m_sackBlocks[i];
+}
+
 const TcpHeader::TcpOptionList&
 TcpHeader::GetOptionList () const
 {
-  return m_options;
+  m_optionList.clear ();
+  TcpOptionList::const_iterator op = m_options.begin ();
+  for (uint8_t n = 0; n < m_nOptions; ++n)
+    {
+      if (m_optionKinds[n] == TcpOption::UNKNOWN)
+        {
+          m_optionList.push_back (*op);
+          ++op;
+        }
+      else
+        {
+          m_optionList.push_back (CreateInlineOption (m_optionKinds[n]));
+        }
+    }
+  return m_optionList;
 }
 
 Ptr<const TcpOption>
 TcpHeader::GetOption(uint8_t kind) const
 {
+  if (IsInlineKind (kind) && (m_inlineOptions & (1 << kind)))
+    {
+      return CreateInlineOption (kind);
+    }
+
   TcpOptionList::const_iterator i;
 
   for (i = m_options.begin (); i != m_options.end (); ++i)
@@ -510,6 +831,11 @@ TcpHeader::GetOption(uint8_t kind) const
 bool
 TcpHeader::HasOption (uint8_t kind) const
 {
+  if (IsInlineKind (kind) && (m_inlineOptions & (1 << kind)))
+    {
+      return true;
+    }
+
   TcpOptionList::const_iterator i;
 
   for (i = m_options.begin (); i != m_options.end (); ++i)
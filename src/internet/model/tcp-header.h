@@ -24,6 +24,7 @@
 #include <stdint.h>
 #include "ns3/header.h"
 #include "ns3/tcp-option.h"
+#include "ns3/tcp-option-sack.h"
 #include "ns3/buffer.h"
 #include "ns3/tcp-socket-factory.h"
 #include "ns3/ipv4-address.h"
@@ -39,6 +40,14 @@ namespace ns3 {
  * This class has fields corresponding to those in a network TCP header
  * (port numbers, sequence and acknowledgement numbers, flags, etc) as well
  * as methods for serialization to and deserialization from a byte buffer.
+ *
+ * The standard options (MSS, Window Scale, SACK-Permitted, SACK and
+ * Timestamp) are stored inline in the header and serialized without
+ * allocating TcpOption objects; the other options are kept in a list of
+ * TcpOption. The TcpOption objects of the standard options are only
+ * created when asked for through GetOption or GetOptionList; the
+ * SetTimestamp, GetTimestamp, AppendSackBlock and GetSackBlock methods
+ * access them without allocations.
  */
 
 class TcpHeader : public Header
@@ -219,6 +228,43 @@ public:
    */
   bool AppendOption (Ptr<const TcpOption> option);
 
+  /**
+   * \brief Append a Timestamp option to the TCP header
+   * \param timestamp The local timestamp
+   * \param echo The timestamp to echo
+   * \return true if option has been appended, false otherwise
+   */
+  bool AppendTimestamp (uint32_t timestamp, uint32_t echo);
+
+  /**
+   * \brief Get the values of the Timestamp option
+   * \param [out] timestamp The timestamp of the sender
+   * \param [out] echo The timestamp echoed by the sender
+   * \return true if the header has a Timestamp option, false otherwise
+   */
+  bool GetTimestamp (uint32_t &timestamp, uint32_t &echo) const;
+
+  /**
+   * \brief Append a block to the SACK option of the TCP header, appending
+   * the option first if the header has none
+   * \param block The SACK block
+   * \return true if the block has been appended, false otherwise
+   */
+  bool AppendSackBlock (const TcpOptionSack::SackBlock &block);
+
+  /**
+   * \brief Get the number of blocks of the SACK option
+   * \return the number of SACK blocks, 0 if the header has no SACK option
+   */
+  uint8_t GetNSackBlocks (void) const;
+
+  /**
+   * \brief Get a block of the SACK option
+   * \param i The index of the block
+   * \return the SACK block
+   */
+  TcpOptionSack::SackBlock GetSackBlock (uint8_t i) const;
+
   /**
    * \brief Initialize the TCP checksum.
    *
@@ -332,6 +378,35 @@ private:
    */
   uint8_t CalculateHeaderLength () const;
 
+  /**
+   * \brief Check if an option kind is stored inline
+   * \param kind the option kind
+   * \return true if options of this kind are stored inline
+   */
+  static bool IsInlineKind (uint8_t kind);
+
+  /**
+   * \brief Get the serialized size of an option stored inline
+   * \param kind the option kind
+   * \return the size of the option
+   */
+  uint8_t GetInlineOptionSize (uint8_t kind) const;
+
+  /**
+   * \brief Create the TcpOption object of an option stored inline
+   * \param kind the option kind
+   * \return the option
+   */
+  Ptr<TcpOption> CreateInlineOption (uint8_t kind) const;
+
+  /**
+   * \brief Record an option appended to the header
+   * \param kind the option kind, or TcpOption::UNKNOWN for an option
+   *        appended to the list of TcpOption
+   * \param size the serialized size of the option
+   */
+  void AddOptionEntry (uint8_t kind, uint8_t size);
+
   uint16_t m_sourcePort;        //!< Source port
   uint16_t m_destinationPort;   //!< Destination port
   SequenceNumber32 m_sequenceNumber;  //!< Sequence number
@@ -349,8 +424,24 @@ private:
   bool m_goodChecksum;    //!< Flag to indicate that checksum is correct
 
   static const uint8_t m_maxOptionsLen = 40;         //!< Maximum options length
-  TcpOptionList m_options;     //!< TcpOption present in the header
+  static const uint8_t m_maxSackBlocks = 4;          //!< Maximum number of SACK blocks
+  TcpOptionList m_options;     //!< TcpOption present in the header, but the ones stored inline
   uint8_t m_optionsLen;        //!< Tcp options length.
+  mutable TcpOptionList m_optionList; //!< All the options, built by GetOptionList
+
+  // Options in the order they appear in the header: the kind of the
+  // options stored inline, TcpOption::UNKNOWN for those in m_options
+  uint8_t m_optionKinds[m_maxOptionsLen]; //!< Kinds of the options
+  uint8_t m_nOptions;          //!< Number of options
+  uint16_t m_inlineOptions;    //!< Bitmask of the kinds of options stored inline
+
+  // Values of the options stored inline
+  uint16_t m_mss;              //!< MSS option
+  uint8_t m_winScale;          //!< Window Scale option
+  uint32_t m_timestamp;        //!< Timestamp of the Timestamp option
+  uint32_t m_echo;             //!< Echo of the Timestamp option
+  uint8_t m_nSackBlocks;       //!< Number of blocks of the SACK option
+  TcpOptionSack::SackBlock m_sackBlocks[m_maxSackBlocks]; //!< Blocks of the SACK option
 };
 
 } // namespace ns3
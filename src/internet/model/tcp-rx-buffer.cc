@@ -18,6 +18,8 @@
  * Author: Adrian Sai-wah Tam <adrian.sw.tam@gmail.com>
  */
 
+#include <algorithm>
+#include <vector>
 #include "ns3/packet.h"
 #include "ns3/log.h"
 #include "tcp-rx-buffer.h"
@@ -113,9 +115,9 @@ TcpRxBuffer::MaxRxSequence (void) const
     { // No data allowed beyond FIN
       return m_finSeq;
     }
-  else if (m_data.size () && m_nextRxSeq > m_data.begin ()->first)
+  else if (m_data.size () && m_nextRxSeq > m_data.front ().first)
     { // No data allowed beyond Rx window allowed
-      return m_data.begin ()->first + SequenceNumber32 (m_maxBuffer);
+      return m_data.front ().first + SequenceNumber32 (m_maxBuffer);
     }
   return m_nextRxSeq + SequenceNumber32 (m_maxBuffer);
 }
@@ -136,6 +138,18 @@ TcpRxBuffer::Finished (void)
   return (m_gotFin && m_finSeq < m_nextRxSeq);
 }
 
+/**
+ * \brief Order buffered segments by their starting sequence number
+ * \param seq the sequence number to compare
+ * \param item the buffered segment
+ * \return true if seq comes before the start of the segment
+ */
+static bool
+SeqBeforeItem (const SequenceNumber32 &seq, const std::pair<SequenceNumber32, Ptr<Packet> > &item)
+{
+  return seq < item.first;
+}
+
 bool
 TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
 {
@@ -151,12 +165,25 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
   if (headSeq < m_nextRxSeq) headSeq = m_nextRxSeq;
   if (m_data.size ())
     {
-      SequenceNumber32 maxSeq = m_data.begin ()->first + SequenceNumber32 (m_maxBuffer);
+      SequenceNumber32 maxSeq = m_data.front ().first + SequenceNumber32 (m_maxBuffer);
       if (maxSeq < tailSeq) tailSeq = maxSeq;
       if (tailSeq < headSeq) headSeq = tailSeq;
     }
+
+  // Find where the packet goes. In the common case it is appended at the
+  // back; otherwise the overlap check starts from the last segment that
+  // begins at or before headSeq, since the earlier ones cannot overlap.
+  BufIterator i = m_data.end ();
+  if (m_data.size ()
+      && m_data.back ().first + SequenceNumber32 (m_data.back ().second->GetSize ()) > headSeq)
+    {
+      i = std::upper_bound (m_data.begin (), m_data.end (), headSeq, SeqBeforeItem);
+      if (i != m_data.begin ())
+        {
+          --i;
+        }
+    }
   // Remove overlapped bytes from packet
-  BufIterator i = m_data.begin ();
   while (i != m_data.end () && i->first <= tailSeq)
     {
       SequenceNumber32 lastByteSeq = i->first + SequenceNumber32 (i->second->GetSize ());
@@ -165,7 +192,7 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
           if (i->first > headSeq && lastByteSeq < tailSeq)
             { // Rare case: Existing packet is embedded fully in the new packet
               m_size -= i->second->GetSize ();
-              m_data.erase (i++);
+              i = m_data.erase (i);
               continue;
             }
           if (i->first <= headSeq)
@@ -193,30 +220,42 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
       NS_ASSERT (length == p->GetSize ());
     }
   // Insert packet into buffer
-  NS_ASSERT (m_data.find (headSeq) == m_data.end ()); // Shouldn't be there yet
-  m_data [ headSeq ] = p;
-
-  if (headSeq > m_nextRxSeq)
+  if (m_data.empty () || m_data.back ().first < headSeq)
+    {
+      m_data.emplace_back (headSeq, p);
+    }
+  else
     {
-      // Generate a new SACK block
-      UpdateSackList (headSeq, tailSeq);
+      i = std::upper_bound (m_data.begin (), m_data.end (), headSeq, SeqBeforeItem);
+      NS_ASSERT (i == m_data.begin () || (i - 1)->first != headSeq); // Shouldn't be there yet
+      m_data.emplace (i, headSeq, p);
     }
 
   NS_LOG_LOGIC ("Buffered packet of seqno=" << headSeq << " len=" << p->GetSize ());
   // Update variables
   m_size += p->GetSize ();      // Occupancy
-  for (i = m_data.begin (); i != m_data.end (); ++i)
+  if (headSeq > m_nextRxSeq)
+    {
+      // Generate a new SACK block, covering the whole run the packet is in
+      TcpOptionSack::SackBlock run = AddOutOfOrderRun (headSeq, tailSeq);
+      UpdateSackList (run.first, run.second);
+    }
+  else
     {
-      if (i->first < m_nextRxSeq)
+      NS_ASSERT (headSeq == m_nextRxSeq);
+      m_nextRxSeq = tailSeq;
+      m_availBytes += p->GetSize ();
+      // The packet may have filled the hole before the first out-of-order
+      // run: all of it is now in order
+      while (m_oooRuns.size () && m_oooRuns.front ().first <= m_nextRxSeq)
         {
-          continue;
+          if (m_oooRuns.front ().second > m_nextRxSeq)
+            {
+              m_availBytes += m_oooRuns.front ().second - m_nextRxSeq;
+              m_nextRxSeq = m_oooRuns.front ().second;
+            }
+          m_oooRuns.pop_front ();
         }
-      else if (i->first > m_nextRxSeq)
-        {
-          break;
-        };
-      m_nextRxSeq = i->first + SequenceNumber32 (i->second->GetSize ());
-      m_availBytes += i->second->GetSize ();
       ClearSackList (m_nextRxSeq);
     }
   NS_LOG_LOGIC ("Updated buffer occupancy=" << m_size << " nextRxSeq=" << m_nextRxSeq);
@@ -227,6 +266,44 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
   return true;
 }
 
+TcpOptionSack::SackBlock
+TcpRxBuffer::AddOutOfOrderRun (const SequenceNumber32 &head, const SequenceNumber32 &tail)
+{
+  NS_LOG_FUNCTION (this << head << tail);
+
+  typedef std::deque<TcpOptionSack::SackBlock>::iterator RunIterator;
+
+  // First run that ends at or after head; out-of-order data usually grows
+  // the last run, so look there before searching.
+  RunIterator it = m_oooRuns.end ();
+  if (m_oooRuns.size () && m_oooRuns.back ().second >= head)
+    {
+      it = std::lower_bound (m_oooRuns.begin (), m_oooRuns.end (), head,
+                             [] (const TcpOptionSack::SackBlock &run, const SequenceNumber32 &seq)
+                             {
+                               return run.second < seq;
+                             });
+    }
+
+  if (it == m_oooRuns.end () || it->first > tail)
+    { // Isolated block
+      return *m_oooRuns.emplace (it, head, tail);
+    }
+
+  // Merge the block with every run it touches. Usually there are at most
+  // two of them; more only if the block embedded some previous data.
+  RunIterator last = it;
+  while (last + 1 != m_oooRuns.end () && (last + 1)->first <= tail)
+    {
+      ++last;
+    }
+  it->first = std::min (it->first, head);
+  it->second = std::max (last->second, tail);
+  TcpOptionSack::SackBlock run = *it;
+  m_oooRuns.erase (it + 1, last + 1);
+  return run;
+}
+
 uint32_t
 TcpRxBuffer::GetSackListSize () const
 {
@@ -271,54 +348,26 @@ TcpRxBuffer::UpdateSackList (const SequenceNumber32 &head, const SequenceNumber3
   //     following SACK blocks in the SACK option may be listed in
   //     arbitrary order.
 
-  m_sackList.push_front (current);
-
-  // We have inserted the block at the beginning of the list. Now, we should
-  // check if any existing blocks overlap with that.
-  bool updated = false;
+  // The block is the whole run of out-of-order data that contains the new
+  // segment, so the blocks reported previously are either disjoint from it
+  // or fully contained in it (as it is the case when the segment merged two
+  // runs). The latter are subsets of the first block, and are removed.
   TcpOptionSack::SackList::iterator it = m_sackList.begin ();
-  TcpOptionSack::SackBlock begin = *it;
-  TcpOptionSack::SackBlock merged;
-  ++it;
-
-  // Iterates until we examined all blocks in the list (maximum 4)
   while (it != m_sackList.end ())
     {
-      current = *it;
-
-      // This is a left merge:
-      // [current_first; current_second] [beg_first; beg_second]
-      if (begin.first == current.second)
-        {
-          NS_ASSERT (current.first < begin.second);
-          merged = TcpOptionSack::SackBlock (current.first, begin.second);
-          updated = true;
-        }
-      // while this is a right merge
-      // [begin_first; begin_second] [current_first; current_second]
-      else if (begin.second == current.first)
+      if (current.first <= it->first && it->second <= current.second)
         {
-          NS_ASSERT (begin.first < current.second);
-          merged = TcpOptionSack::SackBlock (begin.first, current.second);
-          updated = true;
+          it = m_sackList.erase (it);
         }
-
-      // If we have merged the blocks (and the result is in merged) we should
-      // delete the current block (it), the first block, and insert the merged
-      // one at the beginning.
-      if (updated)
+      else
         {
-          m_sackList.erase (it);
-          m_sackList.pop_front ();
-          m_sackList.push_front (merged);
-          it = m_sackList.begin ();
-          begin = *it;
-          updated = false;
+          NS_ASSERT (it->second < current.first || current.second < it->first);
+          ++it;
         }
-
-      ++it;
     }
 
+  m_sackList.push_front (current);
+
   // Since the maximum blocks that fits into a TCP header are 4, there's no
   // point on maintaining the others.
   if (m_sackList.size () > 4)
@@ -369,37 +418,43 @@ TcpRxBuffer::Extract (uint32_t maxSize)
   NS_LOG_LOGIC ("Requested to extract " << extractSize << " bytes from TcpRxBuffer of size=" << m_size);
   if (extractSize == 0) return nullptr;  // No contiguous block to return
   NS_ASSERT (m_data.size ()); // At least we have something to extract
-  Ptr<Packet> outPkt = Create<Packet> (); // The packet that contains all the data to return
-  BufIterator i;
+  std::vector<Ptr<Packet> > pieces; // The segments that contain the data to return
   while (extractSize)
     { // Check the buffered data for delivery
-      i = m_data.begin ();
-      NS_ASSERT (i->first <= m_nextRxSeq); // in-sequence data expected
+      BufItem &head = m_data.front ();
+      NS_ASSERT (head.first <= m_nextRxSeq); // in-sequence data expected
       // Check if we send the whole pkt or just a partial
-      uint32_t pktSize = i->second->GetSize ();
+      uint32_t pktSize = head.second->GetSize ();
       if (pktSize <= extractSize)
-        { // Whole packet is extracted
-          outPkt->AddAtEnd (i->second);
-          m_data.erase (i);
+        { // Whole packet is extracted. The buffer owns it (it is a fragment
+          // created by Add), so it can be handed out directly
+          pieces.push_back (head.second);
+          m_data.pop_front ();
           m_size -= pktSize;
           m_availBytes -= pktSize;
           extractSize -= pktSize;
         }
       else
         { // Partial is extracted and done
-          outPkt->AddAtEnd (i->second->CreateFragment (0, extractSize));
-          m_data[i->first + SequenceNumber32 (extractSize)] = i->second->CreateFragment (extractSize, pktSize - extractSize);
-          m_data.erase (i);
+          pieces.push_back (head.second->CreateFragment (0, extractSize));
+          head.second->RemoveAtStart (extractSize);
+          head.first = head.first + SequenceNumber32 (extractSize);
           m_size -= extractSize;
           m_availBytes -= extractSize;
           extractSize = 0;
         }
     }
-  if (outPkt->GetSize () == 0)
+  // Join the pieces pairwise rather than appending them one by one to the
+  // same packet: each byte is then copied a logarithmic number of times,
+  // instead of once per following segment.
+  for (std::size_t step = 1; step < pieces.size (); step *= 2)
     {
-      NS_LOG_LOGIC ("Nothing extracted.");
-      return nullptr;
+      for (std::size_t j = 0; j + step < pieces.size (); j += 2 * step)
+        {
+          pieces[j]->AddAtEnd (pieces[j + step]);
+        }
     }
+  Ptr<Packet> outPkt = pieces.front ();
   NS_LOG_LOGIC ("Extracted " << outPkt->GetSize ( ) << " bytes, bufsize=" << m_size
                              << ", num pkts in buffer=" << m_data.size ());
   return outPkt;
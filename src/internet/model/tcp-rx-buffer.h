@@ -21,7 +21,8 @@
 #ifndef TCP_RX_BUFFER_H
 #define TCP_RX_BUFFER_H
 
-#include <map>
+#include <deque>
+#include <utility>
 #include "ns3/traced-value.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/sequence-number.h"
@@ -53,6 +54,23 @@ class Packet;
  * To store data, use Add; for retrieving a certain amount of ordered data, use
  * the method Extract.
  *
+ * Reassembly queue
+ * ----------------
+ *
+ * Segments are kept in a double-ended queue, sorted by sequence number and
+ * without overlaps. The head of the queue holds the in-order data that has
+ * not been read yet, followed by the out-of-order segments. Since senders
+ * mostly deliver in order, a new segment is appended at the back in the
+ * common case; otherwise its position is found with a binary search, and
+ * only its neighbours are checked for overlaps. Extract consumes segments
+ * from the front of the queue.
+ *
+ * Alongside the segments, the buffer keeps the maximal contiguous runs of
+ * out-of-order data, sorted by sequence number. A new out-of-order segment
+ * extends (or joins) at most two adjacent runs, and when the hole before
+ * the first run is filled, the whole run becomes readable at once,
+ * without walking its segments again.
+ *
  * SACK list
  * ---------
  *
@@ -185,6 +203,10 @@ private:
   /**
    * \brief Update the sack list, with the block seq starting at the beginning
    *
+   * The block passed is the maximal run of out-of-order data containing the
+   * segment just received; blocks already in the list that are part of it
+   * are dropped.
+   *
    * Note: the maximum size of the block list is 4. Caller is free to
    * drop blocks at the end to accommodate header size; from RFC 2018:
    *
@@ -215,17 +237,32 @@ private:
    */
   void ClearSackList (const SequenceNumber32 &seq);
 
+  /**
+   * \brief Record a new block of out-of-order data in the run list
+   *
+   * The block is merged with the runs that end at its head or start at its
+   * tail.
+   *
+   * \param head sequence number of the block at the beginning
+   * \param tail sequence number of the block at the end
+   * \return the maximal run of out-of-order data containing the block
+   */
+  TcpOptionSack::SackBlock AddOutOfOrderRun (const SequenceNumber32 &head, const SequenceNumber32 &tail);
+
   TcpOptionSack::SackList m_sackList; //!< Sack list (updated constantly)
 
+  /// A segment stored in the buffer, with its starting sequence number
+  typedef std::pair<SequenceNumber32, Ptr<Packet> > BufItem;
   /// container for data stored in the buffer
-  typedef std::map<SequenceNumber32, Ptr<Packet> >::iterator BufIterator;
+  typedef std::deque<BufItem>::iterator BufIterator;
   TracedValue<SequenceNumber32> m_nextRxSeq; //!< Seqnum of the first missing byte in data (RCV.NXT)
   SequenceNumber32 m_finSeq;                 //!< Seqnum of the FIN packet
   bool m_gotFin;                             //!< Did I received FIN packet?
   uint32_t m_size;                           //!< Number of total data bytes in the buffer, not necessarily contiguous
   uint32_t m_maxBuffer;                      //!< Upper bound of the number of data bytes in buffer (RCV.WND)
   uint32_t m_availBytes;                     //!< Number of bytes available to read, i.e. contiguous block at head
-  std::map<SequenceNumber32, Ptr<Packet> > m_data; //!< Corresponding data (may be null)
+  std::deque<BufItem> m_data;                //!< Segments sorted by sequence number, not overlapping
+  std::deque<TcpOptionSack::SackBlock> m_oooRuns; //!< Maximal runs of out-of-order data, sorted
 };
 
 } //namespace ns3
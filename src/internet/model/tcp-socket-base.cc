@@ -42,6 +42,7 @@
 #include "ns3/pointer.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/data-rate.h"
+#include "ns3/departure-time-tag.h"
 #include "ns3/object.h"
 #include "tcp-socket-base.h"
 #include "tcp-l4-protocol.h"
@@ -153,6 +154,19 @@ TcpSocketBase::GetTypeId (void)
                    MakeEnumChecker (TcpSocketState::Off, "Off",
                                     TcpSocketState::On, "On",
                                     TcpSocketState::AcceptOnly, "AcceptOnly"))
+    .AddAttribute ("AckThinning",
+                   "ACK thinning policy for the in-order data received",
+                   EnumValue (TcpSocketBase::ACK_THINNING_NONE),
+                   MakeEnumAccessor (&TcpSocketBase::m_ackThinning),
+                   MakeEnumChecker (TcpSocketBase::ACK_THINNING_NONE, "None",
+                                    TcpSocketBase::ACK_THINNING_COUNT, "Count",
+                                    TcpSocketBase::ACK_THINNING_RTT, "Rtt"))
+    .AddAttribute ("AckThinningCount",
+                   "Number of full-sized segments to wait before sending "
+                   "an ACK when ACK thinning is enabled",
+                   UintegerValue (8),
+                   MakeUintegerAccessor (&TcpSocketBase::m_ackThinningCount),
+                   MakeUintegerChecker<uint32_t> (1))
     .AddTraceSource ("RTO",
                      "Retransmission timeout",
                      MakeTraceSourceAccessor (&TcpSocketBase::m_rto),
@@ -312,6 +326,8 @@ TcpSocketBase::TcpSocketBase (const TcpSocketBase& sock)
     m_dupAckCount (sock.m_dupAckCount),
     m_delAckCount (0),
     m_delAckMaxCount (sock.m_delAckMaxCount),
+    m_ackThinning (sock.m_ackThinning),
+    m_ackThinningCount (sock.m_ackThinningCount),
     m_noDelay (sock.m_noDelay),
     m_synCount (sock.m_synCount),
     m_synRetries (sock.m_synRetries),
@@ -1326,8 +1342,7 @@ TcpSocketBase::DoForwardUp (Ptr<Packet> packet, const Address &fromAddress,
       // When receiving a <SYN> or <SYN-ACK> we should adapt TS to the other end
       if (tcpHeader.HasOption (TcpOption::TS) && m_timestampEnabled)
         {
-          ProcessOptionTimestamp (tcpHeader.GetOption (TcpOption::TS),
-                                  tcpHeader.GetSequenceNumber ());
+          ProcessOptionTimestamp (tcpHeader, tcpHeader.GetSequenceNumber ());
         }
       else
         {
@@ -1361,8 +1376,7 @@ TcpSocketBase::DoForwardUp (Ptr<Packet> packet, const Address &fromAddress,
             }
           else
             {
-              ProcessOptionTimestamp (tcpHeader.GetOption (TcpOption::TS),
-                                      tcpHeader.GetSequenceNumber ());
+              ProcessOptionTimestamp (tcpHeader, tcpHeader.GetSequenceNumber ());
             }
         }
 
@@ -1549,22 +1563,11 @@ void
 TcpSocketBase::ReadOptions (const TcpHeader &tcpHeader, uint32_t *bytesSacked)
 {
   NS_LOG_FUNCTION (this << tcpHeader);
-  TcpHeader::TcpOptionList::const_iterator it;
-  const TcpHeader::TcpOptionList options = tcpHeader.GetOptionList ();
 
-  for (it = options.begin (); it != options.end (); ++it)
+  // Check only for ACK options here
+  if (tcpHeader.HasOption (TcpOption::SACK))
     {
-      const Ptr<const TcpOption> option = (*it);
-
-      // Check only for ACK options here
-      switch (option->GetKind ())
-        {
-        case TcpOption::SACK:
-          *bytesSacked = ProcessOptionSack (option);
-          break;
-        default:
-          continue;
-        }
+      *bytesSacked = ProcessOptionSack (tcpHeader);
     }
 }
 
@@ -3040,12 +3043,25 @@ TcpSocketBase::SendDataPacket (SequenceNumber32 seq, uint32_t maxSize, bool with
   NS_LOG_FUNCTION (this << seq << maxSize << withAck);
 
   bool isStartOfTransmission = BytesInFlight () == 0U;
-  TcpTxItem *outItem = m_txBuffer->CopyFromSequence (maxSize, seq);
+  TcpTxItem *outItem = m_txBuffer->CopyFromSequence (std::min (maxSize, m_tcb->m_segmentSize), seq);
 
   m_rateOps->SkbSent(outItem, isStartOfTransmission);
 
   bool isRetransmission = outItem->IsRetrans ();
   Ptr<Packet> p = outItem->GetPacketCopy ();
+  // A GSO super-segment is built from segments kept apart in the Tx
+  // buffer, so that SACKs and losses are still accounted per segment
+  while (maxSize > m_tcb->m_segmentSize && p->GetSize () < maxSize)
+    {
+      outItem = m_txBuffer->CopyFromSequence (std::min (maxSize - p->GetSize (), m_tcb->m_segmentSize),
+                                              seq + SequenceNumber32 (p->GetSize ()));
+      if (outItem->GetSeqSize () == 0)
+        {
+          break;
+        }
+      m_rateOps->SkbSent (outItem, false);
+      p->AddAtEnd (outItem->GetPacketCopy ());
+    }
   uint32_t sz = p->GetSize (); // Size of packet
   uint8_t flags = withAck ? TcpHeader::ACK : 0;
   uint32_t remainingData = m_txBuffer->SizeFromSequence (seq + SequenceNumber32 (sz));
@@ -3057,7 +3073,18 @@ TcpSocketBase::SendDataPacket (SequenceNumber32 seq, uint32_t maxSize, bool with
   if (IsPacingEnabled ())
     {
       NS_LOG_INFO ("Pacing is enabled");
-      if (m_pacingTimer.IsExpired ())
+      if (m_tcb->m_edtPacing)
+        {
+          // Earliest Departure Time: the segment is sent right away, stamped
+          // with the time it may leave the node, and the departure time of
+          // the next segment is pushed forward by the transmission time of
+          // this one at the current pacing rate.
+          m_edtTxTime = std::max (Simulator::Now (), m_edtNextDeparture);
+          m_edtNextDeparture = m_edtTxTime + m_tcb->m_pacingRate.Get ().CalculateBytesTxTime (sz);
+          NS_LOG_DEBUG ("Current Pacing Rate " << m_tcb->m_pacingRate);
+          NS_LOG_DEBUG ("Segment departs at " << m_edtTxTime << ", next one at " << m_edtNextDeparture);
+        }
+      else if (m_pacingTimer.IsExpired ())
         {
           NS_LOG_DEBUG ("Current Pacing Rate " << m_tcb->m_pacingRate);
           NS_LOG_DEBUG ("Timer is in expired state, activate it " << m_tcb->m_pacingRate.Get ().CalculateBytesTxTime (sz));
@@ -3090,6 +3117,18 @@ TcpSocketBase::SendDataPacket (SequenceNumber32 seq, uint32_t maxSize, bool with
 
   AddSocketTags (p);
 
+  if (sz > m_tcb->m_segmentSize)
+    {
+      SocketGsoTag gsoTag;
+      gsoTag.SetSegmentSize (m_tcb->m_segmentSize);
+      p->AddPacketTag (gsoTag);
+    }
+
+  if (m_edtTxTime > Simulator::Now ())
+    {
+      p->AddPacketTag (DepartureTimeTag (m_edtTxTime));
+    }
+
   if (m_closeOnEmpty && (remainingData == 0))
     {
       flags |= TcpHeader::FIN;
@@ -3151,6 +3190,7 @@ TcpSocketBase::SendDataPacket (SequenceNumber32 seq, uint32_t maxSize, bool with
     }
 
   UpdateRttHistory (seq, sz, isRetransmission);
+  m_edtTxTime = Time (0);
 
   // Update bytes sent during recovery phase
   if (m_tcb->m_congState == TcpSocketState::CA_RECOVERY || m_tcb->m_congState == TcpSocketState::CA_CWR)
@@ -3178,7 +3218,8 @@ TcpSocketBase::UpdateRttHistory (const SequenceNumber32 &seq, uint32_t sz,
   // update the history of sequence numbers used to calculate the RTT
   if (isRetransmission == false)
     { // This is the next expected one, just log at end
-      m_history.push_back (RttHistory (seq, sz, Simulator::Now ()));
+      // A segment paced in EDT mode is sent when it leaves the node
+      m_history.push_back (RttHistory (seq, sz, std::max (Simulator::Now (), m_edtTxTime)));
     }
   else
     { // This is a retransmit, find in list and mark as re-tx
@@ -3283,6 +3324,26 @@ TcpSocketBase::SendPendingData (bool withAck)
           uint32_t maxSizeToSend = static_cast<uint32_t> (nextHigh - next);
           s = std::min (s, maxSizeToSend);
 
+          if (m_tcb->m_gsoMaxSize > m_tcb->m_segmentSize && m_endPoint != nullptr
+              && next >= m_tcb->m_highTxMark && s == m_tcb->m_segmentSize)
+            {
+              // Generic segmentation offload: send as many whole segments
+              // of new data as allowed in one super-segment, of the size
+              // preferred by the congestion control if any
+              uint32_t gsoSize = m_tcb->m_gsoMaxSize;
+              if (m_tcb->m_sendQuantum > 0)
+                {
+                  gsoSize = std::min (gsoSize, m_tcb->m_sendQuantum);
+                }
+              int32_t rWndLeft = (m_highRxAckMark.Get () + SequenceNumber32 (m_rWnd.Get ())) - next;
+              gsoSize = std::min ({gsoSize, availableWindow, availableData,
+                                   static_cast<uint32_t> (std::max (rWndLeft, 0))});
+              if (gsoSize >= 2 * m_tcb->m_segmentSize)
+                {
+                  s = gsoSize - gsoSize % m_tcb->m_segmentSize;
+                }
+            }
+
           // (C.2) If any of the data octets sent in (C.1) are below HighData,
           //       HighRxt MUST be set to the highest sequence number of the
           //       retransmitted segment unless NextSeg () rule (4) was
@@ -3314,7 +3375,23 @@ TcpSocketBase::SendPendingData (bool withAck)
                         " size " << sz);
           m_tcb->m_nextTxSequence += sz;
           ++nPacketsSent;
-          if (IsPacingEnabled ())
+          if (IsPacingEnabled () && m_tcb->m_edtPacing)
+            {
+              // Like TCP small queues in Linux, do not stamp segments too far
+              // in the future: what is waiting in the queue disc still counts
+              // as in flight, and the congestion control would not see the
+              // effect of a lower pacing rate (e.g., when draining a queue).
+              Time horizon = std::max (MilliSeconds (1),
+                                       m_tcb->m_pacingRate.Get ().CalculateBytesTxTime (2 * m_tcb->m_segmentSize));
+              Time ahead = m_edtNextDeparture - Simulator::Now ();
+              if (ahead > horizon && m_pacingTimer.IsExpired ())
+                {
+                  NS_LOG_DEBUG ("Next departure is " << ahead << " ahead, wait " << ahead - horizon);
+                  m_pacingTimer.Schedule (ahead - horizon);
+                  break;
+                }
+            }
+          else if (IsPacingEnabled ())
             {
               NS_LOG_INFO ("Pacing is enabled");
               if (m_pacingTimer.IsExpired ())
@@ -3436,6 +3513,19 @@ TcpSocketBase::ReceivedData (Ptr<Packet> p, const TcpHeader& tcpHeader)
   NS_LOG_DEBUG ("Data segment, seq=" << tcpHeader.GetSequenceNumber () <<
                 " pkt size=" << p->GetSize () );
 
+  // The receiver has no RTT samples of its own: estimate the RTT from the
+  // timestamps echoed by the sender, as Linux tcp_rcv_rtt_measure_ts does
+  uint32_t timestamp;
+  uint32_t echo;
+  if (m_ackThinning == ACK_THINNING_RTT && m_timestampEnabled && tcpHeader.GetTimestamp (timestamp, echo))
+    {
+      if (echo != 0)
+        {
+          Time sample = TcpOptionTS::ElapsedTimeFromTsValue (echo);
+          m_rcvRtt = m_rcvRtt.IsZero () ? sample : m_rcvRtt + (sample - m_rcvRtt) / 8;
+        }
+    }
+
   // Put into Rx buffer
   SequenceNumber32 expectedSeq = m_tcb->m_rxBuffer->NextRxSequence ();
   if (!m_tcb->m_rxBuffer->Add (p, tcpHeader))
@@ -3489,7 +3579,10 @@ TcpSocketBase::ReceivedData (Ptr<Packet> p, const TcpHeader& tcpHeader)
     }
   else
     { // In-sequence packet: ACK if delayed ack count allows
-      if (++m_delAckCount >= m_delAckMaxCount)
+      // A segment coalesced by GRO counts as the full-sized segments it carries
+      m_delAckCount += std::max<uint32_t> (1, (p->GetSize () + m_tcb->m_segmentSize - 1) / m_tcb->m_segmentSize);
+      uint32_t delAckMaxCount = (m_ackThinning == ACK_THINNING_NONE) ? m_delAckMaxCount : m_ackThinningCount;
+      if (m_delAckCount >= delAckMaxCount)
         {
           m_delAckEvent.Cancel ();
           m_delAckCount = 0;
@@ -3513,7 +3606,12 @@ TcpSocketBase::ReceivedData (Ptr<Packet> p, const TcpHeader& tcpHeader)
       else if (m_delAckEvent.IsExpired ())
         {
           m_congestionControl->CwndEvent (m_tcb, TcpSocketState::CA_EVENT_DELAYED_ACK);
-          m_delAckEvent = Simulator::Schedule (m_delAckTimeout,
+          Time delAckTimeout = m_delAckTimeout;
+          if (m_ackThinning == ACK_THINNING_RTT && !m_rcvRtt.IsZero ())
+            {
+              delAckTimeout = std::min (delAckTimeout, m_rcvRtt / 4);
+            }
+          m_delAckEvent = Simulator::Schedule (delAckTimeout,
                                                &TcpSocketBase::DelAckTimeout, this);
           NS_LOG_LOGIC (this << " scheduled delayed ACK at " <<
                         (Simulator::Now () + Simulator::GetDelayLeft (m_delAckEvent)).GetSeconds ());
@@ -3535,11 +3633,11 @@ TcpSocketBase::EstimateRtt (const TcpHeader& tcpHeader)
       RttHistory& h = m_history.front ();
       if (!h.retx && ackSeq >= (h.seq + SequenceNumber32 (h.count)))
         { // Ok to use this sample
-          if (m_timestampEnabled && tcpHeader.HasOption (TcpOption::TS))
+          uint32_t timestamp;
+          uint32_t echo;
+          if (m_timestampEnabled && tcpHeader.GetTimestamp (timestamp, echo))
             {
-              Ptr<const TcpOptionTS> ts;
-              ts = DynamicCast<const TcpOptionTS> (tcpHeader.GetOption (TcpOption::TS));
-              m = TcpOptionTS::ElapsedTimeFromTsValue (ts->GetEcho ());
+              m = TcpOptionTS::ElapsedTimeFromTsValue (echo);
               if (m.IsZero ())
                 {
                   NS_LOG_LOGIC ("TcpSocketBase::EstimateRtt - RTT calculated from TcpOption::TS is zero, approximating to 1us.");
@@ -4158,12 +4256,16 @@ TcpSocketBase::AddOptionWScale (TcpHeader &header)
 }
 
 uint32_t
-TcpSocketBase::ProcessOptionSack (const Ptr<const TcpOption> option)
+TcpSocketBase::ProcessOptionSack (const TcpHeader &tcpHeader)
 {
-  NS_LOG_FUNCTION (this << option);
+  NS_LOG_FUNCTION (this << tcpHeader);
 
-  Ptr<const TcpOptionSack> s = DynamicCast<const TcpOptionSack> (option);
-  return m_txBuffer->Update (s->GetSackList (), MakeCallback (&TcpRateOps::SkbDelivered, m_rateOps));
+  TcpOptionSack::SackList sackList;
+  for (uint8_t i = 0; i < tcpHeader.GetNSackBlocks (); ++i)
+    {
+      sackList.push_back (tcpHeader.GetSackBlock (i));
+    }
+  return m_txBuffer->Update (sackList, MakeCallback (&TcpRateOps::SkbDelivered, m_rateOps));
 }
 
 void
@@ -4205,44 +4307,48 @@ TcpSocketBase::AddOptionSack (TcpHeader& header)
     }
 
   // Append the allowed number of SACK blocks
-  Ptr<TcpOptionSack> option = CreateObject<TcpOptionSack> ();
   TcpOptionSack::SackList::iterator i;
   for (i = sackList.begin (); allowedSackBlocks > 0 && i != sackList.end (); ++i)
     {
-      option->AddSackBlock (*i);
+      header.AppendSackBlock (*i);
       allowedSackBlocks--;
     }
 
-  header.AppendOption (option);
-  NS_LOG_INFO (m_node->GetId () << " Add option SACK " << *option);
+  NS_LOG_INFO (m_node->GetId () << " Add option SACK with " <<
+               static_cast<uint32_t> (header.GetNSackBlocks ()) << " blocks");
 }
 
 void
-TcpSocketBase::ProcessOptionTimestamp (const Ptr<const TcpOption> option,
+TcpSocketBase::ProcessOptionTimestamp (const TcpHeader &tcpHeader,
                                        const SequenceNumber32 &seq)
 {
-  NS_LOG_FUNCTION (this << option);
+  NS_LOG_FUNCTION (this << tcpHeader);
 
-  Ptr<const TcpOptionTS> ts = DynamicCast<const TcpOptionTS> (option);
+  uint32_t timestamp;
+  uint32_t echo;
+  if (!tcpHeader.GetTimestamp (timestamp, echo))
+    {
+      return;
+    }
 
   // This is valid only when no overflow occurs. It happens
   // when a connection last longer than 50 days.
-  if (m_tcb->m_rcvTimestampValue > ts->GetTimestamp ())
+  if (m_tcb->m_rcvTimestampValue > timestamp)
     {
       // Do not save a smaller timestamp (probably there is reordering)
       return;
     }
 
-  m_tcb->m_rcvTimestampValue = ts->GetTimestamp ();
-  m_tcb->m_rcvTimestampEchoReply = ts->GetEcho ();
+  m_tcb->m_rcvTimestampValue = timestamp;
+  m_tcb->m_rcvTimestampEchoReply = echo;
 
   if (seq == m_tcb->m_rxBuffer->NextRxSequence () && seq <= m_highTxAck)
     {
-      m_timestampToEcho = ts->GetTimestamp ();
+      m_timestampToEcho = timestamp;
     }
 
   NS_LOG_INFO (m_node->GetId () << " Got timestamp=" <<
-               m_timestampToEcho << " and Echo="     << ts->GetEcho ());
+               m_timestampToEcho << " and Echo="     << echo);
 }
 
 void
@@ -4250,14 +4356,20 @@ TcpSocketBase::AddOptionTimestamp (TcpHeader& header)
 {
   NS_LOG_FUNCTION (this << header);
 
-  Ptr<TcpOptionTS> option = CreateObject<TcpOptionTS> ();
-
-  option->SetTimestamp (TcpOptionTS::NowToTsValue ());
-  option->SetEcho (m_timestampToEcho);
+  uint32_t timestamp;
+  if (m_edtTxTime > Simulator::Now ())
+    {
+      // Timestamp a segment paced in EDT mode with its departure time
+      timestamp = static_cast<uint32_t> (m_edtTxTime.GetMilliSeconds () & 0xFFFFFFFF);
+    }
+  else
+    {
+      timestamp = TcpOptionTS::NowToTsValue ();
+    }
 
-  header.AppendOption (option);
+  header.AppendTimestamp (timestamp, m_timestampToEcho);
   NS_LOG_INFO (m_node->GetId () << " Add option TS, ts=" <<
-               option->GetTimestamp () << " echo=" << m_timestampToEcho);
+               timestamp << " echo=" << m_timestampToEcho);
 }
 
 void TcpSocketBase::UpdateWindowSize (const TcpHeader &header)
@@ -4536,6 +4648,13 @@ TcpSocketBase::SetPaceInitialWindow (bool paceWindow)
   m_tcb->m_paceInitialWindow = paceWindow;
 }
 
+void
+TcpSocketBase::SetEdtPacing (bool edtPacing)
+{
+  NS_LOG_FUNCTION (this << edtPacing);
+  m_tcb->m_edtPacing = edtPacing;
+}
+
 void
 TcpSocketBase::SetUseEcn (TcpSocketState::UseEcn_t useEcn)
 {
@@ -230,6 +230,21 @@ public:
    */
   virtual TypeId GetInstanceTypeId () const;
 
+  /**
+   * \brief Receiver ACK thinning policies
+   *
+   * Thinning reduces the number of ACKs generated for in-order data, which
+   * are counted in full-sized segments so that a segment coalesced by the
+   * GRO stage of the IP layer counts as the segments it carries. Segments
+   * out of order or filling a hole are still acknowledged immediately.
+   */
+  typedef enum
+  {
+    ACK_THINNING_NONE,  //!< Acknowledge every DelAckCount segments
+    ACK_THINNING_COUNT, //!< Acknowledge every AckThinningCount segments
+    ACK_THINNING_RTT    //!< As ACK_THINNING_COUNT, but delay ACKs by at most a quarter of the RTT
+  } AckThinning_t;
+
   /**
    * \brief TcpGeneralTest friend class (for tests).
    * \relates TcpGeneralTest
@@ -572,6 +587,12 @@ public:
    */
   void SetPaceInitialWindow (bool paceWindow);
 
+  /**
+   * \brief Enable or disable Earliest Departure Time (EDT) pacing
+   * \param edtPacing Boolean to stamp departure times instead of arming the pacing timer
+   */
+  void SetEdtPacing (bool edtPacing);
+
   // Necessary implementations of null functions from ns3::Socket
   virtual enum SocketErrno GetErrno (void) const;    // returns m_errno
   virtual enum SocketType GetSocketType (void) const; // returns socket type
@@ -1153,10 +1174,10 @@ protected:
   /**
    * \brief Read the SACK option
    *
-   * \param option SACK option from the header
+   * \param tcpHeader Header of the segment
    * \returns the number of bytes sacked by this option
    */
-  uint32_t ProcessOptionSack(const Ptr<const TcpOption> option);
+  uint32_t ProcessOptionSack (const TcpHeader &tcpHeader);
 
   /**
    * \brief Add the SACK PERMITTED option to the header
@@ -1179,10 +1200,10 @@ protected:
    * to utilize later to calculate RTT.
    *
    * \see EstimateRtt
-   * \param option Option from the segment
+   * \param tcpHeader Header of the segment
    * \param seq Sequence number of the segment
    */
-  void ProcessOptionTimestamp (const Ptr<const TcpOption> option,
+  void ProcessOptionTimestamp (const TcpHeader &tcpHeader,
                                const SequenceNumber32 &seq);
   /**
    * \brief Add the timestamp option to the header
@@ -1253,6 +1274,9 @@ protected:
   uint32_t          m_dupAckCount {0};     //!< Dupack counter
   uint32_t          m_delAckCount {0};     //!< Delayed ACK counter
   uint32_t          m_delAckMaxCount {0};  //!< Number of packet to fire an ACK before delay timeout
+  AckThinning_t     m_ackThinning {ACK_THINNING_NONE}; //!< ACK thinning policy
+  uint32_t          m_ackThinningCount {0}; //!< Number of segments to fire an ACK with ACK thinning
+  Time              m_rcvRtt {Seconds (0.0)}; //!< RTT estimated by the receiver from the echoed timestamps
 
   // Nagle algorithm
   bool              m_noDelay {false};     //!< Set to true to disable Nagle's algorithm
@@ -1342,6 +1366,8 @@ protected:
 
   // Pacing related variable
   Timer m_pacingTimer {Timer::CANCEL_ON_DESTROY}; //!< Pacing Event
+  Time m_edtNextDeparture {0}; //!< Earliest departure time of the next paced segment (EDT pacing)
+  Time m_edtTxTime {0};        //!< Departure time of the segment being sent (EDT pacing)
 
   // Parameters related to Explicit Congestion Notification
   TracedValue<SequenceNumber32> m_ecnEchoSeq {0};      //!< Sequence number of the last received ECN Echo
@@ -48,6 +48,22 @@ TcpSocketState::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&TcpSocketState::m_paceInitialWindow),
                    MakeBooleanChecker ())
+    .AddAttribute ("EdtPacing",
+                   "Pace by stamping each segment with its earliest departure time "
+                   "(DepartureTimeTag) instead of arming a timer per segment. "
+                   "A time-aware queue disc (e.g., EdtQueueDisc) must be installed "
+                   "on the sending device to enforce the stamped times",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&TcpSocketState::m_edtPacing),
+                   MakeBooleanChecker ())
+    .AddAttribute ("GsoMaxSize",
+                   "Maximum payload of the super-segments handed to the IP layer "
+                   "for generic segmentation offload (GSO); they are split into "
+                   "segments between the queue disc and the device. 0 disables "
+                   "GSO, which is only available over IPv4",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&TcpSocketState::m_gsoMaxSize),
+                   MakeUintegerChecker<uint32_t> (0, 65415))
     .AddTraceSource ("PacingRate",
                      "The current TCP pacing rate",
                      MakeTraceSourceAccessor (&TcpSocketState::m_pacingRate),
@@ -112,6 +128,9 @@ TcpSocketState::TcpSocketState (const TcpSocketState &other)
     m_pacingSsRatio (other.m_pacingSsRatio),
     m_pacingCaRatio (other.m_pacingCaRatio),
     m_paceInitialWindow (other.m_paceInitialWindow),
+    m_edtPacing (other.m_edtPacing),
+    m_gsoMaxSize (other.m_gsoMaxSize),
+    m_sendQuantum (other.m_sendQuantum),
     m_minRtt (other.m_minRtt),
     m_bytesInFlight (other.m_bytesInFlight),
     m_lastRtt (other.m_lastRtt),
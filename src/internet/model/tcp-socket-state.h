@@ -194,6 +194,11 @@ public:
   uint16_t               m_pacingSsRatio {0};        //!< SS pacing ratio
   uint16_t               m_pacingCaRatio {0};        //!< CA pacing ratio
   bool                   m_paceInitialWindow {false}; //!< Enable/Disable pacing for the initial window
+  bool                   m_edtPacing {false};        //!< Pace with departure time stamps instead of a timer
+
+  // Generic segmentation offload
+  uint32_t               m_gsoMaxSize {0};           //!< Max payload of a super-segment, 0 if GSO is disabled
+  uint32_t               m_sendQuantum {0};          //!< Super-segment payload preferred by the congestion control, 0 if none
 
   Time                   m_minRtt  {Time::Max ()};   //!< Minimum RTT observed throughout the connection
 
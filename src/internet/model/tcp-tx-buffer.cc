@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <iterator>
 
 #include "ns3/packet.h"
 #include "ns3/log.h"
@@ -58,7 +59,8 @@ TcpTxBuffer::GetTypeId (void)
  * initialized below is insignificant.
  */
 TcpTxBuffer::TcpTxBuffer (uint32_t n)
-  : m_maxBuffer (32768), m_size (0), m_sentSize (0), m_firstByteSeq (n)
+  : m_maxBuffer (32768), m_size (0), m_sentSize (0), m_firstByteSeq (n),
+    m_lostScanFloor (n), m_highestLost (n), m_nextSegHint (n)
 {
   m_rWndCallback = MakeNullCallback<uint32_t> ();
 }
@@ -174,6 +176,9 @@ TcpTxBuffer::SetHeadSequence (const SequenceNumber32& seq)
   // if you change the head with data already sent, something bad will happen
   NS_ASSERT (m_sentList.size () == 0);
   m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
+  m_lostScanFloor = seq;
+  m_highestLost = seq;
+  m_nextSegHint = seq;
 }
 
 bool
@@ -297,6 +302,8 @@ TcpTxBuffer::GetNewSegment (uint32_t numBytes)
 
   m_appList.erase (it);
   m_sentList.insert (m_sentList.end (), item);
+  m_sentIndex.emplace_hint (m_sentIndex.end (), item->m_startSeq,
+                            std::prev (m_sentList.end ()));
   m_sentSize += item->m_packet->GetSize ();
 
   return item;
@@ -310,36 +317,32 @@ TcpTxBuffer::GetTransmittedSegment (uint32_t numBytes, const SequenceNumber32 &s
   NS_ASSERT (numBytes <= m_sentSize);
   NS_ASSERT (m_sentList.size () >= 1);
 
-  auto it = m_sentList.begin ();
   bool listEdited = false;
   uint32_t s = numBytes;
 
   // Avoid to merge different packet for this retransmission if flags are
   // different.
-  for (; it != m_sentList.end(); ++it)
+  auto idx = m_sentIndex.find (seq);
+  if (idx != m_sentIndex.end ())
     {
-      if ((*it)->m_startSeq == seq)
+      auto it = idx->second;
+      auto next = std::next (it);
+      if (next != m_sentList.end ())
         {
-          auto next = it;
-          next++;
-          if (next != m_sentList.end ())
+          // Next is not sacked and have the same value for m_lost ... there is the possibility to merge
+          if ((! (*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
             {
-              // Next is not sacked and have the same value for m_lost ... there is the possibility to merge
-              if ((! (*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
-                {
-                  s = std::min(s, (*it)->m_packet->GetSize () + (*next)->m_packet->GetSize ());
-                }
-              else
-                {
-                  // Next is sacked... better to retransmit only the first segment
-                  s = std::min(s, (*it)->m_packet->GetSize ());
-                }
+              s = std::min(s, (*it)->m_packet->GetSize () + (*next)->m_packet->GetSize ());
             }
           else
             {
+              // Next is sacked... better to retransmit only the first segment
               s = std::min(s, (*it)->m_packet->GetSize ());
             }
-          break;
+        }
+      else
+        {
+          s = std::min(s, (*it)->m_packet->GetSize ());
         }
     }
 
@@ -400,7 +403,7 @@ TcpTxBuffer::SplitItems (TcpTxItem *t1, TcpTxItem *t2, uint32_t size) const
 TcpTxItem*
 TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listStartFrom,
                                 uint32_t numBytes, const SequenceNumber32 &seq,
-                                bool *listEdited) const
+                                bool *listEdited)
 {
   NS_LOG_FUNCTION (this << numBytes << seq);
 
@@ -436,12 +439,25 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
   TcpTxItem *outItem = nullptr;
   PacketList::iterator it = list.begin ();
   SequenceNumber32 beginOfCurrentPacket = listStartFrom;
+  bool indexed = (&list == &m_sentList);
+
+  if (indexed && seq > listStartFrom)
+    {
+      // Start the walk from the item that contains seq
+      auto idx = m_sentIndex.upper_bound (seq);
+      if (idx != m_sentIndex.begin ())
+        {
+          --idx;
+          it = idx->second;
+          beginOfCurrentPacket = (*it)->m_startSeq;
+        }
+    }
 
   while (it != list.end ())
     {
       currentItem = *it;
       currentPacket = currentItem->m_packet;
-      NS_ASSERT_MSG (list != m_sentList || currentItem->m_startSeq >= m_firstByteSeq,
+      NS_ASSERT_MSG (!indexed || currentItem->m_startSeq >= m_firstByteSeq,
                      "start: " << m_firstByteSeq << " currentItem start: " <<
                      currentItem->m_startSeq);
 
@@ -471,7 +487,12 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
               SplitItems (firstPart, currentItem, seq - beginOfCurrentPacket);
 
               // insert firstPart before currentItem
-              list.insert (it, firstPart);
+              auto firstIt = list.insert (it, firstPart);
+              if (indexed)
+                {
+                  m_sentIndex[firstPart->m_startSeq] = firstIt;
+                  m_sentIndex[currentItem->m_startSeq] = it;
+                }
               if (listEdited)
                 {
                   *listEdited = true;
@@ -518,6 +539,10 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
                   TcpTxItem *previous = *(--it);
 
                   list.erase (it);
+                  if (indexed)
+                    {
+                      m_sentIndex.erase (currentItem->m_startSeq);
+                    }
 
                   MergeItems (previous, currentItem);
                   delete currentItem;
@@ -537,7 +562,12 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
               SplitItems (firstPart, currentItem, numBytes);
 
               // insert firstPart before currentItem
-              list.insert (it, firstPart);
+              auto firstIt = list.insert (it, firstPart);
+              if (indexed)
+                {
+                  m_sentIndex[firstPart->m_startSeq] = firstIt;
+                  m_sentIndex[currentItem->m_startSeq] = it;
+                }
               if (listEdited)
                 {
                   *listEdited = true;
@@ -567,6 +597,10 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
 
           MergeItems (currentItem, next);
           list.erase (it);
+          if (indexed)
+            {
+              m_sentIndex.erase (next->m_startSeq);
+            }
 
           delete next;
 
@@ -612,6 +646,7 @@ TcpTxBuffer::MergeItems (TcpTxItem *t1, TcpTxItem *t2) const
           self->m_retrans -= t2->m_packet->GetSize ();
           t2->m_retrans = false;
         }
+      m_nextSegHint = m_firstByteSeq;
     }
 
   if (t1->m_lastSent < t2->m_lastSent)
@@ -650,16 +685,30 @@ bool
 TcpTxBuffer::IsRetransmittedDataAcked (const SequenceNumber32& ack) const
 {
   NS_LOG_FUNCTION (this);
-  for (const auto &it : m_sentList)
-     {
-       TcpTxItem *item = it;
-       Ptr<Packet> p = item->m_packet;
-       if (item->m_startSeq + p->GetSize () == ack && !item->m_sacked && item->m_retrans)
-         {
-           return true;
-         }
-     }
-  return false;
+  // Only the item that contains the byte before ack can end at ack
+  auto it = FindSentItem (ack - 1);
+  if (it == m_sentList.end ())
+    {
+      return false;
+    }
+
+  TcpTxItem *item = *it;
+  return item->m_startSeq + item->m_packet->GetSize () == ack
+         && !item->m_sacked && item->m_retrans;
+}
+
+TcpTxBuffer::PacketList::const_iterator
+TcpTxBuffer::FindSentItem (const SequenceNumber32 &seq) const
+{
+  if (m_sentList.empty () || seq < m_firstByteSeq || seq >= m_firstByteSeq + m_sentSize)
+    {
+      return m_sentList.end ();
+    }
+
+  auto idx = m_sentIndex.upper_bound (seq);
+  NS_ASSERT (idx != m_sentIndex.begin ());
+  --idx;
+  return idx->second;
 }
 
 void
@@ -708,6 +757,7 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq,
 
           RemoveFromCounts (item, pktSize);
 
+          m_sentIndex.erase (item->m_startSeq);
           i = m_sentList.erase (i);
           NS_LOG_INFO ("Removed " << *item << " lost: " << m_lostOut <<
                        " retrans: " << m_retrans << " sacked: " << m_sackedOut <<
@@ -727,7 +777,9 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq,
           NS_LOG_INFO (*item);
           // PacketTags are preserved when fragmenting
           item->m_packet = item->m_packet->CreateFragment (offset, pktSize);
+          m_sentIndex.erase (item->m_startSeq);
           item->m_startSeq += offset;
+          m_sentIndex.emplace (item->m_startSeq, i);
           m_size -= offset;
           m_sentSize -= offset;
           m_firstByteSeq += offset;
@@ -758,8 +810,8 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq,
           head->m_sacked = false;
           m_sackedOut -= head->m_packet->GetSize ();
           NS_LOG_INFO ("Moving the SACK flag from the HEAD to another segment");
-          AddRenoSack ();
           MarkHeadAsLost ();
+          AddRenoSack ();
         }
 
       NS_ASSERT_MSG (head->m_startSeq == seq,
@@ -772,6 +824,12 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq,
       m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
     }
 
+  // Keep the scoreboard boundaries inside the window, so that they are
+  // still correctly ordered once the sequence numbers wrap around
+  m_lostScanFloor = std::max (m_lostScanFloor, m_firstByteSeq.Get ());
+  m_highestLost = std::max (m_highestLost, m_firstByteSeq.Get ());
+  m_nextSegHint = std::max (m_nextSegHint, m_firstByteSeq.Get ());
+
   NS_LOG_DEBUG ("Discarded up to " << seq << " lost: " << m_lostOut <<
                 " retrans: " << m_retrans << " sacked: " << m_sackedOut);
   NS_LOG_LOGIC ("Buffer status after discarding data " << *this);
@@ -791,18 +849,21 @@ TcpTxBuffer::Update (const TcpOptionSack::SackList &list,
 
   for (auto option_it = list.begin (); option_it != list.end (); ++option_it)
     {
-      PacketList::iterator item_it = m_sentList.begin ();
-      SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-
       if (m_firstByteSeq + m_sentSize < (*option_it).first)
         {
           NS_LOG_INFO ("Not updating scoreboard, the option block is outside the sent list");
           return bytesSacked;
         }
 
+      // Only the items starting inside the block can be sacked: jump to the
+      // first one, instead of walking the list from the head
+      auto idx = m_sentIndex.lower_bound (std::max ((*option_it).first, m_firstByteSeq.Get ()));
+      PacketList::iterator item_it = (idx == m_sentIndex.end ()) ? m_sentList.end () : idx->second;
+
       while (item_it != m_sentList.end ())
         {
           uint32_t pktSize = (*item_it)->m_packet->GetSize ();
+          SequenceNumber32 beginOfCurrentPacket = (*item_it)->m_startSeq;
 
           // Check the boundary of this packet ... only mark as sacked if
           // it is precisely mapped over the option. It means that if the receiver
@@ -857,7 +918,6 @@ TcpTxBuffer::Update (const TcpOptionSack::SackList &list,
               break;
             }
 
-          beginOfCurrentPacket += pktSize;
           ++item_it;
         }
     }
@@ -893,7 +953,12 @@ TcpTxBuffer::UpdateLostCount ()
                    ", will start from item " << *(*m_highestSack.first));
     }
 
-  for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
+  // Items below m_lostScanFloor are already lost or sacked: marking them
+  // again would not change anything, so stop the walk there.
+  bool floorFound = false;
+  SequenceNumber32 newFloor;
+  auto it = m_highestSack.first;
+  for (; it != m_sentList.begin () && (*it)->m_startSeq >= m_lostScanFloor; --it)
     {
       TcpTxItem *item = *it;
       if (item->m_sacked)
@@ -903,24 +968,33 @@ TcpTxBuffer::UpdateLostCount ()
 
       if (sacked >= m_dupAckThresh)
         {
+          if (!floorFound)
+            {
+              // From this item down to the head, everything will be lost or sacked
+              floorFound = true;
+              newFloor = item->m_startSeq + item->m_packet->GetSize ();
+            }
           if (!item->m_sacked && !item->m_lost)
             {
-              item->m_lost = true;
-              m_lostOut += item->m_packet->GetSize ();
+              MarkItemAsLost (item);
             }
         }
       beginOfCurrentPacket -= item->m_packet->GetSize ();
     }
 
-  if (sacked >= m_dupAckThresh)
+  if (sacked >= m_dupAckThresh && it == m_sentList.begin ())
     {
       TcpTxItem *item = *m_sentList.begin ();
       if (!item->m_lost)
         {
-          item->m_lost = true;
-          m_lostOut += item->m_packet->GetSize ();
+          MarkItemAsLost (item);
         }
     }
+
+  if (floorFound && newFloor > m_lostScanFloor)
+    {
+      m_lostScanFloor = newFloor;
+    }
   NS_LOG_INFO ("Status after the update: " << *this);
   ConsistencyCheck ();
 }
@@ -930,35 +1004,28 @@ TcpTxBuffer::IsLost (const SequenceNumber32 &seq) const
 {
   NS_LOG_FUNCTION (this << seq);
 
-  SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-  PacketList::const_iterator it;
-
   if (seq >= m_highestSack.second)
     {
       return false;
     }
 
-  // In theory, using a map and hints when inserting elements can improve
-  // performance
-  for (it = m_sentList.begin (); it != m_sentList.end (); ++it)
+  // Start from the first item that begins at or after seq, and stop at the
+  // first lost or sacked one. No item is lost above m_highestLost.
+  auto idx = m_sentIndex.lower_bound (std::max (seq, m_firstByteSeq.Get ()));
+  PacketList::const_iterator it = (idx == m_sentIndex.end ()) ? m_sentList.end () : idx->second;
+  for (; it != m_sentList.end () && (*it)->m_startSeq < m_highestLost; ++it)
     {
-      // Search for the right iterator before calling IsLost()
-      if (beginOfCurrentPacket >= seq)
+      if ((*it)->m_lost == true)
         {
-          if ((*it)->m_lost == true)
-            {
-              NS_LOG_INFO ("seq=" << seq << " is lost because of lost flag");
-              return true;
-            }
-
-          if ((*it)->m_sacked == true)
-            {
-              NS_LOG_INFO ("seq=" << seq << " is not lost because of sacked flag");
-              return false;
-            }
+          NS_LOG_INFO ("seq=" << seq << " is lost because of lost flag");
+          return true;
         }
 
-      beginOfCurrentPacket += (*it)->m_packet->GetSize ();
+      if ((*it)->m_sacked == true)
+        {
+          NS_LOG_INFO ("seq=" << seq << " is not lost because of sacked flag");
+          return false;
+        }
     }
 
   return false;
@@ -982,19 +1049,34 @@ TcpTxBuffer::NextSeg (SequenceNumber32 *seq, SequenceNumber32 *seqHigh, bool isR
    *
    *     (1.c) IsLost (S2) returns true.
    */
-  PacketList::const_iterator it;
   TcpTxItem *item;
   SequenceNumber32 seqPerRule3;
   bool isSeqPerRule3Valid = false;
-  SequenceNumber32 beginOfCurrentPkt = m_firstByteSeq;
+  bool hintUpdated = false;
 
-  for (it = m_sentList.begin (); it != m_sentList.end (); ++it)
+  // Items below m_nextSegHint are sacked or already retransmitted, and
+  // no item at or above m_highestLost is lost: walk only between them.
+  auto idx = m_sentIndex.lower_bound (std::max (m_nextSegHint, m_firstByteSeq.Get ()));
+  PacketList::const_iterator it = (idx == m_sentIndex.end ()) ? m_sentList.end () : idx->second;
+  for (; it != m_sentList.end (); ++it)
     {
       item = *it;
+      SequenceNumber32 beginOfCurrentPkt = item->m_startSeq;
+
+      if (hintUpdated && beginOfCurrentPkt >= m_highestLost)
+        {
+          break;
+        }
 
       // Condition 1.a , 1.b , and 1.c
       if (item->m_retrans == false && item->m_sacked == false)
         {
+          if (!hintUpdated)
+            {
+              m_nextSegHint = beginOfCurrentPkt;
+              hintUpdated = true;
+            }
+
           if (item->m_lost)
             {
               NS_LOG_INFO("IsLost, returning" << beginOfCurrentPkt);
@@ -1009,9 +1091,11 @@ TcpTxBuffer::NextSeg (SequenceNumber32 *seq, SequenceNumber32 *seqHigh, bool isR
               seqPerRule3 = beginOfCurrentPkt;
             }
         }
+    }
 
-      // Nothing found, iterate
-      beginOfCurrentPkt += item->m_packet->GetSize ();
+  if (!hintUpdated)
+    {
+      m_nextSegHint = m_firstByteSeq + m_sentSize;
     }
 
   /* (2) If no sequence number 'S2' per rule (1) exists but there
@@ -1225,6 +1309,8 @@ TcpTxBuffer::ResetRenoSack ()
     }
 
   m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
+  m_lostScanFloor = m_firstByteSeq;
+  m_nextSegHint = m_firstByteSeq;
 }
 
 void
@@ -1248,12 +1334,16 @@ TcpTxBuffer::ResetSentList ()
       m_appList.push_front (item);
       m_sentList.pop_back ();
     }
+  m_sentIndex.clear ();
 
   m_sentSize = 0;
   m_lostOut = 0;
   m_retrans = 0;
   m_sackedOut = 0;
   m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
+  m_lostScanFloor = m_firstByteSeq;
+  m_highestLost = m_firstByteSeq;
+  m_nextSegHint = m_firstByteSeq;
 }
 
 void
@@ -1264,6 +1354,7 @@ TcpTxBuffer::ResetLastSegmentSent ()
     {
       TcpTxItem *item = m_sentList.back ();
 
+      m_sentIndex.erase (item->m_startSeq);
       m_sentList.pop_back ();
       m_sentSize -= item->m_packet->GetSize ();
       if (item->m_retrans)
@@ -1271,6 +1362,11 @@ TcpTxBuffer::ResetLastSegmentSent ()
           m_retrans -= item->m_packet->GetSize ();
         }
       m_appList.insert (m_appList.begin (), item);
+
+      // The item will be sent again as new data: the boundaries cannot
+      // be above the end of the sent list
+      m_lostScanFloor = std::min (m_lostScanFloor, item->m_startSeq);
+      m_nextSegHint = std::min (m_nextSegHint, item->m_startSeq);
     }
   ConsistencyCheck ();
 }
@@ -1317,6 +1413,11 @@ TcpTxBuffer::SetSentListLost (bool resetSack)
       (*it)->m_retrans = false;
     }
 
+  // Now every item is lost or sacked, and none is retransmitted
+  m_lostScanFloor = m_firstByteSeq + m_sentSize;
+  m_highestLost = m_firstByteSeq + m_sentSize;
+  m_nextSegHint = m_firstByteSeq;
+
   NS_LOG_INFO ("Set sent list lost, status: " << *this);
   NS_ASSERT_MSG (m_sentSize >= m_sackedOut + m_lostOut, *this);
   ConsistencyCheck ();
@@ -1349,6 +1450,7 @@ TcpTxBuffer::DeleteRetransmittedFlagFromHead ()
     {
       m_sentList.front ()->m_retrans = false;
       m_retrans -= m_sentList.front ()->m_packet->GetSize ();
+      m_nextSegHint = m_firstByteSeq;
     }
   ConsistencyCheck ();
 }
@@ -1375,13 +1477,29 @@ TcpTxBuffer::MarkHeadAsLost ()
 
       if (! m_sentList.front()->m_lost)
         {
-          m_sentList.front()->m_lost = true;
-          m_lostOut += m_sentList.front ()->m_packet->GetSize ();
+          MarkItemAsLost (m_sentList.front ());
         }
+      m_nextSegHint = m_firstByteSeq;
     }
   ConsistencyCheck ();
 }
 
+void
+TcpTxBuffer::MarkItemAsLost (TcpTxItem *item)
+{
+  NS_LOG_FUNCTION (this << *item);
+  NS_ASSERT (!item->m_lost);
+
+  item->m_lost = true;
+  m_lostOut += item->m_packet->GetSize ();
+
+  SequenceNumber32 end = item->m_startSeq + item->m_packet->GetSize ();
+  if (end > m_highestLost)
+    {
+      m_highestLost = end;
+    }
+}
+
 void
 TcpTxBuffer::AddRenoSack (void)
 {
@@ -1460,6 +1578,30 @@ TcpTxBuffer::ConsistencyCheck () const
                  " stored lost: " << m_lostOut);
   NS_ASSERT_MSG (retrans == m_retrans, " Counted retrans: " << retrans <<
                  " stored retrans: " << m_retrans);
+
+  NS_ASSERT_MSG (m_sentIndex.size () == m_sentList.size (),
+                 "Index size: " << m_sentIndex.size () <<
+                 " sent list size: " << m_sentList.size ());
+  bool belowFloor = true;
+  bool belowHint = true;
+  for (auto it = m_sentList.begin (); it != m_sentList.end (); ++it)
+    {
+      const TcpTxItem *item = *it;
+      auto idx = m_sentIndex.find (item->m_startSeq);
+      NS_ASSERT_MSG (idx != m_sentIndex.end () && idx->second == it,
+                     "Item " << *item << " is not indexed");
+
+      belowFloor = belowFloor && item->m_startSeq < m_lostScanFloor;
+      belowHint = belowHint && item->m_startSeq < m_nextSegHint;
+      NS_ASSERT_MSG (!belowFloor || item->m_lost || item->m_sacked,
+                     "Item " << *item << " below " << m_lostScanFloor <<
+                     " is neither lost nor sacked");
+      NS_ASSERT_MSG (!belowHint || item->m_retrans || item->m_sacked,
+                     "Item " << *item << " below " << m_nextSegHint <<
+                     " is neither retransmitted nor sacked");
+      NS_ASSERT_MSG (!item->m_lost || item->m_startSeq < m_highestLost,
+                     "Item " << *item << " is lost above " << m_highestLost);
+    }
 }
 
 std::ostream &
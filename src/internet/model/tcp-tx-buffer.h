@@ -22,6 +22,8 @@
 #ifndef TCP_TX_BUFFER_H
 #define TCP_TX_BUFFER_H
 
+#include <map>
+
 #include "ns3/object.h"
 #include "ns3/traced-value.h"
 #include "ns3/sequence-number.h"
@@ -70,8 +72,20 @@ class Packet;
  * associated with every segment sent. This is done through the use of the
  * class TcpTxItem: instead of storing a list of packets, we store a list of
  * TcpTxItem. Each item has different flags (check the corresponding
- * documentation) and maintaining the scoreboard is a matter of travelling the
- * list and set the SACK flag on the corresponding segment sent.
+ * documentation) and maintaining the scoreboard is a matter of finding the
+ * segments covered by a SACK block and setting their SACK flag.
+ *
+ * To avoid walking the whole list on every ACK (which, with windows of tens
+ * of thousands of segments, makes SACK processing quadratic per RTT), the
+ * sent list is indexed by the starting sequence number of each item. Since
+ * the items never overlap, the index is an interval map: the item covering
+ * a given sequence is found in logarithmic time, and the SACK blocks,
+ * IsLost and the retransmission of a previously sent block only touch
+ * the items they cover. The scoreboard also remembers a few sequence
+ * boundaries (below which every segment is lost or sacked, above which no
+ * segment is lost, below which every segment is sacked or retransmitted) so
+ * that UpdateLostCount and NextSeg resume their walks where the previous
+ * call stopped instead of restarting from the head.
  *
  * Item properties
  * ---------------
@@ -427,9 +441,9 @@ private:
    * The {New}Reno cases, for now, are managed in TcpSocketBase through the
    * call to MarkHeadAsLost.
    * This function is, therefore, called after a SACK option has been received,
-   * and updates the lost count. It can be probably optimized by not walking
-   * the entire list, but a subset.
-   *
+   * and updates the lost count. The walk goes backward from the highest
+   * sacked item and stops at m_lostScanFloor, since every item below it is
+   * already marked as lost or sacked.
    */
   void UpdateLostCount ();
 
@@ -561,7 +575,7 @@ private:
    */
   TcpTxItem* GetPacketFromList (PacketList &list, const SequenceNumber32 &startingSeq,
                                 uint32_t numBytes, const SequenceNumber32 &requestedSeq,
-                                bool *listEdited = nullptr) const;
+                                bool *listEdited = nullptr);
 
   /**
    * \brief Merge two TcpTxItem
@@ -587,9 +601,23 @@ private:
    */
   void SplitItems (TcpTxItem *t1, TcpTxItem *t2, uint32_t size) const;
 
+  /**
+   * \brief Mark an item as lost, updating the lost count
+   * \param item Item to mark
+   */
+  void MarkItemAsLost (TcpTxItem *item);
+
+  /**
+   * \brief Find the sent item that contains a sequence number
+   * \param seq Sequence to search
+   * \return an iterator inside m_sentList, or m_sentList.end () if seq is
+   * not inside the sent list
+   */
+  PacketList::const_iterator FindSentItem (const SequenceNumber32 &seq) const;
+
   /**
    * \brief Check if the values of sacked, lost, retrans, are in sync
-   * with the sent list.
+   * with the sent list, and if the index is in sync with the sent list.
    */
   void ConsistencyCheck () const;
 
@@ -602,6 +630,7 @@ private:
 
   PacketList m_appList;  //!< Buffer for application data
   PacketList m_sentList; //!< Buffer for sent (but not acked) data
+  std::map<SequenceNumber32, PacketList::iterator> m_sentIndex; //!< Sent items, indexed by their starting sequence
   uint32_t m_maxBuffer;  //!< Max number of data bytes in buffer (SND.WND)
   uint32_t m_size;       //!< Size of all data in this buffer
   uint32_t m_sentSize;   //!< Size of sent (and not discarded) segments
@@ -614,6 +643,10 @@ private:
   uint32_t m_sackedOut {0}; //!< Number of sacked bytes
   uint32_t m_retrans   {0}; //!< Number of retransmitted bytes
 
+  SequenceNumber32 m_lostScanFloor {0}; //!< Every sent item starting below is lost or sacked
+  SequenceNumber32 m_highestLost {0};   //!< No sent item starting at or above is lost
+  mutable SequenceNumber32 m_nextSegHint {0}; //!< Every sent item starting below is sacked or retransmitted
+
   uint32_t m_dupAckThresh {0}; //!< Duplicate Ack threshold from TcpSocketBase
   uint32_t m_segmentSize {0}; //!< Segment size from TcpSocketBase
   bool     m_renoSack {false}; //!< Indicates if AddRenoSack was called
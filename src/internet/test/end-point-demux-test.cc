@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv6-end-point-demux.h"
+#include "ns3/ipv6-end-point.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Ipv4EndPointDemux lookups with many connections on the same port.
+ *
+ * A listening end point and many connected end points share the local
+ * port: each packet must reach the connection it belongs to, or the
+ * listener when no connection matches, also after the peer of an end
+ * point is changed or an end point is removed.
+ */
+class Ipv4EndPointDemuxTestCase : public TestCase
+{
+public:
+  Ipv4EndPointDemuxTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+Ipv4EndPointDemuxTestCase::Ipv4EndPointDemuxTestCase ()
+  : TestCase ("Ipv4EndPointDemux lookups through the hash indexes")
+{
+}
+
+void
+Ipv4EndPointDemuxTestCase::DoRun (void)
+{
+  Ipv4EndPointDemux demux;
+  Ptr<Ipv4Interface> iface = CreateObject<Ipv4Interface> ();
+  Ipv4Address local ("10.0.0.1");
+
+  Ipv4EndPoint *listener = demux.Allocate (0, 80);
+  NS_TEST_ASSERT_MSG_NE (listener, 0, "Listener not allocated");
+  NS_TEST_ASSERT_MSG_EQ (demux.Allocate (0, 80), 0, "Duplicated listener allocated");
+
+  std::vector<Ipv4EndPoint *> conns;
+  for (uint32_t i = 0; i < 1000; ++i)
+    {
+      Ipv4Address peer (Ipv4Address ("10.1.0.0").Get () + i / 10);
+      conns.push_back (demux.Allocate (0, local, 80, peer, 1000 + i % 10));
+      NS_TEST_ASSERT_MSG_NE (conns.back (), 0, "Connection not allocated");
+    }
+  NS_TEST_ASSERT_MSG_EQ (demux.Allocate (0, local, 80, Ipv4Address ("10.1.0.0"), 1000), 0,
+                         "Duplicated connection allocated");
+  NS_TEST_ASSERT_MSG_EQ (demux.GetAllEndPoints ().size (), 1001, "Wrong number of end points");
+
+  for (uint32_t i = 0; i < 1000; i += 37)
+    {
+      Ipv4Address peer (Ipv4Address ("10.1.0.0").Get () + i / 10);
+      Ipv4EndPointDemux::EndPoints found = demux.Lookup (local, 80, peer, 1000 + i % 10, iface);
+      NS_TEST_ASSERT_MSG_EQ (found.size (), 1, "Connection not found");
+      NS_TEST_ASSERT_MSG_EQ (found.front (), conns[i], "Wrong connection found");
+      NS_TEST_ASSERT_MSG_EQ (demux.SimpleLookup (local, 80, peer, 1000 + i % 10), conns[i],
+                             "Wrong connection found by SimpleLookup");
+    }
+
+  // Unknown peer: the listener gets it
+  Ipv4EndPointDemux::EndPoints found = demux.Lookup (local, 80, Ipv4Address ("10.2.0.1"), 5000, iface);
+  NS_TEST_ASSERT_MSG_EQ (found.size (), 1, "Listener not found");
+  NS_TEST_ASSERT_MSG_EQ (found.front (), listener, "Wrong end point found");
+  NS_TEST_ASSERT_MSG_EQ (demux.Lookup (local, 81, Ipv4Address ("10.2.0.1"), 5000, iface).size (), 0,
+                         "End point found on a port without end points");
+
+  // Changing the peer moves the end point in the index
+  conns[0]->SetPeer (Ipv4Address ("10.2.0.1"), 5000);
+  found = demux.Lookup (local, 80, Ipv4Address ("10.2.0.1"), 5000, iface);
+  NS_TEST_ASSERT_MSG_EQ (found.front (), conns[0], "Connection not found after SetPeer");
+  found = demux.Lookup (local, 80, Ipv4Address ("10.1.0.0"), 1000, iface);
+  NS_TEST_ASSERT_MSG_EQ (found.front (), listener, "Connection found with its old peer");
+
+  // Removed connections are not found anymore
+  demux.DeAllocate (conns[1]);
+  found = demux.Lookup (local, 80, Ipv4Address ("10.1.0.0"), 1001, iface);
+  NS_TEST_ASSERT_MSG_EQ (found.front (), listener, "Removed connection found");
+
+  demux.DeAllocate (listener);
+  NS_TEST_ASSERT_MSG_EQ (demux.LookupPortLocal (80), true, "Port 80 should still be in use");
+  for (uint32_t i = 0; i < conns.size (); ++i)
+    {
+      if (i != 1)
+        {
+          demux.DeAllocate (conns[i]);
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (demux.LookupPortLocal (80), false, "Port 80 should be free");
+  NS_TEST_ASSERT_MSG_EQ (demux.GetAllEndPoints ().size (), 0, "End points left");
+
+  // Ephemeral ports are not reused while allocated
+  Ipv4EndPoint *first = demux.Allocate ();
+  Ipv4EndPoint *second = demux.Allocate ();
+  NS_TEST_ASSERT_MSG_NE (first->GetLocalPort (), second->GetLocalPort (), "Ephemeral port reused");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Ipv6EndPointDemux lookups with many connections on the same port.
+ */
+class Ipv6EndPointDemuxTestCase : public TestCase
+{
+public:
+  Ipv6EndPointDemuxTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+Ipv6EndPointDemuxTestCase::Ipv6EndPointDemuxTestCase ()
+  : TestCase ("Ipv6EndPointDemux lookups through the hash indexes")
+{
+}
+
+void
+Ipv6EndPointDemuxTestCase::DoRun (void)
+{
+  Ipv6EndPointDemux demux;
+  Ipv6Address local ("2001:db8::1");
+  Ipv6Address peer ("2001:db8:1::1");
+
+  Ipv6EndPoint *listener = demux.Allocate (0, 80);
+  NS_TEST_ASSERT_MSG_NE (listener, 0, "Listener not allocated");
+
+  std::vector<Ipv6EndPoint *> conns;
+  for (uint16_t i = 0; i < 1000; ++i)
+    {
+      conns.push_back (demux.Allocate (0, local, 80, peer, 1000 + i));
+      NS_TEST_ASSERT_MSG_NE (conns.back (), 0, "Connection not allocated");
+    }
+
+  for (uint16_t i = 0; i < 1000; i += 37)
+    {
+      Ipv6EndPointDemux::EndPoints found = demux.Lookup (local, 80, peer, 1000 + i, 0);
+      NS_TEST_ASSERT_MSG_EQ (found.size (), 1, "Connection not found");
+      NS_TEST_ASSERT_MSG_EQ (found.front (), conns[i], "Wrong connection found");
+      NS_TEST_ASSERT_MSG_EQ (demux.SimpleLookup (local, 80, peer, 1000 + i), conns[i],
+                             "Wrong connection found by SimpleLookup");
+    }
+  Ipv6EndPointDemux::EndPoints found = demux.Lookup (local, 80, peer, 5000, 0);
+  NS_TEST_ASSERT_MSG_EQ (found.front (), listener, "Listener not found");
+
+  // Changing the local port moves the end point to the other port
+  conns[0]->SetLocalPort (8080);
+  NS_TEST_ASSERT_MSG_EQ (demux.LookupPortLocal (8080), true, "Port 8080 should be in use");
+  found = demux.Lookup (local, 8080, peer, 1000, 0);
+  NS_TEST_ASSERT_MSG_EQ (found.front (), conns[0], "Connection not found after SetLocalPort");
+  found = demux.Lookup (local, 80, peer, 1000, 0);
+  NS_TEST_ASSERT_MSG_EQ (found.front (), listener, "Connection found on its old port");
+
+  demux.DeAllocate (conns[0]);
+  NS_TEST_ASSERT_MSG_EQ (demux.LookupPortLocal (8080), false, "Port 8080 should be free");
+  NS_TEST_ASSERT_MSG_EQ (demux.GetEndPoints ().size (), 1000, "Wrong number of end points");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief End point demux TestSuite
+ */
+class EndPointDemuxTestSuite : public TestSuite
+{
+public:
+  EndPointDemuxTestSuite ()
+    : TestSuite ("end-point-demux", UNIT)
+  {
+    AddTestCase (new Ipv4EndPointDemuxTestCase, TestCase::QUICK);
+    AddTestCase (new Ipv6EndPointDemuxTestCase, TestCase::QUICK);
+  }
+};
+
+static EndPointDemuxTestSuite g_endPointDemuxTestSuite; //!< Static variable for test initialization
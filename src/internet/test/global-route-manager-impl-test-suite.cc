@@ -226,6 +226,95 @@ GlobalRouteManagerImplTestCase::DoRun (void)
 }
 
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief CandidateQueue ordering Test
+ */
+class CandidateQueueOrderTestCase : public TestCase
+{
+public:
+  CandidateQueueOrderTestCase ();
+  virtual void DoRun (void);
+};
+
+CandidateQueueOrderTestCase::CandidateQueueOrderTestCase ()
+  : TestCase ("CandidateQueue pops in distance order, networks first, FIFO on ties")
+{
+}
+
+void
+CandidateQueueOrderTestCase::DoRun (void)
+{
+  CandidateQueue candidate;
+
+  // r1 and r2 share a distance with network n1; n1 must come out first,
+  // then the routers in the order they were pushed.
+  SPFVertex *r1 = new SPFVertex;
+  r1->SetVertexType (SPFVertex::VertexRouter);
+  r1->SetVertexId ("0.0.0.1");
+  r1->SetDistanceFromRoot (5);
+  SPFVertex *r2 = new SPFVertex;
+  r2->SetVertexType (SPFVertex::VertexRouter);
+  r2->SetVertexId ("0.0.0.2");
+  r2->SetDistanceFromRoot (5);
+  SPFVertex *n1 = new SPFVertex;
+  n1->SetVertexType (SPFVertex::VertexNetwork);
+  n1->SetVertexId ("10.0.0.1");
+  n1->SetDistanceFromRoot (5);
+  SPFVertex *r3 = new SPFVertex;
+  r3->SetVertexType (SPFVertex::VertexRouter);
+  r3->SetVertexId ("0.0.0.3");
+  r3->SetDistanceFromRoot (9);
+  SPFVertex *r4 = new SPFVertex;
+  r4->SetVertexType (SPFVertex::VertexRouter);
+  r4->SetVertexId ("0.0.0.4");
+  r4->SetDistanceFromRoot (7);
+
+  candidate.Push (r3);
+  candidate.Push (r1);
+  candidate.Push (r2);
+  candidate.Push (n1);
+  candidate.Push (r4);
+  NS_TEST_ASSERT_MSG_EQ (candidate.Size (), 5, "Wrong queue size");
+  NS_TEST_ASSERT_MSG_EQ (candidate.Top (), n1, "Network should lead its tie group");
+  NS_TEST_ASSERT_MSG_EQ (candidate.Find (Ipv4Address ("0.0.0.3")), r3, "Find failed");
+
+  // A shorter path to r3 moves it to the tail of the distance 5 group.
+  r3->SetDistanceFromRoot (5);
+  candidate.Update (r3);
+
+  SPFVertex *expected[] = { n1, r1, r2, r3, r4 };
+  for (uint32_t i = 0; i < 5; ++i)
+    {
+      SPFVertex *v = candidate.Pop ();
+      NS_TEST_ASSERT_MSG_EQ (v, expected[i], "Wrong pop order at position " << i);
+      NS_TEST_ASSERT_MSG_EQ (candidate.Find (v->GetVertexId ()), 0, "Popped vertex still found");
+      delete v;
+    }
+  NS_TEST_ASSERT_MSG_EQ (candidate.Empty (), true, "Queue should be empty");
+
+  // Random distances come out nondecreasing.
+  for (int i = 0; i < 200; ++i)
+    {
+      SPFVertex *v = new SPFVertex;
+      v->SetVertexType (SPFVertex::VertexRouter);
+      v->SetVertexId (Ipv4Address (i + 1));
+      v->SetDistanceFromRoot (std::rand () % 50);
+      candidate.Push (v);
+    }
+  uint32_t last = 0;
+  while (!candidate.Empty ())
+    {
+      SPFVertex *v = candidate.Pop ();
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (v->GetDistanceFromRoot (), last, "Distances out of order");
+      last = v->GetDistanceFromRoot ();
+      delete v;
+    }
+}
+
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -243,6 +332,7 @@ GlobalRouteManagerImplTestSuite::GlobalRouteManagerImplTestSuite ()
   : TestSuite ("global-route-manager-impl", UNIT)
 {
   AddTestCase (new GlobalRouteManagerImplTestCase (), TestCase::QUICK);
+  AddTestCase (new CandidateQueueOrderTestCase (), TestCase::QUICK);
 }
 
 static GlobalRouteManagerImplTestSuite g_globalRoutingManagerImplTestSuite; //!< Static variable for test initialization
@@ -41,7 +41,10 @@
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/ipv4-global-routing.h"
+#include "ns3/global-route-manager-impl.h"
 #include "ns3/bridge-helper.h"
+#include "ns3/output-stream-wrapper.h"
+#include <sstream>
 
 using namespace ns3;
 
@@ -1244,6 +1247,263 @@ Ipv4GlobalRoutingSlash32TestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \brief Print the global routing tables of some nodes.
+ * \param nodes The nodes.
+ * \returns The routing tables as a string.
+ */
+static std::string
+DumpGlobalRoutingTables (const NodeContainer &nodes)
+{
+  std::ostringstream oss;
+  Ptr<OutputStreamWrapper> stream = Create<OutputStreamWrapper> (&oss);
+  for (uint32_t i = 0; i < nodes.GetN (); ++i)
+    {
+      Ptr<Ipv4GlobalRouting> globalRouting = nodes.Get (i)->GetObject<Ipv4> ()
+        ->GetRoutingProtocol ()->GetObject<Ipv4GlobalRouting> ();
+      globalRouting->PrintRoutingTable (stream);
+    }
+  return oss.str ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 GlobalRouting multithreaded SPF test
+ *
+ * Builds a grid of routers joined by point-to-point links and checks
+ * that running the SPF calculations on several threads produces the
+ * same routing tables as a single-threaded run.
+ */
+class Ipv4GlobalRoutingSpfThreadsTestCase : public TestCase
+{
+public:
+  Ipv4GlobalRoutingSpfThreadsTestCase ();
+  virtual void DoSetup (void);
+  virtual void DoRun (void);
+private:
+  NodeContainer m_nodes; //!< Nodes used in the test.
+};
+
+Ipv4GlobalRoutingSpfThreadsTestCase::Ipv4GlobalRoutingSpfThreadsTestCase ()
+  : TestCase ("Global routing tables do not depend on the SPF thread count")
+{
+}
+
+void
+Ipv4GlobalRoutingSpfThreadsTestCase::DoSetup ()
+{
+  const uint32_t side = 5;
+  m_nodes.Create (side * side);
+
+  InternetStackHelper internet;
+  Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+  internet.SetRoutingHelper (ipv4RoutingHelper);
+  internet.Install (m_nodes);
+
+  SimpleNetDeviceHelper simpleHelper;
+  simpleHelper.SetNetDevicePointToPointMode (true);
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.0.0", "255.255.255.252");
+  for (uint32_t row = 0; row < side; ++row)
+    {
+      for (uint32_t col = 0; col < side; ++col)
+        {
+          uint32_t id = row * side + col;
+          if (col + 1 < side)
+            {
+              NodeContainer pair (m_nodes.Get (id), m_nodes.Get (id + 1));
+              ipv4.Assign (simpleHelper.Install (pair, CreateObject<SimpleChannel> ()));
+              ipv4.NewNetwork ();
+            }
+          if (row + 1 < side)
+            {
+              NodeContainer pair (m_nodes.Get (id), m_nodes.Get (id + side));
+              ipv4.Assign (simpleHelper.Install (pair, CreateObject<SimpleChannel> ()));
+              ipv4.NewNetwork ();
+            }
+        }
+    }
+}
+
+void
+Ipv4GlobalRoutingSpfThreadsTestCase::DoRun ()
+{
+  Config::SetGlobal ("GlobalRoutingSpfThreads", UintegerValue (1));
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+  std::string serial = DumpGlobalRoutingTables (m_nodes);
+
+  Config::SetGlobal ("GlobalRoutingSpfThreads", UintegerValue (4));
+  Ipv4GlobalRoutingHelper::RecomputeRoutingTables ();
+  std::string threaded = DumpGlobalRoutingTables (m_nodes);
+
+  NS_TEST_ASSERT_MSG_EQ (threaded.empty (), false, "No routing tables printed");
+  NS_TEST_ASSERT_MSG_EQ (threaded, serial, "Threaded SPF produced different routes");
+
+  Config::SetGlobal ("GlobalRoutingSpfThreads", UintegerValue (0));
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 GlobalRouting incremental update test
+ *
+ * Flaps links of a grid of routers, and of a chain of routers around a
+ * LAN, and checks that the routes brought up to date by
+ * UpdateRoutingTables are the ones a full recomputation finds.  The
+ * routing table of a separate network must not be touched.
+ */
+class Ipv4GlobalRoutingUpdateTestCase : public TestCase
+{
+public:
+  Ipv4GlobalRoutingUpdateTestCase ();
+  virtual void DoSetup (void);
+  virtual void DoRun (void);
+private:
+  /**
+   * \brief Set both ends of a link up or down.
+   * \param link The link index.
+   * \param up Whether the link goes up.
+   */
+  void SetLink (uint32_t link, bool up);
+  NodeContainer m_nodes; //!< Nodes of the grid and the chain.
+  NodeContainer m_island; //!< Nodes of the separate network.
+  std::vector<NetDeviceContainer> m_links; //!< Point-to-point links of the grid and the chain.
+};
+
+Ipv4GlobalRoutingUpdateTestCase::Ipv4GlobalRoutingUpdateTestCase ()
+  : TestCase ("Global routing incremental updates match a full recomputation")
+{
+}
+
+void
+Ipv4GlobalRoutingUpdateTestCase::DoSetup ()
+{
+  const uint32_t side = 4;
+  m_nodes.Create (side * side + 4);
+  m_island.Create (2);
+
+  InternetStackHelper internet;
+  Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+  internet.SetRoutingHelper (ipv4RoutingHelper);
+  internet.Install (m_nodes);
+  internet.Install (m_island);
+
+  SimpleNetDeviceHelper simpleHelper;
+  simpleHelper.SetNetDevicePointToPointMode (true);
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.2.0.0", "255.255.255.252");
+  for (uint32_t row = 0; row < side; ++row)
+    {
+      for (uint32_t col = 0; col < side; ++col)
+        {
+          uint32_t id = row * side + col;
+          if (col + 1 < side)
+            {
+              NodeContainer pair (m_nodes.Get (id), m_nodes.Get (id + 1));
+              m_links.push_back (simpleHelper.Install (pair, CreateObject<SimpleChannel> ()));
+              ipv4.Assign (m_links.back ());
+              ipv4.NewNetwork ();
+            }
+          if (row + 1 < side)
+            {
+              NodeContainer pair (m_nodes.Get (id), m_nodes.Get (id + side));
+              m_links.push_back (simpleHelper.Install (pair, CreateObject<SimpleChannel> ()));
+              ipv4.Assign (m_links.back ());
+              ipv4.NewNetwork ();
+            }
+        }
+    }
+  // Uneven metrics keep most trees free of equal-cost paths, so that a
+  // flapped link leaves the shape of some of them unchanged.
+  for (uint32_t link = 0; link < m_links.size (); link++)
+    {
+      for (uint32_t i = 0; i < 2; i++)
+        {
+          Ptr<NetDevice> device = m_links[link].Get (i);
+          Ptr<Ipv4> node = device->GetNode ()->GetObject<Ipv4> ();
+          node->SetMetric (node->GetInterfaceForDevice (device), 1 + (link * 7) % 5);
+        }
+    }
+  ipv4.Assign (simpleHelper.Install (m_island, CreateObject<SimpleChannel> ()));
+  ipv4.NewNetwork ();
+
+  // A chain n0 -- n1 == LAN == n2 -- n3 apart from the grid: SPF does not
+  // support equal-cost paths in front of a LAN.
+  uint32_t n0 = side * side;
+  NodeContainer chain (m_nodes.Get (n0), m_nodes.Get (n0 + 1));
+  m_links.push_back (simpleHelper.Install (chain, CreateObject<SimpleChannel> ()));
+  ipv4.Assign (m_links.back ());
+  ipv4.NewNetwork ();
+  chain = NodeContainer (m_nodes.Get (n0 + 2), m_nodes.Get (n0 + 3));
+  m_links.push_back (simpleHelper.Install (chain, CreateObject<SimpleChannel> ()));
+  ipv4.Assign (m_links.back ());
+  SimpleNetDeviceHelper lanHelper;
+  NodeContainer lan (m_nodes.Get (n0 + 1), m_nodes.Get (n0 + 2));
+  ipv4.SetBase ("10.3.0.0", "255.255.255.0");
+  ipv4.Assign (lanHelper.Install (lan, CreateObject<SimpleChannel> ()));
+}
+
+void
+Ipv4GlobalRoutingUpdateTestCase::SetLink (uint32_t link, bool up)
+{
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      Ptr<NetDevice> device = m_links[link].Get (i);
+      Ptr<Ipv4> ipv4 = device->GetNode ()->GetObject<Ipv4> ();
+      int32_t interface = ipv4->GetInterfaceForDevice (device);
+      if (up)
+        {
+          ipv4->SetUp (interface);
+        }
+      else
+        {
+          ipv4->SetDown (interface);
+        }
+    }
+}
+
+void
+Ipv4GlobalRoutingUpdateTestCase::DoRun ()
+{
+  Config::SetGlobal ("GlobalRoutingSpfThreads", UintegerValue (2));
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+
+  Ptr<Ipv4GlobalRouting> islandRouting = m_island.Get (0)->GetObject<Ipv4> ()
+    ->GetRoutingProtocol ()->GetObject<Ipv4GlobalRouting> ();
+  NS_TEST_ASSERT_MSG_GT (islandRouting->GetNRoutes (), 0, "No route on the separate network");
+  Ipv4RoutingTableEntry *islandRoute = islandRouting->GetRoute (0);
+
+  std::vector<bool> down (m_links.size (), false);
+  uint32_t seed = 7;
+  for (uint32_t step = 0; step < 24; ++step)
+    {
+      seed = seed * 1103515245 + 12345;
+      uint32_t link = (seed >> 16) % m_links.size ();
+      down[link] = !down[link];
+      SetLink (link, !down[link]);
+
+      Ipv4GlobalRoutingHelper::UpdateRoutingTables ();
+      std::string updated = DumpGlobalRoutingTables (m_nodes);
+      NS_TEST_ASSERT_MSG_EQ (islandRouting->GetRoute (0), islandRoute,
+                             "Routes of the separate network were recomputed");
+
+      GlobalRouteManagerImpl reference;
+      reference.DeleteGlobalRoutes ();
+      reference.BuildGlobalRoutingDatabase ();
+      reference.InitializeRoutes ();
+      std::string recomputed = DumpGlobalRoutingTables (m_nodes);
+      NS_TEST_ASSERT_MSG_EQ (updated, recomputed, "Routes differ after step " << step);
+      islandRoute = islandRouting->GetRoute (0);
+    }
+
+  Config::SetGlobal ("GlobalRoutingSpfThreads", UintegerValue (0));
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -1267,6 +1527,8 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite ()
     AddTestCase (new TwoBridgeTest, TestCase::QUICK);
     AddTestCase (new Ipv4DynamicGlobalRoutingTestCase, TestCase::QUICK);
     AddTestCase (new Ipv4GlobalRoutingSlash32TestCase, TestCase::QUICK);
+    AddTestCase (new Ipv4GlobalRoutingSpfThreadsTestCase, TestCase::QUICK);
+    AddTestCase (new Ipv4GlobalRoutingUpdateTestCase, TestCase::QUICK);
   }
 
 static Ipv4GlobalRoutingTestSuite g_globalRoutingTestSuite; //!< Static variable for test initialization
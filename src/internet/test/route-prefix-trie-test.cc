@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <vector>
+#include "ns3/test.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/route-prefix-trie.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief RoutePrefixTrie matches with nested and diverging prefixes.
+ *
+ * Checks that Match returns the values of all the prefixes containing
+ * an address, in insertion order, and that removed values (and the
+ * nodes left without values) are not found anymore.
+ */
+class Ipv4RoutePrefixTrieTestCase : public TestCase
+{
+public:
+  Ipv4RoutePrefixTrieTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+Ipv4RoutePrefixTrieTestCase::Ipv4RoutePrefixTrieTestCase ()
+  : TestCase ("Ipv4RoutePrefixTrie with nested prefixes and removals")
+{
+}
+
+void
+Ipv4RoutePrefixTrieTestCase::DoRun (void)
+{
+  Ipv4RoutePrefixTrie<int> trie;
+  std::vector<int> out;
+
+  trie.Insert (Ipv4Address ("10.1.2.0"), Ipv4Mask ("255.255.255.0"), 1);
+  trie.Insert (Ipv4Address ("0.0.0.0"), Ipv4Mask::GetZero (), 2);
+  trie.Insert (Ipv4Address ("10.0.0.0"), Ipv4Mask ("255.0.0.0"), 3);
+  trie.Insert (Ipv4Address ("10.1.2.3"), Ipv4Mask::GetOnes (), 4);
+  trie.Insert (Ipv4Address ("10.1.3.0"), Ipv4Mask ("255.255.255.0"), 5);
+  trie.Insert (Ipv4Address ("10.1.2.0"), Ipv4Mask ("255.255.255.0"), 6);
+  NS_TEST_ASSERT_MSG_EQ (trie.GetSize (), 6, "Wrong number of values");
+
+  trie.Match (Ipv4Address ("10.1.2.3"), out);
+  NS_TEST_ASSERT_MSG_EQ (out.size (), 5, "Wrong number of matches for 10.1.2.3");
+  int expected[] = {1, 2, 3, 4, 6};
+  for (uint32_t i = 0; i < out.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (out[i], expected[i], "Matches not in insertion order");
+    }
+
+  trie.Match (Ipv4Address ("10.1.3.7"), out);
+  NS_TEST_ASSERT_MSG_EQ (out.size (), 3, "Wrong number of matches for 10.1.3.7");
+  NS_TEST_EXPECT_MSG_EQ (out[2], 5, "10.1.3.0/24 not found");
+
+  trie.Match (Ipv4Address ("192.168.0.1"), out);
+  NS_TEST_ASSERT_MSG_EQ (out.size (), 1, "Only the default route should match");
+
+  NS_TEST_EXPECT_MSG_EQ (trie.Remove (Ipv4Address ("10.1.2.0"), Ipv4Mask ("255.255.0.0"), 1), false,
+                         "Removed a value from the wrong prefix");
+  NS_TEST_EXPECT_MSG_EQ (trie.Remove (Ipv4Address ("10.1.2.0"), Ipv4Mask ("255.255.255.0"), 1), true,
+                         "Value not removed");
+  NS_TEST_EXPECT_MSG_EQ (trie.Remove (Ipv4Address ("10.1.2.0"), Ipv4Mask ("255.255.255.0"), 6), true,
+                         "Value not removed");
+  NS_TEST_EXPECT_MSG_EQ (trie.Remove (Ipv4Address ("10.0.0.0"), Ipv4Mask ("255.0.0.0"), 3), true,
+                         "Value not removed");
+  trie.Match (Ipv4Address ("10.1.2.3"), out);
+  NS_TEST_ASSERT_MSG_EQ (out.size (), 2, "Wrong number of matches after removal");
+  NS_TEST_EXPECT_MSG_EQ (out[0], 2, "Default route not found");
+  NS_TEST_EXPECT_MSG_EQ (out[1], 4, "Host route not found");
+  trie.Match (Ipv4Address ("10.1.3.7"), out);
+  NS_TEST_ASSERT_MSG_EQ (out.size (), 2, "Wrong number of matches after removal");
+  NS_TEST_EXPECT_MSG_EQ (out[1], 5, "10.1.3.0/24 lost after removal of its neighbours");
+
+  trie.Clear ();
+  trie.Match (Ipv4Address ("10.1.2.3"), out);
+  NS_TEST_EXPECT_MSG_EQ (out.size (), 0, "Values left after Clear");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief RoutePrefixTrie against a linear scan of random prefixes.
+ *
+ * Random IPv6 prefixes sharing a few leading bits are inserted and
+ * partly removed; for random addresses Match must return exactly the
+ * prefixes that Ipv6Prefix::IsMatch accepts, in insertion order.
+ */
+class Ipv6RoutePrefixTrieTestCase : public TestCase
+{
+public:
+  Ipv6RoutePrefixTrieTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Create a random address close to the stored prefixes.
+   * \param rng random variable
+   * \return the address
+   */
+  Ipv6Address GetRandomAddress (Ptr<UniformRandomVariable> rng);
+};
+
+Ipv6RoutePrefixTrieTestCase::Ipv6RoutePrefixTrieTestCase ()
+  : TestCase ("Ipv6RoutePrefixTrie against a linear scan")
+{
+}
+
+Ipv6Address
+Ipv6RoutePrefixTrieTestCase::GetRandomAddress (Ptr<UniformRandomVariable> rng)
+{
+  uint8_t bytes[16];
+  for (uint32_t i = 0; i < 16; i++)
+    {
+      // few distinct values in the first bytes, so that prefixes nest
+      bytes[i] = static_cast<uint8_t> (rng->GetInteger (0, i < 4 ? 3 : 255));
+    }
+  return Ipv6Address (bytes);
+}
+
+void
+Ipv6RoutePrefixTrieTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (1);
+
+  typedef std::pair<Ipv6Address, Ipv6Prefix> Route;
+  std::vector<Route> routes;
+  Ipv6RoutePrefixTrie<uint32_t> trie;
+  for (uint32_t i = 0; i < 500; i++)
+    {
+      Ipv6Prefix prefix (static_cast<uint8_t> (rng->GetInteger (0, 128)));
+      Ipv6Address network = GetRandomAddress (rng).CombinePrefix (prefix);
+      routes.push_back (Route (network, prefix));
+      trie.Insert (network, prefix, i);
+    }
+  std::vector<bool> removed (routes.size (), false);
+  for (uint32_t i = 0; i < routes.size (); i += 3)
+    {
+      NS_TEST_ASSERT_MSG_EQ (trie.Remove (routes[i].first, routes[i].second, i), true, "Value not removed");
+      removed[i] = true;
+    }
+  NS_TEST_ASSERT_MSG_EQ (trie.GetSize (), 333, "Wrong number of values");
+
+  std::vector<uint32_t> out;
+  for (uint32_t n = 0; n < 1000; n++)
+    {
+      Ipv6Address address = GetRandomAddress (rng);
+      if (n % 2)
+        { // make sure that some long prefixes match
+          address = routes[rng->GetInteger (0, routes.size () - 1)].first;
+        }
+      std::vector<uint32_t> expected;
+      for (uint32_t i = 0; i < routes.size (); i++)
+        {
+          if (!removed[i] && routes[i].second.IsMatch (address, routes[i].first))
+            {
+              expected.push_back (i);
+            }
+        }
+      trie.Match (address, out);
+      NS_TEST_ASSERT_MSG_EQ (out.size (), expected.size (), "Wrong number of matches for " << address);
+      for (uint32_t i = 0; i < out.size (); i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (out[i], expected[i], "Wrong match for " << address);
+        }
+    }
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief RoutePrefixTrie TestSuite
+ */
+class RoutePrefixTrieTestSuite : public TestSuite
+{
+public:
+  RoutePrefixTrieTestSuite ()
+    : TestSuite ("route-prefix-trie", UNIT)
+  {
+    AddTestCase (new Ipv4RoutePrefixTrieTestCase (), TestCase::QUICK);
+    AddTestCase (new Ipv6RoutePrefixTrieTestCase (), TestCase::QUICK);
+  }
+};
+
+static RoutePrefixTrieTestSuite g_routePrefixTrieTestSuite; //!< Static variable for test initialization
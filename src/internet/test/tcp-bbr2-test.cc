@@ -0,0 +1,211 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/tcp-congestion-ops.h"
+#include "ns3/tcp-socket-base.h"
+#include "ns3/tcp-bbr2.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TcpBbr2TestSuite");
+
+/**
+ * \brief Tests whether BBRv2 sets the pacing and cwnd gain of each PROBE_BW phase.
+ */
+class TcpBbr2CheckGainValuesTest : public TestCase
+{
+public:
+  /**
+   * \brief constructor
+   * \param phase PROBE_BW phase under test
+   * \param name description of the test
+   */
+  TcpBbr2CheckGainValuesTest (TcpBbr2::Bbr2ProbeBwPhase_t phase, const std::string &name);
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Execute the test.
+   */
+  void ExecuteTest (void);
+  TcpBbr2::Bbr2ProbeBwPhase_t m_phase; //!< PROBE_BW phase under test
+};
+
+TcpBbr2CheckGainValuesTest::TcpBbr2CheckGainValuesTest (TcpBbr2::Bbr2ProbeBwPhase_t phase,
+                                                        const std::string &name)
+  : TestCase (name),
+    m_phase (phase)
+{}
+
+void
+TcpBbr2CheckGainValuesTest::DoRun ()
+{
+  Simulator::Schedule (Seconds (0.0), &TcpBbr2CheckGainValuesTest::ExecuteTest, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+TcpBbr2CheckGainValuesTest::ExecuteTest ()
+{
+  Ptr<TcpSocketState> state = CreateObject <TcpSocketState> ();
+  state->m_segmentSize = 1000;
+  state->m_cWnd = 10000;
+  state->m_initialCWnd = 10;
+
+  Ptr<TcpBbr2> cong = CreateObject <TcpBbr2> ();
+  cong->CongestionStateSet (state, TcpSocketState::CA_OPEN);
+  cong->SetBbrState (TcpBbr::BBR_PROBE_BW);
+
+  double desiredPacingGain = 1;
+  switch (m_phase)
+    {
+      case TcpBbr2::BBR2_BW_PROBE_UP:
+        cong->StartBwProbeUp (state);
+        desiredPacingGain = 1.25;
+        break;
+      case TcpBbr2::BBR2_BW_PROBE_DOWN:
+        cong->StartBwProbeDown ();
+        desiredPacingGain = 0.75;
+        break;
+      case TcpBbr2::BBR2_BW_PROBE_CRUISE:
+        cong->StartBwProbeCruise ();
+        desiredPacingGain = 1;
+        break;
+      case TcpBbr2::BBR2_BW_PROBE_REFILL:
+        cong->StartBwProbeRefill ();
+        desiredPacingGain = 1;
+        break;
+      default:
+        NS_ASSERT (false);
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (cong->GetProbeBwPhase (), m_phase, "BBRv2 has not entered into desired phase");
+  NS_TEST_ASSERT_MSG_EQ (cong->GetPacingGain (), desiredPacingGain, "BBRv2 has not updated into desired pacing gain");
+  NS_TEST_ASSERT_MSG_EQ (cong->GetCwndGain (), 2, "BBRv2 has not updated into desired cwnd gain");
+}
+
+/**
+ * \brief Tests the reaction of the BBRv2 inflight bounds to losses.
+ *
+ * When not probing, a lossy round cuts inflight_lo by Beta. When a
+ * bandwidth probe causes a loss rate above LossThreshold, inflight_hi
+ * is set and the probe stops.
+ */
+class TcpBbr2LossResponseTest : public TestCase
+{
+public:
+  /**
+   * \brief constructor
+   * \param probing whether the loss happens while probing up
+   * \param name description of the test
+   */
+  TcpBbr2LossResponseTest (bool probing, const std::string &name);
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Execute the test.
+   */
+  void ExecuteTest (void);
+  bool m_probing; //!< Whether the loss happens while probing up
+};
+
+TcpBbr2LossResponseTest::TcpBbr2LossResponseTest (bool probing, const std::string &name)
+  : TestCase (name),
+    m_probing (probing)
+{}
+
+void
+TcpBbr2LossResponseTest::DoRun ()
+{
+  Simulator::Schedule (Seconds (0.0), &TcpBbr2LossResponseTest::ExecuteTest, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+TcpBbr2LossResponseTest::ExecuteTest ()
+{
+  Ptr<TcpSocketState> state = CreateObject <TcpSocketState> ();
+  state->m_segmentSize = 1000;
+  state->m_cWnd = 20000;
+  state->m_initialCWnd = 10;
+
+  Ptr<TcpBbr2> cong = CreateObject <TcpBbr2> ();
+  cong->CongestionStateSet (state, TcpSocketState::CA_OPEN);
+  cong->m_isPipeFilled = true;
+  cong->SetBbrState (TcpBbr::BBR_PROBE_BW);
+
+  TcpRateOps::TcpRateSample rs;
+  rs.m_bytesLoss = 2000;
+  rs.m_priorInFlight = 20000;
+  rs.m_ackedSacked = 1000;
+
+  if (m_probing)
+    {
+      cong->StartBwProbeUp (state);
+      cong->m_bwProbeSamples = true;
+      NS_TEST_ASSERT_MSG_EQ (cong->IsInflightTooHigh (rs, 0), true, "10% loss must be too high");
+      cong->AdaptUpperBounds (state, rs, 0);
+      NS_TEST_ASSERT_MSG_EQ (cong->m_inflightHi, 20000, "inflight_hi must be set to the lossy inflight");
+      NS_TEST_ASSERT_MSG_EQ (cong->GetProbeBwPhase (), TcpBbr2::BBR2_BW_PROBE_DOWN, "BBRv2 must stop probing");
+    }
+  else
+    {
+      cong->StartBwProbeCruise ();
+      cong->m_lossInRound = true;
+      cong->AdaptLowerBounds (state);
+      NS_TEST_ASSERT_MSG_EQ (cong->m_inflightLo, 14000, "inflight_lo must be cut by Beta");
+      state->m_cWnd = 20000;
+      cong->SetCwndBounded (state, TcpRateOps::TcpRateSample ());
+      NS_TEST_ASSERT_MSG_EQ (state->m_cWnd.Get (), 14000, "cwnd must be bounded by inflight_lo");
+    }
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief TCP BBRv2 TestSuite
+ */
+class TcpBbr2TestSuite : public TestSuite
+{
+public:
+  /**
+   * \brief constructor
+   */
+  TcpBbr2TestSuite () : TestSuite ("tcp-bbr2-test", UNIT)
+  {
+    AddTestCase (new TcpBbr2CheckGainValuesTest (TcpBbr2::BBR2_BW_PROBE_UP, "BBRv2 should enter PROBE_UP and set cwnd and pacing gain accordingly"), TestCase::QUICK);
+
+    AddTestCase (new TcpBbr2CheckGainValuesTest (TcpBbr2::BBR2_BW_PROBE_DOWN, "BBRv2 should enter PROBE_DOWN and set cwnd and pacing gain accordingly"), TestCase::QUICK);
+
+    AddTestCase (new TcpBbr2CheckGainValuesTest (TcpBbr2::BBR2_BW_PROBE_CRUISE, "BBRv2 should enter PROBE_CRUISE and set cwnd and pacing gain accordingly"), TestCase::QUICK);
+
+    AddTestCase (new TcpBbr2CheckGainValuesTest (TcpBbr2::BBR2_BW_PROBE_REFILL, "BBRv2 should enter PROBE_REFILL and set cwnd and pacing gain accordingly"), TestCase::QUICK);
+
+    AddTestCase (new TcpBbr2LossResponseTest (false, "BBRv2 should cut inflight_lo on a lossy round while cruising"), TestCase::QUICK);
+
+    AddTestCase (new TcpBbr2LossResponseTest (true, "BBRv2 should set inflight_hi and stop probing on excessive loss"), TestCase::QUICK);
+  }
+};
+
+static TcpBbr2TestSuite g_tcpBbr2Test; //!< static variable for test initialization
+}
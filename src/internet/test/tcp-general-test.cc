@@ -1018,6 +1018,23 @@ TcpGeneralTest::SetPaceInitialWindow (SocketWho who, bool paceWindow)
     }
 }
 
+void
+TcpGeneralTest::SetEdtPacing (SocketWho who, bool edtPacing)
+{
+  if (who == SENDER)
+    {
+      m_senderSocket->SetEdtPacing (edtPacing);
+    }
+  else if (who == RECEIVER)
+    {
+      m_receiverSocket->SetEdtPacing (edtPacing);
+    }
+  else
+    {
+      NS_FATAL_ERROR ("Not defined");
+    }
+}
+
 void
 TcpGeneralTest::SetInitialSsThresh (SocketWho who, uint32_t initialSsThresh)
 {
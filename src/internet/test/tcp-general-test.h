@@ -623,6 +623,14 @@ protected:
    */
   void SetPaceInitialWindow (SocketWho who, bool paceWindow);
 
+  /**
+   * \brief Enable or disable Earliest Departure Time pacing
+   *
+   * \param who socket
+   * \param edtPacing Boolean to enable or disable EDT pacing
+   */
+  void SetEdtPacing (SocketWho who, bool edtPacing);
+
   /**
    * \brief Forcefully set the initial ssthresh
    *
@@ -0,0 +1,290 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/global-value.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
+#include "ns3/node-container.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/tcp-socket-base.h"
+#include "ns3/tcp-socket-factory.h"
+#include "ns3/inet-socket-address.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check that the GRO stage of the IP layer coalesces the segments
+ * of a TCP transfer and, with ACK thinning, that the receiver sends fewer
+ * ACKs, without corrupting the data.
+ */
+class TcpGroTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   * \param ackThinning The ACK thinning policy of the receiver.
+   * \param name The name of the ACK thinning policy.
+   */
+  TcpGroTestCase (TcpSocketBase::AckThinning_t ackThinning, std::string name);
+
+private:
+  virtual void DoRun (void);
+
+  /** The counters of a transfer. */
+  struct Result
+  {
+    uint32_t received;   //!< The bytes read by the sink.
+    uint32_t ipRx;       //!< The packets received by the IP layer of the sink.
+    uint32_t delivered;  //!< The packets delivered to TCP by the IP layer of the sink.
+    uint32_t acks;       //!< The packets sent by the IP layer of the sink.
+    Time duration;       //!< The time of the last data read by the sink.
+  };
+
+  /**
+   * Run a transfer.
+   * \param groFlushTimeout The GRO flush timeout of the sink.
+   * \param ackThinning The ACK thinning policy of the sink.
+   * \returns The counters of the transfer.
+   */
+  Result RunTransfer (Time groFlushTimeout, TcpSocketBase::AckThinning_t ackThinning);
+  /**
+   * Fill the socket buffer of the source.
+   * \param socket The socket.
+   * \param available The room in the buffer.
+   */
+  void Send (Ptr<Socket> socket, uint32_t available);
+  /**
+   * Read the data received by the sink.
+   * \param socket The socket.
+   */
+  void Receive (Ptr<Socket> socket);
+  /**
+   * Accept a connection at the sink.
+   * \param socket The socket.
+   * \param from The source address.
+   */
+  void Accept (Ptr<Socket> socket, const Address &from);
+  /**
+   * Connect the source to the sink.
+   * \param socket The socket.
+   * \param address The address of the sink.
+   */
+  static void Connect (Ptr<Socket> socket, InetSocketAddress address);
+  /**
+   * Count a packet received by the IP layer of the sink.
+   * \param packet The packet.
+   * \param ipv4 The IP layer.
+   * \param interface The interface.
+   */
+  void Rx (Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface);
+  /**
+   * Count a packet sent by the IP layer of the sink.
+   * \param packet The packet.
+   * \param ipv4 The IP layer.
+   * \param interface The interface.
+   */
+  void Tx (Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface);
+  /**
+   * Count a packet delivered to TCP by the IP layer of the sink.
+   * \param header The IP header.
+   * \param packet The packet.
+   * \param interface The interface.
+   */
+  void LocalDeliver (const Ipv4Header &header, Ptr<const Packet> packet, uint32_t interface);
+
+  TcpSocketBase::AckThinning_t m_ackThinning; //!< The ACK thinning policy.
+  uint32_t m_toSend;                  //!< The bytes left to write to the source socket.
+  Result m_result;                    //!< The counters of the current transfer.
+
+  static const uint32_t TOTAL_BYTES = 2000000;  //!< The size of the transfer.
+};
+
+TcpGroTestCase::TcpGroTestCase (TcpSocketBase::AckThinning_t ackThinning, std::string name)
+  : TestCase ("Check TCP GRO with ACK thinning policy " + name),
+    m_ackThinning (ackThinning)
+{
+}
+
+void
+TcpGroTestCase::Send (Ptr<Socket> socket, uint32_t available)
+{
+  while (m_toSend > 0 && socket->GetTxAvailable () > 0)
+    {
+      uint32_t size = std::min (m_toSend, socket->GetTxAvailable ());
+      int sent = socket->Send (Create<Packet> (size));
+      if (sent <= 0)
+        {
+          return;
+        }
+      m_toSend -= sent;
+    }
+  if (m_toSend == 0)
+    {
+      socket->Close ();
+      socket->SetSendCallback (MakeNullCallback<void, Ptr<Socket>, uint32_t> ());
+    }
+}
+
+void
+TcpGroTestCase::Receive (Ptr<Socket> socket)
+{
+  Ptr<Packet> packet;
+  while ((packet = socket->Recv ()))
+    {
+      m_result.received += packet->GetSize ();
+      m_result.duration = Simulator::Now ();
+    }
+}
+
+void
+TcpGroTestCase::Accept (Ptr<Socket> socket, const Address &from)
+{
+  socket->SetRecvCallback (MakeCallback (&TcpGroTestCase::Receive, this));
+}
+
+void
+TcpGroTestCase::Connect (Ptr<Socket> socket, InetSocketAddress address)
+{
+  socket->Connect (address);
+}
+
+void
+TcpGroTestCase::Rx (Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+  m_result.ipRx++;
+}
+
+void
+TcpGroTestCase::Tx (Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+  m_result.acks++;
+}
+
+void
+TcpGroTestCase::LocalDeliver (const Ipv4Header &header, Ptr<const Packet> packet, uint32_t interface)
+{
+  m_result.delivered++;
+}
+
+TcpGroTestCase::Result
+TcpGroTestCase::RunTransfer (Time groFlushTimeout, TcpSocketBase::AckThinning_t ackThinning)
+{
+  // GRO recomputes the checksum of the coalesced segments
+  Config::SetGlobal ("ChecksumEnabled", BooleanValue (true));
+  Config::SetDefault ("ns3::TcpSocket::SegmentSize", UintegerValue (1448));
+  Config::SetDefault ("ns3::TcpSocket::SndBufSize", UintegerValue (1 << 20));
+  Config::SetDefault ("ns3::TcpSocket::RcvBufSize", UintegerValue (1 << 20));
+
+  NodeContainer nodes;
+  nodes.Create (2);
+  SimpleNetDeviceHelper simple;
+  simple.SetDeviceAttribute ("DataRate", StringValue ("100Mbps"));
+  simple.SetChannelAttribute ("Delay", StringValue ("5ms"));
+  simple.SetQueue ("ns3::DropTailQueue", "MaxSize", StringValue ("10000p"));
+  simple.SetNetDevicePointToPointMode (true);
+  NetDeviceContainer devices = simple.Install (nodes);
+  for (uint32_t i = 0; i < devices.GetN (); i++)
+    {
+      devices.Get (i)->SetMtu (1500);
+    }
+
+  InternetStackHelper internet;
+  internet.Install (nodes);
+  Ipv4AddressHelper address ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  Ptr<Ipv4L3Protocol> sinkIp = nodes.Get (1)->GetObject<Ipv4L3Protocol> ();
+  sinkIp->SetAttribute ("GroFlushTimeout", TimeValue (groFlushTimeout));
+  sinkIp->TraceConnectWithoutContext ("Rx", MakeCallback (&TcpGroTestCase::Rx, this));
+  sinkIp->TraceConnectWithoutContext ("Tx", MakeCallback (&TcpGroTestCase::Tx, this));
+  sinkIp->TraceConnectWithoutContext ("LocalDeliver", MakeCallback (&TcpGroTestCase::LocalDeliver, this));
+
+  m_toSend = TOTAL_BYTES;
+  m_result = Result ();
+
+  Ptr<Socket> sink = Socket::CreateSocket (nodes.Get (1), TcpSocketFactory::GetTypeId ());
+  sink->SetAttribute ("AckThinning", EnumValue (ackThinning));
+  sink->Bind (InetSocketAddress (Ipv4Address::GetAny (), 5000));
+  sink->Listen ();
+  sink->SetAcceptCallback (MakeNullCallback<bool, Ptr<Socket>, const Address &> (),
+                           MakeCallback (&TcpGroTestCase::Accept, this));
+
+  Ptr<Socket> source = Socket::CreateSocket (nodes.Get (0), TcpSocketFactory::GetTypeId ());
+  source->Bind ();
+  source->SetSendCallback (MakeCallback (&TcpGroTestCase::Send, this));
+  Simulator::Schedule (Seconds (0.1), &TcpGroTestCase::Connect, source,
+                       InetSocketAddress (interfaces.GetAddress (1), 5000));
+
+  Simulator::Stop (Seconds (20));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  Config::Reset ();
+  Config::SetGlobal ("ChecksumEnabled", BooleanValue (false));
+
+  NS_TEST_EXPECT_MSG_EQ (m_result.received, TOTAL_BYTES, "Not all the data was received");
+  return m_result;
+}
+
+void
+TcpGroTestCase::DoRun (void)
+{
+  Result reference = RunTransfer (Seconds (0), TcpSocketBase::ACK_THINNING_NONE);
+  NS_TEST_ASSERT_MSG_EQ (reference.delivered, reference.ipRx, "Packets coalesced without GRO");
+
+  Result result = RunTransfer (MicroSeconds (500), m_ackThinning);
+  NS_TEST_EXPECT_MSG_LT (result.delivered * 2, result.ipRx, "GRO did not coalesce the segments");
+  NS_TEST_EXPECT_MSG_LT (result.acks, reference.acks, "GRO did not reduce the number of ACKs");
+  NS_TEST_EXPECT_MSG_LT (result.duration, reference.duration * 2, "The transfer was slowed down");
+  if (m_ackThinning != TcpSocketBase::ACK_THINNING_NONE)
+    {
+      Result groOnly = RunTransfer (MicroSeconds (500), TcpSocketBase::ACK_THINNING_NONE);
+      NS_TEST_EXPECT_MSG_LT (result.acks, groOnly.acks, "ACK thinning did not reduce the number of ACKs");
+    }
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief TCP generic receive offload and ACK thinning test suite.
+ */
+class TcpGroTestSuite : public TestSuite
+{
+public:
+  TcpGroTestSuite ()
+    : TestSuite ("tcp-gro", UNIT)
+  {
+    AddTestCase (new TcpGroTestCase (TcpSocketBase::ACK_THINNING_NONE, "None"), TestCase::QUICK);
+    AddTestCase (new TcpGroTestCase (TcpSocketBase::ACK_THINNING_COUNT, "Count"), TestCase::QUICK);
+    AddTestCase (new TcpGroTestCase (TcpSocketBase::ACK_THINNING_RTT, "Rtt"), TestCase::QUICK);
+  }
+};
+
+static TcpGroTestSuite g_tcpGroTestSuite; //!< Static variable for test initialization
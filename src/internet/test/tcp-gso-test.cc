@@ -0,0 +1,312 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/node-container.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/traffic-control-helper.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/tcp-header.h"
+#include "ns3/tcp-socket-factory.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/socket.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check that TCP generic segmentation offload (GSO) puts on the
+ * wire the same segments, at the same times, as sending one segment at
+ * a time, with fewer packets through the IP layer.
+ */
+class TcpGsoTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   * \param qdisc Whether a queue disc is installed on the devices.
+   * \param congestionControl The congestion control.
+   */
+  TcpGsoTestCase (bool qdisc, std::string congestionControl);
+
+private:
+  virtual void DoRun (void);
+
+  /** A segment received on the wire. */
+  struct Segment
+  {
+    int64_t time;          //!< The reception time.
+    uint32_t size;         //!< The IP packet size.
+    uint32_t seq;          //!< The TCP sequence number.
+    uint8_t flags;         //!< The TCP flags.
+  };
+
+  /**
+   * Run a transfer.
+   * \param gsoMaxSize The maximum size of the super-segments, 0 to disable GSO.
+   * \param [out] segments The data segments received by the sink.
+   * \returns The number of packets sent by the IP layer of the source.
+   */
+  uint32_t RunTransfer (uint32_t gsoMaxSize, std::vector<Segment> &segments);
+  /**
+   * Fill the socket buffer of the source.
+   * \param socket The socket.
+   * \param available The room in the buffer.
+   */
+  void Send (Ptr<Socket> socket, uint32_t available);
+  /**
+   * Connect the source to the sink.
+   * \param socket The socket.
+   * \param address The address of the sink.
+   */
+  static void Connect (Ptr<Socket> socket, InetSocketAddress address);
+  /**
+   * Read the data received by the sink.
+   * \param socket The socket.
+   */
+  void Receive (Ptr<Socket> socket);
+  /**
+   * Accept a connection at the sink.
+   * \param socket The socket.
+   * \param from The source address.
+   */
+  void Accept (Ptr<Socket> socket, const Address &from);
+  /**
+   * Record a packet received by the IP layer of the sink.
+   * \param packet The packet.
+   * \param ipv4 The IP layer.
+   * \param interface The interface.
+   */
+  void Rx (Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface);
+  /**
+   * Count a packet sent by the IP layer of the source.
+   * \param packet The packet.
+   * \param ipv4 The IP layer.
+   * \param interface The interface.
+   */
+  void Tx (Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface);
+
+  bool m_qdisc;                       //!< Whether a queue disc is installed.
+  std::string m_congestionControl;    //!< The congestion control.
+  uint32_t m_toSend;                  //!< The bytes left to write to the source socket.
+  uint32_t m_received;                //!< The bytes read by the sink.
+  uint32_t m_ipTx;                    //!< The packets sent by the IP layer of the source.
+  uint32_t m_maxSize;                 //!< The largest packet on the wire.
+  std::vector<Segment> *m_segments;   //!< The data segments received by the sink.
+
+  static const uint32_t TOTAL_BYTES = 400000;  //!< The size of the transfer.
+};
+
+TcpGsoTestCase::TcpGsoTestCase (bool qdisc, std::string congestionControl)
+  : TestCase ("Check TCP GSO with " + congestionControl + (qdisc ? " and a queue disc" : " and no queue disc")),
+    m_qdisc (qdisc),
+    m_congestionControl (congestionControl)
+{
+}
+
+void
+TcpGsoTestCase::Send (Ptr<Socket> socket, uint32_t available)
+{
+  while (m_toSend > 0 && socket->GetTxAvailable () > 0)
+    {
+      uint32_t size = std::min (m_toSend, socket->GetTxAvailable ());
+      int sent = socket->Send (Create<Packet> (size));
+      if (sent <= 0)
+        {
+          return;
+        }
+      m_toSend -= sent;
+    }
+  if (m_toSend == 0)
+    {
+      socket->Close ();
+      m_toSend = 0xffffffff; // do not close twice
+      socket->SetSendCallback (MakeNullCallback<void, Ptr<Socket>, uint32_t> ());
+    }
+}
+
+void
+TcpGsoTestCase::Connect (Ptr<Socket> socket, InetSocketAddress address)
+{
+  socket->Connect (address);
+}
+
+void
+TcpGsoTestCase::Receive (Ptr<Socket> socket)
+{
+  Ptr<Packet> packet;
+  while ((packet = socket->Recv ()))
+    {
+      m_received += packet->GetSize ();
+    }
+}
+
+void
+TcpGsoTestCase::Accept (Ptr<Socket> socket, const Address &from)
+{
+  socket->SetRecvCallback (MakeCallback (&TcpGsoTestCase::Receive, this));
+}
+
+void
+TcpGsoTestCase::Rx (Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+  m_maxSize = std::max (m_maxSize, packet->GetSize ());
+  Ptr<Packet> copy = packet->Copy ();
+  Ipv4Header ipHeader;
+  copy->RemoveHeader (ipHeader);
+  TcpHeader tcpHeader;
+  copy->RemoveHeader (tcpHeader);
+  if (copy->GetSize () > 0 || (tcpHeader.GetFlags () & TcpHeader::FIN))
+    {
+      Segment segment;
+      segment.time = Simulator::Now ().GetTimeStep ();
+      segment.size = packet->GetSize ();
+      segment.seq = tcpHeader.GetSequenceNumber ().GetValue ();
+      segment.flags = tcpHeader.GetFlags ();
+      m_segments->push_back (segment);
+    }
+}
+
+void
+TcpGsoTestCase::Tx (Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+  m_ipTx++;
+}
+
+uint32_t
+TcpGsoTestCase::RunTransfer (uint32_t gsoMaxSize, std::vector<Segment> &segments)
+{
+  Config::SetDefault ("ns3::TcpSocketState::GsoMaxSize", UintegerValue (gsoMaxSize));
+  Config::SetDefault ("ns3::TcpL4Protocol::SocketType", StringValue (m_congestionControl));
+  Config::SetDefault ("ns3::TcpSocket::SegmentSize", UintegerValue (1448));
+  Config::SetDefault ("ns3::TcpSocket::SndBufSize", UintegerValue (1 << 20));
+  Config::SetDefault ("ns3::TcpSocket::RcvBufSize", UintegerValue (1 << 20));
+
+  NodeContainer nodes;
+  nodes.Create (2);
+  SimpleNetDeviceHelper simple;
+  simple.SetDeviceAttribute ("DataRate", StringValue ("20Mbps"));
+  simple.SetChannelAttribute ("Delay", StringValue ("5ms"));
+  simple.SetQueue ("ns3::DropTailQueue", "MaxSize", StringValue ("10000p"));
+  simple.SetNetDevicePointToPointMode (true);
+  NetDeviceContainer devices = simple.Install (nodes);
+  for (uint32_t i = 0; i < devices.GetN (); i++)
+    {
+      devices.Get (i)->SetMtu (1500);
+    }
+
+  InternetStackHelper internet;
+  internet.Install (nodes);
+  Ipv4AddressHelper address ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+  TrafficControlHelper tch;
+  tch.Uninstall (devices);
+  if (m_qdisc)
+    {
+      tch.SetRootQueueDisc ("ns3::FifoQueueDisc", "MaxSize", StringValue ("10000p"));
+      tch.Install (devices);
+    }
+
+  m_toSend = TOTAL_BYTES;
+  m_received = 0;
+  m_ipTx = 0;
+  m_maxSize = 0;
+  m_segments = &segments;
+  nodes.Get (0)->GetObject<Ipv4L3Protocol> ()->TraceConnectWithoutContext ("Tx", MakeCallback (&TcpGsoTestCase::Tx, this));
+  nodes.Get (1)->GetObject<Ipv4L3Protocol> ()->TraceConnectWithoutContext ("Rx", MakeCallback (&TcpGsoTestCase::Rx, this));
+
+  Ptr<Socket> sink = Socket::CreateSocket (nodes.Get (1), TcpSocketFactory::GetTypeId ());
+  sink->Bind (InetSocketAddress (Ipv4Address::GetAny (), 5000));
+  sink->Listen ();
+  sink->SetAcceptCallback (MakeNullCallback<bool, Ptr<Socket>, const Address &> (),
+                           MakeCallback (&TcpGsoTestCase::Accept, this));
+
+  Ptr<Socket> source = Socket::CreateSocket (nodes.Get (0), TcpSocketFactory::GetTypeId ());
+  source->Bind ();
+  source->SetSendCallback (MakeCallback (&TcpGsoTestCase::Send, this));
+  // Connect once the nodes are initialized and the traffic control layer
+  // knows about the queue discs
+  Simulator::Schedule (Seconds (0.1), &TcpGsoTestCase::Connect, source,
+                       InetSocketAddress (interfaces.GetAddress (1), 5000));
+
+  Simulator::Stop (Seconds (10));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_received, TOTAL_BYTES, "Not all the data was received");
+  NS_TEST_EXPECT_MSG_LT_OR_EQ (m_maxSize, 1500, "A packet larger than the MTU was put on the wire");
+
+  Config::Reset ();
+  return m_ipTx;
+}
+
+void
+TcpGsoTestCase::DoRun (void)
+{
+  std::vector<Segment> reference;
+  uint32_t referenceTx = RunTransfer (0, reference);
+  std::vector<Segment> segments;
+  uint32_t gsoTx = RunTransfer (65000, segments);
+
+  NS_TEST_ASSERT_MSG_GT (referenceTx, 2 * gsoTx, "The IP layer handled too many packets with GSO");
+  if (m_congestionControl != "ns3::TcpNewReno")
+    {
+      // The send quantum changes the behavior of the congestion control
+      return;
+    }
+  NS_TEST_ASSERT_MSG_EQ (segments.size (), reference.size (), "GSO changed the number of segments");
+  for (uint32_t i = 0; i < reference.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (segments[i].time, reference[i].time, "Wrong time of segment " << i);
+      NS_TEST_ASSERT_MSG_EQ (segments[i].size, reference[i].size, "Wrong size of segment " << i);
+      NS_TEST_ASSERT_MSG_EQ (segments[i].seq, reference[i].seq, "Wrong sequence number of segment " << i);
+      NS_TEST_ASSERT_MSG_EQ ((uint32_t) segments[i].flags, (uint32_t) reference[i].flags, "Wrong flags of segment " << i);
+    }
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief TCP generic segmentation offload test suite.
+ */
+class TcpGsoTestSuite : public TestSuite
+{
+public:
+  TcpGsoTestSuite ()
+    : TestSuite ("tcp-gso", UNIT)
+  {
+    AddTestCase (new TcpGsoTestCase (false, "ns3::TcpNewReno"), TestCase::QUICK);
+    AddTestCase (new TcpGsoTestCase (true, "ns3::TcpNewReno"), TestCase::QUICK);
+    AddTestCase (new TcpGsoTestCase (true, "ns3::TcpBbr"), TestCase::QUICK);
+  }
+};
+
+static TcpGsoTestSuite g_tcpGsoTestSuite; //!< Static variable for test initialization
@@ -19,11 +19,14 @@
 
 #define __STDC_LIMIT_MACROS
 #include <stdint.h>
+#include <cstring>
 #include "ns3/test.h"
 #include "ns3/core-module.h"
 #include "ns3/tcp-header.h"
 #include "ns3/buffer.h"
 #include "ns3/tcp-option-rfc793.h"
+#include "ns3/tcp-option-ts.h"
+#include "ns3/tcp-option-sack.h"
 
 using namespace ns3;
 
@@ -351,6 +354,96 @@ TcpHeaderWithRFC793OptionTestCase::DoTeardown ()
 
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief TCP header options stored inline test.
+ */
+class TcpHeaderInlineOptionTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   * \param name Test description.
+   */
+  TcpHeaderInlineOptionTestCase (std::string name);
+
+private:
+  virtual void DoRun (void);
+};
+
+TcpHeaderInlineOptionTestCase::TcpHeaderInlineOptionTestCase (std::string name)
+  : TestCase (name)
+{
+}
+
+void
+TcpHeaderInlineOptionTestCase::DoRun (void)
+{
+  TcpOptionSack::SackBlock first (SequenceNumber32 (1000), SequenceNumber32 (2000));
+  TcpOptionSack::SackBlock second (SequenceNumber32 (3000), SequenceNumber32 (4000));
+
+  // The same options, appended as objects and through the inline accessors
+  TcpHeader objects;
+  objects.AppendOption (CreateObject<TcpOptionNOP> ());
+  objects.AppendOption (CreateObject<TcpOptionNOP> ());
+  Ptr<TcpOptionTS> ts = CreateObject<TcpOptionTS> ();
+  ts->SetTimestamp (0x01020304);
+  ts->SetEcho (0x05060708);
+  objects.AppendOption (ts);
+  Ptr<TcpOptionSack> sack = CreateObject<TcpOptionSack> ();
+  sack->AddSackBlock (first);
+  sack->AddSackBlock (second);
+  objects.AppendOption (sack);
+
+  TcpHeader header;
+  header.AppendOption (CreateObject<TcpOptionNOP> ());
+  header.AppendOption (CreateObject<TcpOptionNOP> ());
+  NS_TEST_ASSERT_MSG_EQ (header.AppendTimestamp (0x01020304, 0x05060708), true, "TS not appended");
+  NS_TEST_ASSERT_MSG_EQ (header.AppendTimestamp (1, 2), false, "Second TS appended");
+  NS_TEST_ASSERT_MSG_EQ (header.AppendSackBlock (first), true, "SACK block not appended");
+  NS_TEST_ASSERT_MSG_EQ (header.AppendSackBlock (second), true, "SACK block not appended");
+  NS_TEST_ASSERT_MSG_EQ (header.GetOptionLength (), objects.GetOptionLength (), "Different option length");
+  NS_TEST_ASSERT_MSG_EQ (header.GetSerializedSize (), 20 + 32, "Wrong header size");
+
+  Buffer buffer;
+  buffer.AddAtStart (header.GetSerializedSize ());
+  header.Serialize (buffer.Begin ());
+  Buffer reference;
+  reference.AddAtStart (objects.GetSerializedSize ());
+  objects.Serialize (reference.Begin ());
+  NS_TEST_ASSERT_MSG_EQ (buffer.GetSize (), reference.GetSize (), "Different serialized size");
+  NS_TEST_ASSERT_MSG_EQ (memcmp (buffer.PeekData (), reference.PeekData (), buffer.GetSize ()), 0,
+                         "Different serialized options");
+
+  TcpHeader dest;
+  NS_TEST_ASSERT_MSG_EQ (dest.Deserialize (buffer.Begin ()), 20 + 32, "Wrong deserialized size");
+  uint32_t timestamp = 0;
+  uint32_t echo = 0;
+  NS_TEST_ASSERT_MSG_EQ (dest.GetTimestamp (timestamp, echo), true, "TS not deserialized");
+  NS_TEST_ASSERT_MSG_EQ (timestamp, 0x01020304, "Wrong timestamp");
+  NS_TEST_ASSERT_MSG_EQ (echo, 0x05060708, "Wrong echo");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) dest.GetNSackBlocks (), 2, "Wrong number of SACK blocks");
+  NS_TEST_ASSERT_MSG_EQ (dest.GetSackBlock (1).first, second.first, "Wrong SACK block");
+  NS_TEST_ASSERT_MSG_EQ (dest.GetSackBlock (1).second, second.second, "Wrong SACK block");
+
+  // The options keep their order and values when read as objects; the
+  // padding to the word boundary is read as an END option
+  const TcpHeader::TcpOptionList &options = dest.GetOptionList ();
+  NS_TEST_ASSERT_MSG_EQ (options.size (), 5, "Wrong number of options");
+  uint8_t kinds[] = {TcpOption::NOP, TcpOption::NOP, TcpOption::TS, TcpOption::SACK, TcpOption::END};
+  uint32_t n = 0;
+  for (TcpHeader::TcpOptionList::const_iterator it = options.begin (); it != options.end (); ++it, ++n)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((uint32_t) (*it)->GetKind (), (uint32_t) kinds[n], "Wrong option " << n);
+    }
+  Ptr<const TcpOptionTS> destTs = DynamicCast<const TcpOptionTS> (dest.GetOption (TcpOption::TS));
+  NS_TEST_ASSERT_MSG_EQ (destTs->GetEcho (), 0x05060708, "Wrong echo in the TS object");
+  Ptr<const TcpOptionSack> destSack = DynamicCast<const TcpOptionSack> (dest.GetOption (TcpOption::SACK));
+  NS_TEST_ASSERT_MSG_EQ (destSack->GetNumSackBlocks (), 2, "Wrong number of blocks in the SACK object");
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -435,6 +528,7 @@ public:
   {
     AddTestCase (new TcpHeaderGetSetTestCase ("GetSet test cases"), TestCase::QUICK);
     AddTestCase (new TcpHeaderWithRFC793OptionTestCase ("Test for options in RFC 793"), TestCase::QUICK);
+    AddTestCase (new TcpHeaderInlineOptionTestCase ("Test for options stored inline"), TestCase::QUICK);
     AddTestCase (new TcpHeaderFlagsToString ("Test flags to string function"), TestCase::QUICK);
   }
 
@@ -22,6 +22,7 @@
 #include "ns3/simple-channel.h"
 #include "ns3/config.h"
 #include "ns3/test.h"
+#include "ns3/departure-time-tag.h"
 #include "tcp-general-test.h"
 
 using namespace ns3;
@@ -86,6 +87,10 @@ NS_LOG_COMPONENT_DEFINE ("TcpPacingTestSuite");
  * packet is sent. The important observation here is to realize the contrast between
  * m_expectedInterval and m_nextPacketInterval.
  *
+ * - With Earliest Departure Time (EDT) pacing, segments are handed down as
+ * soon as the window allows, stamped with their departure time. The same
+ * intervals are then checked between the stamped departure times.
+ *
  */
 class
 TcpPacingTest : public TcpGeneralTest
@@ -101,13 +106,14 @@ public:
    * \param ssThresh slow start threshold (bytes)
    * \param paceInitialWindow whether to pace the initial window
    * \param delAckMaxCount Delayed ACK max count parameter
+   * \param edtPacing whether to pace with departure time stamps
    * \param congControl Type of congestion control.
    * \param desc The test description.
    */
   TcpPacingTest (uint32_t segmentSize, uint32_t packetSize,
                  uint32_t packets, uint16_t pacingSsRatio, uint16_t pacingCaRatio,
                  uint32_t ssThresh, bool paceInitialWindow, uint32_t delAckMaxCount,
-                 const TypeId& congControl, const std::string &desc);
+                 bool edtPacing, const TypeId& congControl, const std::string &desc);
 
 protected:
   virtual void CWndTrace (uint32_t oldValue, uint32_t newValue);
@@ -143,6 +149,7 @@ private:
   uint32_t m_ssThresh;                //!< Slow start threshold
   bool     m_paceInitialWindow;       //!< True if initial window should be paced
   uint32_t m_delAckMaxCount;          //!< Delayed ack count for receiver
+  bool     m_edtPacing;               //!< True if segments are paced with departure time stamps
   bool     m_isConnAboutToEnd;        //!< True when sender receives a FIN/ACK from receiver
   Time     m_transmissionStartTime;   //!< Time at which sender starts data transmission
   Time     m_expectedInterval;        //!< Theoretical estimate of the time at which next packet is scheduled for transmission
@@ -160,6 +167,7 @@ TcpPacingTest::TcpPacingTest (uint32_t segmentSize,
                               uint32_t ssThresh,
                               bool paceInitialWindow,
                               uint32_t delAckMaxCount,
+                              bool edtPacing,
                               const TypeId &typeId,
                               const std::string &desc)
   : TcpGeneralTest (desc),
@@ -177,6 +185,7 @@ TcpPacingTest::TcpPacingTest (uint32_t segmentSize,
     m_ssThresh (ssThresh),
     m_paceInitialWindow (paceInitialWindow),
     m_delAckMaxCount (delAckMaxCount),
+    m_edtPacing (edtPacing),
     m_isConnAboutToEnd (false),
     m_transmissionStartTime (Seconds (0)),
     m_expectedInterval (Seconds (0)),
@@ -207,6 +216,7 @@ void TcpPacingTest::ConfigureProperties ()
   SetInitialCwnd (SENDER, m_initialCwnd);
   SetPacingStatus (SENDER, true);
   SetPaceInitialWindow (SENDER, m_paceInitialWindow);
+  SetEdtPacing (SENDER, m_edtPacing);
   SetDelAckMaxCount (RECEIVER, m_delAckMaxCount);
   NS_LOG_DEBUG ("segSize: " << m_segmentSize << " ssthresh: " << m_ssThresh <<
                 " paceInitialWindow: " << m_paceInitialWindow << " delAckMaxCount " << m_delAckMaxCount);
@@ -300,7 +310,13 @@ TcpPacingTest::Tx (const Ptr<const Packet> p, const TcpHeader &h, SocketWho who)
       // The first two (non-data) packets correspond to SYN and an
       // empty ACK, respectively, so start checking after three packets are sent
       bool beyondInitialDataSegment = (m_packetsSent > 3);
-      Time actualInterval = Simulator::Now () - m_prevTxTime;
+      Time txTime = Simulator::Now ();
+      DepartureTimeTag departureTag;
+      if (m_edtPacing && p->PeekPacketTag (departureTag))
+        {
+          txTime = departureTag.GetDepartureTime ();
+        }
+      Time actualInterval = txTime - m_prevTxTime;
       NS_LOG_DEBUG ("TX sent: packetsSent: " << m_packetsSent << " fullCwnd: " << m_isFullCwndSent << " nearEnd: " <<
                     m_isConnAboutToEnd << " beyondInitialDataSegment " << beyondInitialDataSegment);
       if (!m_isFullCwndSent && !m_isConnAboutToEnd && beyondInitialDataSegment)
@@ -314,7 +330,7 @@ TcpPacingTest::Tx (const Ptr<const Packet> p, const TcpHeader &h, SocketWho who)
                         " errorMargin (s): " << errorMargin.GetSeconds ());
         }
 
-      m_prevTxTime = Simulator::Now ();
+      m_prevTxTime = txTime;
       // bytesInFlight isn't updated yet. Its trace is called after Tx
       // so add an additional m_segmentSize to bytesInFlight
       uint32_t soonBytesInFlight = m_bytesInFlight + m_segmentSize;
@@ -373,14 +389,15 @@ public:
     TypeId tid = TcpNewReno::GetTypeId ();
     uint32_t ssThresh = 1e9; // default large value
     bool paceInitialWindow = false;
+    bool edtPacing = false;
     std::string description;
 
     description = std::string ("Pacing case 1: Slow start only, no initial pacing");
-    AddTestCase (new TcpPacingTest (segmentSize, packetSize, numPackets, pacingSsRatio, pacingCaRatio, ssThresh, paceInitialWindow, delAckMaxCount, tid, description), TestCase::QUICK);
+    AddTestCase (new TcpPacingTest (segmentSize, packetSize, numPackets, pacingSsRatio, pacingCaRatio, ssThresh, paceInitialWindow, delAckMaxCount, edtPacing, tid, description), TestCase::QUICK);
 
     paceInitialWindow = true;
     description = std::string ("Pacing case 2: Slow start only, initial pacing");
-    AddTestCase (new TcpPacingTest (segmentSize, packetSize, numPackets, pacingSsRatio, pacingCaRatio, ssThresh, paceInitialWindow, delAckMaxCount, tid, description), TestCase::QUICK);
+    AddTestCase (new TcpPacingTest (segmentSize, packetSize, numPackets, pacingSsRatio, pacingCaRatio, ssThresh, paceInitialWindow, delAckMaxCount, edtPacing, tid, description), TestCase::QUICK);
 
     // set ssThresh to some smaller value to check that pacing
     // slows down in second half of slow start, then transitions to CA
@@ -388,7 +405,7 @@ public:
     paceInitialWindow = false;
     ssThresh = 40;
     numPackets = 60;
-    AddTestCase (new TcpPacingTest (segmentSize, packetSize, numPackets, pacingSsRatio, pacingCaRatio, ssThresh, paceInitialWindow, delAckMaxCount, tid, description), TestCase::QUICK);
+    AddTestCase (new TcpPacingTest (segmentSize, packetSize, numPackets, pacingSsRatio, pacingCaRatio, ssThresh, paceInitialWindow, delAckMaxCount, edtPacing, tid, description), TestCase::QUICK);
 
     // Repeat tests, but with more typical delAckMaxCount == 2
     delAckMaxCount = 2;
@@ -396,17 +413,32 @@ public:
     ssThresh = 1e9;
     numPackets = 40;
     description = std::string ("Pacing case 4: Slow start only, no initial pacing, delayed ACKs");
-    AddTestCase (new TcpPacingTest (segmentSize, packetSize, numPackets, pacingSsRatio, pacingCaRatio, ssThresh, paceInitialWindow, delAckMaxCount, tid, description), TestCase::QUICK);
+    AddTestCase (new TcpPacingTest (segmentSize, packetSize, numPackets, pacingSsRatio, pacingCaRatio, ssThresh, paceInitialWindow, delAckMaxCount, edtPacing, tid, description), TestCase::QUICK);
 
     paceInitialWindow = true;
     description = std::string ("Pacing case 5: Slow start only, initial pacing, delayed ACKs");
-    AddTestCase (new TcpPacingTest (segmentSize, packetSize, numPackets, pacingSsRatio, pacingCaRatio, ssThresh, paceInitialWindow, delAckMaxCount, tid, description), TestCase::QUICK);
+    AddTestCase (new TcpPacingTest (segmentSize, packetSize, numPackets, pacingSsRatio, pacingCaRatio, ssThresh, paceInitialWindow, delAckMaxCount, edtPacing, tid, description), TestCase::QUICK);
 
     description = std::string ("Pacing case 6: Slow start, followed by transition to Congestion avoidance, no initial pacing, delayed ACKs");
     paceInitialWindow = false;
     ssThresh = 40;
     numPackets = 60;
-    AddTestCase (new TcpPacingTest (segmentSize, packetSize, numPackets, pacingSsRatio, pacingCaRatio, ssThresh, paceInitialWindow, delAckMaxCount, tid, description), TestCase::QUICK);
+    AddTestCase (new TcpPacingTest (segmentSize, packetSize, numPackets, pacingSsRatio, pacingCaRatio, ssThresh, paceInitialWindow, delAckMaxCount, edtPacing, tid, description), TestCase::QUICK);
+
+    // Repeat tests with Earliest Departure Time pacing
+    edtPacing = true;
+    delAckMaxCount = 1;
+    paceInitialWindow = true;
+    ssThresh = 1e9;
+    numPackets = 40;
+    description = std::string ("Pacing case 7: Slow start only, initial pacing, EDT");
+    AddTestCase (new TcpPacingTest (segmentSize, packetSize, numPackets, pacingSsRatio, pacingCaRatio, ssThresh, paceInitialWindow, delAckMaxCount, edtPacing, tid, description), TestCase::QUICK);
+
+    description = std::string ("Pacing case 8: Slow start, followed by transition to Congestion avoidance, no initial pacing, EDT");
+    paceInitialWindow = false;
+    ssThresh = 40;
+    numPackets = 60;
+    AddTestCase (new TcpPacingTest (segmentSize, packetSize, numPackets, pacingSsRatio, pacingCaRatio, ssThresh, paceInitialWindow, delAckMaxCount, edtPacing, tid, description), TestCase::QUICK);
   }
 };
 
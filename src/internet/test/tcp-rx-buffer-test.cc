@@ -15,6 +15,7 @@
  *
  */
 
+#include <algorithm>
 #include "ns3/test.h"
 #include "ns3/packet.h"
 #include "ns3/log.h"
@@ -44,6 +45,11 @@ private:
    * \brief Test the SACK list update.
    */
   void TestUpdateSACKList ();
+
+  /**
+   * \brief Test the reassembly of reordered and overlapping segments.
+   */
+  void TestReordering ();
 };
 
 TcpRxBufferTestCase::TcpRxBufferTestCase ()
@@ -55,6 +61,7 @@ void
 TcpRxBufferTestCase::DoRun ()
 {
   TestUpdateSACKList ();
+  TestReordering ();
 }
 
 void
@@ -338,6 +345,89 @@ TcpRxBufferTestCase::TestUpdateSACKList ()
                          "SACK list should contain no element");
 }
 
+void
+TcpRxBufferTestCase::TestReordering ()
+{
+  TcpRxBuffer rxBuf;
+  TcpHeader h;
+  uint8_t data[100];
+
+  rxBuf.SetMaxBufferSize (10000);
+  rxBuf.SetNextRxSequence (SequenceNumber32 (1));
+
+  // Segments 1..49 arrive in reverse order, each one filled with its index
+  for (uint8_t i = 49; i > 0; --i)
+    {
+      std::fill (data, data + 100, i);
+      h.SetSequenceNumber (SequenceNumber32 (1 + 100 * i));
+      rxBuf.Add (Create<Packet> (data, 100), h);
+
+      NS_TEST_ASSERT_MSG_EQ (rxBuf.NextRxSequence (), SequenceNumber32 (1),
+                             "Sequence number differs from expected");
+      NS_TEST_ASSERT_MSG_EQ (rxBuf.GetSackListSize (), 1,
+                             "Reordered segments should form a single block");
+      NS_TEST_ASSERT_MSG_EQ (rxBuf.GetSackList ().front ().first, SequenceNumber32 (1 + 100 * i),
+                             "SACK block different than expected");
+      NS_TEST_ASSERT_MSG_EQ (rxBuf.GetSackList ().front ().second, SequenceNumber32 (5001),
+                             "SACK block different than expected");
+    }
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Available (), 0, "No data should be available");
+
+  // A duplicate of a buffered segment is not stored again
+  h.SetSequenceNumber (SequenceNumber32 (201));
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Add (Create<Packet> (100), h), false,
+                         "Duplicated data should not be buffered");
+
+  // Segment 0 fills the hole
+  std::fill (data, data + 100, 0);
+  h.SetSequenceNumber (SequenceNumber32 (1));
+  rxBuf.Add (Create<Packet> (data, 100), h);
+
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.NextRxSequence (), SequenceNumber32 (5001),
+                         "Sequence number differs from expected");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.GetSackListSize (), 0, "SACK list should be empty");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Available (), 5000, "All data should be available");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Size (), 5000, "Buffer occupancy differs from expected");
+
+  // Extract a partial segment, then the rest, and check the byte order
+  Ptr<Packet> first = rxBuf.Extract (250);
+  NS_TEST_ASSERT_MSG_EQ (first->GetSize (), 250, "Extracted size differs from expected");
+  Ptr<Packet> rest = rxBuf.Extract (10000);
+  NS_TEST_ASSERT_MSG_EQ (rest->GetSize (), 4750, "Extracted size differs from expected");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Available (), 0, "No data should be available");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Size (), 0, "Buffer should be empty");
+
+  uint8_t out[5000];
+  first->CopyData (out, 250);
+  rest->CopyData (out + 250, 4750);
+  bool ordered = true;
+  for (uint32_t j = 0; j < 5000; ++j)
+    {
+      ordered = ordered && (out[j] == j / 100);
+    }
+  NS_TEST_ASSERT_MSG_EQ (ordered, true, "Data was not returned in sender order");
+
+  // A segment embedding a buffered one joins it in a single block
+  h.SetSequenceNumber (SequenceNumber32 (5201));
+  rxBuf.Add (Create<Packet> (100), h);
+  h.SetSequenceNumber (SequenceNumber32 (5101));
+  rxBuf.Add (Create<Packet> (400), h);
+
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.GetSackListSize (), 1, "SACK list should contain one element");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.GetSackList ().front ().first, SequenceNumber32 (5101),
+                         "SACK block different than expected");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.GetSackList ().front ().second, SequenceNumber32 (5501),
+                         "SACK block different than expected");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Size (), 400, "Buffer occupancy differs from expected");
+
+  h.SetSequenceNumber (SequenceNumber32 (5001));
+  rxBuf.Add (Create<Packet> (100), h);
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.NextRxSequence (), SequenceNumber32 (5501),
+                         "Sequence number differs from expected");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Available (), 500, "Available data differs from expected");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Extract (1000)->GetSize (), 500, "Extracted size differs from expected");
+}
+
 void
 TcpRxBufferTestCase::DoTeardown ()
 {
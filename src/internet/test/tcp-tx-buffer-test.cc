@@ -53,6 +53,8 @@ private:
   /** \brief Test the logic of merging items in GetTransmittedSegment()
    * which is triggered by CopyFromSequence()*/
   void TestMergeItemsWhenGetTransmittedSegment ();
+  /** \brief Test the scoreboard with a large window and many SACK holes */
+  void TestLargeWindowScoreboard ();
   /**
    * \brief Callback to provide a value of receiver window
    * \returns the receiver window size
@@ -101,6 +103,14 @@ TcpTxBufferTestCase::DoRun ()
   Simulator::Schedule (Seconds (0.0),
                          &TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment, this);
 
+  /*
+   * Case for the scoreboard:
+   *  -> a window of 1000 segments in which every other segment is sacked,
+   *     one block per ACK, and all the holes are retransmitted in order.
+   */
+  Simulator::Schedule (Seconds (0.0),
+                       &TcpTxBufferTestCase::TestLargeWindowScoreboard, this);
+
   Simulator::Run ();
   Simulator::Destroy ();
 }
@@ -385,6 +395,82 @@ TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment ()
   txBuf.CopyFromSequence (2000, SequenceNumber32(1));
 }
 
+void
+TcpTxBufferTestCase::TestLargeWindowScoreboard ()
+{
+  Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer> ();
+  txBuf->SetRWndCallback (MakeCallback (&TcpTxBufferTestCase::GetRWnd, this));
+  SequenceNumber32 head (1);
+  SequenceNumber32 ret;
+  SequenceNumber32 retHigh;
+  uint32_t segmentSize = 100;
+  uint32_t nSegments = 1000;
+  txBuf->SetHeadSequence (head);
+  txBuf->SetSegmentSize (segmentSize);
+  txBuf->SetDupAckThresh (3);
+  txBuf->SetMaxBufferSize (segmentSize * nSegments);
+
+  txBuf->Add (Create<Packet> (segmentSize * nSegments));
+  for (uint32_t i = 0; i < nSegments; ++i)
+    {
+      txBuf->CopyFromSequence (segmentSize, head + (segmentSize * i));
+    }
+
+  // Every odd segment reaches the receiver
+  for (uint32_t i = 1; i < nSegments; i += 2)
+    {
+      TcpOptionSack::SackList sackList;
+      sackList.push_back (TcpOptionSack::SackBlock (head + (segmentSize * i),
+                                                    head + (segmentSize * (i + 1))));
+      NS_TEST_ASSERT_MSG_EQ (txBuf->Update (sackList), segmentSize,
+                             "Segment " << i << " not sacked");
+    }
+
+  // Every even segment with at least three sacked segments above is lost
+  uint32_t nLost = nSegments / 2 - 2;
+  NS_TEST_ASSERT_MSG_EQ (txBuf->GetSacked (), segmentSize * nSegments / 2,
+                         "Wrong sacked bytes");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->GetLost (), segmentSize * nLost,
+                         "Wrong lost bytes");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->BytesInFlight (), segmentSize * 2,
+                         "Wrong bytes in flight");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->IsLost (head + (segmentSize * 2 * (nLost - 1))), true,
+                         "The highest lost hole is not lost");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->IsLost (head + (segmentSize * 2 * nLost)), false,
+                         "A hole without enough SACKs above is lost");
+
+  // Retransmit the lost holes, in order
+  for (uint32_t i = 0; i < nLost; ++i)
+    {
+      SequenceNumber32 hole = head + (segmentSize * 2 * i);
+      NS_TEST_ASSERT_MSG_EQ (txBuf->NextSeg (&ret, &retHigh, false), true,
+                             "No NextSeg with lost holes");
+      NS_TEST_ASSERT_MSG_EQ (ret, hole, "NextSeg did not return the next lost hole");
+      txBuf->CopyFromSequence (segmentSize, ret);
+      NS_TEST_ASSERT_MSG_EQ (txBuf->IsRetransmittedDataAcked (hole + segmentSize), true,
+                             "The hole is not marked as retransmitted");
+    }
+  NS_TEST_ASSERT_MSG_EQ (txBuf->GetRetransmitsCount (), segmentSize * nLost,
+                         "Wrong retransmitted bytes");
+
+  // Nothing left to retransmit, but rule 3 picks the first hole not lost
+  NS_TEST_ASSERT_MSG_EQ (txBuf->NextSeg (&ret, &retHigh, false), false,
+                         "NextSeg returned a segment without lost data");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->NextSeg (&ret, &retHigh, true), true,
+                         "NextSeg did not apply rule 3 in recovery");
+  NS_TEST_ASSERT_MSG_EQ (ret, head + (segmentSize * 2 * nLost),
+                         "Wrong segment for rule 3");
+
+  // A cumulative ACK in the middle of the window, then the remaining data
+  txBuf->DiscardUpTo (head + (segmentSize * nSegments / 2));
+  NS_TEST_ASSERT_MSG_EQ (txBuf->GetSacked (), segmentSize * nSegments / 4,
+                         "Wrong sacked bytes after a cumulative ACK");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->GetLost (), segmentSize * (nLost - nSegments / 4),
+                         "Wrong lost bytes after a cumulative ACK");
+  txBuf->DiscardUpTo (head + (segmentSize * nSegments));
+  NS_TEST_ASSERT_MSG_EQ (txBuf->Size (), 0, "Data inside the buffer");
+}
+
 void
 TcpTxBufferTestCase::TestTransmittedBlock ()
 {
@@ -0,0 +1,771 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \file
+ * \ingroup mtp
+ * Implementation of class ns3::MultithreadedSimulatorImpl.
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "ns3/core-config.h"
+#include "ns3/simulator.h"
+#include "ns3/scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/channel.h"
+#include "ns3/net-device.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/uinteger.h"
+#include "ns3/nstime.h"
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#endif
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED (MultithreadedSimulatorImpl);
+
+namespace {
+
+/** Time stamp of events which never happen. */
+const uint64_t NEVER = std::numeric_limits<uint64_t>::max ();
+
+} // unnamed namespace
+
+thread_local MultithreadedSimulatorImpl::Partition *MultithreadedSimulatorImpl::g_current = 0;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultithreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .SetGroupName ("Mtp")
+    .AddConstructor<MultithreadedSimulatorImpl> ()
+    .AddAttribute ("MaxThreads",
+                   "The maximum number of threads running partitions; "
+                   "0 means one thread per core.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&MultithreadedSimulatorImpl::m_maxThreads),
+                   MakeUintegerChecker<uint32_t> ())
+  ;
+  return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl ()
+  : m_currentTs (0),
+    m_lookAhead (NEVER),
+    m_maxThreads (0),
+    m_nThreads (1),
+    m_running (false),
+    m_stop (false),
+    m_stopTs (NEVER),
+    m_barrierCount (0),
+    m_barrierGeneration (0)
+{
+  NS_LOG_FUNCTION (this);
+  m_public = GetSystemPartition (0);
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::map<uint32_t, Partition *>::iterator i = m_systemPartitions.begin ();
+       i != m_systemPartitions.end (); ++i)
+    {
+      Partition *partition = i->second;
+      if (partition->events != 0)
+        {
+          Deliver (partition);
+          while (!partition->events->IsEmpty ())
+            {
+              Scheduler::Event next = partition->events->RemoveNext ();
+              next.impl->Unref ();
+            }
+        }
+      delete partition;
+    }
+  m_systemPartitions.clear ();
+  m_partitions.clear ();
+  m_nodePartitions.clear ();
+  m_public = 0;
+  SimulatorImpl::DoDispose ();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+  while (!m_destroyEvents.empty ())
+    {
+      Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
+      m_destroyEvents.pop_front ();
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << schedulerFactory);
+  NS_ASSERT_MSG (!m_running, "Cannot change the scheduler while running");
+  m_schedulerFactory = schedulerFactory;
+  for (std::map<uint32_t, Partition *>::iterator i = m_systemPartitions.begin ();
+       i != m_systemPartitions.end (); ++i)
+    {
+      Partition *partition = i->second;
+      Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+      if (partition->events != 0)
+        {
+          while (!partition->events->IsEmpty ())
+            {
+              scheduler->Insert (partition->events->RemoveNext ());
+            }
+        }
+      partition->events = scheduler;
+    }
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::GetSystemPartition (uint32_t systemId)
+{
+  std::map<uint32_t, Partition *>::iterator i = m_systemPartitions.find (systemId);
+  if (i != m_systemPartitions.end ())
+    {
+      return i->second;
+    }
+  NS_ABORT_MSG_IF (m_running, "Cannot add partition " << systemId << " while running");
+  NS_LOG_LOGIC ("new partition " << systemId);
+  Partition *partition = new Partition;
+  partition->systemId = systemId;
+  partition->index = 0;
+  if (m_schedulerFactory.GetTypeId () != TypeId ())
+    {
+      partition->events = m_schedulerFactory.Create<Scheduler> ();
+    }
+  // uids are allocated from 4, as in DefaultSimulatorImpl.
+  partition->uid = 4;
+  partition->currentUid = 0;
+  partition->currentTs = m_currentTs;
+  partition->currentContext = Simulator::NO_CONTEXT;
+  partition->unscheduledEvents = 0;
+  partition->eventCount = 0;
+  partition->seq = 0;
+  partition->windowEnd = 0;
+  partition->inbound = 0;
+  m_systemPartitions[systemId] = partition;
+  return partition;
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::GetPartition (uint32_t context)
+{
+  if (context == Simulator::NO_CONTEXT)
+    {
+      return m_public;
+    }
+  if (context < m_nodePartitions.size () && m_nodePartitions[context] != 0)
+    {
+      return m_nodePartitions[context];
+    }
+  Ptr<Node> node = NodeList::GetNode (context);
+  Partition *partition = GetSystemPartition (node->GetSystemId ());
+  if (!m_running)
+    {
+      if (context >= m_nodePartitions.size ())
+        {
+          m_nodePartitions.resize (context + 1, 0);
+        }
+      m_nodePartitions[context] = partition;
+    }
+  return partition;
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::GetCurrent (void) const
+{
+  if (g_current != 0)
+    {
+      return g_current;
+    }
+  NS_ASSERT_MSG (!m_running, "Thread-unsafe invocation of the simulator from outside the partitions");
+  return m_public;
+}
+
+EventId
+MultithreadedSimulatorImpl::Insert (Partition *partition, uint64_t ts, uint32_t context, EventImpl *event)
+{
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = ts;
+  ev.key.m_context = context;
+  ev.key.m_uid = partition->uid;
+  partition->uid++;
+  partition->unscheduledEvents++;
+  partition->events->Insert (ev);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::Send (Partition *from, Partition *to, uint64_t ts, uint32_t context, EventImpl *event)
+{
+  NS_ABORT_MSG_IF (ts < from->windowEnd,
+                   "Event from partition " << from->systemId << " to partition " << to->systemId <<
+                   " at " << TimeStep (ts) << ", within the lookahead " << TimeStep (m_lookAhead));
+  Message *message = new Message;
+  message->impl = event;
+  message->ts = ts;
+  message->context = context;
+  message->source = from->index;
+  message->seq = from->seq++;
+  message->next = to->inbound.load (std::memory_order_relaxed);
+  while (!to->inbound.compare_exchange_weak (message->next, message,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed))
+    {
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Deliver (Partition *partition)
+{
+  Message *message = partition->inbound.exchange (0, std::memory_order_acquire);
+  if (message == 0)
+    {
+      return;
+    }
+  // The stack order depends on the thread timing: sort the messages, so
+  // that they get the same uids in every run.
+  std::vector<Message *> messages;
+  for (; message != 0; message = message->next)
+    {
+      messages.push_back (message);
+    }
+  std::sort (messages.begin (), messages.end (),
+             [] (const Message *a, const Message *b)
+             {
+               if (a->ts != b->ts)
+                 {
+                   return a->ts < b->ts;
+                 }
+               if (a->source != b->source)
+                 {
+                   return a->source < b->source;
+                 }
+               return a->seq < b->seq;
+             });
+  for (std::vector<Message *>::iterator i = messages.begin (); i != messages.end (); ++i)
+    {
+      Insert (partition, (*i)->ts, (*i)->context, (*i)->impl);
+      delete *i;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Process (Partition *partition, uint64_t end)
+{
+  g_current = partition;
+  partition->windowEnd = end;
+  while (!partition->events->IsEmpty () && !m_stop.load (std::memory_order_relaxed))
+    {
+      Scheduler::Event next = partition->events->PeekNext ();
+      if (next.key.m_ts >= end)
+        {
+          break;
+        }
+      partition->events->RemoveNext ();
+
+      NS_ASSERT (next.key.m_ts >= partition->currentTs);
+      partition->unscheduledEvents--;
+      partition->eventCount.store (partition->eventCount.load (std::memory_order_relaxed) + 1,
+                                   std::memory_order_relaxed);
+      partition->currentTs = next.key.m_ts;
+      partition->currentContext = next.key.m_context;
+      partition->currentUid = next.key.m_uid;
+      next.impl->Invoke ();
+      next.impl->Unref ();
+    }
+  g_current = 0;
+}
+
+void
+MultithreadedSimulatorImpl::MapPartitions (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (NodeList::Iterator i = NodeList::Begin (); i != NodeList::End (); ++i)
+    {
+      GetPartition ((*i)->GetId ());
+    }
+  m_partitions.clear ();
+  for (std::map<uint32_t, Partition *>::iterator i = m_systemPartitions.begin ();
+       i != m_systemPartitions.end (); ++i)
+    {
+      i->second->index = m_partitions.size ();
+      m_partitions.push_back (i->second);
+    }
+
+  // Events cross partitions only on point-to-point channels, whose
+  // delay bounds how far ahead the partitions may run.
+  m_lookAhead = NEVER;
+  for (NodeList::Iterator i = NodeList::Begin (); i != NodeList::End (); ++i)
+    {
+      Ptr<Node> node = *i;
+      for (uint32_t j = 0; j < node->GetNDevices (); ++j)
+        {
+          Ptr<NetDevice> device = node->GetDevice (j);
+          Ptr<Channel> channel = device->GetChannel ();
+          if (channel == 0)
+            {
+              continue;
+            }
+          bool remote = false;
+          for (std::size_t k = 0; k < channel->GetNDevices (); ++k)
+            {
+              Ptr<Node> peer = channel->GetDevice (k)->GetNode ();
+              if (peer != 0 && peer->GetSystemId () != node->GetSystemId ())
+                {
+                  remote = true;
+                  break;
+                }
+            }
+          if (!remote)
+            {
+              continue;
+            }
+          NS_ABORT_MSG_UNLESS (device->IsPointToPoint (),
+                               "Only point-to-point channels may link partitions, not " <<
+                               channel->GetInstanceTypeId ().GetName () << " of node " << node->GetId ());
+          TimeValue delay;
+          channel->GetAttribute ("Delay", delay);
+          NS_ABORT_MSG_UNLESS (delay.Get ().IsStrictlyPositive (),
+                               "Channel of node " << node->GetId () << " links partitions with no delay");
+          m_lookAhead = std::min<uint64_t> (m_lookAhead, delay.Get ().GetTimeStep ());
+        }
+    }
+  NS_LOG_INFO (m_partitions.size () << " partitions, lookahead " << TimeStep (m_lookAhead));
+}
+
+void
+MultithreadedSimulatorImpl::Barrier (void)
+{
+  uint32_t generation = m_barrierGeneration.load (std::memory_order_acquire);
+  if (m_barrierCount.fetch_add (1, std::memory_order_acq_rel) + 1 == m_nThreads)
+    {
+      m_barrierCount.store (0, std::memory_order_relaxed);
+      m_barrierGeneration.fetch_add (1, std::memory_order_release);
+      return;
+    }
+  for (uint32_t spins = 0; m_barrierGeneration.load (std::memory_order_acquire) == generation; spins++)
+    {
+      // Yield once a round is clearly not about to end, not to starve
+      // the other threads on an oversubscribed machine.
+      if (spins > 100)
+        {
+          std::this_thread::yield ();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Worker::Run (void)
+{
+  impl->RunRounds (index);
+}
+
+void
+MultithreadedSimulatorImpl::RunRounds (uint32_t index)
+{
+  NS_LOG_FUNCTION (this << index);
+  for (uint32_t round = 0; ; round++)
+    {
+      Round &current = m_rounds[round % 2];
+      uint64_t next = NEVER;
+      for (uint32_t i = index; i < m_partitions.size (); i += m_nThreads)
+        {
+          Partition *partition = m_partitions[i];
+          Deliver (partition);
+          if (!partition->events->IsEmpty ())
+            {
+              next = std::min (next, partition->events->PeekNext ().key.m_ts);
+            }
+        }
+      uint64_t seen = current.next.load (std::memory_order_relaxed);
+      while (next < seen
+             && !current.next.compare_exchange_weak (seen, next, std::memory_order_relaxed))
+        {
+        }
+      if (index == 0)
+        {
+          // No event runs until the barrier: the stop state is stable.
+          current.stop = m_stop.load ();
+          current.stopTs = m_stopTs.load ();
+        }
+      Barrier ();
+
+      next = current.next.load (std::memory_order_relaxed);
+      if (index == 0)
+        {
+          m_rounds[(round + 1) % 2].next.store (NEVER, std::memory_order_relaxed);
+        }
+      if (next == NEVER || next >= current.stopTs || current.stop)
+        {
+          break;
+        }
+      uint64_t end = NEVER;
+      if (m_lookAhead < NEVER - next)
+        {
+          end = next + m_lookAhead;
+        }
+      end = std::min (end, current.stopTs);
+      for (uint32_t i = index; i < m_partitions.size (); i += m_nThreads)
+        {
+          Process (m_partitions[i], end);
+        }
+      Barrier ();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (!m_running, "Simulator::Run () called while running");
+  MapPartitions ();
+
+  m_nThreads = m_maxThreads;
+  if (m_nThreads == 0)
+    {
+      m_nThreads = std::max<uint32_t> (std::thread::hardware_concurrency (), 1);
+    }
+#ifndef HAVE_PTHREAD_H
+  m_nThreads = 1;
+#endif
+  m_nThreads = std::min<uint32_t> (m_nThreads, m_partitions.size ());
+  NS_LOG_INFO ("Running " << m_partitions.size () << " partitions on " << m_nThreads << " threads");
+
+  m_stop = false;
+  m_running = true;
+  m_rounds[0].next = NEVER;
+  m_rounds[1].next = NEVER;
+  m_barrierCount = 0;
+
+  // The thread of index 0 is the calling one, so that the partition of
+  // system id 0 runs on the thread which set the simulation up.
+  std::vector<Worker> workers (m_nThreads);
+#ifdef HAVE_PTHREAD_H
+  std::vector<Ptr<SystemThread> > threads;
+  for (uint32_t i = 1; i < m_nThreads; i++)
+    {
+      workers[i].impl = this;
+      workers[i].index = i;
+      threads.push_back (Create<SystemThread> (MakeCallback (&Worker::Run, &workers[i])));
+      threads.back ()->Start ();
+    }
+#endif
+  RunRounds (0);
+#ifdef HAVE_PTHREAD_H
+  for (uint32_t i = 0; i < threads.size (); i++)
+    {
+      threads[i]->Join ();
+    }
+#endif
+  m_running = false;
+
+  uint64_t ts = m_currentTs;
+  bool empty = true;
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      ts = std::max (ts, (*i)->currentTs);
+      empty = empty && (*i)->events->IsEmpty ();
+      // If the simulator stopped naturally by lack of events, make a
+      // consistency test to check that we didn't lose any events along the way.
+      NS_ASSERT (!(*i)->events->IsEmpty () || (*i)->unscheduledEvents == 0);
+    }
+  if (!m_stop && m_stopTs != NEVER)
+    {
+      // The time of Stop (delay) was reached.
+      ts = std::max (ts, m_stopTs.load ());
+      m_stopTs = NEVER;
+    }
+  m_currentTs = ts;
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      if ((*i)->currentTs < ts)
+        {
+          (*i)->currentTs = ts;
+          (*i)->currentUid = 0;
+        }
+      (*i)->currentContext = Simulator::NO_CONTEXT;
+    }
+  NS_LOG_LOGIC ("stopped at " << TimeStep (m_currentTs) << (empty ? ", no event left" : ""));
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished (void) const
+{
+  if (m_stop)
+    {
+      return true;
+    }
+  for (std::map<uint32_t, Partition *>::const_iterator i = m_systemPartitions.begin ();
+       i != m_systemPartitions.end (); ++i)
+    {
+      if (!i->second->events->IsEmpty () || i->second->inbound.load () != 0)
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_stop = true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop (Time const &delay)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep ());
+  uint64_t ts = Now ().GetTimeStep () + delay.GetTimeStep ();
+  uint64_t stopTs = m_stopTs.load ();
+  while (ts < stopTs && !m_stopTs.compare_exchange_weak (stopTs, ts))
+    {
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule (Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep () << event);
+  NS_ASSERT_MSG (delay.IsPositive (), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+  Partition *partition = GetCurrent ();
+  Time tAbsolute = delay + Now ();
+  return Insert (partition, tAbsolute.GetTimeStep (), GetContext (), event);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << delay.GetTimeStep () << event);
+  Partition *current = GetCurrent ();
+  Partition *partition = GetPartition (context);
+  uint64_t ts = (delay + Now ()).GetTimeStep ();
+  if (!m_running || partition == current)
+    {
+      Insert (partition, ts, context, event);
+    }
+  else
+    {
+      Send (current, partition, ts, context, event);
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << event);
+  return Insert (GetCurrent (), Now ().GetTimeStep (), GetContext (), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << event);
+  EventId id (Ptr<EventImpl> (event, false), Now ().GetTimeStep (), 0xffffffff, 2);
+  CriticalSection cs (m_destroyMutex);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now (void) const
+{
+  // Do not add function logging here, to avoid stack overflow
+  if (g_current != 0)
+    {
+      return TimeStep (g_current->currentTs);
+    }
+  return TimeStep (m_currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  return TimeStep (id.GetTs ()) - Now ();
+}
+
+void
+MultithreadedSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      CriticalSection cs (m_destroyMutex);
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  Partition *partition = const_cast<MultithreadedSimulatorImpl *> (this)->GetPartition (id.GetContext ());
+  NS_ASSERT_MSG (!m_running || partition == g_current, "Cannot remove an event of another partition");
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  partition->events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+
+  partition->unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired (const EventId &id) const
+{
+  if (id.GetUid () == 2)
+    {
+      if (id.PeekEventImpl () == 0
+          || id.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      CriticalSection cs (const_cast<SystemMutex &> (m_destroyMutex));
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  if (id.PeekEventImpl () == 0)
+    {
+      return true;
+    }
+  const Partition *partition = const_cast<MultithreadedSimulatorImpl *> (this)->GetPartition (id.GetContext ());
+  if (id.GetTs () < partition->currentTs
+      || (id.GetTs () == partition->currentTs && id.GetUid () <= partition->currentUid)
+      || id.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId (void) const
+{
+  if (g_current != 0)
+    {
+      return g_current->systemId;
+    }
+  return 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext (void) const
+{
+  if (g_current != 0)
+    {
+      return g_current->currentContext;
+    }
+  return Simulator::NO_CONTEXT;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount (void) const
+{
+  uint64_t count = 0;
+  for (std::map<uint32_t, Partition *>::const_iterator i = m_systemPartitions.begin ();
+       i != m_systemPartitions.end (); ++i)
+    {
+      count += i->second->eventCount.load (std::memory_order_relaxed);
+    }
+  return count;
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookAhead (void) const
+{
+  return TimeStep (m_lookAhead);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetNPartitions (void) const
+{
+  return m_systemPartitions.size ();
+}
+
+} // namespace ns3
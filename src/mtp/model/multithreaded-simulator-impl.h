@@ -0,0 +1,249 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \file
+ * \ingroup mtp
+ * Declaration of class ns3::MultithreadedSimulatorImpl.
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/simulator-impl.h"
+#include "ns3/scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/object-factory.h"
+#include "ns3/ptr.h"
+#include "ns3/system-mutex.h"
+
+#include <atomic>
+#include <list>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \defgroup mtp Multithreaded simulation
+ *
+ * Parallel simulation on the threads of a single process.
+ */
+
+/**
+ * \ingroup mtp
+ *
+ * \brief Conservative parallel simulator running partitions of the
+ * nodes on threads.
+ *
+ * Nodes are partitioned by their system id, as in a distributed
+ * simulation, but all the partitions live in one process.  Each
+ * partition has its own event scheduler and clock.  A pool of threads
+ * runs the partitions in rounds: all the threads agree on the earliest
+ * pending event time \c t and process, in parallel, the events of their
+ * partitions before <tt>t + lookahead</tt>, then meet on a barrier.
+ *
+ * The lookahead is the smallest delay of the point-to-point channels
+ * between nodes of different partitions.  Events scheduled for a node of
+ * another partition are pushed on a lock-free inbound stack of that
+ * partition and inserted in its scheduler at the next round, in an order
+ * which does not depend on the thread timing, so runs are reproducible.
+ * PointToPointChannel hands the packets it carries between partitions in
+ * serialized form, so the two partitions never share a packet.
+ *
+ * Other interactions between partitions are not allowed during the run:
+ * only point-to-point channels may link nodes of different partitions,
+ * and the objects of a partition, including trace sinks, must only be
+ * used from events of that partition.  Events without a context run in
+ * the partition of system id 0.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  MultithreadedSimulatorImpl ();
+  /** Destructor. */
+  ~MultithreadedSimulatorImpl ();
+
+  // Inherited
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (const Time &delay);
+  virtual EventId Schedule (const Time &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+  virtual uint64_t GetEventCount (void) const;
+
+  /**
+   * \returns The lookahead found by the last Run.
+   */
+  Time GetLookAhead (void) const;
+  /**
+   * \returns The number of partitions.
+   */
+  uint32_t GetNPartitions (void) const;
+
+private:
+  virtual void DoDispose (void);
+
+  /** An event sent to another partition. */
+  struct Message
+  {
+    Message *next;     //!< The next message of the inbound stack.
+    EventImpl *impl;   //!< The event.
+    uint64_t ts;       //!< The event time stamp.
+    uint32_t context;  //!< The event context.
+    uint32_t source;   //!< The index of the sending partition.
+    uint64_t seq;      //!< The sequence number of the message at its source.
+  };
+
+  /** The state of a partition. */
+  struct Partition
+  {
+    uint32_t systemId;            //!< The system id of the nodes.
+    uint32_t index;               //!< The index in m_partitions.
+    Ptr<Scheduler> events;        //!< The pending events.
+    uint32_t uid;                 //!< The next event uid.
+    uint32_t currentUid;          //!< The uid of the current event.
+    uint64_t currentTs;           //!< The time stamp of the current event.
+    uint32_t currentContext;      //!< The context of the current event.
+    int unscheduledEvents;        //!< The number of pending events.
+    std::atomic<uint64_t> eventCount;  //!< The number of processed events.
+    uint64_t seq;                 //!< The next sequence number of sent messages.
+    uint64_t windowEnd;           //!< The end of the current round.
+    std::atomic<Message *> inbound;    //!< The messages from other partitions.
+  };
+
+  /** The state agreed on by all the threads at the start of a round. */
+  struct Round
+  {
+    std::atomic<uint64_t> next;   //!< The earliest pending event time.
+    bool stop;                    //!< Whether Stop () was called.
+    uint64_t stopTs;              //!< The stop time.
+  };
+
+  /** A thread of the pool. */
+  struct Worker
+  {
+    MultithreadedSimulatorImpl *impl;  //!< The simulator.
+    uint32_t index;                    //!< The thread index.
+    /** Run the rounds. */
+    void Run (void);
+  };
+
+  /**
+   * Get the partition of a system id, creating it if needed.
+   * \param [in] systemId The system id.
+   * \returns The partition.
+   */
+  Partition * GetSystemPartition (uint32_t systemId);
+  /**
+   * Get the partition running the events of a context.
+   * \param [in] context The context.
+   * \returns The partition.
+   */
+  Partition * GetPartition (uint32_t context);
+  /**
+   * Get the partition of the calling thread, or the partition of the
+   * events without context when the simulation is not running.
+   * \returns The partition.
+   */
+  Partition * GetCurrent (void) const;
+  /**
+   * Insert an event in a partition.
+   * \param [in] partition The partition.
+   * \param [in] ts The event time stamp.
+   * \param [in] context The event context.
+   * \param [in] event The event.
+   * \returns The event id.
+   */
+  EventId Insert (Partition *partition, uint64_t ts, uint32_t context, EventImpl *event);
+  /**
+   * Push an event on the inbound stack of another partition.
+   * \param [in] from The sending partition.
+   * \param [in] to The receiving partition.
+   * \param [in] ts The event time stamp.
+   * \param [in] context The event context.
+   * \param [in] event The event.
+   */
+  void Send (Partition *from, Partition *to, uint64_t ts, uint32_t context, EventImpl *event);
+  /**
+   * Insert the inbound events of a partition in its scheduler.
+   * \param [in] partition The partition.
+   */
+  void Deliver (Partition *partition);
+  /**
+   * Process the events of a partition before the end of the round.
+   * \param [in] partition The partition.
+   * \param [in] end The end of the round.
+   */
+  void Process (Partition *partition, uint64_t end);
+  /** Map the nodes to partitions and compute the lookahead. */
+  void MapPartitions (void);
+  /**
+   * Run the rounds on a thread.
+   * \param [in] index The thread index.
+   */
+  void RunRounds (uint32_t index);
+  /** Wait until all the threads reach the barrier. */
+  void Barrier (void);
+
+  /** The partition run by the calling thread, if any. */
+  static thread_local Partition *g_current;
+
+  /** Container type for the events to run at Simulator::Destroy (). */
+  typedef std::list<EventId> DestroyEvents;
+  DestroyEvents m_destroyEvents;                    //!< The events to run at Simulator::Destroy ().
+  SystemMutex m_destroyMutex;                       //!< Protect m_destroyEvents.
+  ObjectFactory m_schedulerFactory;                 //!< The scheduler factory.
+  std::map<uint32_t, Partition *> m_systemPartitions; //!< The partitions by system id.
+  std::vector<Partition *> m_partitions;            //!< The partitions, by system id.
+  std::vector<Partition *> m_nodePartitions;        //!< The partitions, by node id.
+  Partition *m_public;                              //!< The partition of events without context.
+  uint64_t m_currentTs;                             //!< The time outside of Run ().
+  uint64_t m_lookAhead;                             //!< The lookahead, in time steps.
+  uint32_t m_maxThreads;                            //!< The maximum number of threads.
+  uint32_t m_nThreads;                              //!< The number of threads of the current run.
+  bool m_running;                                   //!< Whether Run () is in progress.
+  std::atomic<bool> m_stop;                         //!< Whether Stop () was called.
+  std::atomic<uint64_t> m_stopTs;                   //!< The time given to Stop (delay).
+  struct Round m_rounds[2];                         //!< The state of the current and next rounds.
+  std::atomic<uint32_t> m_barrierCount;             //!< The threads waiting at the barrier.
+  std::atomic<uint32_t> m_barrierGeneration;        //!< The number of barriers passed.
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
@@ -0,0 +1,254 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/global-value.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/packet.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/multithreaded-simulator-impl.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup mtp
+ * \defgroup mtp-test Multithreaded simulation tests
+ */
+
+/**
+ * \ingroup mtp-test
+ * \ingroup tests
+ *
+ * \brief Run packets bouncing on a chain of nodes of different system
+ * ids with the default simulator and the multithreaded one, and check
+ * that every node sees the same packets at the same times.
+ */
+class MultithreadedSimulatorTestCase : public TestCase
+{
+public:
+  MultithreadedSimulatorTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /** The packets received by a node, as (time, size) pairs. */
+  typedef std::vector<std::pair<int64_t, uint32_t> > Log;
+
+  /**
+   * Run the scenario.
+   * \param [in] impl The simulator implementation type.
+   * \param [in] threads The maximum number of threads.
+   * \returns The packets received by each node.
+   */
+  std::vector<Log> RunScenario (std::string impl, uint32_t threads);
+  /**
+   * Receive a packet.
+   * \param [in] device The receiving device.
+   * \param [in] packet The packet.
+   * \param [in] protocol The protocol number.
+   * \param [in] from The sender address.
+   * \returns true.
+   */
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from);
+  /**
+   * Send a packet on a device.
+   * \param [in] device The device.
+   * \param [in] size The packet size.
+   */
+  void Send (Ptr<NetDevice> device, uint32_t size);
+
+  std::vector<Log> m_logs;  //!< The packets received by each node.
+};
+
+MultithreadedSimulatorTestCase::MultithreadedSimulatorTestCase ()
+  : TestCase ("Check that partitions on threads run the events of the default simulator")
+{
+}
+
+void
+MultithreadedSimulatorTestCase::Send (Ptr<NetDevice> device, uint32_t size)
+{
+  device->Send (Create<Packet> (size), device->GetBroadcast (), 0x0800);
+}
+
+bool
+MultithreadedSimulatorTestCase::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet,
+                                         uint16_t protocol, const Address &from)
+{
+  // Only the thread of the partition of the node touches its log.
+  Ptr<Node> node = device->GetNode ();
+  uint32_t size = packet->GetSize ();
+  m_logs[node->GetId ()].push_back (std::make_pair (Simulator::Now ().GetTimeStep (), size));
+  if (size > 100)
+    {
+      // Bounce a smaller packet on the next device, after some processing.
+      uint32_t next = (device->GetIfIndex () + size) % node->GetNDevices ();
+      Simulator::Schedule (MicroSeconds (size % 7), &MultithreadedSimulatorTestCase::Send,
+                           this, node->GetDevice (next), size - 37);
+    }
+  return true;
+}
+
+std::vector<MultithreadedSimulatorTestCase::Log>
+MultithreadedSimulatorTestCase::RunScenario (std::string impl, uint32_t threads)
+{
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue (impl));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue (threads));
+
+  // A chain of 6 nodes on 3 systems, with a local link in the middle
+  // of each system.
+  const uint32_t nNodes = 6;
+  NodeContainer nodes;
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      nodes.Add (CreateObject<Node> (i / 2));
+    }
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  for (uint32_t i = 0; i + 1 < nNodes; i++)
+    {
+      p2p.SetChannelAttribute ("Delay", StringValue (i % 2 ? "1ms" : "100us"));
+      p2p.Install (nodes.Get (i), nodes.Get (i + 1));
+    }
+
+  m_logs.assign (nNodes, Log ());
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      Ptr<Node> node = nodes.Get (i);
+      for (uint32_t j = 0; j < node->GetNDevices (); j++)
+        {
+          Ptr<NetDevice> device = node->GetDevice (j);
+          device->SetReceiveCallback (MakeCallback (&MultithreadedSimulatorTestCase::Receive, this));
+          for (uint32_t k = 0; k < 10; k++)
+            {
+              Simulator::ScheduleWithContext (i, MicroSeconds (k * 150 + i * 13),
+                                              &MultithreadedSimulatorTestCase::Send,
+                                              this, device, 1000 + 101 * k);
+            }
+        }
+    }
+
+  Simulator::Stop (MilliSeconds (40));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), MilliSeconds (40), "Stopped at the wrong time");
+  Simulator::Destroy ();
+
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+  return m_logs;
+}
+
+void
+MultithreadedSimulatorTestCase::DoRun (void)
+{
+  std::vector<Log> reference = RunScenario ("ns3::DefaultSimulatorImpl", 0);
+  uint32_t received = 0;
+  for (uint32_t i = 0; i < reference.size (); i++)
+    {
+      received += reference[i].size ();
+    }
+  NS_TEST_ASSERT_MSG_GT (received, 300, "The scenario is too small to mean anything");
+
+  for (uint32_t threads = 1; threads <= 3; threads++)
+    {
+      std::vector<Log> logs = RunScenario ("ns3::MultithreadedSimulatorImpl", threads);
+      for (uint32_t i = 0; i < reference.size (); i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (logs[i].size (), reference[i].size (),
+                                 "Wrong number of packets at node " << i << " with " << threads << " threads");
+          for (uint32_t j = 0; j < reference[i].size (); j++)
+            {
+              NS_TEST_ASSERT_MSG_EQ (logs[i][j].first, reference[i][j].first,
+                                     "Wrong time of packet " << j << " at node " << i);
+              NS_TEST_ASSERT_MSG_EQ (logs[i][j].second, reference[i][j].second,
+                                     "Wrong size of packet " << j << " at node " << i);
+            }
+        }
+    }
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue (0));
+}
+
+/**
+ * \ingroup mtp-test
+ * \ingroup tests
+ *
+ * \brief Check the partitions and the lookahead found from the topology.
+ */
+class MultithreadedSimulatorLookAheadTestCase : public TestCase
+{
+public:
+  MultithreadedSimulatorLookAheadTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+MultithreadedSimulatorLookAheadTestCase::MultithreadedSimulatorLookAheadTestCase ()
+  : TestCase ("Check the partitions and the lookahead")
+{
+}
+
+void
+MultithreadedSimulatorLookAheadTestCase::DoRun (void)
+{
+  Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl> ();
+  Simulator::SetImplementation (impl);
+
+  NodeContainer nodes;
+  nodes.Add (CreateObject<Node> (0));
+  nodes.Add (CreateObject<Node> (0));
+  nodes.Add (CreateObject<Node> (1));
+  PointToPointHelper p2p;
+  p2p.SetChannelAttribute ("Delay", StringValue ("1us"));
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+  p2p.SetChannelAttribute ("Delay", StringValue ("3ms"));
+  p2p.Install (nodes.Get (1), nodes.Get (2));
+
+  Simulator::Stop (Seconds (1));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (impl->GetNPartitions (), 2, "Wrong number of partitions");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetLookAhead (), MilliSeconds (3), "Local links must not bound the lookahead");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), Seconds (1), "Stopped at the wrong time");
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup mtp-test
+ * \ingroup tests
+ *
+ * \brief Multithreaded simulator test suite.
+ */
+class MtpTestSuite : public TestSuite
+{
+public:
+  MtpTestSuite ();
+};
+
+MtpTestSuite::MtpTestSuite ()
+  : TestSuite ("mtp", UNIT)
+{
+  AddTestCase (new MultithreadedSimulatorTestCase, TestCase::QUICK);
+  AddTestCase (new MultithreadedSimulatorLookAheadTestCase, TestCase::QUICK);
+}
+
+static MtpTestSuite g_mtpTestSuite; //!< Static variable for test initialization
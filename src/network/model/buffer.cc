@@ -50,7 +50,7 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("Buffer");
 
 
-uint32_t Buffer::g_recommendedStart = 0;
+thread_local uint32_t Buffer::g_recommendedStart = 0;
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -75,9 +75,9 @@ uint32_t Buffer::g_recommendedStart = 0;
 #define IS_INITIALIZED(x) (!IS_UNINITIALIZED (x) && !IS_DESTROYED (x))
 #define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
 #define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList *Buffer::g_freeList = 0;
-struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
+thread_local uint32_t Buffer::g_maxSize = 0;
+thread_local Buffer::FreeList *Buffer::g_freeList = 0;
+thread_local struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
 
 Buffer::LocalStaticDestructor::~LocalStaticDestructor(void)
 {
@@ -99,11 +99,11 @@ Buffer::Recycle (struct Buffer::Data *data)
 {
   NS_LOG_FUNCTION (data);
   NS_ASSERT (data->m_count == 0);
-  NS_ASSERT (!IS_UNINITIALIZED (g_freeList));
   g_maxSize = std::max (g_maxSize, data->m_size);
-  /* feed into free list */
+  /* feed into free list, unless the data comes from another thread
+   * which never created a buffer on this one */
   if (data->m_size < g_maxSize ||
-      IS_DESTROYED (g_freeList) ||
+      !IS_INITIALIZED (g_freeList) ||
       g_freeList->size () > 1000)
     {
       Buffer::Deallocate (data);
@@ -123,6 +123,8 @@ Buffer::Create (uint32_t dataSize)
   if (IS_UNINITIALIZED (g_freeList))
     {
       g_freeList = new Buffer::FreeList ();
+      /* a thread_local destructor is registered on first use only */
+      (void) &g_localStaticDestructor;
     }
   else if (IS_INITIALIZED (g_freeList))
     {
@@ -401,9 +403,19 @@ Buffer::AddAtEnd (const Buffer &o)
 {
   NS_LOG_FUNCTION (this << &o);
 
-  if (m_data->m_count == 1 &&
-      (m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
-      m_end == m_data->m_dirtyEnd &&
+  if (o.GetSize () == 0)
+    {
+      return;
+    }
+  if (GetSize () == 0)
+    {
+      /* Nothing to merge: just share the data of o.
+       */
+      *this = o;
+      return;
+    }
+
+  if ((m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
       o.m_start == o.m_zeroAreaStart &&
       o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
     {
@@ -412,6 +424,31 @@ Buffer::AddAtEnd (const Buffer &o)
        * we attempt to aggregate two buffers which contain
        * adjacent zero areas.
        */
+      uint32_t endData = o.m_end - o.m_zeroAreaEnd;
+      if (m_data->m_count != 1 || m_end != m_data->m_dirtyEnd)
+        {
+          /* The data is shared (typically, we are a fragment of
+           * a larger buffer): take a private copy of the real bytes
+           * only, so that the zero areas stay virtual.
+           */
+          struct Buffer::Data *newData = Buffer::Create (GetInternalSize () + endData);
+          memcpy (newData->m_data, m_data->m_data + m_start, GetInternalSize ());
+          m_data->m_count--;
+          if (m_data->m_count == 0)
+            {
+              Buffer::Recycle (m_data);
+            }
+          m_data = newData;
+
+          int32_t delta = -m_start;
+          m_zeroAreaStart += delta;
+          m_zeroAreaEnd += delta;
+          m_end += delta;
+          m_start += delta;
+
+          m_data->m_dirtyStart = m_start;
+          m_data->m_dirtyEnd = m_end;
+        }
       if (m_zeroAreaStart == m_zeroAreaEnd)
         {
           m_zeroAreaStart = m_end;
@@ -420,7 +457,6 @@ Buffer::AddAtEnd (const Buffer &o)
       m_zeroAreaEnd = m_end + zeroSize;
       m_end = m_zeroAreaEnd;
       m_data->m_dirtyEnd = m_zeroAreaEnd;
-      uint32_t endData = o.m_end - o.m_zeroAreaEnd;
       AddAtEnd (endData);
       Buffer::Iterator dst = End ();
       dst.Prev (endData);
@@ -844,25 +880,36 @@ Buffer::Iterator::Write (Iterator start, Iterator end)
   uint32_t size = end.m_current - start.m_current;
   NS_ASSERT_MSG (CheckNoZero (m_current, m_current + size),
                  GetWriteErrorMessage ());
+  // the destination may be located after our own zero area
+  uint8_t *to;
+  if (m_current <= m_zeroStart)
+    {
+      to = &m_data[m_current];
+    }
+  else
+    {
+      to = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+    }
   if (start.m_current <= start.m_zeroStart)
     {
       uint32_t toCopy = std::min (size, start.m_zeroStart - start.m_current);
-      memcpy (&m_data[m_current], &start.m_data[start.m_current], toCopy);
+      memcpy (to, &start.m_data[start.m_current], toCopy);
       start.m_current += toCopy;
       m_current += toCopy;
+      to += toCopy;
       size -= toCopy;
     }
   if (start.m_current <= start.m_zeroEnd)
     {
       uint32_t toCopy = std::min (size, start.m_zeroEnd - start.m_current);
-      memset (&m_data[m_current], 0, toCopy);
+      memset (to, 0, toCopy);
       start.m_current += toCopy;
       m_current += toCopy;
+      to += toCopy;
       size -= toCopy;
     }
   uint32_t toCopy = std::min (size, start.m_dataEnd - start.m_current);
   uint8_t *from = &start.m_data[start.m_current - (start.m_zeroEnd-start.m_zeroStart)];
-  uint8_t *to = &m_data[m_current];
   memcpy (to, from, toCopy);
   m_current += toCopy;
 }
@@ -527,6 +527,12 @@ private:
    * Add bytes at the end of the Buffer.
    * Any call to this method invalidates any Iterator
    * pointing to this Buffer.
+   *
+   * Appending to an empty Buffer shares the data of \p o, and
+   * appending a Buffer which starts with a zero area to one which
+   * ends with a zero area (e.g., merging two fragments of the same
+   * payload) keeps the zero area virtual: only the real bytes are
+   * copied.
    */
   void AddAtEnd (const Buffer &o);
   /**
@@ -767,7 +773,7 @@ private:
    * writing data. i.e., m_start should be initialized to this 
    * value.
    */
-  static uint32_t g_recommendedStart;
+  static thread_local uint32_t g_recommendedStart;
 
   /**
    * offset to the start of the virtual zero area from the start
@@ -798,9 +804,11 @@ private:
   {
     ~LocalStaticDestructor ();
   };
-  static uint32_t g_maxSize; //!< Max observed data size
-  static FreeList *g_freeList; //!< Buffer data container
-  static struct LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
+  // The free list is per thread, for the simulators which run events
+  // on several threads.
+  static thread_local uint32_t g_maxSize; //!< Max observed data size
+  static thread_local FreeList *g_freeList; //!< Buffer data container
+  static thread_local struct LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
 #endif
 };
 
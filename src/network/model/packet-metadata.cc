@@ -34,9 +34,16 @@ NS_LOG_COMPONENT_DEFINE ("PacketMetadata");
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
-uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+thread_local uint32_t PacketMetadata::m_maxSize = 0;
+thread_local uint16_t PacketMetadata::m_chunkUid = 0;
+thread_local PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+
+/**
+ * Whether the free list of the thread was destroyed: the thread-local
+ * destructors of the main thread run before the static ones, which may
+ * still free metadata.
+ */
+static thread_local bool g_freeListDestroyed = false;
 
 PacketMetadata::DataFreeList::~DataFreeList ()
 {
@@ -45,7 +52,7 @@ PacketMetadata::DataFreeList::~DataFreeList ()
     {
       PacketMetadata::Deallocate (*i);
     }
-  PacketMetadata::m_enable = false;
+  g_freeListDestroyed = true;
 }
 
 void 
@@ -575,7 +582,7 @@ PacketMetadata::Create (uint32_t size)
     {
       m_maxSize = size;
     }
-  while (!m_freeList.empty ()) 
+  while (!g_freeListDestroyed && !m_freeList.empty ())
     {
       struct PacketMetadata::Data *data = m_freeList.back ();
       m_freeList.pop_back ();
@@ -596,7 +603,7 @@ void
 PacketMetadata::Recycle (struct PacketMetadata::Data *data)
 {
   NS_LOG_FUNCTION (data);
-  if (!m_enable)
+  if (!m_enable || g_freeListDestroyed)
     {
       PacketMetadata::Deallocate (data);
       return;
@@ -669,15 +676,39 @@ PacketMetadata::DoAddHeader (uint32_t uid, uint32_t size)
       return;
     }
 
-  struct PacketMetadata::SmallItem item;
-  item.next = m_head;
-  item.prev = 0xffff;
-  item.typeUid = uid;
-  item.size = size;
-  item.chunkUid = m_chunkUid;
+  if (m_nPending == PACKET_METADATA_PENDING_SIZE)
+    {
+      EncodePending ();
+    }
+  struct PacketMetadata::PendingHeader &pending = m_pending[m_nPending];
+  pending.typeUid = uid;
+  pending.size = size;
+  pending.chunkUid = m_chunkUid;
   m_chunkUid++;
-  uint16_t written = AddSmall (&item);
-  UpdateHead (written);
+  m_nPending++;
+}
+void
+PacketMetadata::EncodePending (void) const
+{
+  NS_LOG_FUNCTION (this);
+  if (m_nPending == 0)
+    {
+      return;
+    }
+  PacketMetadata *self = const_cast<PacketMetadata *> (this);
+  for (uint8_t i = 0; i < m_nPending; i++)
+    {
+      struct PacketMetadata::SmallItem item;
+      item.next = m_head;
+      item.prev = 0xffff;
+      item.typeUid = m_pending[i].typeUid;
+      item.size = m_pending[i].size;
+      item.chunkUid = m_pending[i].chunkUid;
+      uint16_t written = self->AddSmall (&item);
+      self->UpdateHead (written);
+    }
+  self->m_nPending = 0;
+  NS_ASSERT (IsStateOk ());
 }
 void 
 PacketMetadata::RemoveHeader (const Header &header, uint32_t size)
@@ -690,6 +721,20 @@ PacketMetadata::RemoveHeader (const Header &header, uint32_t size)
       m_metadataSkipped = true;
       return;
     }
+  if (m_nPending > 0)
+    {
+      const struct PacketMetadata::PendingHeader &pending = m_pending[m_nPending - 1];
+      if (pending.typeUid != uid || pending.size != size)
+        {
+          if (m_enableChecking)
+            {
+              NS_FATAL_ERROR ("Removing unexpected header.");
+            }
+          return;
+        }
+      m_nPending--;
+      return;
+    }
   struct PacketMetadata::SmallItem item;
   struct PacketMetadata::ExtraItem extraItem;
   uint32_t read = ReadItems (m_head, &item, &extraItem);
@@ -738,6 +783,7 @@ PacketMetadata::AddTrailer (const Trailer &trailer, uint32_t size)
       m_metadataSkipped = true;
       return;
     }
+  EncodePending ();
   struct PacketMetadata::SmallItem item;
   item.next = 0xffff;
   item.prev = m_tail;
@@ -760,6 +806,7 @@ PacketMetadata::RemoveTrailer (const Trailer &trailer, uint32_t size)
       m_metadataSkipped = true;
       return;
     }
+  EncodePending ();
   struct PacketMetadata::SmallItem item;
   struct PacketMetadata::ExtraItem extraItem;
   uint32_t read = ReadItems (m_tail, &item, &extraItem);
@@ -807,6 +854,8 @@ PacketMetadata::AddAtEnd (PacketMetadata const&o)
       m_metadataSkipped = true;
       return;
     }
+  EncodePending ();
+  o.EncodePending ();
   if (m_tail == 0xffff)
     {
       // We have no items so 'AddAtEnd' is 
@@ -895,6 +944,7 @@ PacketMetadata::RemoveAtStart (uint32_t start)
       m_metadataSkipped = true;
       return;
     }
+  EncodePending ();
   NS_ASSERT (m_data != 0);
   uint32_t leftToRemove = start;
   uint16_t current = m_head;
@@ -958,6 +1008,7 @@ PacketMetadata::RemoveAtEnd (uint32_t end)
       m_metadataSkipped = true;
       return;
     }
+  EncodePending ();
   NS_ASSERT (m_data != 0);
 
   uint32_t leftToRemove = end;
@@ -1046,6 +1097,7 @@ PacketMetadata::ItemIterator
 PacketMetadata::BeginItem (Buffer buffer) const
 {
   NS_LOG_FUNCTION (this << &buffer);
+  EncodePending ();
   return ItemIterator (this, buffer);
 }
 PacketMetadata::ItemIterator::ItemIterator (const PacketMetadata *metadata, Buffer buffer)
@@ -1146,6 +1198,7 @@ PacketMetadata::GetSerializedSize (void) const
       return totalSize;
     }
 
+  EncodePending ();
   struct PacketMetadata::SmallItem item;
   struct PacketMetadata::ExtraItem extraItem;
   uint32_t current = m_head;
@@ -1180,6 +1233,7 @@ PacketMetadata::Serialize (uint8_t* buffer, uint32_t maxSize) const
   NS_LOG_FUNCTION (this << &buffer << maxSize);
   uint8_t* start = buffer;
 
+  EncodePending ();
   buffer = AddToRawU64 (m_packetUid, start, buffer, maxSize);
   if (buffer == 0) 
     {
@@ -1282,6 +1336,7 @@ PacketMetadata::Deserialize (const uint8_t* buffer, uint32_t size)
   const uint8_t* start = buffer;
   uint32_t desSize = size - 4;
 
+  EncodePending ();
   buffer = ReadFromRawU64 (m_packetUid, start, buffer, size);
   desSize -= 8;
 
@@ -74,6 +74,14 @@ class Trailer;
  * integers, and some others as variable-size 32-bit integers.
  * The variable-size 32 bit integers are stored using the uleb128
  * encoding.
+ *
+ * Most packets only ever see whole headers pushed and popped at their
+ * front.  Such headers are first recorded in a small fixed-size table
+ * of pending headers (type, size and chunk uid), which a copy of the
+ * metadata copies by value; a RemoveHeader of the last pending header
+ * just drops it.  The pending headers are encoded in the linked list
+ * only when another operation needs the list: trailers, fragmentation,
+ * aggregation, iteration with an ItemIterator or serialization.
  */
 class PacketMetadata 
 {
@@ -494,6 +502,17 @@ private:
     uint64_t packetUid;
   };
 
+#define PACKET_METADATA_PENDING_SIZE 8
+
+  /**
+   * \brief A whole header not yet encoded in the linked list.
+   */
+  struct PendingHeader {
+    uint32_t typeUid; //!< type of the header, as SmallItem::typeUid
+    uint32_t size;    //!< size of the header
+    uint16_t chunkUid; //!< chunk uid assigned when the header was added
+  };
+
   /**
    * \brief Class to hold all the metadata
    */
@@ -620,6 +639,13 @@ public:
    * \param size header serialized size
    */
   void DoAddHeader (uint32_t uid, uint32_t size);
+  /**
+   * \brief Encode the pending headers in the linked list.
+   *
+   * This does not change the logical content of the metadata, hence
+   * it is a const method.
+   */
+  void EncodePending (void) const;
   /**
    * \brief Check if the metadata state is ok
    * \returns true if the internal state is ok
@@ -661,7 +687,7 @@ public:
    */
   static void Deallocate (struct PacketMetadata::Data *data);
 
-  static DataFreeList m_freeList; //!< the metadata data storage
+  static thread_local DataFreeList m_freeList; //!< the metadata data storage, per thread
   static bool m_enable; //!< Enable the packet metadata
   static bool m_enableChecking; //!< Enable the packet metadata checking
 
@@ -672,8 +698,8 @@ public:
    */
   static bool m_metadataSkipped;
 
-  static uint32_t m_maxSize; //!< maximum metadata size
-  static uint16_t m_chunkUid; //!< Chunk Uid
+  static thread_local uint32_t m_maxSize; //!< maximum metadata size
+  static thread_local uint16_t m_chunkUid; //!< Chunk Uid
 
   struct Data *m_data; //!< Metadata storage
   /*
@@ -685,6 +711,9 @@ public:
   uint16_t m_tail; //!< list tail
   uint16_t m_used; //!< used portion
   uint64_t m_packetUid; //!< packet Uid
+  uint8_t m_nPending; //!< number of pending headers
+  /// headers added after the list head, innermost first
+  struct PendingHeader m_pending[PACKET_METADATA_PENDING_SIZE];
 };
 
 } // namespace ns3
@@ -696,7 +725,8 @@ PacketMetadata::PacketMetadata (uint64_t uid, uint32_t size)
     m_head (0xffff),
     m_tail (0xffff),
     m_used (0),
-    m_packetUid (uid)
+    m_packetUid (uid),
+    m_nPending (0)
 {
   memset (m_data->m_data, 0xff, 4);
   if (size > 0)
@@ -709,11 +739,16 @@ PacketMetadata::PacketMetadata (PacketMetadata const &o)
     m_head (o.m_head),
     m_tail (o.m_tail),
     m_used (o.m_used),
-    m_packetUid (o.m_packetUid)
+    m_packetUid (o.m_packetUid),
+    m_nPending (o.m_nPending)
 {
   NS_ASSERT (m_data != 0);
   NS_ASSERT (m_data->m_count < std::numeric_limits<uint32_t>::max());
   m_data->m_count++;
+  for (uint8_t i = 0; i < m_nPending; i++)
+    {
+      m_pending[i] = o.m_pending[i];
+    }
 }
 PacketMetadata &
 PacketMetadata::operator = (PacketMetadata const& o)
@@ -735,6 +770,11 @@ PacketMetadata::operator = (PacketMetadata const& o)
   m_tail = o.m_tail;
   m_used = o.m_used;
   m_packetUid = o.m_packetUid;
+  m_nPending = o.m_nPending;
+  for (uint8_t i = 0; i < m_nPending; i++)
+    {
+      m_pending[i] = o.m_pending[i];
+    }
   return *this;
 }
 PacketMetadata::~PacketMetadata ()
@@ -20,7 +20,7 @@
 
 /**
 \file   packet-tag-list.cc
-\brief  Implements a linked list of Packet tags, including copy-on-write semantics.
+\brief  Implements a flat array of Packet tags, including copy-on-write semantics.
 */
 
 #include "packet-tag-list.h"
@@ -29,275 +29,227 @@
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 #include <cstring>
+#include <algorithm>
+#include <limits>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("PacketTagList");
 
-PacketTagList::TagData *
-PacketTagList::CreateTagData (size_t dataSize)
+PacketTagList::TagBlock *
+PacketTagList::CreateBlock (uint16_t capacity, uint32_t dataSize)
 {
-  NS_ASSERT_MSG (dataSize
-                 < std::numeric_limits<decltype(TagData::size)>::max (),
-                 "Requested TagData size " << dataSize
-                 << " exceeds maximum "
-                 << std::numeric_limits<decltype(TagData::size)>::max () );
-
-  void * p = std::malloc (sizeof (TagData) + dataSize - 1);
-  // The matching frees are in RemoveAll and RemoveWriter
-
-  TagData * tag = new (p) TagData;
-  tag->size = dataSize;
-  return tag;
+  NS_ASSERT (capacity > 0);
+  size_t size = sizeof (TagBlock) + (capacity - 1) * sizeof (TagData) + dataSize;
+  // The matching free is in RemoveAll and MakeWritable
+  TagBlock * block = static_cast<TagBlock *> (std::malloc (size));
+  if (block == 0)
+    {
+      NS_FATAL_ERROR ("Could not allocate a PacketTagList block of " << size << " bytes");
+    }
+  block->count = 1;
+  block->nTags = 0;
+  block->capacity = capacity;
+  block->used = 0;
+  block->dataSize = dataSize;
+  return block;
 }
 
-bool
-PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
+uint8_t *
+PacketTagList::GetDataArea (TagBlock *block)
 {
-  TypeId tid = tag.GetInstanceTypeId ();
-  NS_LOG_FUNCTION (this << tid);
-  NS_LOG_INFO     ("looking for " << tid);
+  return reinterpret_cast<uint8_t *> (block->tags + block->capacity);
+}
 
-  // trivial case when list is empty
-  if (m_next == 0)
+PacketTagList::TagBlock *
+PacketTagList::MakeWritable (uint16_t extraTags, uint32_t extraBytes)
+{
+  NS_LOG_FUNCTION (this << extraTags << extraBytes);
+  if (m_block == 0)
     {
-      return false;
+      m_block = CreateBlock (std::max<uint16_t> (extraTags, 4),
+                             std::max<uint32_t> (extraBytes, 64));
+      return m_block;
     }
 
-  bool found = false;
-
-  struct TagData ** prevNext = &m_next; // previous node's next pointer
-  struct TagData  * cur      =  m_next; // cursor to current node
-  struct TagData  * it = 0;             // utility
-
-  // Search from the head of the list until we find tid or a merge
-  while (cur != 0)
+  uint32_t neededTags = m_block->nTags + extraTags;
+  uint32_t neededBytes = m_block->used + extraBytes;
+  if (m_block->count == 1
+      && neededTags <= m_block->capacity
+      && neededBytes <= m_block->dataSize)
     {
-      if (cur->count > 1)
-        {
-          // found merge
-          NS_LOG_INFO ("found initial merge before tid");
-          break;
-        }
-      else if (cur->tid == tid)
-        {
-          NS_LOG_INFO ("found tid before initial merge, calling writer");
-          found = (this->*Writer)(tag, true, cur, prevNext);
-          break;
-        }
-      else
-        {
-          // no merge or tid found yet, move on
-          prevNext = &cur->next;
-          cur      =  cur->next;
-        }
-    }  // while !found && !cow
-
-  // did we find it or run out of tags?
-  if (cur == 0 || found)
-    {
-      NS_LOG_INFO ("returning after header with found: " << found);
-      return found;
+      return m_block;
     }
 
-  // From here on out, we have to copy the list
-  // until we find tid, then link past it
-
-  // Before we do all that work, let's make sure tid really exists
-  for (it = cur; it != 0; it = it->next)
+  uint32_t capacity = m_block->capacity;
+  while (capacity < neededTags)
     {
-      if (it->tid == tid)
-        {
-          break;
-        }
+      capacity *= 2;
     }
-  if (it == 0)
+  NS_ASSERT_MSG (capacity <= std::numeric_limits<decltype (TagBlock::capacity)>::max (),
+                 "Too many packet tags: " << neededTags);
+  uint32_t dataSize = m_block->dataSize;
+  while (dataSize < neededBytes)
     {
-      // got to end of list without finding tid
-      NS_LOG_INFO ("tid not found after first merge");
-      return found;
+      dataSize *= 2;
     }
 
-  // At this point cur is a merge, but untested for tid
-  NS_ASSERT (cur != 0);
-  NS_ASSERT (cur->count > 1);
-
-  /*
-     Walk the remainder of the list, copying, until we find tid
-     As we put a copy of the cur node onto our list,
-     we move the merge point down the list.
-
-     Starting position                  End position
-       T1 is a merge                     T1.count decremented
-                                         T2 is a merge
-                                         T1' is a copy of T1
-
-          other                             other
-               \                                 \
-      Prev  ->  T1  ->  T2  -> ...                T1  ->  T2  -> ...
-           /   /                                         /|
-      pNext cur                         Prev  ->  T1' --/ |
-                                                     /    |
-                                                pNext   cur
-
-     When we reach tid, we link past it, decrement count, and we're done.
-  */
-
-  // Should normally check for null cur pointer,
-  // but since we know tid exists, we'll skip this test
-  while ( /* cur && */ cur->tid != tid)
+  NS_LOG_INFO ("copying block of " << m_block->nTags << " tags"
+               << (m_block->count > 1 ? " (shared)" : ""));
+  TagBlock * copy = CreateBlock (capacity, dataSize);
+  uint8_t * data = GetDataArea (copy);
+  for (uint16_t i = 0; i < m_block->nTags; ++i)
     {
-      NS_ASSERT (cur != 0);
-      NS_ASSERT (cur->count > 1);
-      cur->count--;                       // unmerge cur
-      struct TagData * copy = CreateTagData (cur->size);
-      copy->tid = cur->tid;
-      copy->count = 1;
-      copy->size = cur->size;
-      memcpy (copy->data, cur->data, copy->size);
-      copy->next = cur->next;             // merge into tail
-      copy->next->count++;                // mark new merge
-      *prevNext = copy;                   // point prior list at copy
-      prevNext = &copy->next;             // advance
-      cur      =  copy->next;
+      const TagData & src = m_block->tags[i];
+      TagData & dst = copy->tags[i];
+      dst.tid = src.tid;
+      dst.size = src.size;
+      dst.data = data + copy->used;
+      std::memcpy (dst.data, src.data, src.size);
+      copy->used += src.size;
     }
-  // Sanity check:
-  NS_ASSERT (cur != 0);                 // cur should be non-zero
-  NS_ASSERT (cur->tid == tid);          // cur->tid should be tid
-  NS_ASSERT (cur->count > 1);           // cur should be a merge
-
-  // link around tid, removing it from our list
-  found = (this->*Writer)(tag, false, cur, prevNext);
-  return found;
+  copy->nTags = m_block->nTags;
 
+  RemoveAll ();
+  m_block = copy;
+  return m_block;
 }
 
-bool
-PacketTagList::Remove (Tag & tag)
+int32_t
+PacketTagList::Find (TypeId tid) const
 {
-  return COWTraverse (tag, &PacketTagList::RemoveWriter);
+  if (m_block == 0)
+    {
+      return -1;
+    }
+  for (int32_t i = m_block->nTags - 1; i >= 0; --i)
+    {
+      if (m_block->tags[i].tid == tid)
+        {
+          return i;
+        }
+    }
+  return -1;
 }
 
-// COWWriter implementing Remove
-bool
-PacketTagList::RemoveWriter (Tag & tag, bool preMerge,
-                             struct PacketTagList::TagData  * cur,
-                             struct PacketTagList::TagData ** prevNext)
+void
+PacketTagList::Erase (uint16_t index)
 {
-  NS_LOG_FUNCTION_NOARGS ();
-
-  // found tid
-  bool found = true;
-  tag.Deserialize (TagBuffer (cur->data, cur->data + cur->size));
-  *prevNext = cur->next;            // link around cur
-
-  if (preMerge)
+  NS_LOG_FUNCTION (this << index);
+  NS_ASSERT (m_block != 0 && m_block->count == 1);
+  NS_ASSERT (index < m_block->nTags);
+
+  // close the gap in the data area
+  uint8_t * start = m_block->tags[index].data;
+  uint32_t size = m_block->tags[index].size;
+  uint8_t * end = GetDataArea (m_block) + m_block->used;
+  std::memmove (start, start + size, end - (start + size));
+  m_block->used -= size;
+
+  // close the gap in the slots
+  for (uint16_t i = index + 1; i < m_block->nTags; ++i)
     {
-      // found tid before first merge, so delete cur
-      cur->~TagData ();
-      std::free (cur);
+      m_block->tags[i - 1] = m_block->tags[i];
     }
-  else
+  m_block->nTags--;
+
+  for (uint16_t i = 0; i < m_block->nTags; ++i)
     {
-      // cur is always a merge at this point
-      // unmerge cur, since we linked around it already
-      cur->count--;
-      if (cur->next != 0)
+      if (m_block->tags[i].data > start)
         {
-          // there's a next, so make it a merge
-          cur->next->count++;
+          m_block->tags[i].data -= size;
         }
     }
-  return found;
 }
 
 bool
-PacketTagList::Replace (Tag & tag)
+PacketTagList::Remove (Tag & tag)
 {
-  bool found = COWTraverse (tag, &PacketTagList::ReplaceWriter);
-  if (!found)
+  TypeId tid = tag.GetInstanceTypeId ();
+  NS_LOG_FUNCTION (this << tid);
+  int32_t index = Find (tid);
+  if (index < 0)
     {
-      Add (tag);
+      return false;
     }
-  return found;
+  const TagData & cur = m_block->tags[index];
+  tag.Deserialize (TagBuffer (cur.data, cur.data + cur.size));
+  MakeWritable (0, 0);
+  Erase (index);
+  return true;
 }
 
-// COWWriter implementing Replace
 bool
-PacketTagList::ReplaceWriter (Tag & tag, bool preMerge,
-                              struct PacketTagList::TagData  * cur,
-                              struct PacketTagList::TagData ** prevNext)
+PacketTagList::Replace (Tag & tag)
 {
-  NS_LOG_FUNCTION_NOARGS ();
-
-  // found tid
-  bool found = true;
-  if (preMerge)
+  TypeId tid = tag.GetInstanceTypeId ();
+  NS_LOG_FUNCTION (this << tid);
+  int32_t index = Find (tid);
+  if (index < 0)
+    {
+      Add (tag);
+      return false;
+    }
+  MakeWritable (0, 0);
+  uint32_t size = tag.GetSerializedSize ();
+  if (size == m_block->tags[index].size)
     {
-      // found tid before first merge, so just rewrite
-      tag.Serialize (TagBuffer (cur->data, cur->data + cur->size));
+      // same size, so just rewrite
+      TagData & cur = m_block->tags[index];
+      tag.Serialize (TagBuffer (cur.data, cur.data + cur.size));
     }
   else
     {
-      // cur is always a merge at this point
-      // need to copy, replace, and link past cur
-      cur->count--;                     // unmerge cur
-      struct TagData * copy = CreateTagData (tag.GetSerializedSize ());
-      copy->tid = tag.GetInstanceTypeId ();
-      copy->count = 1;
-      tag.Serialize (TagBuffer (copy->data, copy->data + copy->size));
-      copy->next = cur->next;           // merge into tail
-      if (copy->next != 0)
-        {
-          copy->next->count++;          // mark new merge
-        }
-      *prevNext = copy;                 // point prior list at copy
+      Erase (index);
+      Add (tag);
     }
-  return found;
+  return true;
 }
 
 void
 PacketTagList::Add (const Tag &tag) const
 {
-  NS_LOG_FUNCTION (this << tag.GetInstanceTypeId ());
+  TypeId tid = tag.GetInstanceTypeId ();
+  NS_LOG_FUNCTION (this << tid);
   // ensure this id was not yet added
-  for (struct TagData *cur = m_next; cur != 0; cur = cur->next)
-    {
-      NS_ASSERT_MSG (cur->tid != tag.GetInstanceTypeId (),
-                     "Error: cannot add the same kind of tag twice.");
-    }
-  struct TagData * head = CreateTagData (tag.GetSerializedSize ());
-  head->count = 1;
-  head->next = 0;
-  head->tid = tag.GetInstanceTypeId ();
-  head->next = m_next;
-  tag.Serialize (TagBuffer (head->data, head->data + head->size));
-
-  const_cast<PacketTagList *> (this)->m_next = head;
+  NS_ASSERT_MSG (Find (tid) < 0, "Error: cannot add the same kind of tag twice.");
+
+  uint32_t size = tag.GetSerializedSize ();
+  TagBlock * block = const_cast<PacketTagList *> (this)->MakeWritable (1, size);
+  TagData & slot = block->tags[block->nTags];
+  slot.tid = tid;
+  slot.size = size;
+  slot.data = GetDataArea (block) + block->used;
+  tag.Serialize (TagBuffer (slot.data, slot.data + slot.size));
+  block->used += size;
+  block->nTags++;
 }
 
 bool
 PacketTagList::Peek (Tag &tag) const
 {
   NS_LOG_FUNCTION (this << tag.GetInstanceTypeId ());
-  TypeId tid = tag.GetInstanceTypeId ();
-  for (struct TagData *cur = m_next; cur != 0; cur = cur->next)
+  int32_t index = Find (tag.GetInstanceTypeId ());
+  if (index < 0)
     {
-      if (cur->tid == tid)
-        {
-          /* found tag */
-          tag.Deserialize (TagBuffer (cur->data, cur->data + cur->size));
-          return true;
-        }
+      /* no tag found */
+      return false;
     }
-  /* no tag found */
-  return false;
+  const TagData & cur = m_block->tags[index];
+  tag.Deserialize (TagBuffer (cur.data, cur.data + cur.size));
+  return true;
 }
 
 const struct PacketTagList::TagData *
-PacketTagList::Head (void) const
+PacketTagList::Begin (void) const
 {
-  return m_next;
+  return m_block == 0 ? 0 : m_block->tags;
+}
+
+const struct PacketTagList::TagData *
+PacketTagList::End (void) const
+{
+  return m_block == 0 ? 0 : m_block->tags + m_block->nTags;
 }
 
 uint32_t
@@ -309,8 +261,9 @@ PacketTagList::GetSerializedSize (void) const
 
   size = 4; // numberOfTags
 
-  for (struct TagData *cur = m_next; cur != 0; cur = cur->next)
+  for (const TagData *cur = End (); cur != Begin (); )
     {
+      --cur;
       size += 4; // TagData -> size
 
       // TypeId hash; ensure size is multiple of 4 bytes
@@ -346,8 +299,10 @@ PacketTagList::Serialize (uint32_t* buffer, uint32_t maxSize) const
       return 0;
     }
 
-  for (struct TagData *cur = m_next; cur != 0; cur = cur->next)
+  // Most recent tag first
+  for (const TagData *cur = End (); cur != Begin (); )
     {
+      --cur;
       if (size + 4 <= maxSize)
         {
           *p++ = cur->size;
@@ -407,7 +362,14 @@ PacketTagList::Deserialize (const uint32_t* buffer, uint32_t size)
 
   NS_LOG_INFO("Deserializing number of tags " << numberOfTags);
 
-  struct TagData * prevTag = 0;
+  RemoveAll ();
+  if (numberOfTags > 0)
+    {
+      // the serialized size is an upper bound on the data we need
+      m_block = CreateBlock (numberOfTags, size);
+      m_block->nTags = numberOfTags;
+    }
+
   for (uint32_t i = 0; i < numberOfTags; ++i)
     {
       NS_ASSERT (sizeCheck >= 4);
@@ -425,30 +387,20 @@ PacketTagList::Deserialize (const uint32_t* buffer, uint32_t size)
 
       NS_LOG_INFO ("Deserializing tag of type " << tid);
 
-      struct TagData * newTag = CreateTagData (tagSize);
-      newTag->count = 1;
-      newTag->next = 0;
-      newTag->tid = tid;
+      // Most recent tag was serialized first
+      TagData & newTag = m_block->tags[numberOfTags - 1 - i];
+      newTag.tid = tid;
+      newTag.size = tagSize;
+      newTag.data = GetDataArea (m_block) + m_block->used;
 
       NS_ASSERT (sizeCheck >= tagSize);
-      memcpy (newTag->data, p, tagSize);
+      memcpy (newTag.data, p, tagSize);
+      m_block->used += tagSize;
 
       // ensure 4 byte boundary
       uint32_t tagWordSize = (tagSize+3) & (~3);
       p += tagWordSize / 4;
       sizeCheck -= tagWordSize;
-
-      // Set link list pointers.
-      if (i==0)
-        {
-          m_next = newTag;
-        }
-      else
-        {
-          prevTag->next = newTag;
-        }
-
-      prevTag = newTag;
     }
 
   NS_ASSERT (sizeCheck == 0);
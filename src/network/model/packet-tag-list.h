@@ -22,10 +22,11 @@
 
 /**
 \file   packet-tag-list.h
-\brief  Defines a linked list of Packet tags, including copy-on-write semantics.
+\brief  Defines a flat array of Packet tags, including copy-on-write semantics.
 */
 
 #include <stdint.h>
+#include <cstdlib>
 #include <ostream>
 #include "ns3/type-id.h"
 
@@ -43,88 +44,45 @@ class Tag;
  *
  * \internal
  *
- * The implementation of this class is a bit tricky.  Refer to this
- * diagram in the discussion that follows.
+ * All the tags of a packet live in a single contiguous, reference
+ * counted TagBlock:
  *
- * \dot
- *    digraph {
- *        rankdir = "LR";
- *        clusterrank = local;
- *        node [ shape = record, fontname="FreeSans", fontsize="10" ];
- *        oth  [ label="<l> Other branch | <n> next | <c> ..." ];
- *        PTL1 [ label="<l> PacketTagList A | <n> m_next" , shape=Mrecord];
- *        PTL2 [ label="<l> PacketTagList B | <n> m_next" , shape=Mrecord];
- *        oth:n  -> T7:l ;
- *        PTL2:n -> T6:l ;
- *        PTL1:n -> T5:l ;
- *        T1   [ label="<l> T1  | <n> next | <c> count = 1" ];
- *        T2   [ label="<l> T2  | <n> next | <c> count = 1" ];
- *        T3   [ label="<l> T3  | <n> next | <c> count = 2" ];
- *        T4   [ label="<l> T4  | <n> next | <c> count = 1" ];
- *        T5   [ label="<l> T5  | <n> next | <c> count = 2" ];
- *        T6   [ label="<l> T6  | <n> next | <c> count = 1" ];
- *        T7   [ label="<l> T7  | <n> next | <c> count = 1" ];
- *        NULL [ label="0", shape = ellipse ];
- *        subgraph cluster_list {
- *          penwidth = 0;
- *          T6:n -> T5:l ;
- *          T5:n -> T4:l ;
- *          T4:n -> T3:l ;
- *          T7:n -> T3:l ;
- *          T3:n -> T2:l ;
- *          T2:n -> T1:l ;
- *          T1:n -> NULL ;
- *        };
- *      }
- * \enddot
+ * \verbatim
+     +-------+--------+----------+------+-----+------+------+-----+---------+
+     | count | nTags  | capacity | used | ... |  T0  |  T1  | ... |  data   |
+     +-------+--------+----------+------+-----+------+------+-----+---------+
+                                             \___ TagData slots _/ \_ bytes _/
+   \endverbatim
  *
- *   - Tags are stored in serialized form in a tree of TagData
- *     structures. (<tt>T1-T7</tt> in the diagram)
+ *   - Each TagData slot holds the TypeId and size of one tag, and
+ *     points into the data area at the end of the same block, where the
+ *     tag is stored in serialized form.  Slots are in insertion order;
+ *     the most recent tag is the last slot.
  *
- *   - Each TagData points (\c next pointers in the diagram)
- *     toward the root of the tree, which is a null pointer.
- *
- *   - \c count is the number of incoming pointers to this
- *     TagData.  Branch points, where branches merge or join, have
- *     <tt>count \> 1</tt> (\c T3, \c T5); successive links along
- *     a branch have <tt>count = 1</tt> (\c T1, \c T2, \c T4, \c T6, \c T7).
- *
- *   - Each PacketTagList points to a specific TagData,
- *     which is the most recent Tag added to the packet. (<tt>T5-T7</tt>)
- *
- *   - Conceptually, therefore, each Packet has a PacketTagList which
- *     points to a singly-linked list of TagData.
+ *   - A typical packet carries a handful of small tags, so a lookup is
+ *     a linear scan over a few adjacent slots, and a single allocation
+ *     holds the whole list.
  *
  * \par <b> Copy-on-write </b> is implemented as follows:
  *
- *   - #Add prepends the new tag to the list (growing that branch of the tree,
- *     as \c T6). This is a constant time operation, and does not affect
- *     any other #PacketTagList's, hence this is a \c const function.
- *
  *   - Copy constructor (PacketTagList(const PacketTagList & o))
  *     and assignment (#operator=(const PacketTagList & o))
- *     simply join the tree at the same place as the original
- *     PacketTagList \c o, incrementing the \c count.
- *     For assignment, the old branch is deleted, up to
- *     the first branch point, which has its \c count decremented.
- *     (PacketTagList \c B started as a copy of PacketTagList \c A,
- *     before \c T6 was added to \c B).
+ *     share the block of \c o, incrementing its \c count.  Copying a
+ *     Packet therefore stays a constant time operation.
+ *
+ *   - #Add, #Remove and #Replace first make sure this PacketTagList is
+ *     the only owner of its block (<tt>count == 1</tt>), copying the
+ *     block otherwise, and then modify the block in place.  #Remove
+ *     compacts the slots and the data area, so the block never has holes.
  *
- *   - #Remove and #Replace are a little tricky, depending on where the
- *     target tag is found relative to the first branch point:
- *     - \e Target before <em> the first branch point: </em> \n
- *       The target is just dealt with in place (linked around and deleted,
- *       in the case of #Remove; rewritten in the case of #Replace).
- *     - \e Target at or after <em> the first branch point: </em> \n
- *       The portion of the list between the first branch and the target is
- *       shared. This portion is copied before the #Remove or #Replace is
- *       performed.
+ *   - #Add is a \c const function, since it does not affect
+ *     any other PacketTagList's.
  */
 class PacketTagList 
 {
 public:
   /**
-   * Tree node for sharing serialized tags.
+   * Slot describing one serialized tag.
    *
    * See PacketTagList for a discussion of the data structure.
    *
@@ -133,18 +91,12 @@ public:
    * PacketTagIterator::Item::GetTag() needs the data and size values.
    * The Item nested class can't be forward declared, so friending isn't
    * possible.
-   *
-   * We use placement new so we can allocate enough room for the Tag
-   * type which will be serialized into data.  See Object::Aggregates
-   * for a similar construction.
    */
   struct TagData
   {
-    struct TagData * next;      /**< Pointer to next in list */
-    uint32_t count;             /**< Number of incoming links */
     TypeId tid;                 /**< Type of the tag serialized into #data */
     uint32_t size;              /**< Size of the \c data buffer */
-    uint8_t data[1];            /**< Serialization buffer */
+    uint8_t *data;              /**< Serialization buffer, in the data area of the block */
   };  /* struct TagData */
 
   /**
@@ -156,8 +108,8 @@ public:
    *
    * \param [in] o The PacketTagList to copy.
    *
-   * This makes a light-weight copy by #RemoveAll, then
-   * pointing to the same \ref TagData as \pname{o}.
+   * This makes a light-weight copy by sharing the tag block
+   * of \pname{o}.
    */
   inline PacketTagList (PacketTagList const &o);
   /**
@@ -167,18 +119,18 @@ public:
    * \returns the copied object
    *
    * This makes a light-weight copy by #RemoveAll, then
-   * pointing to the same \ref TagData as \pname{o}.
+   * sharing the tag block of \pname{o}.
    */
   inline PacketTagList &operator = (PacketTagList const &o);
   /**
    * Destructor
    *
-   * #RemoveAll's the tags up to the first merge.
+   * #RemoveAll's the tags.
    */
   inline ~PacketTagList ();
 
   /**
-   * Add a tag to the head of this branch.
+   * Add a tag to the list.
    *
    * \param [in] tag The tag to add
    */
@@ -210,13 +162,17 @@ public:
    */
   bool Peek (Tag &tag) const;
   /**
-   * Remove all tags from this list (up to the first merge).
+   * Remove all tags from this list, releasing our reference to the block.
    */
   inline void RemoveAll (void);
   /**
-   * \returns pointer to head of tag list
+   * \returns pointer to the first (oldest) tag slot
+   */
+  const struct PacketTagList::TagData *Begin (void) const;
+  /**
+   * \returns pointer past the last (most recent) tag slot
    */
-  const struct PacketTagList::TagData *Head (void) const;
+  const struct PacketTagList::TagData *End (void) const;
   /**
    * Returns number of bytes required for packet serialization.
    *
@@ -244,68 +200,65 @@ public:
 
 private:
   /**
-   * Allocate and construct a TagData struct, sizing the data area
-   * large enough to serialize dataSize bytes from a Tag.
+   * Shared storage for the tags of one or more PacketTagList's.
    *
-   * \param [in] dataSize The serialized size of the Tag.
-   * \returns The newly constructed TagData object.
+   * We use malloc so we can allocate enough room for the slots and the
+   * serialized tags in one chunk.  See Object::Aggregates for a similar
+   * construction.
    */
-  static
-  TagData * CreateTagData (size_t dataSize);
-  
+  struct TagBlock
+  {
+    uint32_t count;             /**< Number of PacketTagList's sharing this block */
+    uint16_t nTags;             /**< Number of slots in use */
+    uint16_t capacity;          /**< Number of slots allocated */
+    uint32_t used;              /**< Number of bytes in use in the data area */
+    uint32_t dataSize;          /**< Size of the data area */
+    TagData tags[1];            /**< Tag slots, followed by the data area */
+  };  /* struct TagBlock */
+
   /**
-   * Typedef of method function pointer for copy-on-write operations
+   * Allocate a TagBlock with room for \pname{capacity} slots and
+   * \pname{dataSize} bytes of serialized tags.
    *
-   * \param [in] tag The tag type to operate on.
-   * \param [in] preMerge True if \pname{tag} was found before the first merge,
-   *             false otherwise.
-   * \param [in] cur Pointer to the tag.
-   * \param [in] prevNext Pointer to the struct TagData.next pointer
-   *          pointing to \pname{cur}.
-   * \returns True if operation successful, false otherwise
+   * \param [in] capacity The number of slots.
+   * \param [in] dataSize The size of the data area.
+   * \returns The newly allocated, empty block, with a count of 1.
+   */
+  static TagBlock * CreateBlock (uint16_t capacity, uint32_t dataSize);
+  /**
+   * \param [in] block The block.
+   * \returns The start of the data area of \pname{block}.
    */
-  typedef bool (PacketTagList::*COWWriter)
-    (Tag       & tag, bool         preMerge,
-    struct TagData * cur, struct TagData ** prevNext);
+  static uint8_t * GetDataArea (TagBlock *block);
   /**
-   * Traverse the list implementing copy-on-write, using \pname{Writer}.
+   * Make sure we are the only owner of our block, and that it has room
+   * for \pname{extraTags} more tags and \pname{extraBytes} more bytes,
+   * copying or growing the block as needed.
    *
-   * \param [in] tag The tag type to operate on.
-   * \param [in] Writer The copy-on-write function to use.
-   * \returns True if \pname{tag} found, false otherwise.
+   * \param [in] extraTags The number of slots to reserve.
+   * \param [in] extraBytes The number of data bytes to reserve.
+   * \returns The writable block.
    */
-  bool COWTraverse   (Tag & tag, PacketTagList::COWWriter Writer);
+  TagBlock * MakeWritable (uint16_t extraTags, uint32_t extraBytes);
   /**
-   * Copy-on-write implementing Remove.
+   * Find the slot of a tag type.
    *
-   * \param [in] tag The target tag type to remove.
-   * \param [in] preMerge True if \pname{tag} was found before the first merge,
-   *             false otherwise.
-   * \param [in] cur Pointer to the tag.
-   * \param [in] prevNext Pointer to the struct TagData.next pointer
-   *          pointing to \pname{cur}.
-   * \returns True, since tag will definitely be removed.
+   * \param [in] tid The tag type to look for.
+   * \returns The index of the slot, or -1 if not found.
    */
-  bool RemoveWriter  (Tag & tag, bool preMerge,
-                      struct TagData * cur, struct TagData ** prevNext);
+  int32_t Find (TypeId tid) const;
   /**
-   * Copy-on-write implementing Replace
+   * Erase a slot from our (writable) block, compacting the slots and
+   * the data area.
    *
-   * \param [in] tag The target tag type to replace
-   * \param [in] preMerge True if \pname{tag} was found before the first merge,
-   *          false otherwise.
-   * \param [in] cur Pointer to the tag
-   * \param [in] prevNext Pointer to the struct TagData.next pointer
-   *          pointing to \pname{cur}.
-   * \returns True, since tag value will definitely be replaced.
+   * \param [in] index The index of the slot to erase.
    */
-  bool ReplaceWriter (Tag & tag, bool preMerge,
-                      struct TagData * cur, struct TagData ** prevNext);
+  void Erase (uint16_t index);
 
   /**
-   * Pointer to first \ref TagData on the list
+   * Pointer to the shared tag block, or null if there are no tags.
    */
-  struct TagData *m_next;
+  TagBlock *m_block;
 };
 
 } // namespace ns3
@@ -317,16 +270,16 @@ private:
 namespace ns3 {
 
 PacketTagList::PacketTagList ()
-  : m_next ()
+  : m_block (0)
 {
 }
 
 PacketTagList::PacketTagList (PacketTagList const &o)
-  : m_next (o.m_next)
+  : m_block (o.m_block)
 {
-  if (m_next != 0)
+  if (m_block != 0)
     {
-      m_next->count++;
+      m_block->count++;
     }
 }
 
@@ -334,15 +287,15 @@ PacketTagList &
 PacketTagList::operator = (PacketTagList const &o)
 {
   // self assignment
-  if (m_next == o.m_next) 
+  if (m_block == o.m_block) 
     {
       return *this;
     }
   RemoveAll ();
-  m_next = o.m_next;
-  if (m_next != 0) 
+  m_block = o.m_block;
+  if (m_block != 0) 
     {
-      m_next->count++;
+      m_block->count++;
     }
   return *this;
 }
@@ -355,27 +308,15 @@ PacketTagList::~PacketTagList ()
 void
 PacketTagList::RemoveAll (void)
 {
-  struct TagData *prev = 0;
-  for (struct TagData *cur = m_next; cur != 0; cur = cur->next)
+  if (m_block != 0)
     {
-      cur->count--;
-      if (cur->count > 0) 
+      m_block->count--;
+      if (m_block->count == 0)
         {
-          break;
+          std::free (m_block);
         }
-      if (prev != 0) 
-        {
-          prev->~TagData ();
-          std::free (prev);
-        }
-      prev = cur;
-    }
-  if (prev != 0) 
-    {
-      prev->~TagData ();
-      std::free (prev);
+      m_block = 0;
     }
-  m_next = 0;
 }
 
 } // namespace ns3
@@ -21,6 +21,7 @@
 #define PACKET_H
 
 #include <stdint.h>
+#include <atomic>
 #include "buffer.h"
 #include "header.h"
 #include "trailer.h"
@@ -173,9 +174,12 @@ private:
   friend class Packet;
   /**
    * Constructor
-   * \param head head of the items
+   * \param begin first (oldest) tag slot
+   * \param end past the last (most recent) tag slot
    */
-  PacketTagIterator (const struct PacketTagList::TagData *head);
+  PacketTagIterator (const struct PacketTagList::TagData *begin,
+                     const struct PacketTagList::TagData *end);
+  const struct PacketTagList::TagData *m_begin;    //!< first tag slot of the packet
   const struct PacketTagList::TagData *m_current;  //!< actual position over the set of tags in a packet
 };
 
@@ -787,7 +791,7 @@ private:
   /* Please see comments above about nix-vector */
   Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
-  static uint32_t m_globalUid; //!< Global counter of packets Uid
+  static std::atomic<uint32_t> m_globalUid; //!< Global counter of packets Uid
 };
 
 /**
@@ -948,4 +948,62 @@ SocketIpv6TclassTag::Print (std::ostream &os) const
   os << "IPV6_TCLASS = " << m_ipv6Tclass;
 }
 
+SocketGsoTag::SocketGsoTag ()
+  : m_segmentSize (0)
+{
+}
+
+void
+SocketGsoTag::SetSegmentSize (uint16_t size)
+{
+  m_segmentSize = size;
+}
+
+uint16_t
+SocketGsoTag::GetSegmentSize (void) const
+{
+  return m_segmentSize;
+}
+
+TypeId
+SocketGsoTag::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SocketGsoTag")
+    .SetParent<Tag> ()
+    .SetGroupName("Network")
+    .AddConstructor<SocketGsoTag> ()
+    ;
+  return tid;
+}
+
+TypeId
+SocketGsoTag::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+uint32_t
+SocketGsoTag::GetSerializedSize (void) const
+{
+  return sizeof (uint16_t);
+}
+
+void
+SocketGsoTag::Serialize (TagBuffer i) const
+{
+  i.WriteU16 (m_segmentSize);
+}
+
+void
+SocketGsoTag::Deserialize (TagBuffer i)
+{
+  m_segmentSize = i.ReadU16 ();
+}
+
+void
+SocketGsoTag::Print (std::ostream &os) const
+{
+  os << "GSO_SIZE = " << m_segmentSize;
+}
+
 } // namespace ns3
@@ -1395,6 +1395,57 @@ private:
   uint8_t m_ipv6Tclass; //!< the Tclass carried by the tag
 };
 
+/**
+ * \brief indicates that the packet is a generic segmentation offload
+ * (GSO) super-segment.
+ *
+ * The payload of a super-segment is larger than the MTU: the packet goes
+ * through the network layer and the queue disc as a whole, and it is split
+ * into segments of the given size right before being passed to the device.
+ */
+class SocketGsoTag : public Tag
+{
+public:
+  SocketGsoTag ();
+
+  /**
+   * \brief Set the size of the segments to put on the wire
+   *
+   * \param size the segment payload size
+   */
+  void SetSegmentSize (uint16_t size);
+
+  /**
+   * \brief Get the size of the segments to put on the wire
+   *
+   * \returns the segment payload size
+   */
+  uint16_t GetSegmentSize (void) const;
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  // inherited function, no need to doc.
+  virtual TypeId GetInstanceTypeId (void) const;
+
+  // inherited function, no need to doc.
+  virtual uint32_t GetSerializedSize (void) const;
+
+  // inherited function, no need to doc.
+  virtual void Serialize (TagBuffer i) const;
+
+  // inherited function, no need to doc.
+  virtual void Deserialize (TagBuffer i);
+
+  // inherited function, no need to doc.
+  virtual void Print (std::ostream &os) const;
+private:
+  uint16_t m_segmentSize;  //!< the segment size carried by the tag
+};
+
 } // namespace ns3
 
 #endif /* NS3_SOCKET_H */
@@ -387,6 +387,25 @@ BufferTest::DoRun (void)
   val2 <<= 8;
   val2 |= i.ReadU8 ();
   NS_TEST_ASSERT_MSG_EQ (val1, val2, "Bad ReadNtohU16()");
+
+  // Merging fragments of a zero-filled payload keeps the zero area virtual
+  buffer = Buffer (1000);
+  buffer.AddAtStart (2);
+  i = buffer.Begin ();
+  i.WriteU8 (0x1);
+  i.WriteU8 (0x2);
+  frag0 = buffer.CreateFragment (0, 300);
+  frag1 = buffer.CreateFragment (300, 702);
+  frag0.AddAtEnd (frag1);
+  NS_TEST_ASSERT_MSG_EQ (frag0.GetSize (), 1002, "Bad merged size");
+  NS_TEST_ASSERT_MSG_EQ (frag0.GetSerializedSize (), 16, "Zero area was materialized");
+  ENSURE_WRITTEN_BYTES (frag0.CreateFragment (0, 4), 4, 0x1, 0x2, 0x00, 0x00);
+  ENSURE_WRITTEN_BYTES (frag0.CreateFragment (998, 4), 4, 0x00, 0x00, 0x00, 0x00);
+  ENSURE_WRITTEN_BYTES (buffer.CreateFragment (0, 3), 3, 0x1, 0x2, 0x00);
+  other = Buffer ();
+  other.AddAtEnd (frag1);
+  NS_TEST_ASSERT_MSG_EQ (other.GetSize (), 702, "Bad size after append to empty buffer");
+  NS_TEST_ASSERT_MSG_EQ (other.GetSerializedSize (), 12, "Zero area was materialized");
 }
 
 /**
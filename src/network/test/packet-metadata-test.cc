@@ -900,6 +900,34 @@ PacketMetadataTest::DoRun (void)
                                  p3->GetSize ());
   delete [] buf;
   NS_TEST_EXPECT_MSG_EQ (msg, std::string ("hello world"), "Could not find original data in received packet");
+
+  // Copies diverging while their headers are still pending, and more
+  // headers than fit in the pending table.
+  p = Create<Packet> (10);
+  ADD_HEADER (p, 1);
+  ADD_HEADER (p, 2);
+  p1 = p->Copy ();
+  REM_HEADER (p1, 2);
+  ADD_HEADER (p1, 3);
+  ADD_HEADER (p, 4);
+  CHECK_HISTORY (p1, 3, 3, 1, 10);
+  CHECK_HISTORY (p, 4, 4, 2, 1, 10);
+  REM_HEADER (p, 4);
+  REM_HEADER (p, 2);
+  CHECK_HISTORY (p, 2, 1, 10);
+  p = Create<Packet> (10);
+  ADD_HEADER (p, 1);
+  ADD_HEADER (p, 2);
+  ADD_HEADER (p, 3);
+  ADD_HEADER (p, 4);
+  ADD_HEADER (p, 5);
+  ADD_HEADER (p, 6);
+  ADD_HEADER (p, 7);
+  ADD_HEADER (p, 8);
+  ADD_HEADER (p, 9);
+  REM_HEADER (p, 9);
+  REM_HEADER (p, 8);
+  CHECK_HISTORY (p, 8, 7, 6, 5, 4, 3, 2, 1, 10);
 }
 
 
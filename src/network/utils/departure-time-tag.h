@@ -0,0 +1,73 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef DEPARTURE_TIME_TAG_H
+#define DEPARTURE_TIME_TAG_H
+
+#include "ns3/tag.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup network
+ *
+ * \brief Earliest departure time of a packet.
+ *
+ * Senders that pace their traffic in Earliest Departure Time (EDT) mode
+ * stamp each packet with the time before which it must not leave the
+ * node, instead of holding it back themselves. A time-aware stage further
+ * down the stack (e.g., a queue disc) releases the packet when the
+ * stamped time is reached.
+ */
+class DepartureTimeTag : public Tag
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (TagBuffer buf) const;
+  virtual void Deserialize (TagBuffer buf);
+  virtual void Print (std::ostream &os) const;
+  DepartureTimeTag ();
+
+  /**
+   *  Constructs a DepartureTimeTag with the given departure time
+   *
+   *  \param departure earliest departure time
+   */
+  DepartureTimeTag (Time departure);
+  /**
+   *  Sets the earliest departure time
+   *  \param departure earliest departure time
+   */
+  void SetDepartureTime (Time departure);
+  /**
+   *  Gets the earliest departure time
+   *  \returns the earliest departure time
+   */
+  Time GetDepartureTime (void) const;
+private:
+  Time m_departure; //!< Earliest departure time
+};
+
+} // namespace ns3
+
+#endif /* DEPARTURE_TIME_TAG_H */
@@ -146,4 +146,10 @@ QueueDiscItem::Hash (uint32_t perturbation) const
   return 0;
 }
 
+Ptr<QueueDiscItem>
+QueueDiscItem::SplitSegment (void)
+{
+  return 0;
+}
+
 } // namespace ns3
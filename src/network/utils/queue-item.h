@@ -226,6 +226,19 @@ public:
    */
   virtual uint32_t Hash (uint32_t perturbation = 0) const;
 
+  /**
+   * \brief Split the first segment off a generic segmentation offload (GSO) super-segment
+   *
+   * A super-segment (see SocketGsoTag) is queued as a single item and split
+   * into the segments to put on the wire right before being passed to the
+   * device. This method must be called after AddHeader. It returns an item
+   * carrying the first segment, header included, and this item keeps the
+   * rest of the data. The default implementation never splits.
+   *
+   * \return the first segment, or 0 if this item is ready for the device
+   */
+  virtual Ptr<QueueDiscItem> SplitSegment (void);
+
 private:
   /**
    * \brief Default constructor
@@ -22,6 +22,7 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
+#include "ns3/node.h"
 
 namespace ns3 {
 
@@ -80,6 +81,20 @@ PointToPointChannel::Attach (Ptr<PointToPointNetDevice> device)
       m_link[1].m_dst = m_link[0].m_src;
       m_link[0].m_state = IDLE;
       m_link[1].m_state = IDLE;
+      CacheDestination (0);
+      CacheDestination (1);
+    }
+}
+
+void
+PointToPointChannel::CacheDestination (uint32_t wire)
+{
+  Ptr<Node> srcNode = m_link[wire].m_src->GetNode ();
+  Ptr<Node> dstNode = m_link[wire].m_dst->GetNode ();
+  if (srcNode != 0 && dstNode != 0)
+    {
+      m_link[wire].m_dstContext = dstNode->GetId ();
+      m_link[wire].m_remote = dstNode->GetSystemId () != srcNode->GetSystemId ();
     }
 }
 
@@ -96,8 +111,31 @@ PointToPointChannel::TransmitStart (
   NS_ASSERT (m_link[1].m_state != INITIALIZING);
 
   uint32_t wire = src == m_link[0].m_src ? 0 : 1;
+  if (m_link[wire].m_dstContext == 0xffffffff)
+    {
+      // The devices were attached to the channel before their nodes.
+      CacheDestination (wire);
+    }
 
-  Simulator::ScheduleWithContext (m_link[wire].m_dst->GetNode ()->GetId (),
+  if (m_link[wire].m_remote)
+    {
+      // The two ends may run on different threads: they must not share
+      // the packet buffers, nor any reference count, so hand over the
+      // packet in serialized form and the device by address.
+      std::vector<uint8_t> buffer (p->GetSerializedSize ());
+      uint32_t ok = p->Serialize (buffer.data (), buffer.size ());
+      NS_ASSERT (ok);
+      Simulator::ScheduleWithContext (m_link[wire].m_dstContext,
+                                      txTime + m_delay, &PointToPointChannel::ReceiveSerialized,
+                                      PeekPointer (m_link[wire].m_dst), buffer);
+      if (!m_txrxPointToPoint.IsEmpty ())
+        {
+          m_txrxPointToPoint (p, src, m_link[wire].m_dst, txTime, txTime + m_delay);
+        }
+      return true;
+    }
+
+  Simulator::ScheduleWithContext (m_link[wire].m_dstContext,
                                   txTime + m_delay, &PointToPointNetDevice::Receive,
                                   m_link[wire].m_dst, p->Copy ());
 
@@ -106,6 +144,14 @@ PointToPointChannel::TransmitStart (
   return true;
 }
 
+void
+PointToPointChannel::ReceiveSerialized (PointToPointNetDevice *dst, std::vector<uint8_t> buffer)
+{
+  NS_LOG_FUNCTION (dst << buffer.size ());
+  Ptr<Packet> packet = Create<Packet> (buffer.data (), buffer.size (), true);
+  dst->Receive (packet);
+}
+
 std::size_t
 PointToPointChannel::GetNDevices (void) const
 {
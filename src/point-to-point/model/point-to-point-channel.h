@@ -20,6 +20,7 @@
 #define POINT_TO_POINT_CHANNEL_H
 
 #include <list>
+#include <vector>
 #include "ns3/channel.h"
 #include "ns3/ptr.h"
 #include "ns3/nstime.h"
@@ -146,6 +147,13 @@ protected:
      Time duration, Time lastBitTime);
                     
 private:
+  /**
+   * \brief Deliver a packet sent by a device of another system.
+   * \param dst The receiving device
+   * \param buffer The serialized packet
+   */
+  static void ReceiveSerialized (PointToPointNetDevice *dst, std::vector<uint8_t> buffer);
+
   /** Each point to point link has exactly two net devices. */
   static const std::size_t N_DEVICES = 2;
 
@@ -194,13 +202,22 @@ public:
     /** \brief Create the link, it will be in INITIALIZING state
      *
      */
-    Link() : m_state (INITIALIZING), m_src (0), m_dst (0) {}
+    Link() : m_state (INITIALIZING), m_src (0), m_dst (0), m_dstContext (0xffffffff), m_remote (false) {}
 
     WireState                  m_state; //!< State of the link
     Ptr<PointToPointNetDevice> m_src;   //!< First NetDevice
     Ptr<PointToPointNetDevice> m_dst;   //!< Second NetDevice
+    uint32_t                   m_dstContext; //!< Id of the node of m_dst, 0xffffffff until known
+    bool                       m_remote; //!< Whether the nodes have different system ids
   };
 
+  /**
+   * \brief Record the destination node of a wire, once the devices
+   * are attached to their nodes
+   * \param wire The wire
+   */
+  void CacheDestination (uint32_t wire);
+
   Link    m_link[N_DEVICES]; //!< Link model
 };
 
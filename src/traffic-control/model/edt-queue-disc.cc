@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include "ns3/log.h"
+#include "edt-queue-disc.h"
+#include "ns3/object-factory.h"
+#include "ns3/drop-tail-queue.h"
+#include "ns3/departure-time-tag.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EdtQueueDisc");
+
+NS_OBJECT_ENSURE_REGISTERED (EdtQueueDisc);
+
+TypeId EdtQueueDisc::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::EdtQueueDisc")
+    .SetParent<QueueDisc> ()
+    .SetGroupName ("TrafficControl")
+    .AddConstructor<EdtQueueDisc> ()
+    .AddAttribute ("MaxSize",
+                   "The max queue size",
+                   QueueSizeValue (QueueSize ("10000p")),
+                   MakeQueueSizeAccessor (&QueueDisc::SetMaxSize,
+                                          &QueueDisc::GetMaxSize),
+                   MakeQueueSizeChecker ())
+    .AddAttribute ("Horizon",
+                   "Packets whose departure time is further than this in the future are dropped",
+                   TimeValue (Seconds (10)),
+                   MakeTimeAccessor (&EdtQueueDisc::m_horizon),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+EdtQueueDisc::EdtQueueDisc ()
+  : QueueDisc (QueueDiscSizePolicy::SINGLE_INTERNAL_QUEUE)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+EdtQueueDisc::~EdtQueueDisc ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+EdtQueueDisc::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_id.Cancel ();
+  QueueDisc::DoDispose ();
+}
+
+bool
+EdtQueueDisc::DoEnqueue (Ptr<QueueDiscItem> item)
+{
+  NS_LOG_FUNCTION (this << item);
+
+  if (GetCurrentSize () + item > GetMaxSize ())
+    {
+      NS_LOG_LOGIC ("Queue full -- dropping pkt");
+      DropBeforeEnqueue (item, LIMIT_EXCEEDED_DROP);
+      return false;
+    }
+
+  DepartureTimeTag tag;
+  if (item->GetPacket ()->PeekPacketTag (tag)
+      && tag.GetDepartureTime () > Simulator::Now () + m_horizon)
+    {
+      NS_LOG_LOGIC ("Departure time " << tag.GetDepartureTime () << " beyond horizon -- dropping pkt");
+      DropBeforeEnqueue (item, HORIZON_DROP);
+      return false;
+    }
+
+  bool retval = GetInternalQueue (0)->Enqueue (item);
+
+  // If Queue::Enqueue fails, QueueDisc::DropBeforeEnqueue is called by the
+  // internal queue because QueueDisc::AddInternalQueue sets the trace callback
+
+  NS_LOG_LOGIC ("Number packets " << GetInternalQueue (0)->GetNPackets ());
+  NS_LOG_LOGIC ("Number bytes " << GetInternalQueue (0)->GetNBytes ());
+
+  return retval;
+}
+
+Ptr<QueueDiscItem>
+EdtQueueDisc::DoDequeue (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<const QueueDiscItem> head = GetInternalQueue (0)->Peek ();
+
+  if (!head)
+    {
+      NS_LOG_LOGIC ("Queue empty");
+      return 0;
+    }
+
+  DepartureTimeTag tag;
+  Time now = Simulator::Now ();
+  if (head->GetPacket ()->PeekPacketTag (tag) && tag.GetDepartureTime () > now)
+    {
+      // the head packet cannot leave yet: wake up when it can
+      if (m_id.IsExpired ())
+        {
+          m_id = Simulator::Schedule (tag.GetDepartureTime () - now, &QueueDisc::Run, this);
+          NS_LOG_LOGIC ("Waking Event Scheduled at " << tag.GetDepartureTime ().As (Time::S));
+        }
+      return 0;
+    }
+
+  Ptr<QueueDiscItem> item = GetInternalQueue (0)->Dequeue ();
+  item->GetPacket ()->RemovePacketTag (tag);
+
+  return item;
+}
+
+bool
+EdtQueueDisc::CheckConfig (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (GetNQueueDiscClasses () > 0)
+    {
+      NS_LOG_ERROR ("EdtQueueDisc cannot have classes");
+      return false;
+    }
+
+  if (GetNPacketFilters () > 0)
+    {
+      NS_LOG_ERROR ("EdtQueueDisc needs no packet filter");
+      return false;
+    }
+
+  if (GetNInternalQueues () == 0)
+    {
+      // add a DropTail queue
+      AddInternalQueue (CreateObjectWithAttributes<DropTailQueue<QueueDiscItem> >
+                          ("MaxSize", QueueSizeValue (GetMaxSize ())));
+    }
+
+  if (GetNInternalQueues () != 1)
+    {
+      NS_LOG_ERROR ("EdtQueueDisc needs 1 internal queue");
+      return false;
+    }
+
+  return true;
+}
+
+void
+EdtQueueDisc::InitializeParams (void)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+} // namespace ns3
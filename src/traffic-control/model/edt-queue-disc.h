@@ -0,0 +1,78 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef EDT_QUEUE_DISC_H
+#define EDT_QUEUE_DISC_H
+
+#include "ns3/queue-disc.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief Queue disc enforcing Earliest Departure Time (EDT) stamps.
+ *
+ * Packets are queued in FIFO order. A packet carrying a DepartureTimeTag
+ * is held at the head of the queue until its departure time is reached,
+ * at which point the tag is removed and the packet is released; packets
+ * without the tag are released as soon as they reach the head. While the
+ * head packet is waiting, a single watchdog event wakes the queue disc at
+ * its departure time, so that the paced sender needs no timer of its own.
+ *
+ * Stamps of a single sender are non-decreasing, hence the FIFO releases
+ * them in timestamp order. Packets whose departure time lies further than
+ * the configured horizon in the future are dropped, as in Linux fq.
+ */
+class EdtQueueDisc : public QueueDisc {
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  /**
+   * \brief EdtQueueDisc constructor
+   */
+  EdtQueueDisc ();
+
+  virtual ~EdtQueueDisc();
+
+  // Reasons for dropping packets
+  static constexpr const char* LIMIT_EXCEEDED_DROP = "Queue disc limit exceeded";  //!< Packet dropped due to queue disc limit exceeded
+  static constexpr const char* HORIZON_DROP = "Departure time beyond horizon";    //!< Packet dropped due to a departure time beyond the horizon
+
+protected:
+  /**
+   * \brief Dispose of the object
+   */
+  virtual void DoDispose (void);
+
+private:
+  virtual bool DoEnqueue (Ptr<QueueDiscItem> item);
+  virtual Ptr<QueueDiscItem> DoDequeue (void);
+  virtual bool CheckConfig (void);
+  virtual void InitializeParams (void);
+
+  Time m_horizon;    //!< Maximum distance in the future of a departure time
+  EventId m_id;      //!< EventId of the watchdog waking the queue disc at the head departure time
+};
+
+} // namespace ns3
+
+#endif /* EDT_QUEUE_DISC_H */
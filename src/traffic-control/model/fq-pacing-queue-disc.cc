@@ -0,0 +1,439 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/departure-time-tag.h"
+#include "fq-pacing-queue-disc.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FqPacingQueueDisc");
+
+NS_OBJECT_ENSURE_REGISTERED (FqPacingFlow);
+
+TypeId FqPacingFlow::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::FqPacingFlow")
+    .SetParent<QueueDiscClass> ()
+    .SetGroupName ("TrafficControl")
+    .AddConstructor<FqPacingFlow> ()
+  ;
+  return tid;
+}
+
+FqPacingFlow::FqPacingFlow ()
+  : m_credit (0),
+    m_timeNextPacket (0),
+    m_status (INACTIVE),
+    m_index (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+FqPacingFlow::~FqPacingFlow ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+FqPacingFlow::SetCredit (int32_t credit)
+{
+  NS_LOG_FUNCTION (this << credit);
+  m_credit = credit;
+}
+
+int32_t
+FqPacingFlow::GetCredit (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_credit;
+}
+
+void
+FqPacingFlow::IncreaseCredit (int32_t credit)
+{
+  NS_LOG_FUNCTION (this << credit);
+  m_credit += credit;
+}
+
+void
+FqPacingFlow::SetTimeNextPacket (Time time)
+{
+  NS_LOG_FUNCTION (this << time);
+  m_timeNextPacket = time;
+}
+
+Time
+FqPacingFlow::GetTimeNextPacket (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_timeNextPacket;
+}
+
+void
+FqPacingFlow::SetStatus (FlowStatus status)
+{
+  NS_LOG_FUNCTION (this);
+  m_status = status;
+}
+
+FqPacingFlow::FlowStatus
+FqPacingFlow::GetStatus (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_status;
+}
+
+void
+FqPacingFlow::SetIndex (uint32_t index)
+{
+  NS_LOG_FUNCTION (this);
+  m_index = index;
+}
+
+uint32_t
+FqPacingFlow::GetIndex (void) const
+{
+  return m_index;
+}
+
+
+NS_OBJECT_ENSURE_REGISTERED (FqPacingQueueDisc);
+
+TypeId FqPacingQueueDisc::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::FqPacingQueueDisc")
+    .SetParent<QueueDisc> ()
+    .SetGroupName ("TrafficControl")
+    .AddConstructor<FqPacingQueueDisc> ()
+    .AddAttribute ("MaxSize",
+                   "The maximum number of packets accepted by this queue disc",
+                   QueueSizeValue (QueueSize ("10000p")),
+                   MakeQueueSizeAccessor (&QueueDisc::SetMaxSize,
+                                          &QueueDisc::GetMaxSize),
+                   MakeQueueSizeChecker ())
+    .AddAttribute ("FlowLimit",
+                   "The maximum number of packets in a flow queue",
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&FqPacingQueueDisc::m_flowLimit),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("Flows",
+                   "The number of queues into which the incoming packets are classified",
+                   UintegerValue (1024),
+                   MakeUintegerAccessor (&FqPacingQueueDisc::m_flows),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("Quantum",
+                   "The credit, in bytes, given to a flow at each round of the scheduling algorithm",
+                   UintegerValue (3028),
+                   MakeUintegerAccessor (&FqPacingQueueDisc::m_quantum),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("InitialQuantum",
+                   "The credit, in bytes, given to a flow when it is created",
+                   UintegerValue (15140),
+                   MakeUintegerAccessor (&FqPacingQueueDisc::m_initialQuantum),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("MaxRate",
+                   "The maximum sending rate of each flow (zero for no limit)",
+                   DataRateValue (DataRate (0)),
+                   MakeDataRateAccessor (&FqPacingQueueDisc::m_maxRate),
+                   MakeDataRateChecker ())
+    .AddAttribute ("Horizon",
+                   "Packets whose departure time is further than this in the future are dropped",
+                   TimeValue (Seconds (10)),
+                   MakeTimeAccessor (&FqPacingQueueDisc::m_horizon),
+                   MakeTimeChecker ())
+    .AddAttribute ("Perturbation",
+                   "The salt used as an additional input to the hash function used to classify packets",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&FqPacingQueueDisc::m_perturbation),
+                   MakeUintegerChecker<uint32_t> ())
+  ;
+  return tid;
+}
+
+FqPacingQueueDisc::FqPacingQueueDisc ()
+  : QueueDisc (QueueDiscSizePolicy::MULTIPLE_QUEUES, QueueSizeUnit::PACKETS)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+FqPacingQueueDisc::~FqPacingQueueDisc ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+FqPacingQueueDisc::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_id.Cancel ();
+  m_newFlows.clear ();
+  m_oldFlows.clear ();
+  m_throttledFlows.clear ();
+  QueueDisc::DoDispose ();
+}
+
+bool
+FqPacingQueueDisc::DoEnqueue (Ptr<QueueDiscItem> item)
+{
+  NS_LOG_FUNCTION (this << item);
+
+  uint32_t flowHash, h;
+
+  if (GetNPacketFilters () == 0)
+    {
+      flowHash = item->Hash (m_perturbation);
+    }
+  else
+    {
+      int32_t ret = Classify (item);
+
+      if (ret != PacketFilter::PF_NO_MATCH)
+        {
+          flowHash = static_cast<uint32_t> (ret);
+        }
+      else
+        {
+          NS_LOG_ERROR ("No filter has been able to classify this packet, drop it.");
+          DropBeforeEnqueue (item, UNCLASSIFIED_DROP);
+          return false;
+        }
+    }
+
+  if (GetCurrentSize () + item > GetMaxSize ())
+    {
+      NS_LOG_LOGIC ("Queue disc full -- dropping pkt");
+      DropBeforeEnqueue (item, OVERLIMIT_DROP);
+      return false;
+    }
+
+  DepartureTimeTag tag;
+  if (item->GetPacket ()->PeekPacketTag (tag)
+      && tag.GetDepartureTime () > Simulator::Now () + m_horizon)
+    {
+      NS_LOG_LOGIC ("Departure time " << tag.GetDepartureTime () << " beyond horizon -- dropping pkt");
+      DropBeforeEnqueue (item, HORIZON_DROP);
+      return false;
+    }
+
+  h = flowHash % m_flows;
+
+  Ptr<FqPacingFlow> flow;
+  if (m_flowsIndices.find (h) == m_flowsIndices.end ())
+    {
+      NS_LOG_DEBUG ("Creating a new flow queue with index " << h);
+      flow = m_flowFactory.Create<FqPacingFlow> ();
+      Ptr<QueueDisc> qd = m_queueDiscFactory.Create<QueueDisc> ();
+      qd->Initialize ();
+      flow->SetQueueDisc (qd);
+      flow->SetIndex (h);
+      flow->SetCredit (m_initialQuantum);
+      AddQueueDiscClass (flow);
+
+      m_flowsIndices[h] = GetNQueueDiscClasses () - 1;
+    }
+  else
+    {
+      flow = StaticCast<FqPacingFlow> (GetQueueDiscClass (m_flowsIndices[h]));
+    }
+
+  if (flow->GetQueueDisc ()->GetNPackets () >= m_flowLimit)
+    {
+      NS_LOG_LOGIC ("Flow queue " << h << " full -- dropping pkt");
+      DropBeforeEnqueue (item, FLOW_LIMIT_DROP);
+      return false;
+    }
+
+  if (flow->GetStatus () == FqPacingFlow::INACTIVE)
+    {
+      flow->SetStatus (FqPacingFlow::NEW_FLOW);
+      flow->SetCredit (std::max<int32_t> (flow->GetCredit (), m_quantum));
+      m_newFlows.push_back (flow);
+    }
+
+  flow->GetQueueDisc ()->Enqueue (item);
+
+  NS_LOG_DEBUG ("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
+
+  return true;
+}
+
+void
+FqPacingQueueDisc::CheckThrottled (Time now)
+{
+  NS_LOG_FUNCTION (this << now);
+
+  while (!m_throttledFlows.empty () && m_throttledFlows.begin ()->first <= now)
+    {
+      Ptr<FqPacingFlow> flow = m_throttledFlows.begin ()->second;
+      m_throttledFlows.erase (m_throttledFlows.begin ());
+      NS_LOG_DEBUG ("Flow " << flow->GetIndex () << " is no longer throttled");
+      flow->SetStatus (FqPacingFlow::OLD_FLOW);
+      m_oldFlows.push_back (flow);
+    }
+}
+
+void
+FqPacingQueueDisc::ScheduleWatchdog (Time now)
+{
+  NS_LOG_FUNCTION (this << now);
+
+  if (m_throttledFlows.empty ())
+    {
+      return;
+    }
+
+  Time delay = m_throttledFlows.begin ()->first - now;
+  if (m_id.IsRunning () && Simulator::GetDelayLeft (m_id) <= delay)
+    {
+      return;
+    }
+  m_id.Cancel ();
+  m_id = Simulator::Schedule (delay, &QueueDisc::Run, this);
+  NS_LOG_LOGIC ("Waking Event Scheduled in " << delay.As (Time::S));
+}
+
+Ptr<QueueDiscItem>
+FqPacingQueueDisc::DoDequeue (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  Time now = Simulator::Now ();
+  CheckThrottled (now);
+
+  Ptr<FqPacingFlow> flow;
+  Ptr<QueueDiscItem> item;
+
+  while (!item)
+    {
+      std::list<Ptr<FqPacingFlow> > *flows = &m_newFlows;
+      if (flows->empty ())
+        {
+          flows = &m_oldFlows;
+        }
+      if (flows->empty ())
+        {
+          NS_LOG_DEBUG ("No flow found to dequeue a packet");
+          ScheduleWatchdog (now);
+          return 0;
+        }
+
+      flow = flows->front ();
+
+      if (flow->GetCredit () <= 0)
+        {
+          NS_LOG_DEBUG ("Increase credit for flow index " << flow->GetIndex ());
+          flow->IncreaseCredit (m_quantum);
+          flow->SetStatus (FqPacingFlow::OLD_FLOW);
+          flows->pop_front ();
+          m_oldFlows.push_back (flow);
+          continue;
+        }
+
+      Ptr<const QueueDiscItem> head = flow->GetQueueDisc ()->Peek ();
+
+      if (!head)
+        {
+          NS_LOG_DEBUG ("Flow queue " << flow->GetIndex () << " is empty");
+          flows->pop_front ();
+          // force a pass through the old flows to prevent starvation
+          if (flows == &m_newFlows && !m_oldFlows.empty ())
+            {
+              flow->SetStatus (FqPacingFlow::OLD_FLOW);
+              m_oldFlows.push_back (flow);
+            }
+          else
+            {
+              flow->SetStatus (FqPacingFlow::INACTIVE);
+            }
+          continue;
+        }
+
+      Time departure = flow->GetTimeNextPacket ();
+      DepartureTimeTag tag;
+      if (head->GetPacket ()->PeekPacketTag (tag))
+        {
+          departure = std::max (departure, tag.GetDepartureTime ());
+        }
+
+      if (departure > now)
+        {
+          NS_LOG_DEBUG ("Throttling flow " << flow->GetIndex () << " until " << departure);
+          flows->pop_front ();
+          flow->SetTimeNextPacket (departure);
+          flow->SetStatus (FqPacingFlow::THROTTLED);
+          m_throttledFlows.insert (std::make_pair (departure, flow));
+          continue;
+        }
+
+      item = flow->GetQueueDisc ()->Dequeue ();
+    }
+
+  DepartureTimeTag tag;
+  item->GetPacket ()->RemovePacketTag (tag);
+  flow->IncreaseCredit (item->GetSize () * -1);
+
+  if (m_maxRate.GetBitRate () > 0)
+    {
+      // As in Linux, a flow that was late recovers up to half of the
+      // transmission time of this packet
+      Time len = m_maxRate.CalculateBytesTxTime (item->GetSize ());
+      if (!flow->GetTimeNextPacket ().IsZero ())
+        {
+          len -= std::min (len / 2, now - flow->GetTimeNextPacket ());
+        }
+      flow->SetTimeNextPacket (now + len);
+    }
+
+  NS_LOG_DEBUG ("Dequeued packet " << item->GetPacket () << " from flow " << flow->GetIndex ());
+
+  return item;
+}
+
+bool
+FqPacingQueueDisc::CheckConfig (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (GetNQueueDiscClasses () > 0)
+    {
+      NS_LOG_ERROR ("FqPacingQueueDisc cannot have classes");
+      return false;
+    }
+
+  if (GetNInternalQueues () > 0)
+    {
+      NS_LOG_ERROR ("FqPacingQueueDisc cannot have internal queues");
+      return false;
+    }
+
+  return true;
+}
+
+void
+FqPacingQueueDisc::InitializeParams (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_flowFactory.SetTypeId ("ns3::FqPacingFlow");
+
+  m_queueDiscFactory.SetTypeId ("ns3::FifoQueueDisc");
+  m_queueDiscFactory.Set ("MaxSize", QueueSizeValue (GetMaxSize ()));
+}
+
+} // namespace ns3
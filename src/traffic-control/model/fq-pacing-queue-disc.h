@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef FQ_PACING_QUEUE_DISC
+#define FQ_PACING_QUEUE_DISC
+
+#include "ns3/queue-disc.h"
+#include "ns3/object-factory.h"
+#include "ns3/data-rate.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include <list>
+#include <map>
+
+namespace ns3 {
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief A flow queue used by the FqPacing queue disc
+ */
+
+class FqPacingFlow : public QueueDiscClass {
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  /**
+   * \brief FqPacingFlow constructor
+   */
+  FqPacingFlow ();
+
+  virtual ~FqPacingFlow ();
+
+  /**
+   * \enum FlowStatus
+   * \brief Used to determine the status of this flow queue
+   */
+  enum FlowStatus
+    {
+      INACTIVE,
+      NEW_FLOW,
+      OLD_FLOW,
+      THROTTLED
+    };
+
+  /**
+   * \brief Set the credit for this flow
+   * \param credit the credit for this flow
+   */
+  void SetCredit (int32_t credit);
+  /**
+   * \brief Get the credit for this flow
+   * \return the credit for this flow
+   */
+  int32_t GetCredit (void) const;
+  /**
+   * \brief Increase the credit for this flow
+   * \param credit the amount by which the credit is to be increased
+   */
+  void IncreaseCredit (int32_t credit);
+  /**
+   * \brief Set the earliest time the next packet of this flow can be sent
+   * \param time the earliest departure time of the next packet
+   */
+  void SetTimeNextPacket (Time time);
+  /**
+   * \brief Get the earliest time the next packet of this flow can be sent
+   * \return the earliest departure time of the next packet
+   */
+  Time GetTimeNextPacket (void) const;
+  /**
+   * \brief Set the status for this flow
+   * \param status the status for this flow
+   */
+  void SetStatus (FlowStatus status);
+  /**
+   * \brief Get the status of this flow
+   * \return the status of this flow
+   */
+  FlowStatus GetStatus (void) const;
+  /**
+   * \brief Set the index for this flow
+   * \param index the index for this flow
+   */
+  void SetIndex (uint32_t index);
+  /**
+   * \brief Get the index of this flow
+   * \return the index of this flow
+   */
+  uint32_t GetIndex (void) const;
+
+private:
+  int32_t m_credit;         //!< the credit for this flow
+  Time m_timeNextPacket;    //!< the earliest departure time of the next packet
+  FlowStatus m_status;      //!< the status of this flow
+  uint32_t m_index;         //!< the index for this flow
+};
+
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief A Linux-style fq (Fair Queue) pacing queue disc
+ *
+ * Packets are classified into flow queues as in FqCoDelQueueDisc. Flows
+ * that are allowed to send are served in deficit round robin order, while
+ * each flow keeps the earliest time its next packet can leave. This time
+ * is the departure time stamped on the head packet (DepartureTimeTag), if
+ * any, and is otherwise derived from the per-flow maximum rate. A flow
+ * whose next packet cannot leave yet is removed from the round robin and
+ * kept in a set of throttled flows ordered by departure time, from which
+ * it returns when its time is reached. A single watchdog event wakes the
+ * queue disc when the earliest throttled flow becomes eligible, so the
+ * cost of pacing does not depend on the number of flows.
+ */
+
+class FqPacingQueueDisc : public QueueDisc {
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  /**
+   * \brief FqPacingQueueDisc constructor
+   */
+  FqPacingQueueDisc ();
+
+  virtual ~FqPacingQueueDisc ();
+
+  // Reasons for dropping packets
+  static constexpr const char* UNCLASSIFIED_DROP = "Unclassified drop";          //!< No packet filter able to classify packet
+  static constexpr const char* OVERLIMIT_DROP = "Overlimit drop";                //!< Overlimit dropped packets
+  static constexpr const char* FLOW_LIMIT_DROP = "Flow limit drop";              //!< Packet dropped due to the flow queue limit
+  static constexpr const char* HORIZON_DROP = "Departure time beyond horizon";   //!< Packet dropped due to a departure time beyond the horizon
+
+protected:
+  /**
+   * \brief Dispose of the object
+   */
+  virtual void DoDispose (void);
+
+private:
+  virtual bool DoEnqueue (Ptr<QueueDiscItem> item);
+  virtual Ptr<QueueDiscItem> DoDequeue (void);
+  virtual bool CheckConfig (void);
+  virtual void InitializeParams (void);
+
+  /**
+   * \brief Move the throttled flows whose departure time is reached to the old flows
+   * \param now the current time
+   */
+  void CheckThrottled (Time now);
+  /**
+   * \brief Schedule the watchdog for the earliest throttled flow, if needed
+   * \param now the current time
+   */
+  void ScheduleWatchdog (Time now);
+
+  uint32_t m_quantum;        //!< Credit assigned to flows at each round
+  uint32_t m_initialQuantum; //!< Credit assigned to new flows
+  uint32_t m_flows;          //!< Number of flow queues
+  uint32_t m_flowLimit;      //!< Maximum number of packets in a flow queue
+  uint32_t m_perturbation;   //!< hash perturbation value
+  DataRate m_maxRate;        //!< Maximum rate of a flow (zero for no limit)
+  Time m_horizon;            //!< Maximum distance in the future of a departure time
+
+  std::list<Ptr<FqPacingFlow> > m_newFlows;    //!< The list of new flows
+  std::list<Ptr<FqPacingFlow> > m_oldFlows;    //!< The list of old flows
+  std::multimap<Time, Ptr<FqPacingFlow> > m_throttledFlows;  //!< The throttled flows, by departure time
+
+  std::map<uint32_t, uint32_t> m_flowsIndices;    //!< Map with the index of class for each flow
+
+  EventId m_id;                        //!< EventId of the watchdog waking the earliest throttled flow
+  ObjectFactory m_flowFactory;         //!< Factory to create a new flow
+  ObjectFactory m_queueDiscFactory;    //!< Factory to create a new queue
+};
+
+} // namespace ns3
+
+#endif /* FQ_PACING_QUEUE_DISC */
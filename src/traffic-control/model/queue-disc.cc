@@ -1091,6 +1091,19 @@ QueueDisc::Transmit (Ptr<QueueDiscItem> item)
       item->GetPacket ()->RemovePacketTag (priorityTag);
     }
   NS_ASSERT_MSG (m_send, "Send callback not set");
+
+  // Split GSO super-segments into the segments to put on the wire, as Linux
+  // does in validate_xmit_skb. If the device queue gets stopped in the
+  // middle, requeue the rest of the super-segment.
+  for (Ptr<QueueDiscItem> segment = item->SplitSegment (); segment != 0; segment = item->SplitSegment ())
+    {
+      m_send (segment);
+      if (m_devQueueIface && m_devQueueIface->GetTxQueue (item->GetTxQueueIndex ())->IsStopped ())
+        {
+          Requeue (item);
+          return false;
+        }
+    }
   m_send (item);
 
   // the behavior here slightly diverges from Linux. In Linux, it is advised that
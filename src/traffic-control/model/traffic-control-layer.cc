@@ -382,6 +382,11 @@ TrafficControlLayer::Send (Ptr<NetDevice> device, Ptr<QueueDiscItem> item)
               SocketPriorityTag priorityTag;
               item->GetPacket ()->RemovePacketTag (priorityTag);
             }
+          // Split GSO super-segments into the segments to put on the wire
+          for (Ptr<QueueDiscItem> segment = item->SplitSegment (); segment != 0; segment = item->SplitSegment ())
+            {
+              device->Send (segment->GetPacket (), segment->GetAddress (), segment->GetProtocol ());
+            }
           device->Send (item->GetPacket (), item->GetAddress (), item->GetProtocol ());
         }
     }
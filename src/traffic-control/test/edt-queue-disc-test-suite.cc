@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include "ns3/test.h"
+#include "ns3/edt-queue-disc.h"
+#include "ns3/departure-time-tag.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Edt Queue Disc Test Item
+ */
+class EdtQueueDiscTestItem : public QueueDiscItem {
+public:
+  /**
+   * Constructor
+   *
+   * \param p the packet
+   * \param addr the address
+   */
+  EdtQueueDiscTestItem (Ptr<Packet> p, const Address & addr);
+  virtual ~EdtQueueDiscTestItem ();
+  virtual void AddHeader (void);
+  virtual bool Mark (void);
+
+private:
+  EdtQueueDiscTestItem ();
+  /**
+   * \brief Copy constructor
+   * Disable default implementation to avoid misuse
+   */
+  EdtQueueDiscTestItem (const EdtQueueDiscTestItem &);
+  /**
+   * \brief Assignment operator
+   * \return this object
+   * Disable default implementation to avoid misuse
+   */
+  EdtQueueDiscTestItem &operator = (const EdtQueueDiscTestItem &);
+};
+
+EdtQueueDiscTestItem::EdtQueueDiscTestItem (Ptr<Packet> p, const Address & addr)
+  : QueueDiscItem (p, addr, 0)
+{
+}
+
+EdtQueueDiscTestItem::~EdtQueueDiscTestItem ()
+{
+}
+
+void
+EdtQueueDiscTestItem::AddHeader (void)
+{
+}
+
+bool
+EdtQueueDiscTestItem::Mark (void)
+{
+  return false;
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Edt Queue Disc Test Case
+ *
+ * Packets stamped with a departure time must be released by the queue disc
+ * itself (through its watchdog) exactly at that time, without the stamp;
+ * packets without a stamp are released immediately, and packets stamped
+ * beyond the horizon are dropped.
+ */
+class EdtQueueDiscTestCase : public TestCase
+{
+public:
+  EdtQueueDiscTestCase ();
+  virtual void DoRun (void);
+private:
+  /**
+   * Enqueue a packet and run the queue disc
+   * \param queue the queue disc
+   * \param size the size of the packet in bytes
+   * \param departure the departure time to stamp, if positive
+   */
+  void Enqueue (Ptr<EdtQueueDisc> queue, uint32_t size, Time departure);
+  /**
+   * Callback invoked when the queue disc sends a packet
+   * \param item the packet sent
+   */
+  void Send (Ptr<QueueDiscItem> item);
+
+  std::vector<std::pair<Time, uint32_t> > m_sent; //!< Time and size of the sent packets
+  bool m_tagLeaked;                               //!< True if a sent packet still carries the tag
+};
+
+EdtQueueDiscTestCase::EdtQueueDiscTestCase ()
+  : TestCase ("Sanity check on the EDT queue disc implementation"),
+    m_tagLeaked (false)
+{
+}
+
+void
+EdtQueueDiscTestCase::Enqueue (Ptr<EdtQueueDisc> queue, uint32_t size, Time departure)
+{
+  Ptr<Packet> p = Create<Packet> (size);
+  if (departure.IsStrictlyPositive ())
+    {
+      p->AddPacketTag (DepartureTimeTag (departure));
+    }
+  queue->Enqueue (Create<EdtQueueDiscTestItem> (p, Address ()));
+  queue->Run ();
+}
+
+void
+EdtQueueDiscTestCase::Send (Ptr<QueueDiscItem> item)
+{
+  DepartureTimeTag tag;
+  m_tagLeaked |= item->GetPacket ()->PeekPacketTag (tag);
+  m_sent.push_back (std::make_pair (Simulator::Now (), item->GetSize ()));
+}
+
+void
+EdtQueueDiscTestCase::DoRun (void)
+{
+  Ptr<EdtQueueDisc> queue = CreateObject<EdtQueueDisc> ();
+  queue->SetSendCallback ([this] (Ptr<QueueDiscItem> item) { Send (item); });
+  queue->Initialize ();
+
+  Simulator::Schedule (Seconds (0), &EdtQueueDiscTestCase::Enqueue, this, queue, 100, Time (0));
+  Simulator::Schedule (Seconds (0), &EdtQueueDiscTestCase::Enqueue, this, queue, 200, MilliSeconds (2));
+  Simulator::Schedule (Seconds (0), &EdtQueueDiscTestCase::Enqueue, this, queue, 300, MilliSeconds (5));
+  Simulator::Schedule (Seconds (0), &EdtQueueDiscTestCase::Enqueue, this, queue, 400, Seconds (20));
+  // a stamp already in the past is released right away
+  Simulator::Schedule (MilliSeconds (7), &EdtQueueDiscTestCase::Enqueue, this, queue, 500, MilliSeconds (6));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_sent.size (), 4, "Four packets should have been sent");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[0].first, Seconds (0), "Unstamped packet not sent immediately");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[0].second, 100, "Unexpected packet sent first");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[1].first, MilliSeconds (2), "Packet not sent at its departure time");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[1].second, 200, "Unexpected packet sent second");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[2].first, MilliSeconds (5), "Packet not sent at its departure time");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[2].second, 300, "Unexpected packet sent third");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[3].first, MilliSeconds (7), "Late packet not sent immediately");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[3].second, 500, "Unexpected packet sent fourth");
+  NS_TEST_EXPECT_MSG_EQ (m_tagLeaked, false, "The departure time tag should be removed on dequeue");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetStats ().GetNDroppedPackets (EdtQueueDisc::HORIZON_DROP), 1,
+                         "The packet stamped beyond the horizon should have been dropped");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Edt Queue Disc Test Suite
+ */
+static class EdtQueueDiscTestSuite : public TestSuite
+{
+public:
+  EdtQueueDiscTestSuite ()
+    : TestSuite ("edt-queue-disc", UNIT)
+  {
+    AddTestCase (new EdtQueueDiscTestCase (), TestCase::QUICK);
+  }
+} g_edtQueueDiscTestSuite; ///< the test suite
@@ -0,0 +1,281 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include "ns3/test.h"
+#include "ns3/fq-pacing-queue-disc.h"
+#include "ns3/departure-time-tag.h"
+#include "ns3/packet.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief FqPacing Queue Disc Test Item
+ */
+class FqPacingQueueDiscTestItem : public QueueDiscItem {
+public:
+  /**
+   * Constructor
+   *
+   * \param p the packet
+   * \param addr the address
+   * \param hash the flow hash
+   */
+  FqPacingQueueDiscTestItem (Ptr<Packet> p, const Address & addr, uint32_t hash);
+  virtual ~FqPacingQueueDiscTestItem ();
+  virtual void AddHeader (void);
+  virtual bool Mark (void);
+  virtual uint32_t Hash (uint32_t perturbation) const;
+
+private:
+  FqPacingQueueDiscTestItem ();
+  /**
+   * \brief Copy constructor
+   * Disable default implementation to avoid misuse
+   */
+  FqPacingQueueDiscTestItem (const FqPacingQueueDiscTestItem &);
+  /**
+   * \brief Assignment operator
+   * \return this object
+   * Disable default implementation to avoid misuse
+   */
+  FqPacingQueueDiscTestItem &operator = (const FqPacingQueueDiscTestItem &);
+  uint32_t m_hash; //!< the flow hash
+};
+
+FqPacingQueueDiscTestItem::FqPacingQueueDiscTestItem (Ptr<Packet> p, const Address & addr, uint32_t hash)
+  : QueueDiscItem (p, addr, 0),
+    m_hash (hash)
+{
+}
+
+FqPacingQueueDiscTestItem::~FqPacingQueueDiscTestItem ()
+{
+}
+
+void
+FqPacingQueueDiscTestItem::AddHeader (void)
+{
+}
+
+bool
+FqPacingQueueDiscTestItem::Mark (void)
+{
+  return false;
+}
+
+uint32_t
+FqPacingQueueDiscTestItem::Hash (uint32_t perturbation) const
+{
+  return m_hash;
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Common base of the FqPacing Queue Disc test cases
+ */
+class FqPacingQueueDiscTestBase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param name the test case name
+   */
+  FqPacingQueueDiscTestBase (std::string name);
+
+protected:
+  /**
+   * Enqueue a packet and run the queue disc
+   * \param queue the queue disc
+   * \param hash the flow hash
+   * \param size the size of the packet in bytes
+   * \param departure the departure time to stamp, if positive
+   */
+  void Enqueue (Ptr<FqPacingQueueDisc> queue, uint32_t hash, uint32_t size, Time departure);
+  /**
+   * Callback invoked when the queue disc sends a packet
+   * \param item the packet sent
+   */
+  void Send (Ptr<QueueDiscItem> item);
+
+  std::vector<std::pair<Time, uint32_t> > m_sent; //!< Time and size of the sent packets
+  bool m_tagLeaked;                               //!< True if a sent packet still carries the tag
+};
+
+FqPacingQueueDiscTestBase::FqPacingQueueDiscTestBase (std::string name)
+  : TestCase (name),
+    m_tagLeaked (false)
+{
+}
+
+void
+FqPacingQueueDiscTestBase::Enqueue (Ptr<FqPacingQueueDisc> queue, uint32_t hash, uint32_t size, Time departure)
+{
+  Ptr<Packet> p = Create<Packet> (size);
+  if (departure.IsStrictlyPositive ())
+    {
+      p->AddPacketTag (DepartureTimeTag (departure));
+    }
+  queue->Enqueue (Create<FqPacingQueueDiscTestItem> (p, Address (), hash));
+  queue->Run ();
+}
+
+void
+FqPacingQueueDiscTestBase::Send (Ptr<QueueDiscItem> item)
+{
+  DepartureTimeTag tag;
+  m_tagLeaked |= item->GetPacket ()->PeekPacketTag (tag);
+  m_sent.push_back (std::make_pair (Simulator::Now (), item->GetSize ()));
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Check that departure time stamps are honored per flow
+ *
+ * A flow whose packets are stamped in the future is throttled without
+ * blocking the packets of another flow, and each stamped packet leaves
+ * exactly at its departure time.
+ */
+class FqPacingQueueDiscDepartureTime : public FqPacingQueueDiscTestBase
+{
+public:
+  FqPacingQueueDiscDepartureTime ();
+private:
+  virtual void DoRun (void);
+};
+
+FqPacingQueueDiscDepartureTime::FqPacingQueueDiscDepartureTime ()
+  : FqPacingQueueDiscTestBase ("Check that departure times are enforced per flow")
+{
+}
+
+void
+FqPacingQueueDiscDepartureTime::DoRun (void)
+{
+  Ptr<FqPacingQueueDisc> queue = CreateObject<FqPacingQueueDisc> ();
+  queue->SetSendCallback ([this] (Ptr<QueueDiscItem> item) { Send (item); });
+  queue->Initialize ();
+
+  // flow 1 is paced by its sender, flow 2 is not
+  Simulator::Schedule (Seconds (0), &FqPacingQueueDiscDepartureTime::Enqueue, this, queue, 1, 100, MilliSeconds (3));
+  Simulator::Schedule (Seconds (0), &FqPacingQueueDiscDepartureTime::Enqueue, this, queue, 1, 200, MilliSeconds (6));
+  Simulator::Schedule (Seconds (0), &FqPacingQueueDiscDepartureTime::Enqueue, this, queue, 2, 300, Time (0));
+  Simulator::Schedule (Seconds (0), &FqPacingQueueDiscDepartureTime::Enqueue, this, queue, 2, 400, Time (0));
+  // flow 3 is stamped earlier than flow 1: the watchdog must be moved
+  Simulator::Schedule (MilliSeconds (1), &FqPacingQueueDiscDepartureTime::Enqueue, this, queue, 3, 500, MilliSeconds (2));
+  // beyond the horizon
+  Simulator::Schedule (MilliSeconds (1), &FqPacingQueueDiscDepartureTime::Enqueue, this, queue, 3, 600, Seconds (11));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_sent.size (), 5, "Five packets should have been sent");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[0].first, Seconds (0), "Unpaced flow blocked by a throttled flow");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[0].second, 300, "Unexpected packet sent first");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[1].first, Seconds (0), "Unpaced flow blocked by a throttled flow");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[1].second, 400, "Unexpected packet sent second");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[2].first, MilliSeconds (2), "Packet not sent at its departure time");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[2].second, 500, "Unexpected packet sent third");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[3].first, MilliSeconds (3), "Packet not sent at its departure time");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[3].second, 100, "Unexpected packet sent fourth");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[4].first, MilliSeconds (6), "Packet not sent at its departure time");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[4].second, 200, "Unexpected packet sent fifth");
+  NS_TEST_EXPECT_MSG_EQ (m_tagLeaked, false, "The departure time tag should be removed on dequeue");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetStats ().GetNDroppedPackets (FqPacingQueueDisc::HORIZON_DROP), 1,
+                         "The packet stamped beyond the horizon should have been dropped");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Check the per-flow maximum rate and the flow limit
+ */
+class FqPacingQueueDiscMaxRate : public FqPacingQueueDiscTestBase
+{
+public:
+  FqPacingQueueDiscMaxRate ();
+private:
+  virtual void DoRun (void);
+};
+
+FqPacingQueueDiscMaxRate::FqPacingQueueDiscMaxRate ()
+  : FqPacingQueueDiscTestBase ("Check that the maximum rate is enforced per flow")
+{
+}
+
+void
+FqPacingQueueDiscMaxRate::DoRun (void)
+{
+  Ptr<FqPacingQueueDisc> queue = CreateObjectWithAttributes<FqPacingQueueDisc> ("MaxRate", DataRateValue (DataRate ("8Mb/s")),
+                                                                                "FlowLimit", UintegerValue (3));
+  queue->SetSendCallback ([this] (Ptr<QueueDiscItem> item) { Send (item); });
+  queue->Initialize ();
+
+  // two flows of 1000 byte packets: 1 ms each at 8Mb/s
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      Simulator::Schedule (Seconds (0), &FqPacingQueueDiscMaxRate::Enqueue, this, queue, 1, 1000, Time (0));
+    }
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      Simulator::Schedule (Seconds (0), &FqPacingQueueDiscMaxRate::Enqueue, this, queue, 2, 1000, Time (0));
+    }
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (queue->GetStats ().GetNDroppedPackets (FqPacingQueueDisc::FLOW_LIMIT_DROP), 0,
+                         "The first packet is sent right away and frees room in the flow queue");
+  NS_TEST_ASSERT_MSG_EQ (m_sent.size (), 6, "Six packets should have been sent");
+
+  std::vector<Time> sent;
+  for (auto & s : m_sent)
+    {
+      sent.push_back (s.first);
+    }
+  std::vector<Time> expected = {Seconds (0), Seconds (0), MilliSeconds (1), MilliSeconds (1), MilliSeconds (2), MilliSeconds (3)};
+  for (uint32_t i = 0; i < expected.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (sent[i], expected[i], "Packet " << i << " not sent at the maximum rate");
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief FqPacing Queue Disc Test Suite
+ */
+static class FqPacingQueueDiscTestSuite : public TestSuite
+{
+public:
+  FqPacingQueueDiscTestSuite ()
+    : TestSuite ("fq-pacing-queue-disc", UNIT)
+  {
+    AddTestCase (new FqPacingQueueDiscDepartureTime (), TestCase::QUICK);
+    AddTestCase (new FqPacingQueueDiscMaxRate (), TestCase::QUICK);
+  }
+} g_fqPacingQueueDiscTestSuite; ///< the test suite
@@ -0,0 +1,425 @@
+set terminal postscript eps color enh "Times-BoldItalic"
+set output "80211n-mimo-throughput.eps"
+set xlabel "Distance (Meters)"
+set ylabel "Throughput (Mbit/s)"
+set xrange [0:100]
+set yrange [0:600]
+set ytics 0,50,600
+set style line 1 dashtype 1 linewidth 5
+set style line 2 dashtype 1 linewidth 5
+set style line 3 dashtype 1 linewidth 5
+set style line 4 dashtype 1 linewidth 5
+set style line 5 dashtype 1 linewidth 5
+set style line 6 dashtype 1 linewidth 5
+set style line 7 dashtype 1 linewidth 5
+set style line 8 dashtype 1 linewidth 5
+set style line 9 dashtype 2 linewidth 5
+set style line 10 dashtype 2 linewidth 5
+set style line 11 dashtype 2 linewidth 5
+set style line 12 dashtype 2 linewidth 5
+set style line 13 dashtype 2 linewidth 5
+set style line 14 dashtype 2 linewidth 5
+set style line 15 dashtype 2 linewidth 5
+set style line 16 dashtype 2 linewidth 5
+set style line 17 dashtype 3 linewidth 5
+set style line 18 dashtype 3 linewidth 5
+set style line 19 dashtype 3 linewidth 5
+set style line 20 dashtype 3 linewidth 5
+set style line 21 dashtype 3 linewidth 5
+set style line 22 dashtype 3 linewidth 5
+set style line 23 dashtype 3 linewidth 5
+set style line 24 dashtype 3 linewidth 5
+set style line 25 dashtype 4 linewidth 5
+set style line 26 dashtype 4 linewidth 5
+set style line 27 dashtype 4 linewidth 5
+set style line 28 dashtype 4 linewidth 5
+set style line 29 dashtype 4 linewidth 5
+set style line 30 dashtype 4 linewidth 5
+set style line 31 dashtype 4 linewidth 5
+set style line 32 dashtype 4 linewidth 5
+set style increment user
+plot "-"  title "HtMcs0" with lines, "-"  title "HtMcs1" with lines, "-"  title "HtMcs2" with lines, "-"  title "HtMcs3" with lines, "-"  title "HtMcs4" with lines, "-"  title "HtMcs5" with lines, "-"  title "HtMcs6" with lines, "-"  title "HtMcs7" with lines, "-"  title "HtMcs8" with lines, "-"  title "HtMcs9" with lines, "-"  title "HtMcs10" with lines, "-"  title "HtMcs11" with lines, "-"  title "HtMcs12" with lines, "-"  title "HtMcs13" with lines, "-"  title "HtMcs14" with lines, "-"  title "HtMcs15" with lines, "-"  title "HtMcs16" with lines, "-"  title "HtMcs17" with lines, "-"  title "HtMcs18" with lines, "-"  title "HtMcs19" with lines, "-"  title "HtMcs20" with lines, "-"  title "HtMcs21" with lines, "-"  title "HtMcs22" with lines, "-"  title "HtMcs23" with lines, "-"  title "HtMcs24" with lines, "-"  title "HtMcs25" with lines, "-"  title "HtMcs26" with lines, "-"  title "HtMcs27" with lines, "-"  title "HtMcs28" with lines, "-"  title "HtMcs29" with lines, "-"  title "HtMcs30" with lines, "-"  title "HtMcs31" with lines
+0 5.2992
+10 5.2992
+20 5.53472
+30 5.41696
+40 5.65248
+50 5.65248
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 11.1872
+10 10.8339
+20 11.4227
+30 11.1872
+40 11.305
+50 10.7162
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 17.4285
+10 16.0154
+20 16.4864
+30 16.9574
+40 16.0154
+50 16.3686
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 23.552
+10 23.3165
+20 23.081
+30 21.9034
+40 22.3744
+50 23.552
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 33.6794
+10 34.6214
+20 32.855
+30 33.6794
+40 33.3261
+50 21.6678
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 44.0422
+10 44.8666
+20 43.9245
+30 42.9824
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 51.9322
+10 52.7565
+20 52.2854
+30 46.9862
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 54.2874
+10 58.6445
+20 59.2333
+30 30.7354
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 11.4227
+10 10.5984
+20 11.0694
+30 11.4227
+40 11.4227
+50 10.8339
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 22.6099
+10 22.8454
+20 23.081
+30 22.4922
+40 21.9034
+50 21.6678
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 33.3261
+10 34.0326
+20 32.9728
+30 32.855
+40 33.6794
+50 32.9728
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 46.633
+10 45.2198
+20 47.104
+30 44.3955
+40 46.633
+50 45.3376
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 69.4784
+10 65.9456
+20 65.8278
+30 70.3027
+40 66.0634
+50 52.8742
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 91.264
+10 92.3238
+20 92.4416
+30 92.6771
+40 7.77216
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 102.804
+10 103.747
+20 98.0941
+30 100.567
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 105.984
+10 106.455
+20 109.635
+30 81.0189
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 17.4285
+10 15.8976
+20 16.2509
+30 16.1331
+40 16.4864
+50 16.1331
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 32.384
+10 33.4438
+20 32.0307
+30 35.0925
+40 32.0307
+50 32.7373
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 49.3414
+10 50.2835
+20 48.0461
+30 52.6387
+40 51.9322
+50 49.577
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 66.6522
+10 65.8278
+20 69.4784
+30 65.3568
+40 66.4166
+50 69.8317
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 103.864
+10 103.864
+20 104.1
+30 105.631
+40 101.156
+50 85.847
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 126.003
+10 128.594
+20 129.536
+30 137.897
+40 33.5616
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 152.97
+10 145.316
+20 153.324
+30 146.258
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 158.387
+10 163.098
+20 168.397
+30 137.426
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 21.5501
+10 23.081
+20 22.9632
+30 21.3146
+40 23.1987
+50 22.7277
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 47.104
+10 43.8067
+20 46.633
+30 46.9862
+40 44.631
+50 43.4534
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 68.4186
+10 66.2989
+20 67.9475
+30 65.7101
+40 65.7101
+50 70.0672
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 87.7312
+10 86.3181
+20 89.6154
+30 92.2061
+40 90.3219
+50 86.5536
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 133.187
+10 134.129
+20 131.302
+30 137.661
+40 125.414
+50 112.461
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 178.053
+10 178.171
+20 177.7
+30 166.395
+40 34.9747
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 199.132
+10 199.956
+20 195.953
+30 190.182
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 202.783
+10 210.202
+20 220.093
+30 158.623
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "idle-parf-1.eps"
+set title "Percentage time AP1 in Idle state vs time"
+set xlabel "Time (seconds)"
+set ylabel "Percent"
+plot "-"  title "Idle Time" with lines
+0 0
+1 92.0432
+2 43.2528
+3 34.9794
+4 35.2192
+e
@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "power-parf-0.eps"
+set title "Average transmit power (AP0 to STA) vs time"
+set xlabel "Time (seconds)"
+set ylabel "Power (mW)"
+plot "-"  title "Untitled" with lines
+0 0
+1 0.00192
+2 1.65798
+3 1.18163
+4 1.15855
+e
@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "power-parf-1.eps"
+set title "Average transmit power (AP1 to STA) vs time"
+set xlabel "Time (seconds)"
+set ylabel "Power (mW)"
+plot "-"  title "Untitled" with lines
+0 0
+1 0.00192
+2 9.70214
+3 9.56303
+4 9.49448
+e
@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "rx-parf-0.eps"
+set title "Percentage time AP0 in RX state vs time"
+set xlabel "Time (seconds)"
+set ylabel "Percent"
+plot "-"  title "RX Time" with lines
+0 0
+1 0.0092
+2 1.6684
+3 1.6376
+4 1.6128
+e
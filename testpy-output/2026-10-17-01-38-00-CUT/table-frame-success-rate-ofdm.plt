@@ -0,0 +1,2824 @@
+set terminal postscript eps color enh "Times-BoldItalic"
+set output "table-frame-success-rate-ofdm.eps"
+set xlabel "SNR(dB)"
+set ylabel "Frame Success Rate"
+set xrange [-5:30]
+set yrange [0:1.2]
+set style line 1 linewidth 5
+set style line 2 linewidth 5
+set style line 3 linewidth 5
+set style line 4 linewidth 5
+set style line 5 linewidth 5
+set style line 6 linewidth 5
+set style line 7 linewidth 5
+set style line 8 linewidth 5
+set style increment user
+plot "-"  title "OfdmRate6Mbps" with lines, "-"  title "OfdmRate9Mbps" with lines, "-"  title "OfdmRate12Mbps" with lines, "-"  title "OfdmRate18Mbps" with lines, "-"  title "OfdmRate24Mbps" with lines, "-"  title "OfdmRate36Mbps" with lines, "-"  title "OfdmRate48Mbps" with lines, "-"  title "OfdmRate54Mbps" with lines
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0.00098865
+-0.8 0.00201718
+-0.7 0.00306131
+-0.6 0.00411572
+-0.5 0.00517783
+-0.4 0.0374896
+-0.3 0.0707535
+-0.2 0.104479
+-0.1 0.138517
+-1.02696e-15 0.172793
+0.1 0.276903
+0.2 0.382147
+0.3 0.48822
+0.4 0.594946
+0.5 0.702215
+0.6 0.747994
+0.7 0.793852
+0.8 0.839784
+0.9 0.885787
+1 0.931857
+1.1 0.943174
+1.2 0.954494
+1.3 0.965819
+1.4 0.977147
+1.5 0.988479
+1.6 0.990475
+1.7 0.99247
+1.8 0.994465
+1.9 0.996461
+2 0.998457
+2.1 0.998735
+2.2 0.999012
+2.3 0.99929
+2.4 0.999568
+2.5 0.999846
+2.6 0.999874
+2.7 0.999903
+2.8 0.999932
+2.9 0.999961
+3 0.99999
+3.1 1
+3.2 1
+3.3 1
+3.4 1
+3.5 1
+3.6 1
+3.7 1
+3.8 1
+3.9 1
+4 1
+4.1 1
+4.2 1
+4.3 1
+4.4 1
+4.5 1
+4.6 1
+4.7 1
+4.8 1
+4.9 1
+5 1
+5.1 1
+5.2 1
+5.3 1
+5.4 1
+5.5 1
+5.6 1
+5.7 1
+5.8 1
+5.9 1
+6 1
+6.1 1
+6.2 1
+6.3 1
+6.4 1
+6.5 1
+6.6 1
+6.7 1
+6.8 1
+6.9 1
+7 1
+7.1 1
+7.2 1
+7.3 1
+7.4 1
+7.5 1
+7.6 1
+7.7 1
+7.8 1
+7.9 1
+8 1
+8.1 1
+8.2 1
+8.3 1
+8.4 1
+8.5 1
+8.6 1
+8.7 1
+8.8 1
+8.9 1
+9 1
+9.1 1
+9.2 1
+9.3 1
+9.4 1
+9.5 1
+9.6 1
+9.7 1
+9.8 1
+9.9 1
+10 1
+10.1 1
+10.2 1
+10.3 1
+10.4 1
+10.5 1
+10.6 1
+10.7 1
+10.8 1
+10.9 1
+11 1
+11.1 1
+11.2 1
+11.3 1
+11.4 1
+11.5 1
+11.6 1
+11.7 1
+11.8 1
+11.9 1
+12 1
+12.1 1
+12.2 1
+12.3 1
+12.4 1
+12.5 1
+12.6 1
+12.7 1
+12.8 1
+12.9 1
+13 1
+13.1 1
+13.2 1
+13.3 1
+13.4 1
+13.5 1
+13.6 1
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0.000484552
+2.2 0.00098865
+2.3 0.0015004
+2.4 0.00201718
+2.5 0.00253773
+2.6 0.0397625
+2.7 0.0782536
+2.8 0.117306
+2.9 0.156732
+3 0.196442
+3.1 0.294067
+3.2 0.392626
+3.3 0.49189
+3.4 0.591722
+3.5 0.69203
+3.6 0.738505
+3.7 0.785063
+3.8 0.831697
+3.9 0.878405
+4 0.925183
+4.1 0.937669
+4.2 0.950159
+4.3 0.962654
+4.4 0.975153
+4.5 0.987656
+4.6 0.989816
+4.7 0.991976
+4.8 0.994136
+4.9 0.996296
+5 0.998457
+5.1 0.998718
+5.2 0.998979
+5.3 0.999241
+5.4 0.999502
+5.5 0.999763
+5.6 0.999811
+5.7 0.999858
+5.8 0.999905
+5.9 0.999953
+6 1
+6.1 1
+6.2 1
+6.3 1
+6.4 1
+6.5 1
+6.6 1
+6.7 1
+6.8 1
+6.9 1
+7 1
+7.1 1
+7.2 1
+7.3 1
+7.4 1
+7.5 1
+7.6 1
+7.7 1
+7.8 1
+7.9 1
+8 1
+8.1 1
+8.2 1
+8.3 1
+8.4 1
+8.5 1
+8.6 1
+8.7 1
+8.8 1
+8.9 1
+9 1
+9.1 1
+9.2 1
+9.3 1
+9.4 1
+9.5 1
+9.6 1
+9.7 1
+9.8 1
+9.9 1
+10 1
+10.1 1
+10.2 1
+10.3 1
+10.4 1
+10.5 1
+10.6 1
+10.7 1
+10.8 1
+10.9 1
+11 1
+11.1 1
+11.2 1
+11.3 1
+11.4 1
+11.5 1
+11.6 1
+11.7 1
+11.8 1
+11.9 1
+12 1
+12.1 1
+12.2 1
+12.3 1
+12.4 1
+12.5 1
+12.6 1
+12.7 1
+12.8 1
+12.9 1
+13 1
+13.1 1
+13.2 1
+13.3 1
+13.4 1
+13.5 1
+13.6 1
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0.000319284
+4.7 0.000651446
+4.8 0.00098865
+4.9 0.00132917
+5 0.00167218
+5.1 0.0459038
+5.2 0.0917342
+5.3 0.138244
+5.4 0.185206
+5.5 0.232506
+5.6 0.323175
+5.7 0.414572
+5.8 0.506541
+5.9 0.598982
+6 0.691826
+6.1 0.739403
+6.2 0.787065
+6.3 0.834809
+6.4 0.882629
+6.5 0.930522
+6.6 0.9419
+6.7 0.953282
+6.8 0.964668
+6.9 0.976057
+7 0.987451
+7.1 0.989487
+7.2 0.991524
+7.3 0.99356
+7.4 0.995597
+7.5 0.997634
+7.6 0.998035
+7.7 0.998436
+7.8 0.998837
+7.9 0.999239
+8 0.99964
+8.1 0.999704
+8.2 0.999767
+8.3 0.999831
+8.4 0.999895
+8.5 0.999959
+8.6 0.999967
+8.7 0.999975
+8.8 0.999984
+8.9 1
+9 1
+9.1 1
+9.2 1
+9.3 1
+9.4 1
+9.5 1
+9.6 1
+9.7 1
+9.8 1
+9.9 1
+10 1
+10.1 1
+10.2 1
+10.3 1
+10.4 1
+10.5 1
+10.6 1
+10.7 1
+10.8 1
+10.9 1
+11 1
+11.1 1
+11.2 1
+11.3 1
+11.4 1
+11.5 1
+11.6 1
+11.7 1
+11.8 1
+11.9 1
+12 1
+12.1 1
+12.2 1
+12.3 1
+12.4 1
+12.5 1
+12.6 1
+12.7 1
+12.8 1
+12.9 1
+13 1
+13.1 1
+13.2 1
+13.3 1
+13.4 1
+13.5 1
+13.6 1
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0.00098865
+7.7 0.00201718
+7.8 0.00306131
+7.9 0.00411572
+8 0.00517783
+8.1 0.0333671
+8.2 0.0623616
+8.3 0.0917535
+8.4 0.121416
+8.5 0.151285
+8.6 0.231104
+8.7 0.311718
+8.8 0.392927
+8.9 0.474612
+9 0.556695
+9.1 0.615925
+9.2 0.675316
+9.3 0.734853
+9.4 0.794527
+9.5 0.854325
+9.6 0.87574
+9.7 0.89717
+9.8 0.918614
+9.9 0.940072
+10 0.961544
+10.1 0.967464
+10.2 0.973384
+10.3 0.979306
+10.4 0.985229
+10.5 0.991153
+10.6 0.992532
+10.7 0.99391
+10.8 0.995288
+10.9 0.996667
+11 0.998045
+11.1 0.998362
+11.2 0.998679
+11.3 0.998996
+11.4 0.999313
+11.5 0.99963
+11.6 0.999693
+11.7 0.999757
+11.8 0.999821
+11.9 0.999885
+12 0.999949
+12.1 0.999959
+12.2 0.999969
+12.3 0.999979
+12.4 0.99999
+12.5 1
+12.6 1
+12.7 1
+12.8 1
+12.9 1
+13 1
+13.1 1
+13.2 1
+13.3 1
+13.4 1
+13.5 1
+13.6 1
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0.0129445
+11.2 0.0264112
+11.3 0.0400822
+11.4 0.0538876
+11.5 0.0677939
+11.6 0.147578
+11.7 0.228655
+11.8 0.310563
+11.9 0.393088
+12 0.476103
+12.1 0.542996
+12.2 0.61012
+12.3 0.677453
+12.4 0.744974
+12.5 0.812666
+12.6 0.840521
+12.7 0.868402
+12.8 0.896308
+12.9 0.924239
+13 0.952193
+13.1 0.959488
+13.2 0.966785
+13.3 0.974084
+13.4 0.981383
+13.5 0.988685
+13.6 0.990413
+13.7 0.992141
+13.8 0.993869
+13.9 0.995597
+14 0.997325
+14.1 0.997776
+14.2 0.998226
+14.3 0.998677
+14.4 0.999128
+14.5 0.999578
+14.6 0.999642
+14.7 0.999706
+14.8 0.99977
+14.9 0.999833
+15 0.999897
+15.1 0.999918
+15.2 0.999938
+15.3 0.999959
+15.4 0.999979
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0
+11.2 0
+11.3 0
+11.4 0
+11.5 0
+11.6 0
+11.7 0
+11.8 0
+11.9 0
+12 0
+12.1 0
+12.2 0
+12.3 0
+12.4 0
+12.5 0
+12.6 0
+12.7 0
+12.8 0
+12.9 0
+13 0
+13.1 0
+13.2 0
+13.3 0
+13.4 0
+13.5 0
+13.6 0
+13.7 0
+13.8 0
+13.9 0
+14 0
+14.1 0
+14.2 0
+14.3 0
+14.4 0
+14.5 0
+14.6 0.000156486
+14.7 0.000319284
+14.8 0.000484552
+14.9 0.000651446
+15 0.000819559
+15.1 0.0098587
+15.2 0.0191935
+15.3 0.0286626
+15.4 0.0382218
+15.5 0.0478491
+15.6 0.102432
+15.7 0.157885
+15.8 0.213901
+15.9 0.270335
+16 0.327103
+16.1 0.400045
+16.2 0.473363
+16.3 0.547001
+16.4 0.620919
+16.5 0.695085
+16.6 0.734221
+16.7 0.773416
+16.8 0.812666
+16.9 0.85197
+17 0.891324
+17.1 0.906177
+17.2 0.921036
+17.3 0.935902
+17.4 0.950775
+17.5 0.965655
+17.6 0.97065
+17.7 0.975646
+17.8 0.980643
+17.9 0.985641
+18 0.990639
+18.1 0.992038
+18.2 0.993437
+18.3 0.994836
+18.4 0.996235
+18.5 0.997634
+18.6 0.997975
+18.7 0.998317
+18.8 0.998658
+18.9 0.999
+19 0.999342
+19.1 0.999438
+19.2 0.999535
+19.3 0.999632
+19.4 0.999728
+19.5 0.999825
+19.6 0.999856
+19.7 0.999887
+19.8 0.999918
+19.9 0.999949
+20 0.999979
+20.1 0.999984
+20.2 0.999988
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0
+11.2 0
+11.3 0
+11.4 0
+11.5 0
+11.6 0
+11.7 0
+11.8 0
+11.9 0
+12 0
+12.1 0
+12.2 0
+12.3 0
+12.4 0
+12.5 0
+12.6 0
+12.7 0
+12.8 0
+12.9 0
+13 0
+13.1 0
+13.2 0
+13.3 0
+13.4 0
+13.5 0
+13.6 0
+13.7 0
+13.8 0
+13.9 0
+14 0
+14.1 0
+14.2 0
+14.3 0
+14.4 0
+14.5 0
+14.6 0
+14.7 0
+14.8 0
+14.9 0
+15 0
+15.1 0
+15.2 0
+15.3 0
+15.4 0
+15.5 0
+15.6 0
+15.7 0
+15.8 0
+15.9 0
+16 0
+16.1 0.000819559
+16.2 0.00167218
+16.3 0.00253773
+16.4 0.0034118
+16.5 0.00429225
+16.6 0.0253338
+16.7 0.0469612
+16.8 0.0688819
+16.9 0.091003
+17 0.113277
+17.1 0.184597
+17.2 0.256717
+17.3 0.329417
+17.4 0.402572
+17.5 0.476103
+17.6 0.537636
+17.7 0.599368
+17.8 0.661278
+17.9 0.723351
+18 0.785573
+18.1 0.815264
+18.2 0.844985
+18.3 0.874736
+18.4 0.904515
+18.5 0.934321
+18.6 0.943626
+18.7 0.952933
+18.8 0.962242
+18.9 0.971555
+19 0.980869
+19.1 0.983749
+19.2 0.986628
+19.3 0.989508
+19.4 0.992388
+19.5 0.995268
+19.6 0.995947
+19.7 0.996626
+19.8 0.997305
+19.9 0.997984
+20 0.998663
+20.1 0.998883
+20.2 0.999103
+20.3 0.999323
+20.4 0.999543
+20.5 0.999763
+20.6 0.999807
+20.7 0.99985
+20.8 0.999893
+20.9 0.999936
+21 0.999979
+21.1 0.999984
+21.2 0.999988
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0
+11.2 0
+11.3 0
+11.4 0
+11.5 0
+11.6 0
+11.7 0
+11.8 0
+11.9 0
+12 0
+12.1 0
+12.2 0
+12.3 0
+12.4 0
+12.5 0
+12.6 0
+12.7 0
+12.8 0
+12.9 0
+13 0
+13.1 0
+13.2 0
+13.3 0
+13.4 0
+13.5 0
+13.6 0
+13.7 0
+13.8 0
+13.9 0
+14 0
+14.1 0
+14.2 0
+14.3 0
+14.4 0
+14.5 0
+14.6 0
+14.7 0
+14.8 0
+14.9 0
+15 0
+15.1 0
+15.2 0
+15.3 0
+15.4 0
+15.5 0
+15.6 0
+15.7 0
+15.8 0
+15.9 0
+16 0
+16.1 0
+16.2 0
+16.3 0
+16.4 0
+16.5 0
+16.6 0
+16.7 0
+16.8 0
+16.9 0
+17 0
+17.1 0
+17.2 0
+17.3 0
+17.4 0
+17.5 0
+17.6 0.00367533
+17.7 0.00749891
+17.8 0.0113805
+17.9 0.0153003
+18 0.0192487
+18.1 0.0642091
+18.2 0.110162
+18.3 0.156674
+18.4 0.203582
+18.5 0.250797
+18.6 0.330654
+18.7 0.411059
+18.8 0.491911
+18.9 0.573137
+19 0.654689
+19.1 0.698263
+19.2 0.741913
+19.3 0.785635
+19.4 0.829425
+19.5 0.873281
+19.6 0.891304
+19.7 0.909337
+19.8 0.92738
+19.9 0.945433
+20 0.963496
+20.1 0.968738
+20.2 0.973981
+20.3 0.979224
+20.4 0.984468
+20.5 0.989713
+20.6 0.991215
+20.7 0.992717
+20.8 0.994219
+20.9 0.99572
+21 0.997222
+21.1 0.997675
+21.2 0.998128
+21.3 0.99858
+21.4 0.999033
+21.5 0.999486
+21.6 0.99957
+21.7 0.999654
+21.8 0.999739
+21.9 0.999823
+22 0.999907
+22.1 0.999924
+22.2 0.99994
+22.3 0.999957
+22.4 0.999973
+22.5 0.99999
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+e